@@ -0,0 +1,261 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the host micro-benchmark harness
+//
+//------------------------------------------------------------------------------
+
+// clock_gettime()
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Calibration kernel input, processed BENCH_CALIB_ROUNDS times per repetition
+#define BENCH_CALIB_BYTES   4096u
+#define BENCH_CALIB_ROUNDS  64u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    char     name[BENCH_NAME_MAX];
+    uint64_t bytes;
+    uint64_t ns;
+    double   ns_per_byte;
+    double   bytes_per_s;
+    // ns_per_byte relative to the calibration kernel
+    double   score;
+    // Comparison only, never fails the baseline check
+    bool     reference;
+} bench_result_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static bench_result_t s_results[BENCH_MAX_CASES];
+static unsigned s_count;
+static double s_calib_ns_per_byte;
+static volatile uint32_t s_sink;
+static uint8_t s_calib_buf[BENCH_CALIB_BYTES];
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+void bench_sink(uint32_t value) {
+    s_sink ^= value;
+}
+
+//------------------------------------------------------------------------------
+// Calibration kernel: byte-serial FNV-1a, one dependent multiply per byte,
+// representative of the byte-at-a-time code under test
+static uint64_t calib_run(void *pctx) {
+    (void)pctx;
+    uint32_t h = 2166136261u;
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t r = 0; r < BENCH_CALIB_ROUNDS; ++r) {
+        for (uint32_t i = 0; i < BENCH_CALIB_BYTES; ++i) {
+            h = (h ^ s_calib_buf[i]) * 16777619u;
+        }
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink(h);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+// Helper for the fastest of BENCH_REPS repetitions
+static uint64_t best_of(bench_fn fn, void *pctx) {
+    uint64_t best = UINT64_MAX;
+    for (unsigned r = 0; r < BENCH_REPS; ++r) {
+        uint64_t ns = fn(pctx);
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    return best ? best : 1u;
+}
+
+//------------------------------------------------------------------------------
+static bench_result_t *find_result(const char *name) {
+    for (unsigned i = 0; i < s_count; ++i) {
+        if (strcmp(s_results[i].name, name) == 0) {
+            return &s_results[i];
+        }
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Helper for recording a case
+static void record(const char *name, uint64_t bytes, bench_fn fn, void *pctx,
+        bool reference) {
+    if (bytes == 0u || (s_count >= BENCH_MAX_CASES && !find_result(name))) {
+        return;
+    }
+    // Later passes keep the fastest time seen for the case
+    bench_result_t *pr = find_result(name);
+    uint64_t ns = best_of(fn, pctx);
+    if (!pr) {
+        pr = &s_results[s_count++];
+        (void)snprintf(pr->name, sizeof(pr->name), "%s", name);
+        pr->bytes = bytes;
+        pr->ns = ns;
+        pr->reference = reference;
+    } else if (ns < pr->ns) {
+        pr->ns = ns;
+    }
+}
+
+//------------------------------------------------------------------------------
+void bench_case(const char *name, uint64_t bytes, bench_fn fn, void *pctx) {
+    record(name, bytes, fn, pctx, false);
+}
+
+//------------------------------------------------------------------------------
+void bench_reference(const char *name, uint64_t bytes, bench_fn fn, void *pctx) {
+    record(name, bytes, fn, pctx, true);
+}
+
+//------------------------------------------------------------------------------
+static void write_json(FILE *pf, const char *suite) {
+    fprintf(pf, "{\n  \"suite\": \"%s\",\n", suite);
+    fprintf(pf, "  \"calib_ns_per_byte\": %.4f,\n", s_calib_ns_per_byte);
+    fprintf(pf, "  \"results\": [\n");
+    // One case per line, so baselines diff and parse line by line
+    for (unsigned i = 0; i < s_count; ++i) {
+        const bench_result_t *pr = &s_results[i];
+        fprintf(pf,
+            "    {\"name\": \"%s\", \"bytes\": %llu, \"ns_per_byte\": %.4f, "
+            "\"bytes_per_s\": %.0f, \"score\": %.4f}%s\n",
+            pr->name, (unsigned long long)pr->bytes, pr->ns_per_byte,
+            pr->bytes_per_s, pr->score, (i + 1u < s_count) ? "," : "");
+    }
+    fprintf(pf, "  ]\n}\n");
+}
+
+//------------------------------------------------------------------------------
+// Compare against a baseline written by write_json()
+// Returns the number of regressions, or -1 if the file cannot be read
+static int compare_baseline(const char *path, double threshold_pct) {
+    FILE *pf = fopen(path, "r");
+    if (!pf) {
+        fprintf(stderr, "bench: cannot read baseline %s\n", path);
+        return -1;
+    }
+    int regressions = 0;
+    unsigned matched = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), pf)) {
+        char name[BENCH_NAME_MAX];
+        const char *pname = strstr(line, "\"name\": \"");
+        const char *pscore = strstr(line, "\"score\": ");
+        double base = 0.0;
+        if (!pname || !pscore ||
+                sscanf(pname, "\"name\": \"%63[^\"]\"", name) != 1 ||
+                sscanf(pscore, "\"score\": %lf", &base) != 1 || base <= 0.0) {
+            continue;
+        }
+        const bench_result_t *pr = find_result(name);
+        if (!pr) {
+            printf("  %-46s missing from this run\n", name);
+            continue;
+        }
+        matched++;
+        double change_pct = (pr->score / base - 1.0) * 100.0;
+        bool regressed = !pr->reference && change_pct > threshold_pct;
+        printf("  %-46s %+7.1f%%%s\n", name, change_pct,
+            regressed ? "  REGRESSION" : (pr->reference ? "  (reference)" : ""));
+        regressions += regressed ? 1 : 0;
+    }
+    fclose(pf);
+    printf("bench: %u cases compared, %d regressed beyond %.0f%%\n",
+        matched, regressions, threshold_pct);
+    return regressions;
+}
+
+//------------------------------------------------------------------------------
+int bench_main(int argc, char **argv, const char *suite, void (*cases)(void)) {
+    const char *json_path = NULL;
+    const char *baseline_path = NULL;
+    double threshold_pct = BENCH_DEFAULT_THRESHOLD_PCT;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold_pct = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--json PATH] [--baseline PATH] "
+                "[--threshold PCT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (uint32_t i = 0; i < BENCH_CALIB_BYTES; ++i) {
+        s_calib_buf[i] = (uint8_t)(i * 31u);
+    }
+    uint64_t calib_ns = UINT64_MAX;
+    s_count = 0;
+    for (unsigned pass = 0; pass < BENCH_PASSES; ++pass) {
+        uint64_t ns = best_of(calib_run, NULL);
+        calib_ns = (ns < calib_ns) ? ns : calib_ns;
+        cases();
+    }
+    s_calib_ns_per_byte = (double)calib_ns /
+        ((double)BENCH_CALIB_BYTES * BENCH_CALIB_ROUNDS);
+    // Derived figures from the fastest times
+    for (unsigned i = 0; i < s_count; ++i) {
+        bench_result_t *pr = &s_results[i];
+        pr->ns_per_byte = (double)pr->ns / (double)pr->bytes;
+        pr->bytes_per_s = (double)pr->bytes * 1e9 / (double)pr->ns;
+        pr->score = pr->ns_per_byte / s_calib_ns_per_byte;
+    }
+
+    if (json_path) {
+        FILE *pf = fopen(json_path, "w");
+        if (!pf) {
+            fprintf(stderr, "bench: cannot write %s\n", json_path);
+            return 2;
+        }
+        write_json(pf, suite);
+        fclose(pf);
+        // Human-readable summary alongside the file
+        for (unsigned i = 0; i < s_count; ++i) {
+            printf("  %-46s %8.3f ns/B %10.1f MB/s\n", s_results[i].name,
+                s_results[i].ns_per_byte, s_results[i].bytes_per_s / 1e6);
+        }
+    } else {
+        write_json(stdout, suite);
+    }
+
+    if (baseline_path) {
+        int regressions = compare_baseline(baseline_path, threshold_pct);
+        if (regressions < 0) {
+            return 2;
+        }
+        return regressions ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_BENCH_H_
+#define INCLUDE_BENCH_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a minimal host micro-benchmark harness: timed cases,
+// JSON results, and comparison against a stored baseline.
+//
+// Results are also reported as a score relative to a fixed calibration
+// kernel, and the baseline comparison uses the score, so a baseline recorded
+// on one machine remains usable on a faster or slower one.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Repetitions per case; the fastest is kept, as it is the least disturbed
+#ifndef BENCH_REPS
+#define BENCH_REPS  5u
+#endif
+
+// Passes over the whole suite, interleaved so that a slow spell on the host
+// cannot hit every repetition of one case
+#ifndef BENCH_PASSES
+#define BENCH_PASSES  3u
+#endif
+
+// Cases per suite
+#define BENCH_MAX_CASES  64u
+#define BENCH_NAME_MAX   64u
+
+// Default regression threshold, percent slower than baseline
+// Notes:
+//    - Shared and virtualized hosts swing call-heavy cases by over 50% from
+//      run to run, so the default only flags structural slowdowns (e.g., a
+//      per-byte system call); lower it on a quiet benchmark machine
+#define BENCH_DEFAULT_THRESHOLD_PCT  100u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Run one repetition; returns the nanoseconds spent in the measured section
+// so cases can leave their setup out of the timing
+typedef uint64_t (*bench_fn)(void *pctx);
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Monotonic clock in nanoseconds
+uint64_t bench_now_ns(void);
+
+//------------------------------------------------------------------------------
+// Time a case moving the given bytes per repetition and record the result
+void bench_case(const char *name, uint64_t bytes, bench_fn fn, void *pctx);
+
+//------------------------------------------------------------------------------
+// Time a comparison case (e.g., the alternative a case is measured against)
+// Notes:
+//    - Reported and compared like bench_case(), but never counted as a
+//      regression, so the suite only fails on the code under test
+void bench_reference(const char *name, uint64_t bytes, bench_fn fn, void *pctx);
+
+//------------------------------------------------------------------------------
+// Keep a computed value alive so the optimizer cannot drop the work
+void bench_sink(uint32_t value);
+
+//------------------------------------------------------------------------------
+// Suite entry point: parses options, runs the cases, writes JSON and checks
+// the baseline
+// Options:
+//    --json PATH       write results to PATH (default: stdout)
+//    --baseline PATH   compare scores against PATH
+//    --threshold PCT   allowed slowdown per case (default 100)
+// Returns the process exit code: 0 pass, 1 regression, 2 usage or I/O error
+int bench_main(int argc, char **argv, const char *suite, void (*cases)(void));
+
+#endif // INCLUDE_BENCH_H_
@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define formatter benchmarks: fmt_buf()/fmt_uart() against the C library's
+// snprintf() on the same messages
+//
+//------------------------------------------------------------------------------
+
+#include <limits.h>
+#include <stdio.h>
+#include "bench.h"
+#include "fmt_api.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Lines formatted per repetition of every case
+#define LINES_PER_REP  4096u
+#define LINE_BYTES     96u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef enum {
+    MSG_INTS = 0,   // decimal and hex integers
+    MSG_TEXT,       // strings and padding
+    MSG_TELEMETRY,  // counters and fixed-point readings
+    MSG_COUNT
+} msg_t;
+
+typedef struct {
+    msg_t msg;
+    // Format with snprintf() instead of fmt_buf() or fmt_uart()
+    bool  libc;
+} fmt_case_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static const char *const s_msg_names[MSG_COUNT] = { "ints", "text", "telemetry" };
+static char s_line[LINE_BYTES];
+UART_DEFINE_INSTANCE(s_uart, 64, 1024);
+static uart_stub_ctx_t s_ctx;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+// One line of message m with inputs varying by i; returns its length
+static size_t format_fmt(msg_t m, uint32_t i) {
+    switch (m) {
+    case MSG_INTS:
+        return fmt_buf(s_line, sizeof(s_line), "id=%u err=%d addr=0x%08x n=%5u\r\n",
+            i, -(int32_t)(i & 0xFFu), 0x20000000u + i * 4u, i & 0x3FFu);
+    case MSG_TEXT:
+        return fmt_buf(s_line, sizeof(s_line), "[%-6s] %s: %12s|\r\n",
+            (i & 1u) ? "WARN" : "INFO", "uart3", (i & 2u) ? "overrun" : "ok");
+    default:
+        return fmt_buf(s_line, sizeof(s_line), "t=%u v=%.3k mV i=%.2k mA T=%.1q\r\n",
+            i * 10u, 3300 + (int32_t)(i & 0x7Fu), -(int32_t)(i % 5000u),
+            (int32_t)(0x00190000 + (i & 0xFFFFu)));
+    }
+}
+
+//------------------------------------------------------------------------------
+// The same lines with the C library; fixed point split by hand
+static size_t format_libc(msg_t m, uint32_t i) {
+    int n;
+    switch (m) {
+    case MSG_INTS:
+        n = snprintf(s_line, sizeof(s_line), "id=%u err=%d addr=0x%08x n=%5u\r\n",
+            i, -(int32_t)(i & 0xFFu), 0x20000000u + i * 4u, i & 0x3FFu);
+        break;
+    case MSG_TEXT:
+        n = snprintf(s_line, sizeof(s_line), "[%-6s] %s: %12s|\r\n",
+            (i & 1u) ? "WARN" : "INFO", "uart3", (i & 2u) ? "overrun" : "ok");
+        break;
+    default: {
+        int32_t mv = 3300 + (int32_t)(i & 0x7Fu);
+        int32_t ma = (int32_t)(i % 5000u);
+        int32_t q = 0x00190000 + (int32_t)(i & 0xFFFFu);
+        int32_t t10 = (int32_t)(((int64_t)q * 10 + 0x8000) >> 16);
+        n = snprintf(s_line, sizeof(s_line),
+            "t=%u v=%d.%03d mV i=%s%d.%02d mA T=%d.%d\r\n",
+            i * 10u, mv / 1000, mv % 1000, ma ? "-" : "", ma / 100, ma % 100,
+            t10 / 10, t10 % 10);
+        break;
+    }
+    }
+    return (n > 0) ? (size_t)n : 0u;
+}
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+static uint64_t run_buf(void *pctx) {
+    const fmt_case_t *pc = (const fmt_case_t*)pctx;
+    size_t total = 0;
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+        total += pc->libc ? format_libc(pc->msg, i) : format_fmt(pc->msg, i);
+        bench_sink((uint32_t)(uint8_t)s_line[0]);
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink((uint32_t)total);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t run_uart(void *pctx) {
+    const fmt_case_t *pc = (const fmt_case_t*)pctx;
+    uart_hw_vtable_t hw;
+    // Stub hardware accepts every byte and stores none
+    s_ctx = (uart_stub_ctx_t){ .block_io = true, .tx_bytes = INT_MAX };
+    uart_hw_stub_create(&hw, &s_ctx);
+    (void)uart_init_instance(&s_uart, &hw, 115200);
+    size_t total = 0;
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+        if (pc->libc) {
+            size_t n = format_libc(pc->msg, i);
+            total += uart_write(s_uart.pu, (const uint8_t*)s_line, n);
+        } else {
+            total += fmt_uart(s_uart.pu,
+                "t=%u v=%.3k mV i=%.2k mA T=%.1q\r\n",
+                i * 10u, 3300 + (int32_t)(i & 0x7Fu), -(int32_t)(i % 5000u),
+                (int32_t)(0x00190000 + (i & 0xFFFFu)));
+        }
+        uart_service_tx(s_uart.pu);
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink((uint32_t)total);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+// Suite
+//------------------------------------------------------------------------------
+static void run_cases(void) {
+    static fmt_case_t cases[2u * MSG_COUNT + 2u];
+    char name[BENCH_NAME_MAX];
+    size_t k = 0;
+
+    for (int m = 0; m < (int)MSG_COUNT; ++m) {
+        // Case size: bytes of output per repetition, the same for both
+        size_t bytes = 0;
+        for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+            bytes += format_fmt((msg_t)m, i);
+        }
+        for (int libc = 0; libc < 2; ++libc) {
+            cases[k] = (fmt_case_t){ .msg = (msg_t)m, .libc = libc };
+            (void)snprintf(name, sizeof(name), "%s/%s",
+                libc ? "snprintf" : "fmt_buf", s_msg_names[m]);
+            bench_case(name, bytes, run_buf, &cases[k++]);
+        }
+    }
+
+    size_t bytes = 0;
+    for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+        bytes += format_fmt(MSG_TELEMETRY, i);
+    }
+    for (int libc = 0; libc < 2; ++libc) {
+        cases[k] = (fmt_case_t){ .msg = MSG_TELEMETRY, .libc = libc };
+        (void)snprintf(name, sizeof(name), "%s/telemetry",
+            libc ? "snprintf+uart_write" : "fmt_uart");
+        bench_case(name, bytes, run_uart, &cases[k++]);
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    return bench_main(argc, argv, "fmt", run_cases);
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Run the projects/bench kernels on the host, for tracking alongside the
+// cycle counts the firmware reports on target
+//
+//------------------------------------------------------------------------------
+
+#include "bench.h"
+#include "bench_kernels.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Kernel runs per repetition
+#define RUNS_PER_REP  256u
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+static uint64_t run_kernel(void *pctx) {
+    const bench_kernel_t *pk = (const bench_kernel_t*)pctx;
+    uint64_t ns = 0;
+    uint32_t sum = 0;
+    if (!pk->setup) {
+        uint64_t t0 = bench_now_ns();
+        for (unsigned r = 0; r < RUNS_PER_REP; ++r) {
+            sum += pk->run();
+        }
+        ns = bench_now_ns() - t0;
+    } else {
+        for (unsigned r = 0; r < RUNS_PER_REP; ++r) {
+            pk->setup();
+            uint64_t t0 = bench_now_ns();
+            sum += pk->run();
+            ns += bench_now_ns() - t0;
+        }
+    }
+    bench_sink(sum);
+    return ns;
+}
+
+//------------------------------------------------------------------------------
+static void run_cases(void) {
+    for (size_t i = 0; i < bench_kernel_count; ++i) {
+        bench_case(bench_kernels[i].name,
+            (uint64_t)bench_kernels[i].bytes * RUNS_PER_REP,
+            run_kernel, (void*)&bench_kernels[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    bench_kernels_init();
+    return bench_main(argc, argv, "kernels", run_cases);
+}
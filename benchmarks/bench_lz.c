@@ -0,0 +1,167 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define streaming LZ benchmarks: lz_write() against uart_write() on the same
+// telemetry lines, lz_decode(), and the incompressible worst case
+//
+//------------------------------------------------------------------------------
+
+#include <limits.h>
+#include <stdio.h>
+#include "bench.h"
+#include "lz_api.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Lines per repetition of every case
+#define LINES_PER_REP  4096u
+#define LINE_BYTES     64u
+#define RAW_MAX        (LINES_PER_REP * LINE_BYTES)
+
+// 115200 baud 8N1: bytes per second on the wire
+#define WIRE_BPS       (115200u / 10u)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef enum {
+    RUN_UART_WRITE = 0,
+    RUN_LZ_WRITE
+} lz_run_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Telemetry as in bench_fmt: lines, then their offsets
+static uint8_t s_raw[RAW_MAX];
+static uint32_t s_line_at[LINES_PER_REP + 1u];
+static size_t s_raw_len;
+static uint8_t s_random[RAW_MAX];
+// Telemetry compressed a line per call, as lz_write() sends it
+static uint8_t s_packed[LZ_BOUND(RAW_MAX)];
+static size_t s_packed_len;
+static uint8_t s_out[RAW_MAX];
+static lz_encoder_t s_enc;
+static lz_decoder_t s_dec;
+UART_DEFINE_INSTANCE(s_uart, 64, 1024);
+static uart_stub_ctx_t s_ctx;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static void make_inputs(void) {
+    size_t n = 0;
+    for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+        int32_t mv = 3300 + (int32_t)(i & 0x7Fu);
+        int32_t ma = (int32_t)(i % 5000u);
+        s_line_at[i] = (uint32_t)n;
+        n += (size_t)snprintf((char*)&s_raw[n], RAW_MAX - n,
+            "t=%u v=%d.%03d mV i=-%d.%02d mA T=25.%u\r\n",
+            i * 10u, mv / 1000, mv % 1000, ma / 100, ma % 100, i % 10u);
+    }
+    s_line_at[LINES_PER_REP] = (uint32_t)n;
+    s_raw_len = n;
+
+    uint32_t r = 1u;
+    for (size_t i = 0; i < RAW_MAX; ++i) {
+        r = r * 1103515245u + 12345u;
+        s_random[i] = (uint8_t)(r >> 16);
+    }
+
+    lz_encoder_init(&s_enc);
+    s_packed_len = 0;
+    for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+        size_t got;
+        (void)lz_encode(&s_enc, &s_raw[s_line_at[i]], s_line_at[i + 1u] - s_line_at[i],
+            &s_packed[s_packed_len], sizeof(s_packed) - s_packed_len, &got);
+        s_packed_len += got;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+static uint64_t run_uart(void *pctx) {
+    lz_run_t run = (lz_run_t)(uintptr_t)pctx;
+    uart_hw_vtable_t hw;
+    // Stub hardware accepts every byte and stores none
+    s_ctx = (uart_stub_ctx_t){ .block_io = true, .tx_bytes = INT_MAX };
+    uart_hw_stub_create(&hw, &s_ctx);
+    (void)uart_init_instance(&s_uart, &hw, 115200);
+    lz_encoder_init(&s_enc);
+    size_t total = 0;
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < LINES_PER_REP; ++i) {
+        const uint8_t *p = &s_raw[s_line_at[i]];
+        size_t n = s_line_at[i + 1u] - s_line_at[i];
+        total += (run == RUN_LZ_WRITE) ? lz_write(&s_enc, s_uart.pu, p, n)
+                                       : uart_write(s_uart.pu, p, n);
+        uart_service_tx(s_uart.pu);
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink((uint32_t)total);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t run_decode(void *pctx) {
+    (void)pctx;
+    lz_decoder_init(&s_dec);
+    size_t used;
+    uint64_t t0 = bench_now_ns();
+    size_t n = lz_decode(&s_dec, s_packed, s_packed_len, &used, s_out, sizeof(s_out));
+    uint64_t t1 = bench_now_ns();
+    bench_sink((uint32_t)n + s_out[n / 2u]);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+// Worst case for the encoder: every probe misses, all output is literals
+static uint64_t run_random(void *pctx) {
+    (void)pctx;
+    lz_encoder_init(&s_enc);
+    size_t total = 0;
+    uint64_t t0 = bench_now_ns();
+    for (size_t i = 0; i < s_raw_len; i += 1024u) {
+        size_t n = (s_raw_len - i < 1024u) ? s_raw_len - i : 1024u;
+        size_t got;
+        (void)lz_encode(&s_enc, &s_random[i], n, s_out, sizeof(s_out), &got);
+        total += got;
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink((uint32_t)total + s_out[0]);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+// Suite
+//------------------------------------------------------------------------------
+static void run_cases(void) {
+    // Case size: telemetry bytes per repetition, before compression
+    bench_case("uart_write/telemetry", s_raw_len, run_uart,
+        (void*)(uintptr_t)RUN_UART_WRITE);
+    bench_case("lz_write/telemetry", s_raw_len, run_uart,
+        (void*)(uintptr_t)RUN_LZ_WRITE);
+    bench_case("lz_decode/telemetry", s_raw_len, run_decode, NULL);
+    bench_case("lz_encode/random", s_raw_len, run_random, NULL);
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    make_inputs();
+    // Ratio of the stream lz_write() sends, and what it buys on the line
+    uint32_t q = lz_ratio_q16(&s_enc.stats);
+    fprintf(stderr, "lz: telemetry %zu -> %zu bytes, ratio %.2f: %.0f B/s of "
+        "text at 115200 baud instead of %u\n", s_raw_len, s_packed_len,
+        q / 65536.0, (double)WIRE_BPS * q / 65536.0, WIRE_BPS);
+    return bench_main(argc, argv, "lz", run_cases);
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define shell dispatch benchmarks: perfect-hash lookup (shell_find) against
+// a strcmp() chain, for tables of increasing size
+//
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "shell_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Lookups per repetition of every case, cycling through the table's names
+#define LOOKUPS_PER_REP  4096u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    const shell_table_t *ptable;
+    // Search the entries one by one instead of hashing
+    bool chain;
+} shell_case_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Generated from synthetic lists of 8, 64 and 512 commands
+extern const shell_table_t g_cmds_8;
+extern const shell_table_t g_cmds_64;
+extern const shell_table_t g_cmds_512;
+
+//------------------------------------------------------------------------------
+// Command Handlers
+//------------------------------------------------------------------------------
+int bench_nop(shell_t *psh, int argc, char **argv) {
+    (void)psh;
+    (void)argc;
+    (void)argv;
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+// The usual alternative: compare against every name in turn
+static const shell_cmd_t *find_chain(const shell_table_t *pt, const char *pname) {
+    for (uint32_t i = 0; i < pt->count; ++i) {
+        if (strcmp(pt->pcmds[i].name, pname) == 0) {
+            return &pt->pcmds[i];
+        }
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+static uint64_t run_find(void *pctx) {
+    const shell_case_t *pc = (const shell_case_t*)pctx;
+    const shell_table_t *pt = pc->ptable;
+    uint32_t hits = 0;
+    uint32_t k = 0;
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < LOOKUPS_PER_REP; ++i) {
+        // Names of a generated table are all distinct; step through them in
+        // an order unrelated to the slot order
+        const char *pname = pt->pcmds[k].name;
+        k = (k + 7u < pt->count) ? k + 7u : (k + 7u) % pt->count;
+        const shell_cmd_t *pcmd = pc->chain ? find_chain(pt, pname)
+                                            : shell_find(pt, pname, strlen(pname));
+        hits += (pcmd != NULL);
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink(hits);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+// Suite
+//------------------------------------------------------------------------------
+static void run_cases(void) {
+    static const shell_table_t *const tables[] = {
+        &g_cmds_8, &g_cmds_64, &g_cmds_512
+    };
+    static shell_case_t cases[2u * (sizeof(tables) / sizeof(tables[0]))];
+    char name[BENCH_NAME_MAX];
+    size_t k = 0;
+
+    for (size_t t = 0; t < sizeof(tables) / sizeof(tables[0]); ++t) {
+        // Case size: name bytes looked up per repetition
+        size_t bytes = 0;
+        uint32_t j = 0;
+        for (uint32_t i = 0; i < LOOKUPS_PER_REP; ++i) {
+            bytes += strlen(tables[t]->pcmds[j].name);
+            j = (j + 7u) % tables[t]->count;
+        }
+        for (int chain = 0; chain < 2; ++chain) {
+            cases[k] = (shell_case_t){ .ptable = tables[t], .chain = chain };
+            (void)snprintf(name, sizeof(name), "%s/%u",
+                chain ? "strcmp_chain" : "shell_find", tables[t]->count);
+            // The strcmp() chain is only there for comparison
+            if (chain) {
+                bench_reference(name, bytes, run_find, &cases[k++]);
+            } else {
+                bench_case(name, bytes, run_find, &cases[k++]);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    return bench_main(argc, argv, "shell", run_cases);
+}
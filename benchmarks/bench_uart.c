@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define ringbuf and UART core micro-benchmarks against the stub backend
+//
+//------------------------------------------------------------------------------
+
+#include <limits.h>
+#include <stdio.h>
+#include "bench.h"
+#include "ringbuf.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Bytes moved per repetition of every case
+#define BYTES_PER_REP  (256u * 1024u)
+
+// Largest FIFO used by any case
+#define FIFO_MAX       16384u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    // FIFO size in bytes
+    size_t fifo;
+    // Message (uart_write/uart_read) or echo chunk size in bytes
+    size_t chunk;
+    // Stub installs the block transfer entries
+    bool block;
+} uart_case_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static uint8_t s_rx_fifo[FIFO_MAX];
+static uint8_t s_tx_fifo[FIFO_MAX];
+static uint8_t s_data[FIFO_MAX];
+static struct uart_t s_uart;
+static uart_stub_ctx_t s_ctx;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+// Fresh instance over the stub; Tx accepts everything and stores nothing
+static void uart_setup(const uart_case_t *pc) {
+    uart_hw_vtable_t hw;
+    s_ctx = (uart_stub_ctx_t){ .block_io = pc->block, .tx_bytes = INT_MAX };
+    uart_hw_stub_create(&hw, &s_ctx);
+    (void)uart_init(&s_uart, &hw, 115200, s_rx_fifo, pc->fifo,
+        s_tx_fifo, pc->fifo);
+}
+
+//------------------------------------------------------------------------------
+static void case_name(char *pname, size_t size, const char *op,
+        const char *param, const uart_case_t *pc) {
+    (void)snprintf(pname, size, "%s/fifo=%zu/%s=%zu/%s", op, pc->fifo, param,
+        pc->chunk, pc->block ? "block" : "byte");
+}
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+static uint64_t run_ringbuf(void *pctx) {
+    const uart_case_t *pc = (const uart_case_t*)pctx;
+    ringbuf_t rb;
+    uint8_t byte = 0;
+    uint32_t sum = 0;
+    ringbuf_init(&rb, s_rx_fifo, pc->fifo);
+    uint64_t t0 = bench_now_ns();
+    for (size_t done = 0; done < BYTES_PER_REP; done += pc->fifo) {
+        for (size_t i = 0; i < pc->fifo; ++i) {
+            (void)ringbuf_push(&rb, (uint8_t)i);
+        }
+        while (ringbuf_pop(&rb, &byte)) {
+            sum += byte;
+        }
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink(sum);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t run_write(void *pctx) {
+    const uart_case_t *pc = (const uart_case_t*)pctx;
+    uart_setup(pc);
+    uint64_t t0 = bench_now_ns();
+    for (size_t done = 0; done < BYTES_PER_REP; done += pc->chunk) {
+        (void)uart_write(&s_uart, s_data, pc->chunk);
+    }
+    return bench_now_ns() - t0;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t run_read(void *pctx) {
+    const uart_case_t *pc = (const uart_case_t*)pctx;
+    uint8_t out[FIFO_MAX];
+    uint64_t ns = 0;
+    uart_setup(pc);
+    for (size_t done = 0; done < BYTES_PER_REP; done += pc->fifo) {
+        uart_isr_rx_block(&s_uart, s_data, pc->fifo);
+        uint64_t t0 = bench_now_ns();
+        while (uart_read(&s_uart, out, pc->chunk)) {
+        }
+        ns += bench_now_ns() - t0;
+    }
+    bench_sink(out[0]);
+    return ns;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t run_echo(void *pctx) {
+    const uart_case_t *pc = (const uart_case_t*)pctx;
+    uint64_t ns = 0;
+    uart_setup(pc);
+    uart_set_echo_chunk_size(&s_uart, pc->chunk);
+    for (size_t done = 0; done < BYTES_PER_REP; done += pc->fifo) {
+        uart_isr_rx_block(&s_uart, s_data, pc->fifo);
+        uint64_t t0 = bench_now_ns();
+        uart_echo_pump(&s_uart);
+        ns += bench_now_ns() - t0;
+    }
+    return ns;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t run_service_tx(void *pctx) {
+    const uart_case_t *pc = (const uart_case_t*)pctx;
+    uint64_t ns = 0;
+    uart_setup(pc);
+    for (size_t done = 0; done < BYTES_PER_REP; done += pc->fifo) {
+        // Queue a full FIFO while the backend is busy, then time the drain
+        s_ctx.tx_bytes = 0;
+        (void)uart_write(&s_uart, s_data, pc->fifo);
+        s_ctx.tx_bytes = INT_MAX;
+        uint64_t t0 = bench_now_ns();
+        uart_service_tx(&s_uart);
+        ns += bench_now_ns() - t0;
+    }
+    return ns;
+}
+
+//------------------------------------------------------------------------------
+// Suite
+//------------------------------------------------------------------------------
+static void run_cases(void) {
+    static const size_t fifos[] = { 64u, 1024u, 16384u };
+    static const size_t msgs[] = { 1u, 16u, 256u };
+    // Echo chunks are bounded by UART_ECHO_DRAIN_CHUNK_BYTES
+    static const size_t chunks[] = { 1u, 8u, 32u };
+    char name[BENCH_NAME_MAX];
+
+    for (size_t i = 0; i < FIFO_MAX; ++i) {
+        s_data[i] = (uint8_t)(i * 13u);
+    }
+
+    for (size_t f = 0; f < sizeof(fifos) / sizeof(fifos[0]); ++f) {
+        uart_case_t c = { .fifo = fifos[f] };
+        (void)snprintf(name, sizeof(name), "ringbuf_push_pop/fifo=%zu", c.fifo);
+        bench_case(name, BYTES_PER_REP, run_ringbuf, &c);
+    }
+
+    for (int block = 0; block < 2; ++block) {
+        for (size_t m = 0; m < sizeof(msgs) / sizeof(msgs[0]); ++m) {
+            uart_case_t c = { .fifo = 1024u, .chunk = msgs[m], .block = block };
+            case_name(name, sizeof(name), "uart_write", "msg", &c);
+            bench_case(name, BYTES_PER_REP, run_write, &c);
+        }
+    }
+
+    for (size_t m = 0; m < sizeof(msgs) / sizeof(msgs[0]); ++m) {
+        uart_case_t c = { .fifo = 4096u, .chunk = msgs[m] };
+        case_name(name, sizeof(name), "uart_read", "msg", &c);
+        bench_case(name, BYTES_PER_REP, run_read, &c);
+    }
+
+    for (int block = 0; block < 2; ++block) {
+        for (size_t k = 0; k < sizeof(chunks) / sizeof(chunks[0]); ++k) {
+            uart_case_t c = { .fifo = 4096u, .chunk = chunks[k], .block = block };
+            case_name(name, sizeof(name), "uart_echo_pump", "chunk", &c);
+            bench_case(name, BYTES_PER_REP, run_echo, &c);
+        }
+    }
+
+    for (int block = 0; block < 2; ++block) {
+        for (size_t f = 1; f < sizeof(fifos) / sizeof(fifos[0]); ++f) {
+            uart_case_t c = { .fifo = fifos[f], .chunk = fifos[f], .block = block };
+            case_name(name, sizeof(name), "uart_service_tx", "burst", &c);
+            bench_case(name, BYTES_PER_REP, run_service_tx, &c);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    return bench_main(argc, argv, "uart", run_cases);
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define end-to-end benchmarks of the STM32H5 UART backend on the
+// register-level peripheral model
+//
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include "bench.h"
+#include "uart_core.h"
+#include "uart_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Bytes echoed per repetition of every case
+#define BYTES_PER_REP  4096u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    // USART FIFO mode (CR1.FIFOEN)
+    bool fifo;
+    // Main loop period in character times / 4
+    uint32_t quarter_chars;
+} hw_case_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_uart, 1024, 1024);
+static uint8_t s_data[BYTES_PER_REP];
+static uint8_t s_out[BYTES_PER_REP];
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+// Stream a block in at line rate and echo it through the real register path
+static uint64_t run_echo(void *pctx) {
+    const hw_case_t *pc = (const hw_case_t*)pctx;
+    uart_hw_vtable_t hw;
+    periph_sim_reset();
+    uart_hw_install(&hw);
+    (void)uart_init_instance(&s_uart, &hw, 115200);
+    if (pc->fifo) {
+        uint32_t cr1 = REG32(USART3_BASE + USART_CR1_OFFSET);
+        REG32(USART3_BASE + USART_CR1_OFFSET) = cr1 & ~USART_CR1_UE;
+        REG32(USART3_BASE + USART_CR1_OFFSET) = cr1 | USART_CR1_FIFOEN;
+    }
+    uint64_t period = (uint64_t)periph_sim_usart_char_ns() * pc->quarter_chars / 4u;
+    // Bytes lost to an overrun never come back; stop well after the last
+    uint64_t deadline = 2u * (BYTES_PER_REP + 64u) *
+        (uint64_t)periph_sim_usart_char_ns();
+    size_t got = 0;
+
+    uint64_t t0 = bench_now_ns();
+    periph_sim_usart_rx(s_data, BYTES_PER_REP, 0u);
+    while (got < BYTES_PER_REP && periph_sim_now() < deadline) {
+        (void)uart_poll_rx(s_uart.pu);
+        uart_echo_pump(s_uart.pu);
+        uart_service_tx(s_uart.pu);
+        periph_sim_advance(period);
+        got += periph_sim_usart_tx_take(&s_out[got], BYTES_PER_REP - got);
+    }
+    uint64_t t1 = bench_now_ns();
+    bench_sink(s_out[BYTES_PER_REP - 1u]);
+    return t1 - t0;
+}
+
+//------------------------------------------------------------------------------
+// Suite
+//------------------------------------------------------------------------------
+static void run_cases(void) {
+    static const hw_case_t cases[] = {
+        { .fifo = false, .quarter_chars = 2u },
+        { .fifo = true,  .quarter_chars = 2u },
+        { .fifo = true,  .quarter_chars = 16u },
+    };
+    char name[BENCH_NAME_MAX];
+
+    for (size_t i = 0; i < BYTES_PER_REP; ++i) {
+        s_data[i] = (uint8_t)(i * 29u);
+    }
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        (void)snprintf(name, sizeof(name), "uart_hw_echo/%s/period=%.2fchar",
+            cases[c].fifo ? "fifo" : "nofifo", cases[c].quarter_chars / 4.0);
+        bench_case(name, BYTES_PER_REP, run_echo, (void*)&cases[c]);
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    return bench_main(argc, argv, "uart_hw_sim", run_cases);
+}
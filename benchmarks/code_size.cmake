@@ -0,0 +1,41 @@
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+#-------------------------------------------------------------------------------
+#
+# Report the .text cost of each code size probe over the first one
+#
+#   cmake -DSIZE_TOOL=size "-DPROBES=base;a;b" -P code_size.cmake
+#
+#-------------------------------------------------------------------------------
+
+cmake_minimum_required(VERSION 3.16)
+
+execute_process(
+    COMMAND ${SIZE_TOOL} ${PROBES}
+    OUTPUT_VARIABLE out
+    RESULT_VARIABLE rc
+)
+if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "code_size: ${SIZE_TOOL} failed")
+endif()
+
+# Berkeley format: text data bss dec hex filename, after a header line
+string(REPLACE "\n" ";" lines "${out}")
+set(base_text "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[ \t]*([0-9]+)[ \t]+[0-9]+[ \t]+[0-9]+[ \t]+[0-9]+[ \t]+[0-9a-f]+[ \t]+(.+)$")
+        set(text ${CMAKE_MATCH_1})
+        get_filename_component(name "${CMAKE_MATCH_2}" NAME)
+        if(base_text STREQUAL "")
+            set(base_text ${text})
+            message("code_size: ${name}: ${text} bytes .text (reference)")
+        else()
+            math(EXPR delta "${text} - ${base_text}")
+            message("code_size: ${name}: +${delta} bytes .text")
+        endif()
+    endif()
+endforeach()
+message("code_size: a static host C library may link its printf engine into "
+    "every program; the firmware probes (projects/bench) measure newlib-nano")
@@ -0,0 +1,272 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines a portable DMA channel allocator and chain runner.
+//
+// Notes:
+//    - Channels are allocated and loaded from thread context, normally at
+//      initialization; only dma_isr() runs from the channel interrupt
+//    - Finished blocks are counted from the block in progress, so one
+//      interrupt may report several, each to the callback in order
+//
+//------------------------------------------------------------------------------
+
+#include "dma_api.h"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    dma_config_t cfg;
+    bool allocated;
+    bool running;
+    bool ring;
+    // Blocks loaded (0: none) and which of them notify
+    uint32_t n;
+    uint32_t notify;
+    // Next block to finish
+    uint32_t next;
+    // Bumped by every start and stop, so a callback may restart the channel
+    uint32_t gen;
+} dma_channel_t;
+
+_Static_assert(DMA_CHAIN_MAX <= 32u, "notify mask holds DMA_CHAIN_MAX bits");
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Installed backend
+static dma_hw_vtable_t s_hw;
+static bool s_ready;
+static dma_channel_t s_ch[DMA_MAX_CHANNELS];
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to look up a channel its owner may use
+static dma_channel_t *owned(uint32_t ch) {
+    if (!s_ready || ch >= DMA_MAX_CHANNELS || !s_ch[ch].allocated) {
+        return NULL;
+    }
+    return &s_ch[ch];
+}
+
+//------------------------------------------------------------------------------
+static bool config_valid(const dma_config_t *pcfg) {
+    if (pcfg->raw) {
+        return true;
+    }
+    if (pcfg->dir > DMA_DIR_MEM_TO_MEM || pcfg->width > DMA_WIDTH_32) {
+        return false;
+    }
+    if (pcfg->dir == DMA_DIR_MEM_TO_MEM) {
+        return pcfg->request == DMA_REQ_NONE;
+    }
+    return pcfg->request != DMA_REQ_NONE && pcfg->pperiph != NULL;
+}
+
+//------------------------------------------------------------------------------
+static bool block_valid(const dma_config_t *pcfg, const dma_block_t *pb) {
+    uint32_t unit = 1u << pcfg->width;
+    if (pb->len == 0u || pb->len > DMA_BLOCK_MAX_BYTES || (pb->len % unit) != 0u) {
+        return false;
+    }
+    switch (pcfg->dir) {
+    case DMA_DIR_MEM_TO_PERIPH:
+        return pb->psrc != NULL;
+    case DMA_DIR_PERIPH_TO_MEM:
+        return pb->pdst != NULL;
+    default:
+        return pb->psrc != NULL && pb->pdst != NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool dma_init(const dma_hw_vtable_t *phw) {
+    // Initial sanity checks
+    if (!phw || !phw->hw_init || !phw->hw_load || !phw->hw_start ||
+            !phw->hw_stop || !phw->hw_poll || !phw->hw_position ||
+            !phw->hw_irq_enable) {
+        return false;
+    }
+    // Install hardware API
+    s_hw = *phw;
+    for (uint32_t ch = 0; ch < DMA_MAX_CHANNELS; ch++) {
+        s_ch[ch] = (dma_channel_t){ 0 };
+    }
+    s_ready = s_hw.hw_init();
+    return s_ready;
+}
+
+//------------------------------------------------------------------------------
+bool dma_alloc(const dma_config_t *pcfg, uint32_t *pch) {
+    if (!s_ready || !pcfg || !pch || !config_valid(pcfg)) {
+        return false;
+    }
+    for (uint32_t ch = 0; ch < DMA_MAX_CHANNELS; ch++) {
+        dma_channel_t *pc = &s_ch[ch];
+        if (!pc->allocated) {
+            *pc = (dma_channel_t){ .cfg = *pcfg, .allocated = true };
+            if (pcfg->on_event) {
+                s_hw.hw_irq_enable(ch, true);
+            }
+            *pch = ch;
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void dma_free(uint32_t ch) {
+    dma_channel_t *pc = owned(ch);
+    if (!pc) {
+        return;
+    }
+    s_hw.hw_irq_enable(ch, false);
+    (void)s_hw.hw_stop(ch);
+    *pc = (dma_channel_t){ 0 };
+}
+
+//------------------------------------------------------------------------------
+bool dma_load(uint32_t ch, const dma_block_t *pblocks, size_t n, bool ring) {
+    dma_channel_t *pc = owned(ch);
+    if (!pc || pc->cfg.raw || pc->running || !pblocks || n == 0u ||
+            n > DMA_CHAIN_MAX) {
+        return false;
+    }
+    uint32_t notify = 0u;
+    for (size_t i = 0; i < n; i++) {
+        if (!block_valid(&pc->cfg, &pblocks[i])) {
+            return false;
+        }
+        if (pblocks[i].flags & DMA_BLOCK_NOTIFY) {
+            notify |= 1u << i;
+        }
+    }
+    if (!s_hw.hw_load(ch, &pc->cfg, pblocks, n, ring)) {
+        pc->n = 0u;
+        return false;
+    }
+    pc->n = (uint32_t)n;
+    pc->ring = ring;
+    pc->notify = notify;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool dma_start(uint32_t ch) {
+    dma_channel_t *pc = owned(ch);
+    if (!pc || pc->running || pc->n == 0u) {
+        return false;
+    }
+    pc->next = 0u;
+    pc->gen++;
+    pc->running = s_hw.hw_start(ch, pc->cfg.on_event != NULL);
+    return pc->running;
+}
+
+//------------------------------------------------------------------------------
+bool dma_stop(uint32_t ch) {
+    dma_channel_t *pc = owned(ch);
+    if (!pc || pc->cfg.raw || !s_hw.hw_stop(ch)) {
+        return false;
+    }
+    (void)s_hw.hw_poll(ch);
+    pc->running = false;
+    pc->gen++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool dma_position(uint32_t ch, uint32_t *pblock, uint32_t *premaining) {
+    dma_channel_t *pc = owned(ch);
+    if (!pc || !pc->running || !pblock || !premaining) {
+        return false;
+    }
+    return s_hw.hw_position(ch, pblock, premaining);
+}
+
+//------------------------------------------------------------------------------
+void dma_irq_mask(uint32_t ch, bool masked) {
+    dma_channel_t *pc = owned(ch);
+    if (pc && pc->cfg.on_event) {
+        s_hw.hw_irq_enable(ch, !masked);
+    }
+}
+
+//------------------------------------------------------------------------------
+size_t dma_channels_free(void) {
+    size_t n = 0;
+    for (uint32_t ch = 0; ch < DMA_MAX_CHANNELS; ch++) {
+        n += s_ch[ch].allocated ? 0u : 1u;
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+void dma_isr(uint32_t ch) {
+    dma_channel_t *pc = owned(ch);
+    if (!pc) {
+        return;
+    }
+    dma_event_fn fn = pc->cfg.on_event;
+    if (pc->cfg.raw) {
+        // The owner reads its own registers
+        if (fn) {
+            fn(pc->cfg.pctx, ch, 0u, 0u);
+        }
+        return;
+    }
+    // Clear the events before reading the position: a block finishing in
+    // between is counted now and raises another (empty) interrupt
+    uint32_t events = s_hw.hw_poll(ch);
+    if (!pc->running) {
+        return;
+    }
+    if (events & DMA_EV_ERROR) {
+        (void)s_hw.hw_stop(ch);
+        pc->running = false;
+        pc->gen++;
+        if (fn) {
+            fn(pc->cfg.pctx, ch, pc->next, DMA_EV_ERROR);
+        }
+        return;
+    }
+
+    uint32_t cur;
+    uint32_t remaining;
+    bool active = s_hw.hw_position(ch, &cur, &remaining);
+    uint32_t done;
+    if (!active) {
+        // Ran off the end of a linear chain
+        done = pc->n - pc->next;
+        pc->running = false;
+    } else if (pc->ring && pc->n == 1u) {
+        // The position cannot tell laps apart: one per event
+        done = (events & DMA_EV_BLOCK) ? 1u : 0u;
+    } else if (pc->ring) {
+        done = (cur + pc->n - pc->next) % pc->n;
+    } else {
+        done = cur - pc->next;
+    }
+
+    uint32_t gen = pc->gen;
+    while (done--) {
+        uint32_t block = pc->next;
+        pc->next = pc->ring ? (block + 1u) % pc->n : block + 1u;
+        bool last = !active && pc->next == pc->n;
+        if (fn && (((pc->notify >> block) & 1u) || last)) {
+            fn(pc->cfg.pctx, ch, block, DMA_EV_BLOCK | (last ? DMA_EV_END : 0u));
+            // Restarted or stopped from the callback: the count is stale
+            if (pc->gen != gen || !pc->allocated) {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the portable LED PWM modes. It only turns each mode
+// into timer settings and a duty table; the backend plays them in hardware.
+//
+//------------------------------------------------------------------------------
+
+#include "led_pwm_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Blink counter resolution: 0.1 ms ticks, or 1 ms ticks for long periods
+#define BLINK_FINE_HZ     10000u
+#define BLINK_COARSE_HZ   1000u
+#define BLINK_MAX_TICKS   0xFFFFu
+
+// Breathe table: fade in over half the steps, out over the other half
+#define BREATHE_STEPS     LED_PWM_MAX_STEPS
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Installed backend
+static led_pwm_hw_vtable_t s_hw;
+static led_pwm_mode_t s_mode;
+
+// Played by hardware: must persist while a sequence runs
+static uint16_t s_table[LED_PWM_MAX_STEPS];
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to start a brightness sequence on the PWM carrier
+static bool run_sequence(size_t steps, uint32_t step_us) {
+    uint32_t counter_hz = LED_PWM_CARRIER_HZ * LED_PWM_LEVELS;
+    if (!s_hw.hw_sequence || !step_us ||
+            !s_hw.hw_pwm(counter_hz, LED_PWM_LEVELS, s_table[0])) {
+        (void)s_hw.hw_stop();
+        return false;
+    }
+    if (!s_hw.hw_sequence(s_table, steps, step_us)) {
+        (void)s_hw.hw_stop();
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_init(const led_pwm_hw_vtable_t *phw) {
+    // Initial sanity checks
+    if (!phw || !phw->hw_init || !phw->hw_pwm || !phw->hw_stop) {
+        return false;
+    }
+    // Install hardware API
+    s_hw = *phw;
+    s_mode = LED_PWM_OFF;
+    return s_hw.hw_init() && s_hw.hw_stop();
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_steady(uint32_t level) {
+    if (!led_pwm_off() || level > LED_PWM_LEVELS) {
+        return false;
+    }
+    if (!s_hw.hw_pwm(LED_PWM_CARRIER_HZ * LED_PWM_LEVELS, LED_PWM_LEVELS, level)) {
+        return false;
+    }
+    s_mode = LED_PWM_STEADY;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_blink(uint32_t period_ms, uint32_t on_ms) {
+    if (!led_pwm_off() || period_ms < 2u || on_ms > period_ms) {
+        return false;
+    }
+    // Finest resolution whose period still fits the 16-bit counter
+    uint32_t counter_hz = BLINK_FINE_HZ;
+    if ((uint64_t)period_ms * (counter_hz / 1000u) > BLINK_MAX_TICKS) {
+        counter_hz = BLINK_COARSE_HZ;
+        if (period_ms > BLINK_MAX_TICKS) {
+            return false;
+        }
+    }
+    uint32_t ticks_per_ms = counter_hz / 1000u;
+    if (!s_hw.hw_pwm(counter_hz, period_ms * ticks_per_ms, on_ms * ticks_per_ms)) {
+        return false;
+    }
+    s_mode = LED_PWM_BLINK;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_breathe(uint32_t period_ms) {
+    const uint32_t half = BREATHE_STEPS / 2u;
+    if (!led_pwm_off() || period_ms < BREATHE_STEPS || period_ms > 60000u) {
+        return false;
+    }
+    // Squared ramp approximates perceived brightness (gamma ~2)
+    for (uint32_t i = 0; i < half; ++i) {
+        uint16_t level = (uint16_t)((LED_PWM_LEVELS * i * i) / ((half - 1u) * (half - 1u)));
+        s_table[i] = level;
+        s_table[BREATHE_STEPS - 1u - i] = level;
+    }
+    if (!run_sequence(BREATHE_STEPS, (period_ms * 1000u) / BREATHE_STEPS)) {
+        return false;
+    }
+    s_mode = LED_PWM_BREATHE;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_pattern(uint32_t bits, uint32_t nbits, uint32_t step_ms) {
+    if (!led_pwm_off() || nbits == 0u || nbits > 32u || step_ms == 0u ||
+            step_ms > 6000u) {
+        return false;
+    }
+    for (uint32_t i = 0; i < nbits; ++i) {
+        s_table[i] = ((bits >> i) & 1u) ? (uint16_t)LED_PWM_LEVELS : 0u;
+    }
+    if (!run_sequence(nbits, step_ms * 1000u)) {
+        return false;
+    }
+    s_mode = LED_PWM_PATTERN;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_off(void) {
+    s_mode = LED_PWM_OFF;
+    return s_hw.hw_stop();
+}
+
+//------------------------------------------------------------------------------
+led_pwm_mode_t led_pwm_mode(void) {
+    return s_mode;
+}
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines a portable SPI core implementation.
+//
+// Notes:
+//    - Thread context (spi_submit) and the completion interrupt (spi_isr)
+//      both hand transfers to the backend, so thread context masks the
+//      completion interrupt around its queue update (hw_irq_mask); with no
+//      hw_irq_mask the core must only be used from one context
+//    - Only a transfer that follows an SPI_XFER_CS_HOLD one is chained with
+//      hw_link: anything else needs chip select released in between, which
+//      the backend does at the end of a chain
+//
+//------------------------------------------------------------------------------
+
+#include "spi_core.h"
+
+//------------------------------------------------------------------------------
+// Opaque Context
+//------------------------------------------------------------------------------
+
+// Define spi_t size helper function
+size_t spi_context_size(void) { return sizeof(struct spi_t); }
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to hand queued transfers to the backend: a bus start when it is
+// idle, then chained behind a held transfer for as long as it takes them
+static void issue(spi_t *ps) {
+    while (ps->issued != ps->tail) {
+        spi_xfer_t *px = ps->queue[ps->issued & ps->mask];
+        if (ps->head == ps->issued) {
+            if (!ps->hw.hw_start(px)) {
+                return;
+            }
+            ps->stats.started++;
+        } else {
+            const spi_xfer_t *pprev = ps->queue[(ps->issued - 1u) & ps->mask];
+            if (!ps->hw.hw_link || !(pprev->flags & SPI_XFER_CS_HOLD) ||
+                    !ps->hw.hw_link(px)) {
+                // Started from the completion interrupt instead
+                return;
+            }
+            ps->stats.linked++;
+        }
+        px->status = SPI_XFER_ACTIVE;
+        ps->issued++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper to retire the oldest transfer with the backend
+static void finish(spi_t *ps, spi_xfer_status_t status) {
+    spi_xfer_t *px = ps->queue[ps->head & ps->mask];
+    ps->head++;
+    px->status = status;
+    if (status == SPI_XFER_DONE) {
+        ps->stats.completed++;
+    } else {
+        ps->stats.failed++;
+    }
+    if (px->done) {
+        px->done(px->pctx, px);
+    }
+}
+
+//------------------------------------------------------------------------------
+static inline void irq_mask(spi_t *ps, bool masked) {
+    if (ps->hw.hw_irq_mask) {
+        ps->hw.hw_irq_mask(masked);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool spi_init(
+        spi_t                 *ps,
+        const spi_hw_vtable_t *phw,
+        uint32_t              clock_hz,
+        spi_mode_t            mode,
+        spi_xfer_t            **pqueue,
+        size_t                depth) {
+    // Initial sanity checks
+    if (!ps || !phw || !phw->hw_init || !phw->hw_start ||
+            !phw->hw_poll_done || !pqueue || depth == 0u ||
+            (depth & (depth - 1u)) != 0u || depth > UINT32_MAX / 2u ||
+            clock_hz == 0u || mode > SPI_MODE_3) {
+        return false;
+    }
+    // Install hardware API
+    ps->hw = *phw;
+    ps->queue = pqueue;
+    ps->mask = (uint32_t)depth - 1u;
+    ps->head = 0;
+    ps->issued = 0;
+    ps->tail = 0;
+    ps->stats = (spi_stats_t){ 0 };
+    return ps->hw.hw_init(clock_hz, mode);
+}
+
+//------------------------------------------------------------------------------
+bool spi_submit(spi_t *ps, spi_xfer_t *px) {
+    if (!px || px->len == 0u || px->len > SPI_XFER_MAX_BYTES ||
+            px->status == SPI_XFER_QUEUED || px->status == SPI_XFER_ACTIVE) {
+        return false;
+    }
+    irq_mask(ps, true);
+    uint32_t queued = ps->tail - ps->head;
+    if (queued > ps->mask) {
+        irq_mask(ps, false);
+        return false;
+    }
+    px->status = SPI_XFER_QUEUED;
+    ps->queue[ps->tail & ps->mask] = px;
+    ps->tail++;
+    ps->stats.submitted++;
+    if (queued + 1u > ps->stats.max_queued) {
+        ps->stats.max_queued = queued + 1u;
+    }
+    issue(ps);
+    irq_mask(ps, false);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t spi_isr(spi_t *ps) {
+    size_t n = 0;
+    // Finished in order; a callback may submit again as it goes
+    size_t done = ps->hw.hw_poll_done();
+    while (done-- && ps->head != ps->issued) {
+        finish(ps, SPI_XFER_DONE);
+        n++;
+    }
+    if (ps->hw.hw_error && ps->hw.hw_error()) {
+        while (ps->head != ps->issued) {
+            finish(ps, SPI_XFER_ERROR);
+            n++;
+        }
+    }
+    // Whatever could not be chained starts now
+    issue(ps);
+    return n;
+}
+
+//------------------------------------------------------------------------------
+size_t spi_pending(const spi_t *ps) {
+    return ps->tail - ps->head;
+}
+
+//------------------------------------------------------------------------------
+void spi_get_stats(const spi_t *ps, spi_stats_t *pstats) {
+    *pstats = ps->stats;
+}
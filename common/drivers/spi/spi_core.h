@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SPI_CORE_H_
+#define INCLUDE_SPI_CORE_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a portable SPI core API.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "spi_api.h"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Opaque handle declared in API header
+// Notes:
+//    - Defined here only so instances can be sized and allocated at compile
+//      time (see SPI_DEFINE_INSTANCE); clients must treat it as opaque
+//    - The queue is a ring of descriptor pointers with free-running indices:
+//      [head, issued) are with the backend, [issued, tail) wait for the bus
+struct spi_t {
+    // Hardware backend - to be installed
+    spi_hw_vtable_t hw;
+    spi_xfer_t **queue;
+    uint32_t    mask;
+    uint32_t    head;
+    uint32_t    issued;
+    uint32_t    tail;
+    spi_stats_t stats;
+};
+
+//------------------------------------------------------------------------------
+// Static Instances
+//------------------------------------------------------------------------------
+
+// Storage descriptor for a statically allocated instance
+typedef struct {
+    spi_t       *ps;
+    spi_xfer_t  **pqueue;
+    size_t      depth;
+    // RAM used by this instance: context plus queue
+    size_t      footprint_bytes;
+} spi_instance_t;
+
+// Exact RAM footprint of an instance, as a compile-time constant
+#define SPI_INSTANCE_FOOTPRINT(entries) \
+    (sizeof(struct spi_t) + (size_t)(entries) * sizeof(spi_xfer_t*))
+
+// Allocate an instance's context and queue in .bss
+// Notes:
+//    - Each object is a named symbol (name_ctx, name_queue), so the linker
+//      map reports the footprint per instance
+#define SPI_DEFINE_INSTANCE(name, entries)                                     \
+    _Static_assert((entries) > 0 && ((entries) & ((entries) - 1)) == 0,        \
+        #name ": queue depth must be a power of two");                         \
+    static struct spi_t name##_ctx;                                            \
+    static spi_xfer_t *name##_queue[(entries)];                                \
+    static const spi_instance_t name = {                                       \
+        .ps = &name##_ctx,                                                     \
+        .pqueue = name##_queue,                                                \
+        .depth = (entries),                                                    \
+        .footprint_bytes = SPI_INSTANCE_FOOTPRINT(entries),                    \
+    }
+
+//------------------------------------------------------------------------------
+// Inline Function Definitions
+//------------------------------------------------------------------------------
+// Initialize a statically allocated instance
+static inline bool spi_init_instance(
+        const spi_instance_t  *pi,
+        const spi_hw_vtable_t *phw,
+        uint32_t              clock_hz,
+        spi_mode_t            mode) {
+    return spi_init(pi->ps, phw, clock_hz, mode, pi->pqueue, pi->depth);
+}
+
+#endif // INCLUDE_SPI_CORE_H_
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines a portable system timebase: a 64-bit monotonic tick
+// advanced from the tick ISR, and a cycle-accurate now() from the backend.
+//
+//------------------------------------------------------------------------------
+
+#include "timebase_api.h"
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Installed backend
+static timebase_hw_vtable_t s_hw;
+static uint32_t s_tick_hz;
+
+// 64-bit tick split in halves: 32-bit targets cannot update it atomically
+// Notes:
+//    - Written by the tick ISR only
+//    - Readers retry if the high half changed under them
+static volatile uint32_t s_tick_lo;
+static volatile uint32_t s_tick_hi;
+
+// Optional tick hook, called from the tick ISR
+static timebase_tick_fn volatile s_hook;
+static void *volatile s_hook_ctx;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool timebase_init(const timebase_hw_vtable_t *phw, uint32_t tick_hz) {
+    // Initial sanity checks
+    if (!phw || !phw->hw_init || !phw->hw_cycles || !phw->hw_cycle_hz ||
+            !tick_hz) {
+        return false;
+    }
+    // Install hardware API
+    s_hw = *phw;
+    s_tick_hz = tick_hz;
+    s_tick_lo = 0;
+    s_tick_hi = 0;
+    s_hook = NULL;
+    return s_hw.hw_init(tick_hz);
+}
+
+//------------------------------------------------------------------------------
+void timebase_isr_tick(void) {
+    uint32_t lo = s_tick_lo + 1u;
+    s_tick_lo = lo;
+    if (lo == 0u) {
+        s_tick_hi = s_tick_hi + 1u;
+    }
+    timebase_tick_fn hook = s_hook;
+    if (hook) {
+        hook(s_hook_ctx, lo);
+    }
+}
+
+//------------------------------------------------------------------------------
+void timebase_set_tick_hook(timebase_tick_fn fn, void *pctx) {
+    // Context first: the ISR may fire between the two stores
+    s_hook_ctx = pctx;
+    s_hook = fn;
+}
+
+//------------------------------------------------------------------------------
+uint64_t timebase_ticks(void) {
+    uint32_t hi;
+    uint32_t lo;
+    do {
+        hi = s_tick_hi;
+        lo = s_tick_lo;
+    } while (hi != s_tick_hi);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+//------------------------------------------------------------------------------
+uint32_t timebase_tick_hz(void) {
+    return s_tick_hz;
+}
+
+//------------------------------------------------------------------------------
+uint32_t timebase_ms_to_ticks(uint32_t ms) {
+    return (uint32_t)(((uint64_t)ms * s_tick_hz + 999u) / 1000u);
+}
+
+//------------------------------------------------------------------------------
+uint32_t timebase_now(void) {
+    return s_hw.hw_cycles();
+}
+
+//------------------------------------------------------------------------------
+uint64_t timebase_cycles_to_ns(uint32_t cycles) {
+    return ((uint64_t)cycles * 1000000000u) / s_hw.hw_cycle_hz();
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines a hierarchical (cascading) timer wheel.
+//
+// Level 0 holds timers due within TW_SLOTS ticks, one slot per tick. Each
+// higher level holds timers TW_SLOTS times further out, one slot per
+// TW_SLOTS^level ticks. Every time level 0 wraps, the next slot of level 1 is
+// re-sorted down, and so on up the levels. Start and cancel are O(1); each
+// timer is touched at most once per level on its way down.
+//
+//------------------------------------------------------------------------------
+
+#include "timer_wheel.h"
+#include <stddef.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define TW_SLOT_MASK  (TW_SLOTS - 1u)
+// Furthest delta that can be placed without parking in the top level
+#define TW_MAX_DELTA  ((1u << (TW_SLOT_BITS * TW_LEVELS)) - 1u)
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to link a timer at the head of a list
+static inline void list_push(tw_timer_t **pphead, tw_timer_t *pt) {
+    pt->pnext = *pphead;
+    if (pt->pnext) {
+        pt->pnext->pplink = &pt->pnext;
+    }
+    pt->pplink = pphead;
+    *pphead = pt;
+}
+
+//------------------------------------------------------------------------------
+// Helper to unlink a timer from whatever list it is in
+static inline void list_unlink(tw_timer_t *pt) {
+    *pt->pplink = pt->pnext;
+    if (pt->pnext) {
+        pt->pnext->pplink = pt->pplink;
+    }
+    pt->pnext = NULL;
+    pt->pplink = NULL;
+}
+
+//------------------------------------------------------------------------------
+// Helper to select the slot for a timer from its distance to now
+// Cascades run before the current level 0 slot, so they may place into it
+static void place(timer_wheel_t *ptw, tw_timer_t *pt, bool now_slot_open) {
+    uint32_t delta = pt->expires - ptw->now;
+    uint32_t at = pt->expires;
+
+    if (delta == 0u && now_slot_open) {
+        // Due this tick and the slot has not run yet
+    } else if (delta == 0u || delta > INT32_MAX) {
+        // Due now or overdue: this tick's slot has already run, use the next
+        delta = 1u;
+        at = ptw->now + 1u;
+    } else if (delta > TW_MAX_DELTA) {
+        // Beyond the wheel: park at its reach, re-placed when cascaded
+        delta = TW_MAX_DELTA;
+        at = ptw->now + TW_MAX_DELTA;
+    }
+
+    uint32_t level = 0;
+    while (level < (TW_LEVELS - 1u) &&
+            delta >= (1u << (TW_SLOT_BITS * (level + 1u)))) {
+        level++;
+    }
+    uint32_t index = (at >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK;
+    list_push(&ptw->slot[level][index].phead, pt);
+}
+
+//------------------------------------------------------------------------------
+// Helper to re-sort one upper-level slot into the levels below
+// Return true if the level's index wrapped, so the next level is due too
+static bool cascade(timer_wheel_t *ptw, uint32_t level) {
+    uint32_t index = (ptw->now >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK;
+    tw_timer_t *plist = ptw->slot[level][index].phead;
+
+    ptw->slot[level][index].phead = NULL;
+    if (plist) {
+        plist->pplink = &plist;
+    }
+    while (plist) {
+        tw_timer_t *pt = plist;
+        list_unlink(pt);
+        place(ptw, pt, true);
+    }
+    return index == 0u;
+}
+
+//------------------------------------------------------------------------------
+void timer_wheel_init(timer_wheel_t *ptw, uint32_t now) {
+    memset(ptw->slot, 0, sizeof(ptw->slot));
+    ptw->now = now;
+    ptw->pending = 0;
+}
+
+//------------------------------------------------------------------------------
+void timer_wheel_start(
+        timer_wheel_t  *ptw,
+        tw_timer_t     *pt,
+        uint32_t       delay,
+        uint32_t       period,
+        tw_callback_fn cb,
+        void           *pctx) {
+    timer_wheel_cancel(ptw, pt);
+    // This tick's slot has already run: 0 means the next one, and the period
+    // counts from there
+    pt->expires = ptw->now + (delay ? delay : 1u);
+    pt->period = period;
+    pt->cb = cb;
+    pt->pctx = pctx;
+    place(ptw, pt, false);
+    ptw->pending++;
+}
+
+//------------------------------------------------------------------------------
+void timer_wheel_cancel(timer_wheel_t *ptw, tw_timer_t *pt) {
+    if (pt->pplink) {
+        list_unlink(pt);
+        ptw->pending--;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool timer_wheel_pending(const tw_timer_t *pt) {
+    return pt->pplink != NULL;
+}
+
+//------------------------------------------------------------------------------
+uint32_t timer_wheel_advance(timer_wheel_t *ptw, uint32_t now) {
+    uint32_t fired = 0;
+
+    while ((int32_t)(now - ptw->now) > 0) {
+        if (!ptw->pending) {
+            // Nothing to run or cascade: jump straight there
+            ptw->now = now;
+            break;
+        }
+        ptw->now++;
+
+        // Cascade upper levels at each level 0 wrap
+        uint32_t index = ptw->now & TW_SLOT_MASK;
+        if (index == 0u) {
+            for (uint32_t level = 1; level < TW_LEVELS; ++level) {
+                if (!cascade(ptw, level)) {
+                    break;
+                }
+            }
+        }
+
+        // Detach the due slot so callbacks may start/cancel timers freely
+        tw_timer_t *plist = ptw->slot[0][index].phead;
+        ptw->slot[0][index].phead = NULL;
+        if (plist) {
+            plist->pplink = &plist;
+        }
+        while (plist) {
+            tw_timer_t *pt = plist;
+            list_unlink(pt);
+            ptw->pending--;
+            if (pt->period) {
+                // Re-arm from the due time, not from now, so periods don't drift
+                pt->expires += pt->period;
+                place(ptw, pt, false);
+                ptw->pending++;
+            }
+            pt->cb(pt, pt->pctx);
+            fired++;
+        }
+    }
+    return fired;
+}
+
+//------------------------------------------------------------------------------
+uint32_t timer_wheel_next_delay(const timer_wheel_t *ptw, uint32_t max) {
+    if (!ptw->pending) {
+        return max;
+    }
+    // Exact answer from level 0
+    for (uint32_t d = 1; d <= TW_SLOTS; ++d) {
+        if (ptw->slot[0][(ptw->now + d) & TW_SLOT_MASK].phead) {
+            return (d < max) ? d : max;
+        }
+    }
+    // Otherwise wake at the next cascade, which may bring timers down
+    uint32_t d = TW_SLOTS - (ptw->now & TW_SLOT_MASK);
+    return (d < max) ? d : max;
+}
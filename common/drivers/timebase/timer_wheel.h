@@ -0,0 +1,127 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TIMER_WHEEL_H_
+#define INCLUDE_TIMER_WHEEL_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a hierarchical timer wheel for large numbers of
+// software timers driven by the system tick.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file timer_wheel.h
+ *  @brief O(1) start/cancel hierarchical timer wheel.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Wheel geometry: TW_LEVELS wheels of TW_SLOTS slots each
+// Notes:
+//    - Level n slots are TW_SLOTS^n ticks wide, so 4 levels of 64 slots
+//      reach 2^24 ticks (4.6 hours at 1 kHz) without re-queuing
+//    - Longer timers park in the top level and are re-queued as they near
+#define TW_SLOT_BITS  6u
+#define TW_SLOTS      (1u << TW_SLOT_BITS)
+#define TW_LEVELS     4u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct tw_timer_t tw_timer_t;
+
+/** @brief Timer expiry callback, runs in the context calling timer_wheel_advance(). */
+typedef void (*tw_callback_fn)(tw_timer_t *pt, void *pctx);
+
+/** @brief Software timer (caller-owned storage, intrusive list node). */
+struct tw_timer_t {
+    tw_timer_t     *pnext;
+    // Link pointing at this timer (slot head or previous timer's pnext),
+    // NULL when not pending; gives O(1) unlink without a slot reference
+    tw_timer_t     **pplink;
+    uint32_t       expires;
+    uint32_t       period;
+    tw_callback_fn cb;
+    void           *pctx;
+};
+
+/** @brief Slot list head; a timer is pending when it is linked into one. */
+typedef struct {
+    tw_timer_t *phead;
+} tw_slot_t;
+
+/** @brief Timer wheel context (caller-owned storage). */
+typedef struct {
+    tw_slot_t slot[TW_LEVELS][TW_SLOTS];
+    uint32_t  now;
+    uint32_t  pending;
+} timer_wheel_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Initialize an empty wheel.
+ *  @param ptw  Wheel context.
+ *  @param now  Current tick.
+ *  @return void.
+ */
+void timer_wheel_init(timer_wheel_t *ptw, uint32_t now);
+
+//------------------------------------------------------------------------------
+/** @brief Start (or restart) a timer in O(1).
+ *  @param ptw     Wheel context.
+ *  @param pt      Timer (caller-owned storage).
+ *  @param delay   Ticks from now until the first expiry (0 = next advance).
+ *  @param period  Ticks between later expiries, 0 for one-shot.
+ *  @param cb      Expiry callback.
+ *  @param pctx    User context passed to cb.
+ *  @return void.
+ */
+void timer_wheel_start(
+    timer_wheel_t *ptw,
+    tw_timer_t *pt,
+    uint32_t delay,
+    uint32_t period,
+    tw_callback_fn cb,
+    void *pctx);
+
+//------------------------------------------------------------------------------
+/** @brief Cancel a timer in O(1); harmless if it is not pending.
+ *  @param ptw  Wheel context.
+ *  @param pt   Timer.
+ *  @return void.
+ */
+void timer_wheel_cancel(timer_wheel_t *ptw, tw_timer_t *pt);
+/** @brief Whether a timer is waiting to expire.
+ *  @param pt  Timer.
+ *  @return true if pending.
+ */
+bool timer_wheel_pending(const tw_timer_t *pt);
+
+//------------------------------------------------------------------------------
+/** @brief Run every timer due up to and including tick now.
+ *  @param ptw  Wheel context.
+ *  @param now  Current tick (e.g., low half of timebase_ticks()).
+ *  @return Number of callbacks run.
+ */
+uint32_t timer_wheel_advance(timer_wheel_t *ptw, uint32_t now);
+/** @brief Ticks until the next possible expiry, for tickless sleep.
+ *  @param ptw  Wheel context.
+ *  @param max  Value returned when nothing is pending.
+ *  @return Ticks; may be early (never late) for timers in upper levels.
+ */
+uint32_t timer_wheel_next_delay(const timer_wheel_t *ptw, uint32_t max);
+
+#endif // INCLUDE_TIMER_WHEEL_H_
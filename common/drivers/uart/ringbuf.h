@@ -11,59 +11,144 @@
 //
 //------------------------------------------------------------------------------
 
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 //------------------------------------------------------------------------------
 // Types
 //------------------------------------------------------------------------------
 
+// Single-producer/single-consumer ring buffer
+// Notes:
+//    - The producer (e.g., an ISR) only writes head and the consumer only
+//      writes tail, so neither side needs a critical section; data is
+//      published with release stores and picked up with acquire loads
+//    - Positions run over [0, 2 * capacity), so head == tail is empty and
+//      head - tail == capacity is full without a shared count
 typedef struct ringbuf_t {
     uint8_t *pbuf;
     size_t  capacity;
-    size_t  head;
-    size_t  tail;
-    size_t  count;
+    _Atomic size_t head;
+    _Atomic size_t tail;
 } ringbuf_t;
 
+//------------------------------------------------------------------------------
+// Preemption points between touching data and publishing a position, where
+// an ordering bug would show; the threaded ISR harness builds with
+// RINGBUF_PREEMPT_HOOK to widen these windows
+#ifdef RINGBUF_PREEMPT_HOOK
+void ringbuf_preempt_point(void);
+#define RINGBUF_PREEMPT()  ringbuf_preempt_point()
+#else
+#define RINGBUF_PREEMPT()  ((void)0)
+#endif
+
 //------------------------------------------------------------------------------
 // Inline Function Definitions
 //------------------------------------------------------------------------------
 static inline void ringbuf_init(ringbuf_t *pr, void *pstorage, size_t size) {
     pr->pbuf = (uint8_t*)pstorage;
     pr->capacity = size;
-    pr->head = 0;
-    pr->tail = 0;
-    pr->count = 0;
+    atomic_store_explicit(&pr->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&pr->tail, 0, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Helpers for positions in [0, 2 * capacity)
+static inline size_t ringbuf_index(const ringbuf_t *pr, size_t pos) {
+    return (pos < pr->capacity) ? pos : pos - pr->capacity;
+}
+
+static inline size_t ringbuf_advance(const ringbuf_t *pr, size_t pos, size_t n) {
+    pos += n;
+    return (pos >= 2u * pr->capacity) ? pos - 2u * pr->capacity : pos;
+}
+
+static inline size_t ringbuf_used(const ringbuf_t *pr, size_t head, size_t tail) {
+    return (head >= tail) ? head - tail : head + 2u * pr->capacity - tail;
 }
 
 //------------------------------------------------------------------------------
 static inline size_t ringbuf_available(const ringbuf_t *pr) {
-    return pr->count;
+    return ringbuf_used(pr,
+        atomic_load_explicit(&pr->head, memory_order_acquire),
+        atomic_load_explicit(&pr->tail, memory_order_acquire));
 }
 
 //------------------------------------------------------------------------------
 static inline size_t ringbuf_space(const ringbuf_t *pr) {
-    return pr->capacity - pr->count;
+    return pr->capacity - ringbuf_available(pr);
 }
 
 //------------------------------------------------------------------------------
 static inline bool ringbuf_push(ringbuf_t *pr, uint8_t byte) {
-    if (pr->count == pr->capacity) return false;
-    pr->pbuf[pr->head] = byte;
-    pr->head = (pr->head + 1) % pr->capacity;
-    pr->count++;
+    size_t head = atomic_load_explicit(&pr->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&pr->tail, memory_order_acquire);
+    if (ringbuf_used(pr, head, tail) == pr->capacity) return false;
+    pr->pbuf[ringbuf_index(pr, head)] = byte;
+    RINGBUF_PREEMPT();
+    atomic_store_explicit(&pr->head, ringbuf_advance(pr, head, 1u),
+        memory_order_release);
     return true;
 }
 
 //------------------------------------------------------------------------------
 static inline bool ringbuf_pop(ringbuf_t *pr, uint8_t *pout) {
-    if (pr->count == 0) return false;
+    size_t tail = atomic_load_explicit(&pr->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&pr->head, memory_order_acquire);
+    if (head == tail) return false;
     // Deep copy byte value
-    *pout = pr->pbuf[pr->tail];
-    pr->tail = (pr->tail + 1) % pr->capacity;
-    pr->count--;
+    *pout = pr->pbuf[ringbuf_index(pr, tail)];
+    RINGBUF_PREEMPT();
+    atomic_store_explicit(&pr->tail, ringbuf_advance(pr, tail, 1u),
+        memory_order_release);
     return true;
 }
 
+//------------------------------------------------------------------------------
+// Span access: read or write in place, without a per-byte copy
+// Notes:
+//    - A span never crosses the end of storage, so a wrapped FIFO takes two
+//      peek/consume (or reserve/commit) rounds to drain (or fill)
+//    - Peek/consume are consumer side, reserve/commit producer side
+//------------------------------------------------------------------------------
+static inline size_t ringbuf_peek_span(const ringbuf_t *pr, const uint8_t **pp) {
+    size_t tail = atomic_load_explicit(&pr->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&pr->head, memory_order_acquire);
+    size_t count = ringbuf_used(pr, head, tail);
+    size_t to_end = pr->capacity - ringbuf_index(pr, tail);
+    *pp = &pr->pbuf[ringbuf_index(pr, tail)];
+    return (count < to_end) ? count : to_end;
+}
+
+//------------------------------------------------------------------------------
+static inline void ringbuf_consume(ringbuf_t *pr, size_t n) {
+    // Caller must not consume more than was peeked
+    size_t tail = atomic_load_explicit(&pr->tail, memory_order_relaxed);
+    RINGBUF_PREEMPT();
+    atomic_store_explicit(&pr->tail, ringbuf_advance(pr, tail, n),
+        memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+static inline size_t ringbuf_reserve_span(const ringbuf_t *pr, uint8_t **pp) {
+    size_t head = atomic_load_explicit(&pr->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&pr->tail, memory_order_acquire);
+    size_t space = pr->capacity - ringbuf_used(pr, head, tail);
+    size_t to_end = pr->capacity - ringbuf_index(pr, head);
+    *pp = &pr->pbuf[ringbuf_index(pr, head)];
+    return (space < to_end) ? space : to_end;
+}
+
+//------------------------------------------------------------------------------
+static inline void ringbuf_commit(ringbuf_t *pr, size_t n) {
+    // Caller must not commit more than was reserved
+    size_t head = atomic_load_explicit(&pr->head, memory_order_relaxed);
+    RINGBUF_PREEMPT();
+    atomic_store_explicit(&pr->head, ringbuf_advance(pr, head, n),
+        memory_order_release);
+}
+
 #endif // INCLUDE_RING_BUF_H_
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines a portable UART-to-UART bridge.
+//
+//------------------------------------------------------------------------------
+
+#include "uart_bridge.h"
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to move one route until the source is empty or the destination full
+static size_t route_pump(uart_bridge_route_t *pr, uart_bridge_clock_fn clock) {
+    size_t moved = 0;
+    size_t backlog = uart_rx_available(pr->psrc);
+
+    if (backlog > pr->stats.max_backlog_bytes) {
+        pr->stats.max_backlog_bytes = (uint32_t)backlog;
+    }
+    if (backlog && !pr->backlog) {
+        pr->backlog = true;
+        pr->backlog_since = clock ? clock() : 0;
+    }
+
+    // Copy Rx span straight into Tx span: no intermediate buffer, and nothing
+    // leaves the source until the destination has room for it
+    while (1) {
+        const uint8_t *psrc;
+        uint8_t *pdst;
+        size_t n = uart_rx_peek(pr->psrc, &psrc);
+        if (!n) {
+            break;
+        }
+        size_t room = uart_tx_reserve(pr->pdst, &pdst);
+        if (!room) {
+            pr->stats.backpressure_events++;
+            break;
+        }
+        if (n > room) {
+            n = room;
+        }
+        memcpy(pdst, psrc, n);
+        uart_rx_consume(pr->psrc, n);
+        uart_tx_commit(pr->pdst, n);
+        moved += n;
+        pr->stats.spans_moved++;
+    }
+    pr->stats.bytes_forwarded += (uint32_t)moved;
+
+    // Latency: time from data first waiting to the backlog fully draining
+    if (pr->backlog && !uart_rx_available(pr->psrc)) {
+        pr->backlog = false;
+        if (clock) {
+            pr->stats.latency_last = clock() - pr->backlog_since;
+            if (pr->stats.latency_last > pr->stats.latency_max) {
+                pr->stats.latency_max = pr->stats.latency_last;
+            }
+        }
+    }
+    return moved;
+}
+
+//------------------------------------------------------------------------------
+void uart_bridge_init(
+        uart_bridge_t *pb, uart_t *pa, uart_t *pbu, uart_bridge_clock_fn clock) {
+    memset(pb, 0, sizeof(*pb));
+    pb->route[UART_BRIDGE_A_TO_B].psrc = pa;
+    pb->route[UART_BRIDGE_A_TO_B].pdst = pbu;
+    pb->route[UART_BRIDGE_B_TO_A].psrc = pbu;
+    pb->route[UART_BRIDGE_B_TO_A].pdst = pa;
+    pb->clock = clock;
+}
+
+//------------------------------------------------------------------------------
+size_t uart_bridge_pump(uart_bridge_t *pb) {
+    size_t moved = 0;
+    for (size_t dir = 0; dir < UART_BRIDGE_ROUTES; ++dir) {
+        moved += route_pump(&pb->route[dir], pb->clock);
+    }
+    return moved;
+}
+
+//------------------------------------------------------------------------------
+const uart_bridge_stats_t *uart_bridge_stats(
+        const uart_bridge_t *pb, uart_bridge_dir_t dir) {
+    return &pb->route[dir].stats;
+}
+
+//------------------------------------------------------------------------------
+void uart_bridge_stats_clear(uart_bridge_t *pb) {
+    for (size_t dir = 0; dir < UART_BRIDGE_ROUTES; ++dir) {
+        memset(&pb->route[dir].stats, 0, sizeof(pb->route[dir].stats));
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_UART_BRIDGE_H_
+#define INCLUDE_UART_BRIDGE_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a portable UART-to-UART bridge that forwards the Rx
+// FIFO of one instance into the Tx FIFO of another, in both directions.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file uart_bridge.h
+ *  @brief Full duplex UART bridge moving FIFO spans in place.
+ */
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Route selector: which way data flows through the bridge. */
+typedef enum {
+    /** @brief Rx of instance A to Tx of instance B. */
+    UART_BRIDGE_A_TO_B = 0,
+    /** @brief Rx of instance B to Tx of instance A. */
+    UART_BRIDGE_B_TO_A,
+    /** @brief Number of routes (not a route). */
+    UART_BRIDGE_ROUTES
+} uart_bridge_dir_t;
+
+/** @brief Optional monotonic clock for latency counters, any tick unit. */
+typedef uint32_t (*uart_bridge_clock_fn)(void);
+
+/** @brief Per route throughput, back-pressure and latency counters. */
+typedef struct {
+    /** @brief Bytes moved from source Rx to destination Tx. */
+    uint32_t bytes_forwarded;
+    /** @brief Contiguous spans moved (bytes/spans is the average burst). */
+    uint32_t spans_moved;
+    /** @brief Pumps that left data in the source because the destination was full. */
+    uint32_t backpressure_events;
+    /** @brief Deepest source backlog seen at the start of a pump. */
+    uint32_t max_backlog_bytes;
+    /** @brief Clock ticks from data first waiting to backlog drained, last time. */
+    uint32_t latency_last;
+    /** @brief Clock ticks from data first waiting to backlog drained, worst case. */
+    uint32_t latency_max;
+} uart_bridge_stats_t;
+
+/** @brief One direction of a bridge. */
+typedef struct {
+    uart_t              *psrc;
+    uart_t              *pdst;
+    uart_bridge_stats_t stats;
+    // Clock value when the current backlog first appeared
+    uint32_t            backlog_since;
+    bool                backlog;
+} uart_bridge_route_t;
+
+/** @brief Bridge context (caller-owned storage). */
+typedef struct {
+    uart_bridge_route_t  route[UART_BRIDGE_ROUTES];
+    uart_bridge_clock_fn clock;
+} uart_bridge_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Join two initialized UART instances.
+ *  @param pb     Bridge context (caller-owned storage).
+ *  @param pa     Instance A.
+ *  @param pbu    Instance B.
+ *  @param clock  Clock for latency counters, NULL to leave them at 0.
+ *  @return void.
+ */
+void uart_bridge_init(
+    uart_bridge_t *pb, uart_t *pa, uart_t *pbu, uart_bridge_clock_fn clock);
+
+//------------------------------------------------------------------------------
+/** @brief Forward everything the destinations can take, in both directions.
+ *         Data that does not fit stays queued in the source Rx FIFO.
+ *  @param pb  Bridge context.
+ *  @return Total bytes forwarded by this call.
+ */
+size_t uart_bridge_pump(uart_bridge_t *pb);
+
+//------------------------------------------------------------------------------
+/** @brief Get the counters of one route.
+ *  @param pb   Bridge context.
+ *  @param dir  Route to query.
+ *  @return Pointer to the route counters.
+ */
+const uart_bridge_stats_t *uart_bridge_stats(
+    const uart_bridge_t *pb, uart_bridge_dir_t dir);
+/** @brief Reset the counters of both routes.
+ *  @param pb  Bridge context.
+ *  @return void.
+ */
+void uart_bridge_stats_clear(uart_bridge_t *pb);
+
+#endif // INCLUDE_UART_BRIDGE_H_
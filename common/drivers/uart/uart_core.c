@@ -9,27 +9,129 @@
 //------------------------------------------------------------------------------
 
 #include "uart_core.h"
+#include "trace_api.h"
 #include <string.h>
 
 //------------------------------------------------------------------------------
-// Types
+// Opaque Context
 //------------------------------------------------------------------------------
 
-// Opaque handle declared in API header
-struct uart_t {
-    // Hardware backend - to be installed
-    uart_hw_vtable_t hw;
-    // Each instance has its own statically allocated FIFOs
-    ringbuf_t rx_fifo;
-    ringbuf_t tx_fifo;
-    uint32_t  rx_overflow_count;
-    size_t    echo_chunk_size_bytes;
-};
 // Define uart_t size helper function
 size_t uart_context_size(void) { return sizeof(struct uart_t); }
 
 //------------------------------------------------------------------------------
 // Function Definitions
+//------------------------------------------------------------------------------
+// Helper for a counter with a single writer (the producer side)
+// A plain load/store pair, so the ISR needs no locked read-modify-write
+static inline void counter_add(_Atomic uint32_t *pc, uint32_t n) {
+    atomic_store_explicit(pc,
+        atomic_load_explicit(pc, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Helper to stamp the start of a new batch, producer side
+// Notes:
+//    - Called before the batch's first byte is pushed
+//    - A batch starts when data lands in an empty FIFO, or after a
+//      threshold/timeout delivery closed the previous one
+static inline void rx_ts_mark(uart_t *pu) {
+    if (!pu->hw.hw_timestamp) {
+        return;
+    }
+    if (pu->rx_ts_open && ringbuf_available(&pu->rx_fifo)) {
+        return;
+    }
+    pu->rx_ts_open = true;
+    uint32_t head = atomic_load_explicit(&pu->rx_ts_head, memory_order_relaxed);
+    if ((head - atomic_load_explicit(&pu->rx_ts_tail, memory_order_acquire)) >=
+            UART_RX_TS_DEPTH) {
+        // Queue full: join the newest batch
+        return;
+    }
+    uart_rx_ts_t *pe = &pu->rx_ts[head & (UART_RX_TS_DEPTH - 1u)];
+    pe->seq = pu->rx_seq_in;
+    pe->ts = pu->hw.hw_timestamp();
+    // Publish the entry before the bytes it stamps
+    atomic_store_explicit(&pu->rx_ts_head, head + 1u, memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// Helper to find the batch holding Rx stream position seq, consumer side
+// Retires batches that end before seq
+// Notes:
+//    - seq must be a byte already popped or still unread, so that its
+//      batch entry is published
+static const uart_rx_ts_t *rx_ts_find(uart_t *pu, uint32_t seq) {
+    uint32_t head = atomic_load_explicit(&pu->rx_ts_head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&pu->rx_ts_tail, memory_order_relaxed);
+    while ((head - tail) > 1u) {
+        const uart_rx_ts_t *pnext =
+            &pu->rx_ts[(tail + 1u) & (UART_RX_TS_DEPTH - 1u)];
+        // Wrap-safe: is the next batch's start at or behind the read position?
+        if ((int32_t)(seq - pnext->seq) < 0) {
+            break;
+        }
+        tail++;
+    }
+    atomic_store_explicit(&pu->rx_ts_tail, tail, memory_order_release);
+    if (head == tail) {
+        return NULL;
+    }
+    return &pu->rx_ts[tail & (UART_RX_TS_DEPTH - 1u)];
+}
+
+//------------------------------------------------------------------------------
+// Helper to wake the consumer once for the bytes received since last time
+static inline void rx_batch_deliver(uart_t *pu) {
+    pu->rx_batch_bytes = 0;
+    pu->rx_ts_open = false;
+    pu->rx_notify(pu->rx_notify_ctx, ringbuf_available(&pu->rx_fifo));
+}
+
+//------------------------------------------------------------------------------
+// Helper to account for n bytes just committed to the Rx FIFO as one block
+static inline void rx_block_account(uart_t *pu, size_t n) {
+    pu->rx_seq_in += (uint32_t)n;
+    if (pu->rx_notify && n) {
+        pu->rx_batch_bytes += n;
+        if (pu->rx_batch_threshold &&
+                pu->rx_batch_bytes >= pu->rx_batch_threshold) {
+            rx_batch_deliver(pu);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper for backends with block reads: read straight into FIFO segments
+// Notes:
+//    - Data the FIFO has no room for stays in the backend (e.g., the kernel
+//      tty buffer) instead of being dropped and counted as overflow
+//    - Bytes land in a reserved segment before commit, so the FIFO still
+//      looks empty to rx_ts_mark() when the first block arrives
+static size_t poll_rx_block(uart_t *pu) {
+    size_t total = 0;
+    for (;;) {
+        uint8_t *pdst;
+        size_t span = ringbuf_reserve_span(&pu->rx_fifo, &pdst);
+        if (!span) {
+            break;
+        }
+        size_t n = pu->hw.hw_rx_read_block(pdst, span);
+        if (!n) {
+            break;
+        }
+        rx_ts_mark(pu);
+        ringbuf_commit(&pu->rx_fifo, n);
+        rx_block_account(pu, n);
+        total += n;
+        if (n < span) {
+            break;
+        }
+    }
+    return total;
+}
+
 //------------------------------------------------------------------------------
 bool uart_init(
         uart_t                 *pu, 
@@ -50,8 +152,24 @@ bool uart_init(
     pu->hw = *phw;
     ringbuf_init(&pu->rx_fifo, prx_buf, rx_size);
     ringbuf_init(&pu->tx_fifo, ptx_buf, tx_size);
-    pu->rx_overflow_count = 0;
+    atomic_store_explicit(&pu->rx_overflow_count, 0, memory_order_relaxed);
+    pu->rx_overflow_base = 0;
     pu->echo_chunk_size_bytes = UART_ECHO_DRAIN_CHUNK_BYTES;
+    for (uint32_t kind = 0; kind < UART_RX_ERR_KINDS; ++kind) {
+        atomic_store_explicit(&pu->rx_error_count[kind], 0, memory_order_relaxed);
+        pu->rx_error_base[kind] = 0;
+    }
+    atomic_store_explicit(&pu->rx_error_pending, 0, memory_order_relaxed);
+    pu->rx_error_marking = false;
+    pu->rx_notify = NULL;
+    pu->rx_notify_ctx = NULL;
+    pu->rx_batch_threshold = 0;
+    pu->rx_batch_bytes = 0;
+    atomic_store_explicit(&pu->rx_ts_head, 0, memory_order_relaxed);
+    atomic_store_explicit(&pu->rx_ts_tail, 0, memory_order_relaxed);
+    pu->rx_seq_in = 0;
+    pu->rx_seq_out = 0;
+    pu->rx_ts_open = false;
     return pu->hw.hw_init(baud);
 }
 
@@ -63,19 +181,147 @@ void uart_isr_rx_byte(uart_t *pu, uint8_t byte) {
     // Notes:
     //    - A real-time (lossy) application could keep latest instead 
     //      of dropping it, dropping oldest (pop) instead
-    if (!ringbuf_push(&pu->rx_fifo, byte)) {
+    TRACE_ENTER(TRACE_UART_RX_BYTE);
+    if (!ringbuf_space(&pu->rx_fifo)) {
         // FIFO full
-        pu->rx_overflow_count++;
+        counter_add(&pu->rx_overflow_count, 1u);
+        TRACE_EXIT(TRACE_UART_RX_BYTE);
+        return;
+    }
+    rx_ts_mark(pu);
+    (void)ringbuf_push(&pu->rx_fifo, byte);
+    pu->rx_seq_in++;
+    // Batched delivery: wake the consumer on threshold, not per byte
+    if (pu->rx_notify) {
+        pu->rx_batch_bytes++;
+        if (pu->rx_batch_threshold &&
+                pu->rx_batch_bytes >= pu->rx_batch_threshold) {
+            rx_batch_deliver(pu);
+        }
+    }
+    TRACE_EXIT(TRACE_UART_RX_BYTE);
+}
+
+//------------------------------------------------------------------------------
+void uart_isr_rx_block(uart_t *pu, const uint8_t *pdata, size_t len) {
+    // To be called from a DMA or idle-line ISR with everything received
+    // Stamp once for the whole block, then copy it in place
+    size_t done = 0;
+    if (len && ringbuf_space(&pu->rx_fifo)) {
+        pu->rx_ts_open = false;
+        rx_ts_mark(pu);
+    }
+    while (done < len) {
+        uint8_t *pdst;
+        size_t n = ringbuf_reserve_span(&pu->rx_fifo, &pdst);
+        if (!n) {
+            break;
+        }
+        if (n > len - done) {
+            n = len - done;
+        }
+        memcpy(pdst, &pdata[done], n);
+        ringbuf_commit(&pu->rx_fifo, n);
+        done += n;
+    }
+    rx_block_account(pu, done);
+    counter_add(&pu->rx_overflow_count, (uint32_t)(len - done));
+}
+
+//------------------------------------------------------------------------------
+void uart_isr_rx_timeout(uart_t *pu) {
+    // Line silent: the next byte starts a new batch
+    pu->rx_ts_open = false;
+    // Flush out the tail of a batch that did not reach threshold
+    if (pu->rx_notify && pu->rx_batch_bytes) {
+        rx_batch_deliver(pu);
+    }
+}
+
+//------------------------------------------------------------------------------
+void uart_isr_rx_error(uart_t *pu, uint32_t err_mask) {
+    // To be called from ISR (or polling loop) once the backend has cleared
+    // the hardware flags, so reception is never held off by a sticky error
+    for (uint32_t kind = 0; kind < UART_RX_ERR_KINDS; ++kind) {
+        if (err_mask & UART_RX_ERR_MASK(kind)) {
+            counter_add(&pu->rx_error_count[kind], 1u);
+        }
+    }
+    // Latch for the consumer so it can discard the affected frame
+    if (pu->rx_error_marking) {
+        atomic_fetch_or_explicit(&pu->rx_error_pending, err_mask,
+            memory_order_relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+size_t uart_poll_rx(uart_t *pu) {
+    size_t n = 0;
+    if (pu->hw.hw_rx_read_block) {
+        // Block backends report errors per poll, not per byte
+        if (pu->hw.hw_rx_errors) {
+            uint32_t err_mask = pu->hw.hw_rx_errors();
+            if (err_mask) {
+                uart_isr_rx_error(pu, err_mask);
+            }
+        }
+        n = poll_rx_block(pu);
+        if (pu->hw.hw_rx_timeout_expired && pu->hw.hw_rx_timeout_expired()) {
+            uart_isr_rx_timeout(pu);
+        }
+        return n;
+    }
+    // Errors are reported ahead of the byte they affect
+    // Notes:
+    //    - Overrun means bytes were lost before the next byte read
+    //    - Framing/noise/parity apply to the next byte read
+    while (pu->hw.hw_rx_available()) {
+        if (pu->hw.hw_rx_errors) {
+            uint32_t err_mask = pu->hw.hw_rx_errors();
+            if (err_mask) {
+                uart_isr_rx_error(pu, err_mask);
+            }
+        }
+        uart_isr_rx_byte(pu, pu->hw.hw_rx_read());
+        n++;
+    }
+    // Catch errors raised with no byte left to read
+    if (pu->hw.hw_rx_errors) {
+        uint32_t err_mask = pu->hw.hw_rx_errors();
+        if (err_mask) {
+            uart_isr_rx_error(pu, err_mask);
+        }
+    }
+    // Timeout is checked last so it closes the batch just read
+    if (pu->hw.hw_rx_timeout_expired && pu->hw.hw_rx_timeout_expired()) {
+        uart_isr_rx_timeout(pu);
     }
+    return n;
 }
 
 //------------------------------------------------------------------------------
 void uart_service_tx(uart_t *pu) {
     uint8_t byte;
+    TRACE_ENTER(TRACE_UART_SERVICE_TX);
+    if (pu->hw.hw_tx_write_block) {
+        // Hand whole FIFO segments to the backend until it pushes back
+        const uint8_t *psrc;
+        size_t span;
+        while ((span = ringbuf_peek_span(&pu->tx_fifo, &psrc)) != 0u) {
+            size_t n = pu->hw.hw_tx_write_block(psrc, span);
+            ringbuf_consume(&pu->tx_fifo, n);
+            if (n < span) {
+                break;
+            }
+        }
+        TRACE_EXIT(TRACE_UART_SERVICE_TX);
+        return;
+    }
     // Write TX FIFO ready data to UART
     while (pu->hw.hw_tx_ready() && ringbuf_pop(&pu->tx_fifo, &byte)) {
         pu->hw.hw_tx_write(byte);
     }
+    TRACE_EXIT(TRACE_UART_SERVICE_TX);
 }
 
 //------------------------------------------------------------------------------
@@ -107,21 +353,75 @@ size_t uart_read(uart_t *pu, uint8_t *pout, size_t maxlen) {
     while (n < maxlen && ringbuf_pop(&pu->rx_fifo, &byte)) {
         pout[n++] = byte;
     }
+    pu->rx_seq_out += (uint32_t)n;
+    return n;
+}
+
+//------------------------------------------------------------------------------
+size_t uart_read_ts(uart_t *pu, uint8_t *pout, size_t maxlen, uint32_t *pts) {
+    // Look up the bytes actually returned: a lookup before the read could
+    // pair a batch the ISR pushes in between with the previous batch's time
+    uint32_t seq = pu->rx_seq_out;
+    size_t n = uart_read(pu, pout, maxlen);
+    const uart_rx_ts_t *pe = n ? rx_ts_find(pu, seq) : NULL;
+    *pts = pe ? pe->ts : 0;
     return n;
 }
 
+//------------------------------------------------------------------------------
+bool uart_rx_arrival(uart_t *pu, uint32_t *pts) {
+    if (!ringbuf_available(&pu->rx_fifo)) {
+        return false;
+    }
+    const uart_rx_ts_t *pe = rx_ts_find(pu, pu->rx_seq_out);
+    if (!pe) {
+        return false;
+    }
+    *pts = pe->ts;
+    return true;
+}
+
 //------------------------------------------------------------------------------
 size_t uart_tx_queued(const uart_t *pu) {
     // What's queued in the Tx FIFO?
     return ringbuf_available(&pu->tx_fifo);
 }
 
+//------------------------------------------------------------------------------
+size_t uart_tx_space(const uart_t *pu) {
+    return ringbuf_space(&pu->tx_fifo);
+}
+
+//------------------------------------------------------------------------------
+size_t uart_rx_peek(const uart_t *pu, const uint8_t **pp) {
+    return ringbuf_peek_span(&pu->rx_fifo, pp);
+}
+
+//------------------------------------------------------------------------------
+void uart_rx_consume(uart_t *pu, size_t n) {
+    ringbuf_consume(&pu->rx_fifo, n);
+    pu->rx_seq_out += (uint32_t)n;
+}
+
+//------------------------------------------------------------------------------
+size_t uart_tx_reserve(const uart_t *pu, uint8_t **pp) {
+    return ringbuf_reserve_span(&pu->tx_fifo, pp);
+}
+
+//------------------------------------------------------------------------------
+void uart_tx_commit(uart_t *pu, size_t n) {
+    ringbuf_commit(&pu->tx_fifo, n);
+    // Attempt immediate flush to UART, as uart_write() does
+    uart_service_tx(pu);
+}
+
 //------------------------------------------------------------------------------
 void uart_echo_pump(uart_t *pu) {
     // Transfer directly from Rx to Tx in configured chunks
     size_t chunk = 
         pu->echo_chunk_size_bytes ? 
             pu->echo_chunk_size_bytes : UART_ECHO_DRAIN_CHUNK_BYTES;
+    TRACE_ENTER(TRACE_UART_ECHO_PUMP);
     while (uart_rx_available(pu)) {
         size_t still_to_read = uart_rx_available(pu);
         if (still_to_read > chunk) {
@@ -133,16 +433,74 @@ void uart_echo_pump(uart_t *pu) {
         if (!rcount) break;
         uart_write(pu, tmp, rcount);
     }
+    TRACE_EXIT(TRACE_UART_ECHO_PUMP);
 }
 
 //------------------------------------------------------------------------------
 uint32_t uart_rx_overflow_count(const uart_t *pu) {
-    return pu->rx_overflow_count;
+    return atomic_load_explicit(&pu->rx_overflow_count, memory_order_relaxed) -
+        pu->rx_overflow_base;
 }
 
 //------------------------------------------------------------------------------
 void uart_rx_overflow_clear(uart_t *pu) {
-    pu->rx_overflow_count = 0;
+    pu->rx_overflow_base =
+        atomic_load_explicit(&pu->rx_overflow_count, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+uint32_t uart_rx_error_count(const uart_t *pu, uart_rx_err_t kind) {
+    if (kind >= UART_RX_ERR_KINDS) {
+        return 0;
+    }
+    return atomic_load_explicit(&pu->rx_error_count[kind], memory_order_relaxed) -
+        pu->rx_error_base[kind];
+}
+
+//------------------------------------------------------------------------------
+void uart_rx_error_clear(uart_t *pu) {
+    for (uint32_t kind = 0; kind < UART_RX_ERR_KINDS; ++kind) {
+        pu->rx_error_base[kind] =
+            atomic_load_explicit(&pu->rx_error_count[kind], memory_order_relaxed);
+    }
+    atomic_store_explicit(&pu->rx_error_pending, 0, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void uart_set_rx_error_marking(uart_t *pu, bool enable) {
+    pu->rx_error_marking = enable;
+    if (!enable) {
+        atomic_store_explicit(&pu->rx_error_pending, 0, memory_order_relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+uint32_t uart_rx_error_take(uart_t *pu) {
+    // One exchange, so an error latched by the ISR meanwhile is never lost
+    return atomic_exchange_explicit(&pu->rx_error_pending, 0, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool uart_set_rx_batching(
+        uart_t            *pu,
+        size_t            threshold,
+        uint32_t          timeout_chars,
+        uart_rx_notify_fn notify,
+        void              *pctx) {
+    // Silence detection is only as good as the backend's receiver timeout;
+    // disabling batching needs no timeout at all
+    if (notify && timeout_chars && !pu->hw.hw_rx_timeout_config) {
+        return false;
+    }
+    if (pu->hw.hw_rx_timeout_config &&
+            !pu->hw.hw_rx_timeout_config(notify ? timeout_chars : 0)) {
+        return false;
+    }
+    pu->rx_batch_threshold = threshold;
+    pu->rx_batch_bytes = 0;
+    pu->rx_notify_ctx = pctx;
+    pu->rx_notify = notify;
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -25,4 +25,132 @@
 //    this as a configuration parameter from flash
 static const size_t UART_ECHO_DRAIN_CHUNK_BYTES = 32;
 
+// Rx arrival timestamps kept per instance, one per batch of bytes
+// Notes:
+//    - Must be a power of two
+//    - When full, new bytes join the newest batch and inherit its
+//      (earlier) timestamp rather than being dropped
+#ifndef UART_RX_TS_DEPTH
+#define UART_RX_TS_DEPTH  8u
+#endif
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Arrival time of a batch of Rx bytes starting at Rx stream position seq
+typedef struct {
+    uint32_t seq;
+    uint32_t ts;
+} uart_rx_ts_t;
+
+_Static_assert((UART_RX_TS_DEPTH & (UART_RX_TS_DEPTH - 1u)) == 0u,
+    "UART_RX_TS_DEPTH must be a power of two");
+
+// Opaque handle declared in API header
+// Notes:
+//    - Defined here only so instances can be sized and allocated at compile
+//      time (see UART_DEFINE_INSTANCE); clients must treat it as opaque
+struct uart_t {
+    // Hardware backend - to be installed
+    uart_hw_vtable_t hw;
+    // Each instance has its own statically allocated FIFOs
+    ringbuf_t rx_fifo;
+    ringbuf_t tx_fifo;
+    // Rx diagnostics: the producer (ISR) counts, the consumer clears by
+    // moving its own baseline, so each word has a single writer
+    _Atomic uint32_t rx_overflow_count;
+    uint32_t  rx_overflow_base;
+    size_t    echo_chunk_size_bytes;
+    // Line error diagnostics, per kind
+    _Atomic uint32_t rx_error_count[UART_RX_ERR_KINDS];
+    uint32_t  rx_error_base[UART_RX_ERR_KINDS];
+    _Atomic uint32_t rx_error_pending;
+    bool      rx_error_marking;
+    // Batched Rx delivery
+    uart_rx_notify_fn rx_notify;
+    void      *rx_notify_ctx;
+    size_t    rx_batch_threshold;
+    size_t    rx_batch_bytes;
+    // Rx arrival timestamps, parallel to the Rx FIFO
+    // Notes:
+    //    - Producer (ISR) owns ts_head, seq_in and ts_open
+    //    - Consumer owns ts_tail and seq_out
+    uart_rx_ts_t rx_ts[UART_RX_TS_DEPTH];
+    _Atomic uint32_t rx_ts_head;
+    _Atomic uint32_t rx_ts_tail;
+    uint32_t  rx_seq_in;
+    uint32_t  rx_seq_out;
+    bool      rx_ts_open;
+};
+//------------------------------------------------------------------------------
+// Static Instances
+//------------------------------------------------------------------------------
+
+// Upper bound on a FIFO size, to catch sizes given in bits or mistyped
+#ifndef UART_FIFO_MAX_BYTES
+#define UART_FIFO_MAX_BYTES  (64u * 1024u)
+#endif
+
+// Storage descriptor for a statically allocated instance
+typedef struct {
+    uart_t  *pu;
+    uint8_t *prx_buf;
+    size_t  rx_size;
+    uint8_t *ptx_buf;
+    size_t  tx_size;
+    // RAM used by this instance: context plus both FIFOs
+    size_t  footprint_bytes;
+} uart_instance_t;
+
+// Exact RAM footprint of an instance, as a compile-time constant
+#define UART_INSTANCE_FOOTPRINT(rx_bytes, tx_bytes) \
+    (sizeof(struct uart_t) + (size_t)(rx_bytes) + (size_t)(tx_bytes))
+
+// Allocate an instance's context and FIFOs in .bss with exact sizes
+// Notes:
+//    - The context gets the alignment of struct uart_t from the compiler, no
+//      byte array casts
+//    - Each object is a named symbol (name_ctx, name_rx_fifo, name_tx_fifo),
+//      so the linker map reports the footprint per instance
+//    - Define UART_INSTANCE_MAX_FOOTPRINT to cap every instance at build time
+#ifdef UART_INSTANCE_MAX_FOOTPRINT
+#define UART_INSTANCE_BUDGET_CHECK(name, rx_bytes, tx_bytes)                   \
+    _Static_assert(UART_INSTANCE_FOOTPRINT(rx_bytes, tx_bytes) <=              \
+        UART_INSTANCE_MAX_FOOTPRINT, #name ": footprint over budget")
+#else
+#define UART_INSTANCE_BUDGET_CHECK(name, rx_bytes, tx_bytes)                   \
+    _Static_assert(1, "")
+#endif
+
+#define UART_DEFINE_INSTANCE(name, rx_bytes, tx_bytes)                         \
+    _Static_assert((rx_bytes) > 0 && (rx_bytes) <= UART_FIFO_MAX_BYTES,        \
+        #name ": Rx FIFO size out of range");                                  \
+    _Static_assert((tx_bytes) > 0 && (tx_bytes) <= UART_FIFO_MAX_BYTES,        \
+        #name ": Tx FIFO size out of range");                                  \
+    UART_INSTANCE_BUDGET_CHECK(name, rx_bytes, tx_bytes);                      \
+    static struct uart_t name##_ctx;                                           \
+    static uint8_t name##_rx_fifo[(rx_bytes)];                                 \
+    static uint8_t name##_tx_fifo[(tx_bytes)];                                 \
+    static const uart_instance_t name = {                                      \
+        .pu = &name##_ctx,                                                     \
+        .prx_buf = name##_rx_fifo,                                             \
+        .rx_size = (rx_bytes),                                                 \
+        .ptx_buf = name##_tx_fifo,                                             \
+        .tx_size = (tx_bytes),                                                 \
+        .footprint_bytes = UART_INSTANCE_FOOTPRINT(rx_bytes, tx_bytes),        \
+    }
+
+//------------------------------------------------------------------------------
+// Inline Function Definitions
+//------------------------------------------------------------------------------
+// Initialize a statically allocated instance
+static inline bool uart_init_instance(
+        const uart_instance_t  *pi,
+        const uart_hw_vtable_t *phw,
+        uint32_t               baud) {
+    return uart_init(
+        pi->pu, phw, baud, pi->prx_buf, pi->rx_size, pi->ptx_buf, pi->tx_size);
+}
+
 #endif // INCLUDE_UART_CORE_H_
\ No newline at end of file
@@ -0,0 +1,208 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_BOOT_API_H_
+#define INCLUDE_BOOT_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the core of a UART bootloader: it receives an
+// application image in blocks over frame_api.h frames (COBS + CRC-16) and
+// programs it into flash while the next block is arriving.
+//
+// The host drives the protocol and sends one command at a time, resending a
+// command if no reply comes. Payloads are little-endian:
+//    HELLO                     -> OK, value = block size
+//    BEGIN size(4) crc32(4)    -> OK once the boot record and the sectors
+//                                 the image needs are erased
+//    DATA  offset(4) data      -> OK, value = next offset expected
+//    END                       -> OK, value = CRC-32, once the image is
+//                                 programmed, its CRC-32 read back from flash
+//                                 matches and the boot record is written
+//    RUN                       -> OK, then boot_poll() returns true
+// Each reply is the command | BOOT_REPLY, a status and a 32-bit value.
+//
+// A DATA block is copied into one of two RAM buffers and programmed from
+// there, one 128-bit quad-word per boot_poll(). Its reply goes out as soon as
+// the other buffer is free, so the host sends block n + 1 while block n is
+// programmed, and only waits on the flash when programming falls behind the
+// line. A block resent after its reply was lost is acknowledged again, not
+// programmed twice.
+//
+// The boot record (magic, size, CRC-32, inverted magic) is one quad-word in
+// its own sector. BEGIN erases it first, so an interrupted update never
+// leaves an application that looks valid.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "flash_api.h"
+#include "frame_api.h"
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file boot_api.h
+ *  @brief UART bootloader core with double-buffered, pipelined programming.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Largest DATA block, a multiple of FLASH_QWORD_BYTES. */
+#ifndef BOOT_BLOCK_BYTES
+#define BOOT_BLOCK_BYTES     1024u
+#endif
+
+/** @brief RAM block buffers. */
+#define BOOT_BUFFERS         2u
+
+/** @brief Commands. */
+#define BOOT_CMD_HELLO       0x01u
+#define BOOT_CMD_BEGIN       0x02u
+#define BOOT_CMD_DATA        0x03u
+#define BOOT_CMD_END         0x04u
+#define BOOT_CMD_RUN         0x05u
+/** @brief Set in the first byte of a reply. */
+#define BOOT_REPLY           0x80u
+
+/** @brief Reply status. */
+#define BOOT_OK              0u
+#define BOOT_ERR_CMD         1u   /**< Unknown or malformed command. */
+#define BOOT_ERR_STATE       2u   /**< Not valid now, e.g., DATA before BEGIN. */
+#define BOOT_ERR_SIZE        3u   /**< Image or block size out of range. */
+#define BOOT_ERR_SEQ         4u   /**< Offset ahead of the next expected. */
+#define BOOT_ERR_CRC         5u   /**< Image read back does not match. */
+#define BOOT_ERR_FLASH       6u   /**< Erase or programming failed. */
+
+/** @brief Payload sizes: DATA header, reply. */
+#define BOOT_DATA_HDR_BYTES  5u
+#define BOOT_REPLY_BYTES     6u
+
+/** @brief Boot record magic ("BOOT"). */
+#define BOOT_RECORD_MAGIC    0x544F4F42u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Flash layout (see the board's platform_config.h). */
+typedef struct {
+    /** @brief Application vector table, sector aligned. */
+    uint32_t app_base;
+    /** @brief Largest application image in bytes. */
+    uint32_t app_max;
+    /** @brief Boot record address, in a sector of its own. */
+    uint32_t record_addr;
+} boot_layout_t;
+
+/** @brief Boot record, one flash quad-word. */
+typedef struct {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t magic_inv;
+} boot_record_t;
+
+/** @brief One RAM block buffer. */
+typedef struct {
+    uint8_t  data[BOOT_BLOCK_BYTES];
+    uint32_t addr;
+    // Padded to whole quad-words, and how much is programmed
+    uint32_t len;
+    uint32_t done;
+} boot_buf_t;
+
+/** @brief Counters. */
+typedef struct {
+    uint32_t blocks;        /**< DATA blocks accepted. */
+    uint32_t dups;          /**< DATA blocks resent after a lost reply. */
+    uint32_t held;          /**< DATA replies held until a buffer was free. */
+    uint32_t qwords;        /**< Quad-words programmed. */
+    uint32_t erases;        /**< Sectors erased. */
+    uint32_t flash_errors;
+} boot_stats_t;
+
+/** @brief Bootloader instance; treat as opaque. */
+typedef struct {
+    uart_t            *pu;
+    flash_hw_vtable_t flash;
+    boot_layout_t     layout;
+    uint32_t          buffers;
+    uint8_t           state;
+    // Why the last update was abandoned, for the next command to report
+    uint8_t           error;
+    bool              contacted;
+    bool              run;
+    // Image being received
+    uint32_t          size;
+    uint32_t          crc;
+    uint32_t          next;
+    // Erase progress: the record sector, then the image sectors
+    bool              erase_record;
+    uint32_t          erase_addr;
+    uint32_t          erase_end;
+    // Full buffers, oldest (being programmed) at head
+    boot_buf_t        buf[BOOT_BUFFERS];
+    uint32_t          head;
+    uint32_t          count;
+    // Read-back check
+    uint32_t          verify_off;
+    uint32_t          verify_crc;
+    // Command whose reply waits on the flash, and a reply waiting for Tx room
+    uint8_t           waiting;
+    bool              out_due;
+    size_t            out_len;
+    uint8_t           out[FRAME_ENCODED_MAX(BOOT_REPLY_BYTES)];
+    frame_decoder_t   dec;
+    uint8_t           dec_buf[FRAME_DECODE_BUF(BOOT_DATA_HDR_BYTES + BOOT_BLOCK_BYTES)];
+    /** @brief Counters. */
+    boot_stats_t      stats;
+} boot_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Initialize the bootloader.
+ *  @param pb       Instance (caller-owned).
+ *  @param pu       UART the host is on (the bootloader owns its Rx data).
+ *  @param pflash   Flash backend (copied).
+ *  @param playout  Flash layout (copied).
+ *  @param buffers  RAM buffers to use, 1 to BOOT_BUFFERS; 1 programs each
+ *                  block before acknowledging it.
+ *  @return true on success.
+ */
+bool boot_init(boot_t *pb, uart_t *pu, const flash_hw_vtable_t *pflash,
+    const boot_layout_t *playout, uint32_t buffers);
+
+//------------------------------------------------------------------------------
+/** @brief Handle commands and move erasing, programming and checking on by
+ *         one step; Context: Main Loop, as often as possible.
+ *  @param pb  Instance.
+ *  @return true once RUN has been acknowledged and the reply sent: start
+ *          the application.
+ */
+bool boot_poll(boot_t *pb);
+
+//------------------------------------------------------------------------------
+/** @brief Whether a host has sent a command, to hold off starting the
+ *         application.
+ */
+bool boot_contacted(const boot_t *pb);
+
+//------------------------------------------------------------------------------
+/** @brief Whether flash holds a complete application: a boot record whose
+ *         CRC-32 matches the image.
+ *  @param pflash   Flash backend.
+ *  @param playout  Flash layout.
+ *  @return true if the application can be started.
+ */
+bool boot_app_valid(const flash_hw_vtable_t *pflash, const boot_layout_t *playout);
+
+#endif // INCLUDE_BOOT_API_H_
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_CRC_API_H_
+#define INCLUDE_CRC_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies table-driven CRCs for link framing and image checks.
+// Both can be computed incrementally over non-contiguous data, e.g., the two
+// spans of a ring buffer.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file crc_api.h
+ *  @brief CRC-16/CCITT-FALSE and CRC-32 (IEEE 802.3), byte-wise table driven.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief CRC-16/CCITT-FALSE initial value (no final XOR). */
+#define CRC16_CCITT_INIT  0xFFFFu
+/** @brief CRC-32 initial value; finish with crc32_final(). */
+#define CRC32_INIT        0xFFFFFFFFu
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Update a CRC-16/CCITT-FALSE (poly 0x1021, MSB first).
+ *  @param crc    CRC16_CCITT_INIT, or the result of a previous update.
+ *  @param pdata  Bytes to add.
+ *  @param len    Number of bytes.
+ *  @return Updated CRC, which is also the final value.
+ */
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *pdata, size_t len);
+
+//------------------------------------------------------------------------------
+/** @brief Update a CRC-32 (poly 0x04C11DB7 reflected, as in zlib).
+ *  @param crc    CRC32_INIT, or the result of a previous update.
+ *  @param pdata  Bytes to add.
+ *  @param len    Number of bytes.
+ *  @return Updated CRC, before the final XOR.
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *pdata, size_t len);
+
+//------------------------------------------------------------------------------
+/** @brief Apply the CRC-32 final XOR. */
+static inline uint32_t crc32_final(uint32_t crc) {
+    return crc ^ 0xFFFFFFFFu;
+}
+
+//------------------------------------------------------------------------------
+/** @brief One-shot CRC-16/CCITT-FALSE. */
+static inline uint16_t crc16_ccitt(const uint8_t *pdata, size_t len) {
+    return crc16_ccitt_update(CRC16_CCITT_INIT, pdata, len);
+}
+
+/** @brief One-shot CRC-32. */
+static inline uint32_t crc32(const uint8_t *pdata, size_t len) {
+    return crc32_final(crc32_update(CRC32_INIT, pdata, len));
+}
+
+#endif // INCLUDE_CRC_API_H_
@@ -0,0 +1,210 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_DMA_API_H_
+#define INCLUDE_DMA_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a portable DMA channel API: one allocator hands out
+// the controller's channels, so drivers sharing it never clash, and each
+// channel runs a chain of blocks from linked-list descriptors. A chain may
+// loop back to its first block (a ring), e.g., for a circular Rx buffer or a
+// repeating waveform, and runs with no CPU involvement; the owner's callback
+// runs from the channel interrupt as blocks finish.
+//
+// The core (common/drivers/dma) sits over a run-time installed backend, as
+// for the timebase; the STM32H5 backend drives GPDMA1.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file dma_api.h
+ *  @brief Portable DMA channel allocator with linked-list block chains.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Channels the allocator manages. */
+#define DMA_MAX_CHANNELS     8u
+/** @brief Most blocks in one channel's chain. */
+#define DMA_CHAIN_MAX        8u
+/** @brief Longest block in bytes. */
+#define DMA_BLOCK_MAX_BYTES  65535u
+
+/** @brief Request line for memory to memory: no peripheral paces it. */
+#define DMA_REQ_NONE         0xFFFFFFFFu
+
+/** @brief Block flag: call the channel's callback when this block finishes. */
+#define DMA_BLOCK_NOTIFY     (1u << 0)
+/** @brief Block flag: the memory address stays put (fill or sink). */
+#define DMA_BLOCK_FIXED      (1u << 1)
+
+/** @brief Event: a block finished. */
+#define DMA_EV_BLOCK         (1u << 0)
+/** @brief Event: the chain ran off its end; the channel stopped. */
+#define DMA_EV_END           (1u << 1)
+/** @brief Event: transfer error; the channel stopped. */
+#define DMA_EV_ERROR         (1u << 2)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Transfer direction. */
+typedef enum {
+    DMA_DIR_MEM_TO_PERIPH = 0,
+    DMA_DIR_PERIPH_TO_MEM,
+    DMA_DIR_MEM_TO_MEM
+} dma_dir_t;
+
+/** @brief Data width per transfer, log2 of its bytes. */
+typedef enum {
+    DMA_WIDTH_8 = 0,
+    DMA_WIDTH_16,
+    DMA_WIDTH_32
+} dma_width_t;
+
+/** @brief Channel event callback, called from the channel interrupt.
+ *  @param pctx    User context from the channel configuration.
+ *  @param ch      Channel.
+ *  @param block   Index of the block in the chain the event is about.
+ *  @param events  DMA_EV_x bits (0 for an owner-programmed channel).
+ */
+typedef void (*dma_event_fn)(void *pctx, uint32_t ch, uint32_t block,
+    uint32_t events);
+
+/** @brief Channel configuration, fixed while the channel is allocated. */
+typedef struct {
+    /** @brief Hardware request line, or DMA_REQ_NONE for memory to memory. */
+    uint32_t request;
+    dma_dir_t dir;
+    dma_width_t width;
+    /** @brief Peripheral data register (not for memory to memory). */
+    volatile void *pperiph;
+    /** @brief Called from the channel interrupt (NULL: no interrupt). */
+    dma_event_fn on_event;
+    void *pctx;
+    /** @brief The owner programs the channel itself; the allocator only
+     *  reserves it and routes its interrupt to on_event. */
+    bool raw;
+} dma_config_t;
+
+/** @brief One block of a chain. The peripheral side comes from the channel
+ *  configuration, so only the memory side is used, except from memory to
+ *  memory. */
+typedef struct {
+    const volatile void *psrc;
+    volatile void *pdst;
+    /** @brief Bytes, a multiple of the data width (up to DMA_BLOCK_MAX_BYTES). */
+    uint32_t len;
+    /** @brief DMA_BLOCK_x flags. */
+    uint32_t flags;
+} dma_block_t;
+
+// Hardware API
+// Functions to be called by portable core
+/** @brief Virtual function table for a run-time installed DMA backend. */
+typedef struct {
+    /** @brief Initialize the controller, every channel idle. @return true on success. */
+    bool (*hw_init)(void);
+    /** @brief Build an idle channel's linked list; ring links the last block
+     *  back to the first. @return false if the hardware cannot run it. */
+    bool (*hw_load)(uint32_t ch, const dma_config_t *pcfg,
+        const dma_block_t *pblocks, size_t n, bool ring);
+    /** @brief Start the loaded chain from its first block. @return true on success. */
+    bool (*hw_start)(uint32_t ch, bool irq);
+    /** @brief Stop the channel, whatever it is doing, within a bounded wait.
+     *  @return false if it did not stop (left running). */
+    bool (*hw_stop)(uint32_t ch);
+    /** @brief Read and clear the channel's DMA_EV_BLOCK and DMA_EV_ERROR events. */
+    uint32_t (*hw_poll)(uint32_t ch);
+    /** @brief Block in progress and bytes left in it. @return false once stopped. */
+    bool (*hw_position)(uint32_t ch, uint32_t *pblock, uint32_t *premaining);
+    /** @brief Enable or disable the channel's interrupt line. */
+    void (*hw_irq_enable)(uint32_t ch, bool enable);
+} dma_hw_vtable_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Install a backend; every channel free and idle.
+ *  @param phw  Backend virtual function table (copied internally).
+ *  @return true on success.
+ */
+bool dma_init(const dma_hw_vtable_t *phw);
+
+//------------------------------------------------------------------------------
+/** @brief Reserve a free channel.
+ *  @param pcfg  Configuration (copied internally).
+ *  @param pch   Receives the channel.
+ *  @return false if none is free or the configuration is invalid.
+ */
+bool dma_alloc(const dma_config_t *pcfg, uint32_t *pch);
+
+//------------------------------------------------------------------------------
+/** @brief Stop a channel and give it back. */
+void dma_free(uint32_t ch);
+
+//------------------------------------------------------------------------------
+/** @brief Load a chain of blocks into a stopped channel.
+ *  @param ch       Channel.
+ *  @param pblocks  Blocks, in order (copied; the data buffers are not).
+ *  @param n        Number of blocks, 1 to DMA_CHAIN_MAX.
+ *  @param ring     Loop back to the first block after the last.
+ *  @return false if the channel is running or a block is invalid.
+ */
+bool dma_load(uint32_t ch, const dma_block_t *pblocks, size_t n, bool ring);
+
+//------------------------------------------------------------------------------
+/** @brief Start the loaded chain from its first block.
+ *  @return false if nothing is loaded or the channel is running.
+ */
+bool dma_start(uint32_t ch);
+
+//------------------------------------------------------------------------------
+/** @brief Stop a channel; the chain stays loaded for the next start.
+ *  @return false if ch is not owned or raw, or the hardware did not stop the
+ *          channel in time; it then stays running and cannot be reloaded.
+ */
+bool dma_stop(uint32_t ch);
+
+//------------------------------------------------------------------------------
+/** @brief Where a running chain is, e.g., how far a ring has filled.
+ *  @param ch          Channel.
+ *  @param pblock      Receives the block in progress.
+ *  @param premaining  Receives the bytes left in it.
+ *  @return false if the channel is not running.
+ */
+bool dma_position(uint32_t ch, uint32_t *pblock, uint32_t *premaining);
+
+//------------------------------------------------------------------------------
+/** @brief Mask (true) or unmask a channel's interrupt, so thread context can
+ *  update state its callback also uses. */
+void dma_irq_mask(uint32_t ch, bool masked);
+
+//------------------------------------------------------------------------------
+/** @brief Channels not allocated. */
+size_t dma_channels_free(void);
+
+//------------------------------------------------------------------------------
+/** @brief ISR: report finished blocks and errors to the channel's owner.
+ *  Call from the channel interrupt (the STM32H5 backend does).
+ *  @param ch  Channel.
+ *  @return void.
+ *  @note Finished blocks are counted from the position in the chain, so a
+ *        ring of more than one block must be serviced at least once a lap.
+ */
+void dma_isr(uint32_t ch);
+
+#endif // INCLUDE_DMA_API_H_
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_FLASH_API_H_
+#define INCLUDE_FLASH_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a non-blocking embedded flash backend: erase a
+// sector or program one 128-bit quad-word, then poll for completion. The
+// caller keeps working (receiving the next data, say) while the flash is
+// busy instead of spinning in the driver.
+//
+// A quad-word is programmed once between erases; ECC flash does not allow
+// rewriting it, even with the same value.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file flash_api.h
+ *  @brief Non-blocking flash erase and quad-word programming backend.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Programming unit in bytes (128 bits). */
+#define FLASH_QWORD_BYTES  16u
+
+/** @brief hw_status(): idle, last operation succeeded. */
+#define FLASH_OK           0
+/** @brief hw_status(): operation in progress. */
+#define FLASH_BUSY         1
+/** @brief hw_status(): last operation failed (flags are cleared). */
+#define FLASH_ERROR        (-1)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Hardware API
+/** @brief Virtual function table for an installed flash backend. */
+typedef struct {
+    /** @brief Unlock erase and programming. @return true if unlocked. */
+    bool (*hw_unlock)(void);
+    /** @brief Lock erase and programming again. */
+    void (*hw_lock)(void);
+    /** @brief Start erasing the sector holding addr.
+     *  @return false if addr is outside the flash or an operation is running. */
+    bool (*hw_erase_start)(uint32_t addr);
+    /** @brief Start programming one quad-word at addr (FLASH_QWORD_BYTES
+     *         aligned) from pqw[4].
+     *  @return false if addr is invalid or an operation is running. */
+    bool (*hw_program_start)(uint32_t addr, const uint32_t *pqw);
+    /** @brief FLASH_BUSY, FLASH_OK, or FLASH_ERROR once for a failed operation. */
+    int (*hw_status)(void);
+    /** @brief Read len bytes from addr; waits out a running operation. */
+    void (*hw_read)(uint32_t addr, uint8_t *pdst, size_t len);
+    /** @brief Erase granularity in bytes. */
+    uint32_t sector_bytes;
+} flash_hw_vtable_t;
+
+#endif // INCLUDE_FLASH_API_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_FMT_API_H_
+#define INCLUDE_FMT_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a small printf-style formatter that needs no heap and
+// a bounded stack (no recursion, one FMT_DIGITS_MAX scratch buffer), for
+// firmware linked with nano.specs/nosys.specs. fmt_uart() formats straight
+// into the Tx FIFO of a uart_t through uart_tx_reserve()/uart_tx_commit(), so
+// text is never staged in a separate buffer.
+//
+// Conversions: %[flags][width][.precision][length]conv
+//   flags      '-' left-justify, '0' zero-pad, '+' / ' ' sign of positives
+//   width      digits or '*' (int argument)
+//   precision  digits or '*'; minimum digits for integers, maximum characters
+//              for %s, decimals for %k/%q
+//   length     hh, h, l, ll, z
+//   conv       d i u x X c s p %
+//              k  scaled decimal: int32 (int64 with l/ll) holding value * 10^p,
+//                 p = precision (default 3), e.g. ("%.2k", 2350) -> "23.50"
+//              q  Q16.16 fixed point int32, rounded to p decimals (default 3,
+//                 at most 9), e.g. ("%.2q", 0x00018000) -> "1.50"
+// Floating point is not supported.
+//
+//------------------------------------------------------------------------------
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file fmt_api.h
+ *  @brief Heap-free printf-style formatting into buffers and UART Tx FIFOs.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Scratch space for one converted number (64-bit with decimals). */
+#define FMT_DIGITS_MAX  32u
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Format into a buffer, always NUL-terminated when cap > 0.
+ *  @param pout  Output buffer.
+ *  @param cap   Buffer size including the terminator.
+ *  @param fmt   Format string (see above).
+ *  @return Characters stored, excluding the terminator; output beyond
+ *          cap - 1 is dropped (unlike snprintf, the full length is not
+ *          returned).
+ */
+size_t fmt_buf(char *pout, size_t cap, const char *fmt, ...);
+
+/** @brief fmt_buf() with a va_list. */
+size_t fmt_vbuf(char *pout, size_t cap, const char *fmt, va_list ap);
+
+//------------------------------------------------------------------------------
+/** @brief Format into the Tx FIFO in place; Context: Application APIs.
+ *  @param pu   Opaque context pointer (caller-owned storage).
+ *  @param fmt  Format string (see above).
+ *  @return Bytes queued; output the Tx FIFO has no room for is dropped, as
+ *          with uart_write().
+ */
+size_t fmt_uart(uart_t *pu, const char *fmt, ...);
+
+/** @brief fmt_uart() with a va_list. */
+size_t fmt_vuart(uart_t *pu, const char *fmt, va_list ap);
+
+#endif // INCLUDE_FMT_API_H_
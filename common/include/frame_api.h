@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_FRAME_API_H_
+#define INCLUDE_FRAME_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies packet framing for byte streams such as a UART:
+// payload + CRC-16, COBS encoded, terminated by a 0x00 delimiter. COBS
+// guarantees the delimiter never appears inside a frame, so a receiver
+// resynchronizes at the next 0x00 after any corruption, at a worst-case cost
+// of one byte per 254.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file frame_api.h
+ *  @brief COBS framing with CRC-16 integrity check and a streaming decoder.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Frame delimiter, never present inside an encoded frame. */
+#define FRAME_DELIM      0x00u
+/** @brief CRC-16/CCITT-FALSE trailer, MSB first, covered by the encoding. */
+#define FRAME_CRC_BYTES  2u
+
+/** @brief Worst-case encoded size of an n byte payload, delimiter included. */
+#define FRAME_ENCODED_MAX(n) \
+    ((n) + FRAME_CRC_BYTES + ((n) + FRAME_CRC_BYTES) / 254u + 2u)
+
+/** @brief Decoder buffer size needed for payloads of up to n bytes. */
+#define FRAME_DECODE_BUF(n)  ((n) + FRAME_CRC_BYTES)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Receive callback for one verified frame.
+ *  @param pctx      User context given to frame_decoder_init().
+ *  @param ppayload  Payload, valid only during the call.
+ *  @param len       Payload length in bytes.
+ */
+typedef void (*frame_rx_fn)(void *pctx, const uint8_t *ppayload, size_t len);
+
+/** @brief Streaming decoder state; treat as opaque. */
+typedef struct {
+    uint8_t     *pbuf;
+    size_t      cap;
+    size_t      len;
+    // COBS block code and bytes left in the block, 0/0 between frames
+    uint8_t     code;
+    uint8_t     left;
+    // Frame too long for pbuf: discarding until the next delimiter
+    bool        overrun;
+    frame_rx_fn on_frame;
+    void        *pctx;
+    /** @brief Frames delivered. */
+    uint32_t    frames;
+    /** @brief Frames dropped on CRC mismatch. */
+    uint32_t    crc_errors;
+    /** @brief Frames dropped as malformed (bad COBS, too short, too long). */
+    uint32_t    malformed;
+} frame_decoder_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Encode one frame.
+ *  @param ppayload  Payload bytes.
+ *  @param len       Payload length.
+ *  @param pout      Output, at least FRAME_ENCODED_MAX(len) bytes.
+ *  @param cap       Output capacity.
+ *  @return Encoded length including the delimiter, 0 if cap is too small.
+ */
+size_t frame_encode(const uint8_t *ppayload, size_t len, uint8_t *pout, size_t cap);
+
+//------------------------------------------------------------------------------
+/** @brief Initialize a streaming decoder.
+ *  @param pd        Decoder state (caller-owned).
+ *  @param pbuf      Frame buffer, FRAME_DECODE_BUF(max payload) bytes.
+ *  @param cap       Frame buffer size.
+ *  @param on_frame  Called for each frame that passes the CRC check.
+ *  @param pctx      User context passed to on_frame.
+ *  @return void.
+ */
+void frame_decoder_init(
+    frame_decoder_t *pd,
+    void *pbuf,
+    size_t cap,
+    frame_rx_fn on_frame,
+    void *pctx);
+
+//------------------------------------------------------------------------------
+/** @brief Feed received bytes, in any split; frames are delivered as their
+ *         delimiter arrives.
+ *  @param pd     Decoder state.
+ *  @param pdata  Received bytes, e.g., a uart_rx_peek() span.
+ *  @param len    Number of bytes.
+ *  @return Number of frames delivered by this call.
+ */
+size_t frame_decoder_feed(frame_decoder_t *pd, const uint8_t *pdata, size_t len);
+
+#endif // INCLUDE_FRAME_API_H_
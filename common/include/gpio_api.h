@@ -14,6 +14,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include <stdbool.h>
 #include <stdint.h>
 
 //------------------------------------------------------------------------------
@@ -24,23 +25,114 @@
  *  @brief Portable GPIO API for clients to use.
  */
 
+//------------------------------------------------------------------------------
+// Pin Descriptors
+//------------------------------------------------------------------------------
+
+/** @brief GPIO port index: 0 for port A, 1 for port B, and so on. */
+typedef uint8_t gpio_port_t;
+
+/** @brief Pin descriptor: port index in bits 7..4, pin number in bits 3..0.
+ *  Built with GPIO_PIN() so it is a compile-time constant. */
+typedef uint8_t gpio_pin_t;
+
+#define GPIO_PORT_A  0u
+#define GPIO_PORT_B  1u
+#define GPIO_PORT_C  2u
+#define GPIO_PORT_D  3u
+#define GPIO_PORT_E  4u
+#define GPIO_PORT_F  5u
+#define GPIO_PORT_G  6u
+#define GPIO_PORT_H  7u
+#define GPIO_PORT_I  8u
+/** @brief Number of ports a descriptor can name. */
+#define GPIO_PORT_COUNT  9u
+/** @brief Pins per port. */
+#define GPIO_PORT_PINS   16u
+
+/** @brief Make a pin descriptor, e.g., GPIO_PIN(GPIO_PORT_B, 0) for PB0. */
+#define GPIO_PIN(port, pin)  ((gpio_pin_t)((((port) & 0xFu) << 4) | ((pin) & 0xFu)))
+/** @brief Port index of a pin descriptor. */
+#define GPIO_PIN_PORT(p)     ((gpio_port_t)((p) >> 4))
+/** @brief Pin number within its port. */
+#define GPIO_PIN_NUM(p)      ((uint32_t)((p) & 0xFu))
+/** @brief Port mask bit of a pin descriptor, for the *_mask operations. */
+#define GPIO_PIN_MASK(p)     (1u << GPIO_PIN_NUM(p))
+
+//------------------------------------------------------------------------------
+// Pin Configuration
+//------------------------------------------------------------------------------
+
+/** @brief Pin function. */
+typedef enum {
+    GPIO_MODE_INPUT = 0,
+    GPIO_MODE_OUTPUT,
+    GPIO_MODE_AF,
+    GPIO_MODE_ANALOG,
+} gpio_mode_t;
+
+/** @brief Output driver. */
+typedef enum {
+    GPIO_OTYPE_PUSH_PULL = 0,
+    GPIO_OTYPE_OPEN_DRAIN,
+} gpio_otype_t;
+
+/** @brief Output slew rate, slowest first. */
+typedef enum {
+    GPIO_SPEED_LOW = 0,
+    GPIO_SPEED_MEDIUM,
+    GPIO_SPEED_HIGH,
+    GPIO_SPEED_VERY_HIGH,
+} gpio_speed_t;
+
+/** @brief Internal bias resistor. */
+typedef enum {
+    GPIO_PULL_NONE = 0,
+    GPIO_PULL_UP,
+    GPIO_PULL_DOWN,
+} gpio_pull_t;
+
+/** @brief Complete configuration of one pin. */
+typedef struct {
+    gpio_mode_t  mode;
+    gpio_otype_t otype;
+    gpio_speed_t speed;
+    gpio_pull_t  pull;
+    uint8_t      af;     /**< Alternate function number, GPIO_MODE_AF only. */
+} gpio_config_t;
+
 //------------------------------------------------------------------------------
 // API Object Definition
 //------------------------------------------------------------------------------
 
 // Define functor prototypes for the API
+/** @brief Virtual function type for GPIO pin configuration. */
+typedef bool (*gpio_configure_fn)(gpio_pin_t pin, const gpio_config_t *pcfg);
 /** @brief Virtual function type for GPIO pin write. */
-typedef void (*gpio_write_fn)(uint32_t pin, uint8_t value);
+typedef void (*gpio_write_fn)(gpio_pin_t pin, uint8_t value);
 /** @brief Virtual function type for GPIO pin toggle. */
-typedef void (*gpio_toggle_fn)(uint32_t pin);
+typedef void (*gpio_toggle_fn)(gpio_pin_t pin);
+/** @brief Virtual function type for GPIO port write of the pins in mask. */
+typedef void (*gpio_write_mask_fn)(gpio_port_t port, uint32_t mask, uint32_t value);
+/** @brief Virtual function type for GPIO port set or clear of the pins in mask. */
+typedef void (*gpio_mask_fn)(gpio_port_t port, uint32_t mask);
 
 // Organize the GPIO API into an object type
 /** @brief Virtual function table for GPIO API. */
 typedef struct {
+    /** @brief Configure a pin and enable its port clock. @return true on success. */
+    gpio_configure_fn  configure;
     /** @brief Write a value to a GPIO pin. @return void. */
-    gpio_write_fn  write;
+    gpio_write_fn      write;
     /** @brief Toggle the current value on a GPIO pin. @return void. */
-    gpio_toggle_fn toggle;
+    gpio_toggle_fn     toggle;
+    /** @brief Drive each pin in mask to its bit in value, leaving other pins
+     *  untouched; one atomic store on target. @return void. */
+    gpio_write_mask_fn write_mask;
+    /** @brief Drive the pins in mask high; one atomic store on target. @return void. */
+    gpio_mask_fn       set_mask;
+    /** @brief Drive the pins in mask low; one atomic store on target. @return void. */
+    gpio_mask_fn       clear_mask;
 }
 gpio_api_t;
 
@@ -50,9 +142,9 @@ extern gpio_api_t gpio;
 //------------------------------------------------------------------------------
 // Function Declarations
 //------------------------------------------------------------------------------
-/** @brief Initialize a GPIO instance: enable clock and configure pins.
+/** @brief Install the GPIO API; pins are then set up with gpio.configure().
  *  @return void.
  */
 void gpio_init(void);
 
-#endif // INCLUDE_GPIO_API_H_
\ No newline at end of file
+#endif // INCLUDE_GPIO_API_H_
@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_LED_PWM_API_H_
+#define INCLUDE_LED_PWM_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies an LED indicator driven by a hardware timer. Blink,
+// breathe and pattern modes are set up once and then run without the CPU:
+// the backend generates PWM on the LED pin and, for sequences, has hardware
+// (e.g., a DMA channel paced by a second timer) feed the duty cycle from a
+// table.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file led_pwm_api.h
+ *  @brief Hardware-timed LED blink, breathe and pattern modes.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Brightness levels: duty 0 (off) to LED_PWM_LEVELS (fully on). */
+#define LED_PWM_LEVELS       256u
+/** @brief PWM carrier for brightness modes, fast enough not to flicker. */
+#define LED_PWM_CARRIER_HZ   1000u
+/** @brief Longest duty table the core keeps for breathe and pattern. */
+#define LED_PWM_MAX_STEPS    64u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Hardware API
+// Functions to be called by portable core
+/** @brief Virtual function table for a run-time installed LED PWM backend. */
+typedef struct {
+    /** @brief Clock the timer(s) and route the LED pin. @return true on success. */
+    bool (*hw_init)(void);
+    /** @brief Run steady PWM: counter at counter_hz, output on for the first
+     *  duty of every period ticks (duty >= period is always on).
+     *  @return false if the timing is out of range. */
+    bool (*hw_pwm)(uint32_t counter_hz, uint32_t period, uint32_t duty);
+    /** @brief On top of hw_pwm, load pduty[i] as the duty every step_us
+     *  microseconds, looping forever without CPU. The table must stay valid
+     *  until hw_stop. Optional. @return false if unsupported or out of range. */
+    bool (*hw_sequence)(const uint16_t *pduty, size_t steps, uint32_t step_us);
+    /** @brief Stop PWM and any sequence; the LED is left off.
+     *  @return false if the sequencer did not stop within a bounded wait. */
+    bool (*hw_stop)(void);
+} led_pwm_hw_vtable_t;
+
+/** @brief Current mode. */
+typedef enum {
+    LED_PWM_OFF = 0,
+    LED_PWM_STEADY,
+    LED_PWM_BLINK,
+    LED_PWM_BREATHE,
+    LED_PWM_PATTERN,
+} led_pwm_mode_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Install a backend; the LED starts off.
+ *  @param phw  Backend virtual function table (copied internally).
+ *  @return true on success.
+ */
+bool led_pwm_init(const led_pwm_hw_vtable_t *phw);
+
+//------------------------------------------------------------------------------
+/** @brief Hold a fixed brightness.
+ *  @param level  0 (off) to LED_PWM_LEVELS (fully on).
+ *  @return true on success.
+ */
+bool led_pwm_steady(uint32_t level);
+
+//------------------------------------------------------------------------------
+/** @brief Blink: on for on_ms at the start of every period_ms.
+ *  @param period_ms  Blink period, 2 ms to 65 s.
+ *  @param on_ms      On time, at most period_ms.
+ *  @return true on success.
+ */
+bool led_pwm_blink(uint32_t period_ms, uint32_t on_ms);
+
+//------------------------------------------------------------------------------
+/** @brief Breathe: fade in and out with perceptual (squared) brightness.
+ *  @param period_ms  Duration of one fade in plus fade out, 64 ms to 60 s.
+ *  @return true on success.
+ */
+bool led_pwm_breathe(uint32_t period_ms);
+
+//------------------------------------------------------------------------------
+/** @brief Pattern: play bit i of bits (LSB first) as on/off for step_ms, looping.
+ *  @param bits     On/off pattern.
+ *  @param nbits    Pattern length, 1 to 32.
+ *  @param step_ms  Time per bit, 1 ms to 6 s.
+ *  @return true on success.
+ */
+bool led_pwm_pattern(uint32_t bits, uint32_t nbits, uint32_t step_ms);
+
+//------------------------------------------------------------------------------
+/** @brief Turn the LED off and release the hardware sequencer.
+ *  @return false if the sequencer did not stop; no mode can start until a
+ *          later call succeeds.
+ */
+bool led_pwm_off(void);
+/** @brief Mode last started successfully. */
+led_pwm_mode_t led_pwm_mode(void);
+
+#endif // INCLUDE_LED_PWM_API_H_
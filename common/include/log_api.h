@@ -0,0 +1,221 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_LOG_API_H_
+#define INCLUDE_LOG_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies deferred binary logging: a log statement stores a
+// message ID, a timestamp and its raw arguments in a lock-free ring, and the
+// main loop later sends the records over a UART, one frame each. No text is
+// formatted on the MCU.
+//
+// Each LOG_x() statement places its level, file, line and format string in
+// the "log_fmt" section, and the message ID is the offset of that entry in
+// the section. The section must stay below 64 KiB minus one, so that IDs fit
+// 16 bits and never reach LOG_ID_DROPPED; the firmware linker script checks
+// this. The firmware linker script keeps the section in the ELF but
+// not in flash, so format strings cost no target memory. tools/log_decode.py
+// reads the section back out of the ELF (or a dictionary it generated from
+// one) and turns received records into text.
+//
+// Arguments are integers or floats, at most LOG_ARGS_MAX of them, each sent
+// as 32 bits; strings and pointers are not supported.
+//
+//------------------------------------------------------------------------------
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file log_api.h
+ *  @brief Deferred binary logging with host-side formatting.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Most arguments one record carries. */
+#define LOG_ARGS_MAX      4u
+
+/** @brief Levels; statements below LOG_LEVEL compile to nothing. */
+#define LOG_LEVEL_DEBUG   0
+#define LOG_LEVEL_INFO    1
+#define LOG_LEVEL_WARN    2
+#define LOG_LEVEL_ERROR   3
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL         LOG_LEVEL_DEBUG
+#endif
+
+/** @brief Reserved ID of the record reporting dropped records; its argument
+ *         is the number dropped since the last report. */
+#define LOG_ID_DROPPED    0xFFFFu
+
+/** @brief Largest record payload: ID, varint timestamp, varint arguments. */
+#define LOG_PAYLOAD_MAX   (2u + 5u + 5u * LOG_ARGS_MAX)
+
+/** @brief Section holding the format string dictionary. */
+#define LOG_SECTION       "log_fmt"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Timestamp source, e.g., timebase_now() or a cycle counter. */
+typedef uint32_t (*log_time_fn)(void);
+
+/** @brief One record slot; the ring is an array of these (caller-owned). */
+typedef struct {
+    _Atomic uint8_t state;
+    uint8_t  nargs;
+    uint16_t id;
+    uint32_t ts;
+    uint32_t args[LOG_ARGS_MAX];
+} log_slot_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Set up the record ring; Context: Init, before any LOG_x().
+ *  @param pslots  Slot storage (caller-owned).
+ *  @param count   Number of slots, a power of two of at least 2.
+ *  @param now     Timestamp source, or NULL for zero timestamps.
+ *  @return false if count is not a power of two of at least 2.
+ */
+bool log_init(log_slot_t *pslots, size_t count, log_time_fn now);
+
+//------------------------------------------------------------------------------
+/** @brief Store a record; Context: Any, including nested ISRs.
+ *  @param id     Message ID (see LOG_x()).
+ *  @param pargs  Arguments as 32-bit words.
+ *  @param nargs  Number of arguments, at most LOG_ARGS_MAX.
+ *  @return false if the ring was full and the record was dropped.
+ */
+bool log_write(uint16_t id, const uint32_t *pargs, size_t nargs);
+
+//------------------------------------------------------------------------------
+/** @brief Send stored records as frames; Context: Main loop (single caller).
+ *  @param pu           UART to send on; frames go out whole or not at all.
+ *  @param max_records  Most records to send in this call.
+ *  @return Number of records sent, including any dropped-record report.
+ */
+size_t log_drain(uart_t *pu, size_t max_records);
+
+//------------------------------------------------------------------------------
+/** @brief Number of records stored and not yet sent. */
+size_t log_pending(void);
+
+/** @brief Number of records dropped on a full ring since log_init(). */
+uint32_t log_dropped(void);
+
+//------------------------------------------------------------------------------
+// Argument Packing
+//------------------------------------------------------------------------------
+
+static inline uint32_t log_arg_int(uint32_t v) {
+    return v;
+}
+
+static inline uint32_t log_arg_float(float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+/** @brief Pack one argument: floats by their bits, integers truncated. */
+#define LOG_ARG(x) \
+    _Generic((x), float: log_arg_float, double: log_arg_float, \
+        default: log_arg_int)(x)
+
+//------------------------------------------------------------------------------
+// Log Macros
+//------------------------------------------------------------------------------
+
+/** @brief Log at a level: LOG_INFO("rx %u bytes, %d dBm", n, rssi).
+ *         Below LOG_LEVEL a statement emits no code and no dictionary entry,
+ *         so it uses no message ID. */
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...)  LOG_AT_("D", __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)  LOG_OFF_(__VA_ARGS__)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...)   LOG_AT_("I", __VA_ARGS__)
+#else
+#define LOG_INFO(...)   LOG_OFF_(__VA_ARGS__)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...)   LOG_AT_("W", __VA_ARGS__)
+#else
+#define LOG_WARN(...)   LOG_OFF_(__VA_ARGS__)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...)  LOG_AT_("E", __VA_ARGS__)
+#else
+#define LOG_ERROR(...)  LOG_OFF_(__VA_ARGS__)
+#endif
+
+// Dictionary entry: level, file, line and format, separated by 0x1F
+// Notes:
+//    - The file is the basename where the compiler provides __FILE_NAME__
+//      (GCC 12, Clang 9): full paths would bloat the section and push
+//      message IDs past 16 bits
+#define LOG_STR_(x)  #x
+#define LOG_STR(x)   LOG_STR_(x)
+#ifdef __FILE_NAME__
+#define LOG_FILE_    __FILE_NAME__
+#else
+#define LOG_FILE_    __FILE__
+#endif
+#define LOG_ENTRY_(tag, fmt) \
+    tag "\x1f" LOG_FILE_ "\x1f" LOG_STR(__LINE__) "\x1f" fmt
+
+// Number of arguments after the format string (0..4)
+#define LOG_NARGS_(f, a, b, c, d, n, ...)  n
+#define LOG_NARGS(...)  LOG_NARGS_(__VA_ARGS__, 4, 3, 2, 1, 0, _)
+
+#define LOG_CAT_(a, b)  a##b
+#define LOG_CAT(a, b)   LOG_CAT_(a, b)
+
+#define LOG_PACK_0(f)              NULL
+#define LOG_PACK_1(f, a)           (const uint32_t[]){ LOG_ARG(a) }
+#define LOG_PACK_2(f, a, b)        (const uint32_t[]){ LOG_ARG(a), LOG_ARG(b) }
+#define LOG_PACK_3(f, a, b, c) \
+    (const uint32_t[]){ LOG_ARG(a), LOG_ARG(b), LOG_ARG(c) }
+#define LOG_PACK_4(f, a, b, c, d) \
+    (const uint32_t[]){ LOG_ARG(a), LOG_ARG(b), LOG_ARG(c), LOG_ARG(d) }
+
+#define LOG_FMT_(f, ...)  f
+
+// Start of the dictionary section; provided by the linker
+extern const char __start_log_fmt[];
+
+#define LOG_AT_(tag, ...)                                                      \
+    do {                                                                       \
+        static const char log_entry_[]                                         \
+            __attribute__((section(LOG_SECTION), used)) =                      \
+            LOG_ENTRY_(tag, LOG_FMT_(__VA_ARGS__, _));                         \
+        (void)log_write((uint16_t)(log_entry_ - __start_log_fmt),              \
+            LOG_CAT(LOG_PACK_, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__),           \
+            LOG_NARGS(__VA_ARGS__));                                           \
+    } while (0)
+
+// Compiled out: the arguments are only named, not evaluated, so variables
+// kept for logging raise no unused warnings
+#define LOG_OFF_(...)                                                          \
+    do {                                                                       \
+        (void)sizeof(LOG_CAT(LOG_PACK_, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)); \
+    } while (0)
+
+#endif // INCLUDE_LOG_API_H_
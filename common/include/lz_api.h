@@ -0,0 +1,172 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_LZ_API_H_
+#define INCLUDE_LZ_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a streaming LZ77 compressor for a UART byte stream,
+// for repetitive text such as telemetry on a slow link. lz_write() stands in
+// for uart_write(): it compresses straight into the Tx FIFO through
+// uart_tx_reserve()/uart_tx_commit(), and lz_read() decompresses from the Rx
+// FIFO spans on the other side (tools/lz_decode.py on a host).
+//
+// Stream format, a sequence of tokens:
+//    0LLLLLLL                    literal run: L + 1 bytes follow (1 to 128)
+//    1LLLLLDD DDDDDDDD           match: copy L + 3 bytes (3 to 34) from
+//                                D + 1 bytes back (1 to LZ_WINDOW)
+// A match may overlap the bytes it produces (distance < length).
+//
+// Each lz_write() call ends on a token boundary, so whatever it queued
+// decodes completely on arrival; matches reach back into earlier calls. No
+// heap: the encoder and decoder keep their window in caller-owned state,
+// and an encoder call does a bounded amount of work (one hash probe per
+// input byte, input limited by the free Tx space).
+//
+// Both ends must start together (lz_encoder_init()/lz_decoder_init() at
+// link start-up); a lost or corrupted byte corrupts the rest of the stream.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file lz_api.h
+ *  @brief Heap-free streaming LZ77 compression on UART Tx/Rx FIFO spans.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief History window in bytes (fixed by the stream format). */
+#define LZ_WINDOW         1024u
+/** @brief Shortest and longest match. */
+#define LZ_MATCH_MIN      3u
+#define LZ_MATCH_MAX      34u
+/** @brief Longest literal run. */
+#define LZ_LITERAL_MAX    128u
+
+/** @brief Match finder hash table entries, as a power of two. */
+#ifndef LZ_HASH_BITS
+#define LZ_HASH_BITS      10u
+#endif
+
+/** @brief Worst-case compressed size of n bytes (all literals). */
+#define LZ_BOUND(n)       ((n) + (n) / LZ_LITERAL_MAX + 1u)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Totals since initialization. */
+typedef struct {
+    uint64_t in;            /**< Bytes accepted. */
+    uint64_t out;           /**< Compressed bytes produced. */
+} lz_stats_t;
+
+/** @brief Encoder state (about 3 KiB); treat as opaque. */
+typedef struct {
+    // Input seen so far, the last LZ_WINDOW bytes of it, and the latest
+    // position of each 3-byte hash (low 16 bits)
+    uint32_t   pos;
+    uint8_t    hist[LZ_WINDOW];
+    uint16_t   head[1u << LZ_HASH_BITS];
+    // Literal run being collected
+    uint8_t    lit[LZ_LITERAL_MAX];
+    uint32_t   nlit;
+    /** @brief Totals. */
+    lz_stats_t stats;
+} lz_encoder_t;
+
+/** @brief Decoder state (about 1 KiB); treat as opaque. */
+typedef struct {
+    uint32_t   pos;
+    uint8_t    hist[LZ_WINDOW];
+    // Bytes left of the current literal run or match, the match distance,
+    // and a match token's first byte while waiting for its second
+    uint32_t   lit_left;
+    uint32_t   copy_left;
+    uint32_t   dist;
+    uint8_t    token;
+    /** @brief Totals: in = compressed bytes taken, out = bytes produced. */
+    lz_stats_t stats;
+} lz_decoder_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Start a new stream.
+ *  @param pz  Encoder state (caller-owned).
+ */
+void lz_encoder_init(lz_encoder_t *pz);
+
+//------------------------------------------------------------------------------
+/** @brief Compress into the Tx FIFO in place; Context: Application APIs.
+ *  @param pz     Encoder state.
+ *  @param pu     UART to queue the compressed bytes on.
+ *  @param pdata  Bytes to send; best passed a whole message per call.
+ *  @param len    Number of bytes.
+ *  @return Bytes accepted: as many as are sure to fit once compressed
+ *          (LZ_BOUND()); the caller keeps the rest, unlike uart_write(),
+ *          since the stream cannot skip bytes.
+ */
+size_t lz_write(lz_encoder_t *pz, uart_t *pu, const uint8_t *pdata, size_t len);
+
+//------------------------------------------------------------------------------
+/** @brief Compress into a buffer (same stream as lz_write()).
+ *  @param pz     Encoder state.
+ *  @param pdata  Bytes to compress.
+ *  @param len    Number of bytes.
+ *  @param pout   Output buffer.
+ *  @param cap    Output capacity.
+ *  @param pn     Set to the compressed length.
+ *  @return Bytes accepted, as for lz_write().
+ */
+size_t lz_encode(lz_encoder_t *pz, const uint8_t *pdata, size_t len,
+    uint8_t *pout, size_t cap, size_t *pn);
+
+//------------------------------------------------------------------------------
+/** @brief Compression ratio so far, input over output, in Q16.16 (print with
+ *         fmt_api.h "%.2q"); 1.0 before any output.
+ */
+uint32_t lz_ratio_q16(const lz_stats_t *ps);
+
+//------------------------------------------------------------------------------
+/** @brief Start a new stream.
+ *  @param pd  Decoder state (caller-owned).
+ */
+void lz_decoder_init(lz_decoder_t *pd);
+
+//------------------------------------------------------------------------------
+/** @brief Decompress from a buffer, in any split of the stream.
+ *  @param pd     Decoder state.
+ *  @param pin    Compressed bytes.
+ *  @param len    Number of compressed bytes.
+ *  @param pused  Set to the compressed bytes taken; the rest waits for room.
+ *  @param pout   Output buffer.
+ *  @param cap    Output capacity.
+ *  @return Bytes produced.
+ */
+size_t lz_decode(lz_decoder_t *pd, const uint8_t *pin, size_t len, size_t *pused,
+    uint8_t *pout, size_t cap);
+
+//------------------------------------------------------------------------------
+/** @brief Decompress from the Rx FIFO in place; Context: Application APIs.
+ *  @param pd    Decoder state.
+ *  @param pu    UART the compressed stream arrives on.
+ *  @param pout  Output buffer.
+ *  @param cap   Output capacity.
+ *  @return Bytes produced.
+ */
+size_t lz_read(lz_decoder_t *pd, uart_t *pu, uint8_t *pout, size_t cap);
+
+#endif // INCLUDE_LZ_API_H_
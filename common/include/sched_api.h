@@ -0,0 +1,127 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SCHED_API_H_
+#define INCLUDE_SCHED_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a run-to-completion, event-driven cooperative
+// scheduler. ISRs (or tasks) post event bits to a task; the scheduler runs
+// the highest-priority task with pending events to completion, and sleeps
+// the core when no task is ready. The backend provides interrupt masking,
+// the sleep instruction and an optional cycle counter for run-time accounting.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file sched_api.h
+ *  @brief Run-to-completion cooperative scheduler with O(1) priority selection.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief One task per priority, one priority per ready-bitmap bit. */
+#define SCHED_MAX_TASKS  32u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Hardware API
+// Functions to be called by portable core
+/** @brief Virtual function table for a run-time installed scheduler backend. */
+typedef struct {
+    /** @brief Prepare the backend, e.g., start the cycle counter. Optional. */
+    bool (*hw_init)(void);
+    /** @brief Mask interrupts. @return Previous mask state for hw_irq_restore. */
+    uint32_t (*hw_irq_save)(void);
+    /** @brief Restore the interrupt mask state returned by hw_irq_save. */
+    void (*hw_irq_restore)(uint32_t state);
+    /** @brief Sleep until an interrupt is pending; called with interrupts
+     *  masked, so a post racing the ready check still wakes the core. */
+    void (*hw_idle)(void);
+    /** @brief Free-running cycle counter for accounting (wraps). Optional. */
+    uint32_t (*hw_cycles)(void);
+} sched_hw_vtable_t;
+
+/** @brief Task body: run to completion for the events taken at dispatch.
+ *  @param pctx    Context given at task creation.
+ *  @param events  Event bits posted since the task last ran (never 0).
+ */
+typedef void (*sched_task_fn)(void *pctx, uint32_t events);
+
+/** @brief Per-task run-time accounting. Cycles are 0 without hw_cycles. */
+typedef struct {
+    uint32_t runs;        /**< Dispatches of the task. */
+    uint64_t cycles;      /**< Total cycles spent in the task body. */
+    uint32_t cycles_max;  /**< Longest single run, in cycles. */
+} sched_task_stats_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Install a backend and clear all tasks and statistics.
+ *  @param phw  Backend virtual function table (copied internally).
+ *  @return true on success.
+ */
+bool sched_init(const sched_hw_vtable_t *phw);
+
+//------------------------------------------------------------------------------
+/** @brief Register the task that runs at a priority.
+ *  @param prio  0 (lowest) to SCHED_MAX_TASKS - 1 (highest); must be free.
+ *  @param fn    Task body.
+ *  @param pctx  Context handed to every run.
+ *  @return true on success.
+ */
+bool sched_task_create(uint32_t prio, sched_task_fn fn, void *pctx);
+
+//------------------------------------------------------------------------------
+/** @brief Post event bits to a task, making it ready; Context: any, ISR safe.
+ *  @param prio    Priority of the target task.
+ *  @param events  Event bits OR-ed into the task's pending set (0 is ignored).
+ *  @return void.
+ */
+void sched_post(uint32_t prio, uint32_t events);
+
+//------------------------------------------------------------------------------
+/** @brief Run the highest-priority ready task once, to completion.
+ *  @return true if a task ran, false if none was ready.
+ */
+bool sched_dispatch(void);
+
+//------------------------------------------------------------------------------
+/** @brief Sleep until the next interrupt if no task is ready.
+ *  @return void.
+ */
+void sched_idle(void);
+
+//------------------------------------------------------------------------------
+/** @brief Scheduler main loop: dispatch while ready, otherwise idle.
+ *  @return Never.
+ */
+void sched_run(void);
+
+//------------------------------------------------------------------------------
+/** @brief Read a task's run-time accounting.
+ *  @param prio    Priority of the task.
+ *  @param pstats  Output statistics.
+ *  @return true if a task exists at prio.
+ */
+bool sched_task_stats(uint32_t prio, sched_task_stats_t *pstats);
+/** @brief Cycles spent asleep in sched_idle() since init or last clear. */
+uint64_t sched_idle_cycles(void);
+/** @brief Reset all task and idle accounting. */
+void sched_stats_clear(void);
+
+#endif // INCLUDE_SCHED_API_H_
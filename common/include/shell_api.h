@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SHELL_API_H_
+#define INCLUDE_SHELL_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a line-editing command shell on a uart_t.
+//
+// Commands are listed in a text file and tools/shell_gen.py turns the list
+// into a const shell_table_t at build time, with a minimal perfect hash over
+// the names: finding a command costs two hashes of the name and one string
+// compare, whatever the number of commands.
+//
+// Input is edited in a caller-provided line buffer (backspace, Ctrl-U to
+// erase the line, Ctrl-C to cancel) and tokenized there in place: argv[]
+// points into the line buffer, arguments split on blanks, double quotes group
+// blanks and a backslash takes the next character literally. Output goes
+// straight into the UART Tx FIFO (shell_printf() formats in place with
+// fmt_vuart()). A command with more output than the Tx FIFO holds returns
+// SHELL_MORE and is called again once the FIFO has drained to half full,
+// keeping its position in shell_state().
+//
+//------------------------------------------------------------------------------
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file shell_api.h
+ *  @brief UART command shell with perfect-hash command dispatch.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Most arguments of one command line, the command name included. */
+#define SHELL_ARGS_MAX   8
+
+/** @brief Command result: finished. */
+#define SHELL_OK         0
+/** @brief Command result: more output to come, call again. */
+#define SHELL_MORE       1
+/** @brief Command result: bad arguments (any negative value is an error). */
+#define SHELL_ERR_USAGE  (-1)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief One shell instance (caller-owned; treat as opaque). */
+typedef struct shell_t shell_t;
+
+/** @brief Command handler.
+ *  @param psh   Shell running the command.
+ *  @param argc  Number of arguments, argv[0] being the command name.
+ *  @param argv  Arguments, NUL-terminated in the shell's line buffer.
+ *  @return SHELL_OK, SHELL_MORE, or a negative error code.
+ */
+typedef int (*shell_cmd_fn)(shell_t *psh, int argc, char **argv);
+
+/** @brief One command table entry. */
+typedef struct {
+    const char   *name;
+    shell_cmd_fn fn;
+    const char   *help;
+} shell_cmd_t;
+
+/** @brief Command table generated by tools/shell_gen.py. */
+typedef struct {
+    /** @brief Commands, in hash slot order. */
+    const shell_cmd_t *pcmds;
+    /** @brief Per-bucket displacement: a seed (>= 0) or -(slot + 1). */
+    const int16_t     *pdisp;
+    uint16_t          count;
+} shell_table_t;
+
+struct shell_t {
+    uart_t              *pu;
+    const shell_table_t *ptable;
+    const char          *prompt;
+    // Line buffer and edit state
+    char                *pline;
+    size_t              cap;
+    size_t              len;
+    uint8_t             esc;
+    bool                cr;
+    // Command being resumed after SHELL_MORE
+    const shell_cmd_t   *prun;
+    int                 argc;
+    char                *argv[SHELL_ARGS_MAX];
+    uint32_t            state;
+};
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Initialize a shell and print the prompt.
+ *  @param psh     Shell storage (caller-owned).
+ *  @param pu      UART the shell reads and writes.
+ *  @param ptable  Generated command table.
+ *  @param pline   Line buffer (caller-owned); also holds argv[] strings.
+ *  @param cap     Line buffer size; lines are at most cap - 1 characters.
+ *  @param prompt  Prompt text, e.g., "> ".
+ *  @return true on success.
+ */
+bool shell_init(shell_t *psh, uart_t *pu, const shell_table_t *ptable,
+    char *pline, size_t cap, const char *prompt);
+
+//------------------------------------------------------------------------------
+/** @brief Process received input and run or resume commands; Context: Main
+ *         Loop or a task woken by Rx.
+ *  @param psh  Shell.
+ *  @return true while a command is unfinished (SHELL_MORE); poll again once
+ *          Tx space frees up.
+ */
+bool shell_poll(shell_t *psh);
+
+//------------------------------------------------------------------------------
+/** @brief Look a command up by name in constant time.
+ *  @param ptable  Generated command table.
+ *  @param pname   Name (need not be NUL-terminated).
+ *  @param len     Name length.
+ *  @return The command, or NULL if there is none by that name.
+ */
+const shell_cmd_t *shell_find(const shell_table_t *ptable, const char *pname,
+    size_t len);
+
+//------------------------------------------------------------------------------
+/** @brief Split a line into arguments in place.
+ *  @param pline  Line, NUL-terminated; rewritten with the arguments.
+ *  @param argv   Set to the arguments, which point into pline.
+ *  @param max    Capacity of argv.
+ *  @return Argument count, or -1 if there are more than max or a quote is
+ *          not closed.
+ */
+int shell_tokenize(char *pline, char **argv, int max);
+
+//------------------------------------------------------------------------------
+// Output, for command handlers
+/** @brief Format into the Tx FIFO (see fmt_api.h); output that does not fit
+ *         is dropped.
+ *  @return Bytes queued.
+ */
+size_t shell_printf(shell_t *psh, const char *fmt, ...);
+/** @brief Queue bytes to the Tx FIFO. @return Bytes queued. */
+size_t shell_write(shell_t *psh, const char *pdata, size_t len);
+/** @brief Free Tx FIFO space, to size output chunks under SHELL_MORE. */
+size_t shell_tx_space(const shell_t *psh);
+/** @brief UART the shell runs on, e.g., for its diagnostics. */
+uart_t *shell_uart(const shell_t *psh);
+/** @brief Per-run word for a command's progress across SHELL_MORE calls;
+ *         0 on the first call of each run. */
+uint32_t *shell_state(shell_t *psh);
+
+//------------------------------------------------------------------------------
+/** @brief Built-in "help" handler listing the table; name it in the command
+ *         list, e.g., "help shell_cmd_help List commands".
+ */
+int shell_cmd_help(shell_t *psh, int argc, char **argv);
+
+#endif // INCLUDE_SHELL_API_H_
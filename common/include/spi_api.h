@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SPI_API_H_
+#define INCLUDE_SPI_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a portable SPI master API with a transaction queue,
+// implemented by a core (common/drivers/spi) over a run-time installed
+// backend, as for the UART.
+//
+// Transfers are full duplex and caller-owned: spi_submit() queues a
+// descriptor and returns at once; the backend moves the data (e.g., by DMA)
+// and the core calls the descriptor's done callback from the completion
+// interrupt. A transfer flagged SPI_XFER_CS_HOLD keeps chip select asserted
+// into the next one, and a backend with hw_link chains that next one onto
+// the running transfer, so they run back to back with no CPU in between.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file spi_api.h
+ *  @brief Portable queued SPI master API with an opaque handle.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Longest transfer in bytes (a DMA block). */
+#define SPI_XFER_MAX_BYTES   65535u
+/** @brief Byte clocked out for a transfer with no Tx buffer. */
+#define SPI_FILL_BYTE        0xFFu
+
+/** @brief Keep chip select asserted after this transfer, into the next. */
+#define SPI_XFER_CS_HOLD     (1u << 0)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Clock polarity and phase, numbered as usual (CPOL << 1 | CPHA). */
+typedef enum {
+    SPI_MODE_0 = 0,
+    SPI_MODE_1,
+    SPI_MODE_2,
+    SPI_MODE_3
+} spi_mode_t;
+
+/** @brief Where a transfer is; set by the core. */
+typedef enum {
+    /** @brief Not queued (initial state; set it before the first submit). */
+    SPI_XFER_IDLE = 0,
+    /** @brief Waiting for the bus. */
+    SPI_XFER_QUEUED,
+    /** @brief Handed to the backend. */
+    SPI_XFER_ACTIVE,
+    /** @brief Finished; Rx data is in place. */
+    SPI_XFER_DONE,
+    /** @brief Abandoned after a backend error; Rx data is incomplete. */
+    SPI_XFER_ERROR
+} spi_xfer_status_t;
+
+typedef struct spi_xfer_t spi_xfer_t;
+
+/** @brief Completion callback, called from the completion interrupt.
+ *  @param pctx  User context from the descriptor.
+ *  @param px    The finished transfer; it may be submitted again from here.
+ */
+typedef void (*spi_done_fn)(void *pctx, spi_xfer_t *px);
+
+/** @brief Transfer descriptor; caller-owned, left alone until it finishes. */
+struct spi_xfer_t {
+    /** @brief Bytes to send, or NULL to send SPI_FILL_BYTE. */
+    const uint8_t *ptx;
+    /** @brief Room for the bytes received, or NULL to discard them. */
+    uint8_t *prx;
+    /** @brief Bytes each way (1 to SPI_XFER_MAX_BYTES). */
+    size_t len;
+    /** @brief SPI_XFER_x flags. */
+    uint32_t flags;
+    /** @brief Called when finished (may be NULL). */
+    spi_done_fn done;
+    void *pctx;
+    /** @brief Set by the core. */
+    volatile spi_xfer_status_t status;
+};
+
+// Hardware API
+// Functions to be called by portable core
+/** @brief Virtual function table for a run-time installed SPI backend. */
+typedef struct {
+    /** @brief Initialize HW as master at no more than clock_hz. @return true on success. */
+    bool (*hw_init)(uint32_t clock_hz, spi_mode_t mode);
+    /** @brief Start a transfer on an idle bus, asserting chip select unless
+     *  the last transfer held it. @return false if busy. */
+    bool (*hw_start)(const spi_xfer_t *px);
+    /** @brief Number of transfers finished since the last call, oldest
+     *  first; chip select is released after one without SPI_XFER_CS_HOLD. */
+    size_t (*hw_poll_done)(void);
+    // Optional entries (may be NULL)
+    /** @brief Chain a transfer to run right after the last one started or
+     *  chained, without CPU; only called after an SPI_XFER_CS_HOLD transfer.
+     *  @return false if too late (the bus stopped) or no room. */
+    bool (*hw_link)(const spi_xfer_t *px);
+    /** @brief Read and clear a bus or DMA error; the transfers in progress
+     *  are abandoned and chip select released. */
+    bool (*hw_error)(void);
+    /** @brief Mask (true) or unmask the completion interrupt, so thread
+     *  context can update the queue the interrupt also runs. */
+    void (*hw_irq_mask)(bool masked);
+} spi_hw_vtable_t;
+
+/** @brief Totals since initialization. */
+typedef struct {
+    uint32_t submitted;     /**< Transfers accepted by spi_submit(). */
+    uint32_t completed;     /**< Finished with SPI_XFER_DONE. */
+    uint32_t failed;        /**< Finished with SPI_XFER_ERROR. */
+    uint32_t started;       /**< Handed over with hw_start (a bus start). */
+    uint32_t linked;        /**< Handed over with hw_link (no gap). */
+    uint32_t max_queued;    /**< Deepest the queue has been. */
+} spi_stats_t;
+
+/** @brief One-per-instance opaque handle */
+typedef struct spi_t spi_t;
+/** @brief Helper function to query spi_t size in bytes for one spi_t context's storage allocation. */
+size_t spi_context_size(void);
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Initialize an SPI instance.
+ *  @param ps        Opaque context pointer (caller-owned storage).
+ *  @param phw       Backend virtual function table (copied internally).
+ *  @param clock_hz  Highest bit rate the device takes.
+ *  @param mode      Clock polarity and phase.
+ *  @param pqueue    Queue storage: depth descriptor pointers (caller-provided).
+ *  @param depth     Queue depth, a power of two.
+ *  @return true on success.
+ */
+bool spi_init(
+    spi_t *ps,
+    const spi_hw_vtable_t *phw,
+    uint32_t clock_hz,
+    spi_mode_t mode,
+    spi_xfer_t **pqueue,
+    size_t depth);
+
+//------------------------------------------------------------------------------
+/** @brief Queue a transfer; it starts at once if the bus is free.
+ *  @param ps  Opaque context pointer.
+ *  @param px  Transfer, not already queued or in progress.
+ *  @return false if the queue is full or the descriptor is invalid.
+ */
+bool spi_submit(spi_t *ps, spi_xfer_t *px);
+
+//------------------------------------------------------------------------------
+/** @brief ISR: finish completed transfers and hand the next ones over.
+ *  Call from the backend's completion interrupt (or poll it).
+ *  @param ps  Opaque context pointer.
+ *  @return Transfers finished by this call.
+ */
+size_t spi_isr(spi_t *ps);
+
+//------------------------------------------------------------------------------
+/** @brief Transfers queued or in progress. */
+size_t spi_pending(const spi_t *ps);
+
+//------------------------------------------------------------------------------
+/** @brief Copy out the totals. */
+void spi_get_stats(const spi_t *ps, spi_stats_t *pstats);
+
+#endif // INCLUDE_SPI_API_H_
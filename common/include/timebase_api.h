@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TIMEBASE_API_H_
+#define INCLUDE_TIMEBASE_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a generic system timebase API that can be implemented
+// for various deployment contexts, e.g., execution on a target hardware device,
+// or unit testing on a development host. In the latter case, the
+// implementation will be a stub driven by a virtual clock.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file timebase_api.h
+ *  @brief Portable monotonic timebase: 64-bit tick and cycle counter.
+ */
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Hardware API
+// Functions to be called by portable core
+/** @brief Virtual function table for a run-time installed timebase backend. */
+typedef struct {
+    /** @brief Start the periodic tick interrupt at tick_hz. @return true on success. */
+    bool (*hw_init)(uint32_t tick_hz);
+    /** @brief Read the free-running cycle counter (wraps). */
+    uint32_t (*hw_cycles)(void);
+    /** @brief Frequency of the cycle counter in Hz. */
+    uint32_t (*hw_cycle_hz)(void);
+} timebase_hw_vtable_t;
+
+/** @brief Per-tick callback; Context: tick ISR, keep it short.
+ *  @param pctx  Context given to timebase_set_tick_hook.
+ *  @param tick  Low 32 bits of the tick count just reached.
+ */
+typedef void (*timebase_tick_fn)(void *pctx, uint32_t tick);
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Install a backend and start the tick.
+ *  @param phw      Backend virtual function table (copied internally).
+ *  @param tick_hz  Tick rate in Hz, e.g., 1000 for a 1 ms tick.
+ *  @return true on success.
+ */
+bool timebase_init(const timebase_hw_vtable_t *phw, uint32_t tick_hz);
+
+//------------------------------------------------------------------------------
+/** @brief Advance the tick by one; Context: tick ISR (SysTick) only.
+ *  @return void.
+ */
+void timebase_isr_tick(void);
+/** @brief Install a callback run from every tick, e.g., to post a timer event.
+ *  @param fn    Callback, or NULL to remove.
+ *  @param pctx  Context handed to fn.
+ *  @return void.
+ */
+void timebase_set_tick_hook(timebase_tick_fn fn, void *pctx);
+
+//------------------------------------------------------------------------------
+/** @brief Monotonic tick count since init; safe from any context.
+ *  @return Ticks, never wraps in practice (64-bit).
+ */
+uint64_t timebase_ticks(void);
+/** @brief Configured tick rate.
+ *  @return Ticks per second.
+ */
+uint32_t timebase_tick_hz(void);
+/** @brief Convert milliseconds to ticks, rounding up so delays are never short.
+ *  @param ms  Milliseconds.
+ *  @return Ticks.
+ */
+uint32_t timebase_ms_to_ticks(uint32_t ms);
+
+//------------------------------------------------------------------------------
+/** @brief Cycle-accurate timestamp for short interval measurement.
+ *  @return Free-running cycle count (wraps; subtract as uint32_t).
+ */
+uint32_t timebase_now(void);
+/** @brief Convert a cycle interval from timebase_now() to nanoseconds.
+ *  @param cycles  Interval in cycles.
+ *  @return Nanoseconds.
+ */
+uint64_t timebase_cycles_to_ns(uint32_t cycles);
+
+#endif // INCLUDE_TIMEBASE_API_H_
@@ -0,0 +1,69 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TRACE_API_H_
+#define INCLUDE_TRACE_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies trace points for timing hot paths from outside the
+// code, e.g., with a logic analyzer on reserved pins.
+//
+// Unless TRACE_ENABLE is defined, every macro expands to nothing. When it is,
+// the backend named by TRACE_BACKEND_H (default "trace_hw.h", found on the
+// platform include path) supplies static inline trace_backend_init(),
+// trace_backend_enter(id) and trace_backend_exit(id). On target these are one
+// GPIO store each; the host stub records timestamped events instead.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file trace_api.h
+ *  @brief Zero-cost-when-disabled trace points for hot-path timing.
+ */
+
+//------------------------------------------------------------------------------
+// Trace Point Identifiers
+//------------------------------------------------------------------------------
+
+/** @brief Trace points; each maps to its own channel (pin) in the backend. */
+typedef enum {
+    TRACE_UART_RX_BYTE = 0,  /**< uart_isr_rx_byte() */
+    TRACE_UART_SERVICE_TX,   /**< uart_service_tx() */
+    TRACE_UART_ECHO_PUMP,    /**< uart_echo_pump() */
+    TRACE_ID_APP_FIRST,      /**< First identifier free for applications. */
+} trace_id_t;
+
+//------------------------------------------------------------------------------
+// Trace Macros
+//------------------------------------------------------------------------------
+
+#ifdef TRACE_ENABLE
+
+#ifndef TRACE_BACKEND_H
+#define TRACE_BACKEND_H "trace_hw.h"
+#endif
+#include TRACE_BACKEND_H
+
+/** @brief Prepare the trace channels, e.g., configure the pins. */
+#define TRACE_INIT()      trace_backend_init()
+/** @brief Mark entry to a traced section (channel goes high). */
+#define TRACE_ENTER(id)   trace_backend_enter((uint32_t)(id))
+/** @brief Mark exit from a traced section (channel goes low). */
+#define TRACE_EXIT(id)    trace_backend_exit((uint32_t)(id))
+
+#else
+
+#define TRACE_INIT()      ((void)0)
+#define TRACE_ENTER(id)   ((void)0)
+#define TRACE_EXIT(id)    ((void)0)
+
+#endif // TRACE_ENABLE
+
+#endif // INCLUDE_TRACE_API_H_
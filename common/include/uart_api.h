@@ -30,6 +30,25 @@
 // Types
 //------------------------------------------------------------------------------
 
+// Rx line errors
+// Reported by a backend as a bit mask, counted per kind by the core
+/** @brief Kinds of Rx line error a backend may detect. */
+typedef enum {
+    /** @brief Byte(s) lost because the receiver was not read in time. */
+    UART_RX_ERR_OVERRUN = 0,
+    /** @brief Stop bit not detected (baud mismatch, break, line glitch). */
+    UART_RX_ERR_FRAMING,
+    /** @brief Noise detected on a received byte. */
+    UART_RX_ERR_NOISE,
+    /** @brief Parity check failed on a received byte. */
+    UART_RX_ERR_PARITY,
+    /** @brief Number of error kinds (not an error). */
+    UART_RX_ERR_KINDS
+} uart_rx_err_t;
+
+/** @brief Bit mask for one uart_rx_err_t kind, as returned by hw_rx_errors. */
+#define UART_RX_ERR_MASK(kind)  (1u << (kind))
+
 // Hardware API
 // Functions to be called by portable core
 /** @brief Virtual function table for a run-time installed UART backend. */
@@ -46,8 +65,29 @@ typedef struct {
     bool (*hw_rx_available)(void);
     /** @brief Read one byte from Rx (check if available first). */
     uint8_t (*hw_rx_read)(void);
+    // Optional entries (may be NULL)
+    /** @brief Read and clear latched Rx line errors. @return UART_RX_ERR_MASK() bits. */
+    uint32_t (*hw_rx_errors)(void);
+    /** @brief Arm the receiver timeout in character times (0 disables). @return true on success. */
+    bool (*hw_rx_timeout_config)(uint32_t char_times);
+    /** @brief Read and clear the receiver timeout (line silent) event. */
+    bool (*hw_rx_timeout_expired)(void);
+    /** @brief Read a free-running timer for Rx arrival timestamps (wraps). */
+    uint32_t (*hw_timestamp)(void);
+    // Block transfer design, preferred by the core over the per-byte entries:
+    // one call moves a whole contiguous FIFO segment
+    /** @brief Read up to max Rx bytes that are ready now. @return Bytes read. */
+    size_t (*hw_rx_read_block)(uint8_t *pdst, size_t max);
+    /** @brief Write up to len Tx bytes without blocking. @return Bytes accepted. */
+    size_t (*hw_tx_write_block)(const uint8_t *psrc, size_t len);
 } uart_hw_vtable_t;
 
+/** @brief Consumer wakeup for a batch of Rx data.
+ *  @param pctx       User context given to uart_set_rx_batching().
+ *  @param available  Bytes available in the Rx FIFO at notification time.
+ */
+typedef void (*uart_rx_notify_fn)(void *pctx, size_t available);
+
 /** @brief One-per-instance opaque handle */
 typedef struct uart_t uart_t;
 /** @brief Helper function to query uart_t size in bytes for one uart_t context's storage allocation. */
@@ -84,6 +124,37 @@ bool uart_init(
  */
  void uart_isr_rx_byte(uart_t *pu, uint8_t byte);
 
+//------------------------------------------------------------------------------
+/** @brief DMA/Idle Rx Variant: Push a block of inbound bytes as one batch.
+ *  @param pu     Opaque context pointer (caller-owned storage).
+ *  @param pdata  Bytes received.
+ *  @param len    Number of bytes received.
+ *  @return void.
+ */
+void uart_isr_rx_block(uart_t *pu, const uint8_t *pdata, size_t len);
+
+//------------------------------------------------------------------------------
+/** @brief ISR Rx Variant: Report Rx line errors detected by the backend.
+ *  @param pu        Opaque context pointer (caller-owned storage).
+ *  @param err_mask  UART_RX_ERR_MASK() bits for the errors detected.
+ *  @return void.
+ */
+void uart_isr_rx_error(uart_t *pu, uint32_t err_mask);
+
+//------------------------------------------------------------------------------
+/** @brief ISR Rx Variant: Report that the Rx line has gone silent.
+ *  @param pu    Opaque context pointer (caller-owned storage).
+ *  @return void.
+ */
+void uart_isr_rx_timeout(uart_t *pu);
+
+//------------------------------------------------------------------------------
+/** @brief Polling Rx Variant: Move all bytes and errors pending in HW to the core.
+ *  @param pu    Opaque context pointer (caller-owned storage).
+ *  @return Number of bytes read from HW.
+ */
+size_t uart_poll_rx(uart_t *pu);
+
 //------------------------------------------------------------------------------
 /** @brief Move queued Tx bytes to HW; Context: Main Loop or TX Empty ISR.
  *  @param pu    Opaque context pointer (caller-owned storage).
@@ -104,6 +175,11 @@ size_t uart_write(uart_t *pu, const uint8_t *pdata, size_t len);
  *  @return Size in bytes of data queued in Tx FIFO.
  */
 size_t uart_tx_queued(const uart_t *pu);
+/** @brief Get free space in Tx FIFO; Context: Application APIs.
+ *  @param pu     Opaque context pointer (caller-owned storage).
+ *  @return Size in bytes uart_write() can accept without truncating.
+ */
+size_t uart_tx_space(const uart_t *pu);
 /** @brief Check if Rx available, then read; Context: Polling Rx Variant.
  *  @param pu  Opaque context pointer (caller-owned storage).
  *  @return Size in bytes of Rx data available in FIFO for read.
@@ -116,6 +192,49 @@ size_t uart_rx_available(const uart_t *pu);
  *  @return Size in bytes of data read from Rx FIFO.
  */
 size_t uart_read(uart_t *pu, uint8_t *pout, size_t maxlen);
+/** @brief Read as uart_read(), also reporting when the data arrived.
+ *  @param pu      Opaque context pointer (caller-owned storage).
+ *  @param pout    User-owned buffer into which to read maxlen bytes.
+ *  @param maxlen  Maximum length to read in bytes.
+ *  @param pts     Set to the backend timestamp of the batch holding the first
+ *                 byte read, 0 if nothing was read or the backend has no
+ *                 timestamp source.
+ *  @return Size in bytes of data read from Rx FIFO.
+ */
+size_t uart_read_ts(uart_t *pu, uint8_t *pout, size_t maxlen, uint32_t *pts);
+/** @brief Get the arrival time of the next unread Rx byte (span consumers).
+ *  @param pu   Opaque context pointer (caller-owned storage).
+ *  @param pts  Set to the backend timestamp of the batch holding that byte.
+ *  @return false if the Rx FIFO is empty or no timestamp source exists.
+ */
+bool uart_rx_arrival(uart_t *pu, uint32_t *pts);
+
+//------------------------------------------------------------------------------
+// Span (in-place) access to the FIFOs
+/** @brief Get the next contiguous run of Rx FIFO data without copying it.
+ *  @param pu  Opaque context pointer (caller-owned storage).
+ *  @param pp  Set to the first byte of the run.
+ *  @return Length of the run in bytes, 0 if the Rx FIFO is empty.
+ */
+size_t uart_rx_peek(const uart_t *pu, const uint8_t **pp);
+/** @brief Release bytes obtained from uart_rx_peek().
+ *  @param pu  Opaque context pointer (caller-owned storage).
+ *  @param n   Bytes to release, at most the length peeked.
+ *  @return void.
+ */
+void uart_rx_consume(uart_t *pu, size_t n);
+/** @brief Get the next contiguous run of free Tx FIFO space to write in place.
+ *  @param pu  Opaque context pointer (caller-owned storage).
+ *  @param pp  Set to the first free byte of the run.
+ *  @return Length of the run in bytes, 0 if the Tx FIFO is full.
+ */
+size_t uart_tx_reserve(const uart_t *pu, uint8_t **pp);
+/** @brief Queue bytes written into a uart_tx_reserve() run and attempt a flush.
+ *  @param pu  Opaque context pointer (caller-owned storage).
+ *  @param n   Bytes to queue, at most the length reserved.
+ *  @return void.
+ */
+void uart_tx_commit(uart_t *pu, size_t n);
 
 //------------------------------------------------------------------------------
 /** @brief Echo helper: read data from Rx FIFO, write to Tx FIFO.
@@ -137,6 +256,53 @@ uint32_t uart_rx_overflow_count(const uart_t *pu);
  */
 void uart_rx_overflow_clear(uart_t *pu);
 
+//------------------------------------------------------------------------------
+// Line Error Diagnostics
+/** @brief Get number of Rx line errors of one kind seen by this instance.
+ *  @param pu    Opaque context pointer (caller-owned storage).
+ *  @param kind  Error kind to query.
+ *  @return Number of errors of that kind since init or last clear.
+ */
+uint32_t uart_rx_error_count(const uart_t *pu, uart_rx_err_t kind);
+/** @brief Clear all Rx line error counters and any pending corrupt mark.
+ *  @param pu    Opaque context pointer (caller-owned storage).
+ *  @return void.
+ */
+void uart_rx_error_clear(uart_t *pu);
+/** @brief Enable marking of Rx data as corrupt when a line error is reported.
+ *  @param pu      Opaque context pointer (caller-owned storage).
+ *  @param enable  true to latch errors until taken with uart_rx_error_take().
+ *  @return void.
+ */
+void uart_set_rx_error_marking(uart_t *pu, bool enable);
+/** @brief Take (read and clear) the errors latched since the last take.
+ *         A non-zero result means the frame being assembled by the
+ *         consumer is corrupt and should be discarded.
+ *  @param pu    Opaque context pointer (caller-owned storage).
+ *  @return UART_RX_ERR_MASK() bits, 0 if none or marking is disabled.
+ */
+uint32_t uart_rx_error_take(uart_t *pu);
+
+//------------------------------------------------------------------------------
+// Batched Rx Delivery
+/** @brief Deliver Rx data to the consumer in batches instead of per byte.
+ *         The notifier runs once every threshold bytes and once when the
+ *         line has been silent for timeout_chars character times.
+ *  @param pu             Opaque context pointer (caller-owned storage).
+ *  @param threshold      Bytes per batch before notifying (0 = timeout only).
+ *  @param timeout_chars  Line silence in character times (0 = threshold only).
+ *  @param notify         Consumer wakeup, NULL disables batching.
+ *  @param pctx           User context passed to notify.
+ *  @return false if a timeout is requested with a notify but the backend
+ *          cannot provide it.
+ */
+bool uart_set_rx_batching(
+    uart_t *pu,
+    size_t threshold,
+    uint32_t timeout_chars,
+    uart_rx_notify_fn notify,
+    void *pctx);
+
 //------------------------------------------------------------------------------
 // Override Drain Chunk Size
 /** @brief Tune the number of bytes to drain (echo) from Rx to Tx.
@@ -0,0 +1,175 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_XFER_API_H_
+#define INCLUDE_XFER_API_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies a reliable, in-order segment stream over a uart_t,
+// for bulk transfers: a selective-repeat sliding window on frame_api.h frames
+// (COBS + CRC-16).
+//
+// The sender keeps up to `window` segments in flight. The receiver buffers
+// segments that arrive out of order, delivers them in order and answers with
+// a cumulative ACK (next sequence number expected), a bitmap of the segments
+// received beyond it and its own window. Only the missing segments are sent
+// again:
+//    - a UART link keeps bytes in order, so an unacknowledged segment sent
+//      before one that has been acknowledged was lost, and is resent at once
+//    - if nothing is acknowledged for rto ticks (lost ACKs, or the last
+//      segment lost), the oldest segment is resent
+//
+// A zero-length segment marks the end of a transfer (xfer_send_end()); the
+// receiver's callback then gets len 0. Both ends run the same code, and a
+// link may carry transfers in both directions at once.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "frame_api.h"
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Doxygen Brief
+//------------------------------------------------------------------------------
+
+/** @file xfer_api.h
+ *  @brief Selective-repeat sliding-window transfer over framed UART.
+ */
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+/** @brief Largest segment payload; one slot of each window holds this much. */
+#ifndef XFER_SEG_MAX
+#define XFER_SEG_MAX     240u
+#endif
+
+/** @brief Largest window, in segments (the ACK bitmap covers a window). */
+#define XFER_WINDOW_MAX  32u
+
+/** @brief Segment header: type, 16-bit sequence number. */
+#define XFER_HDR_BYTES   3u
+
+/** @brief ACK payload: type, cumulative ACK, bitmap, window. */
+#define XFER_ACK_BYTES   8u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+/** @brief Time source, any tick; rto is in the same ticks. */
+typedef uint32_t (*xfer_time_fn)(void);
+
+/** @brief In-order delivery of one received segment.
+ *  @param pctx   User context given to xfer_init().
+ *  @param pdata  Segment payload, valid only during the call; NULL at end.
+ *  @param len    Payload length, 0 for the end-of-transfer mark.
+ */
+typedef void (*xfer_rx_fn)(void *pctx, const uint8_t *pdata, size_t len);
+
+/** @brief One segment buffer; each window is an array of these
+ *         (caller-owned). */
+typedef struct {
+    uint16_t seq;
+    uint16_t len;
+    uint8_t  state;
+    // Sender: when and in which order the segment was last transmitted
+    uint32_t sent_at;
+    uint32_t stamp;
+    // Frame payload: header, then the segment data
+    uint8_t  frame[XFER_HDR_BYTES + XFER_SEG_MAX];
+} xfer_slot_t;
+
+/** @brief Configuration. */
+typedef struct {
+    /** @brief Segments in flight and buffered out of order (1 to
+     *         XFER_WINDOW_MAX); 1 is stop-and-wait. */
+    uint32_t     window;
+    /** @brief Retransmission timeout in time source ticks; allow for the
+     *         Tx FIFO to drain plus a round trip. */
+    uint32_t     rto;
+    xfer_time_fn now;
+} xfer_config_t;
+
+/** @brief Counters. */
+typedef struct {
+    uint32_t segs_sent;    /**< Data segments transmitted, resends included. */
+    uint32_t resent_lost;  /**< Resends of segments found lost from ACKs. */
+    uint32_t resent_rto;   /**< Resends after a retransmission timeout. */
+    uint32_t segs_rcvd;    /**< Data segments delivered. */
+    uint32_t dups;         /**< Data segments already received or out of
+                                the window, discarded. */
+    uint32_t acks_sent;
+    uint32_t acks_rcvd;
+} xfer_stats_t;
+
+/** @brief One endpoint; treat as opaque. */
+typedef struct {
+    uart_t          *pu;
+    xfer_config_t   cfg;
+    // Sender: oldest unacknowledged, next to queue (the wire carries the
+    // low 16 bits), window the peer offers, transmission order
+    xfer_slot_t     *ptx;
+    uint32_t        base;
+    uint32_t        next;
+    uint32_t        peer_window;
+    uint32_t        stamp;
+    uint32_t        acked_stamp;
+    // Receiver: next in order, ACK owed
+    xfer_slot_t     *prx;
+    uint32_t        expected;
+    bool            ack_due;
+    xfer_rx_fn      on_rx;
+    void            *pctx;
+    frame_decoder_t dec;
+    uint8_t         dec_buf[FRAME_DECODE_BUF(XFER_HDR_BYTES + XFER_SEG_MAX)];
+    /** @brief Counters. */
+    xfer_stats_t    stats;
+} xfer_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+/** @brief Initialize an endpoint.
+ *  @param px     Endpoint (caller-owned).
+ *  @param pu     UART carrying the link (xfer owns its Rx data).
+ *  @param ptx    Send window, cfg.window slots.
+ *  @param prx    Receive window, cfg.window slots.
+ *  @param pcfg   Configuration (copied).
+ *  @param on_rx  Delivery callback for received segments.
+ *  @param pctx   User context passed to on_rx.
+ *  @return true on success.
+ */
+bool xfer_init(xfer_t *px, uart_t *pu, xfer_slot_t *ptx, xfer_slot_t *prx,
+    const xfer_config_t *pcfg, xfer_rx_fn on_rx, void *pctx);
+
+//------------------------------------------------------------------------------
+/** @brief Queue one segment for sending.
+ *  @param px     Endpoint.
+ *  @param pdata  Bytes to send.
+ *  @param len    Bytes offered; at most XFER_SEG_MAX are taken.
+ *  @return Bytes taken, 0 if the send window is full.
+ */
+size_t xfer_send(xfer_t *px, const uint8_t *pdata, size_t len);
+/** @brief Queue the end-of-transfer mark. @return false if the window is full. */
+bool xfer_send_end(xfer_t *px);
+/** @brief Segments xfer_send() can take now. */
+size_t xfer_send_space(const xfer_t *px);
+/** @brief Whether every queued segment has been acknowledged. */
+bool xfer_idle(const xfer_t *px);
+
+//------------------------------------------------------------------------------
+/** @brief Receive, acknowledge and (re)transmit; Context: Main Loop.
+ *         Frames are queued only when the Tx FIFO has room for all of them.
+ *  @param px  Endpoint.
+ *  @return void.
+ */
+void xfer_poll(xfer_t *px);
+
+#endif // INCLUDE_XFER_API_H_
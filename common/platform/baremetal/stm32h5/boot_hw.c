@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the STM32H5 jump from the bootloader to the application
+//
+//------------------------------------------------------------------------------
+
+#include "boot_hw.h"
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void boot_hw_jump(uint32_t app_base) {
+    __asm volatile ("cpsid i" ::: "memory");
+
+    // Nothing of the bootloader may fire once the application runs
+    REG32(SYST_CSR_ADDR) = 0u;
+    for (uint32_t i = 0; i < NVIC_REG_COUNT; ++i) {
+        REG32(NVIC_ICER_ADDR + 4u * i) = 0xFFFFFFFFu;
+        REG32(NVIC_ICPR_ADDR + 4u * i) = 0xFFFFFFFFu;
+    }
+
+    REG32(SCB_VTOR_ADDR) = app_base;
+    uint32_t sp = REG32(app_base);
+    uint32_t pc = REG32(app_base + 4u);
+    __asm volatile (
+        "dsb\n"
+        "isb\n"
+        "msr msp, %0\n"
+        "cpsie i\n"
+        "bx %1\n"
+        : : "r" (sp), "r" (pc) : "memory");
+    for (;;) {
+    }
+}
@@ -0,0 +1,26 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_BOOT_HW_H_
+#define INCLUDE_BOOT_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the STM32H5 hand-over from the bootloader to the
+// application.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Start the application whose vector table is at app_base, as if from reset:
+// interrupts disabled and cleared, SysTick stopped, VTOR moved, then the
+// stack pointer and entry point loaded from the table; does not return
+void boot_hw_jump(uint32_t app_base);
+
+#endif // INCLUDE_BOOT_HW_H_
@@ -0,0 +1,261 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the functionality to install and initialize the STM32H5
+// DMA hardware
+//
+// Each block of a chain is one GPDMA linked-list item that reloads the
+// transfer settings, block size, both addresses and the link to the next
+// item; a ring's last item links back to its first. A channel starts with
+// an empty block and its link register on the first item, so it loads that
+// item before it moves any data. The channel raises transfer complete at
+// the end of every block, and the item its link register points at tells
+// which block it is on.
+//
+// Notes:
+//    - Every channel's items sit in one aligned block, so they share the
+//      64 KiB region CLBAR selects
+//    - The block starts with a spare word: an item at the start of the region
+//      would have a null link address, which ends the list instead
+//    - Data addresses go through DMA_BUS_ADDR(), so the host model can run
+//      the same lists
+//
+//------------------------------------------------------------------------------
+
+#include "dma_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define DMA_CH_REG(ch, offset)  REG32(GPDMA1_BASE + GPDMA_CH_OFFSET(ch) + (offset))
+
+// Registers each item reloads
+#define LLI_UPDATE  (GPDMA_CLLR_UT1 | GPDMA_CLLR_UB1 | GPDMA_CLLR_USA | \
+    GPDMA_CLLR_UDA | GPDMA_CLLR_ULL)
+
+#define DMA_IRQ_EN  (GPDMA_CCR_TCIE | GPDMA_CCR_DTEIE | GPDMA_CCR_ULEIE | \
+    GPDMA_CCR_USEIE)
+
+// Storage for every channel's items, a power of two to align it to
+#define LLI_POOL_ALIGN  2048u
+
+_Static_assert(DMA_MAX_CHANNELS <= GPDMA1_CHANNELS,
+    "more channels allocated than GPDMA1 has");
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// GPDMA linked-list item, in the order the channel reads it for LLI_UPDATE
+typedef struct {
+    uint32_t ctr1;
+    uint32_t cbr1;
+    uint32_t csar;
+    uint32_t cdar;
+    uint32_t cllr;
+} dma_lli_t;
+
+typedef struct {
+    uint32_t reserved;
+    dma_lli_t lli[DMA_MAX_CHANNELS][DMA_CHAIN_MAX];
+} dma_pool_t;
+
+typedef struct {
+    uint32_t ctr2;
+    uint32_t n;
+} dma_chan_t;
+
+_Static_assert(sizeof(dma_pool_t) <= LLI_POOL_ALIGN,
+    "LLI_POOL_ALIGN too small for the item pool");
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Read by the channels as they move from one block to the next
+static dma_pool_t s_pool __attribute__((aligned(LLI_POOL_ALIGN)));
+static dma_chan_t s_chan[DMA_MAX_CHANNELS];
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper for the CLLR value that loads an item next
+static inline uint32_t lli_link(const dma_lli_t *plli) {
+    return LLI_UPDATE | (DMA_BUS_ADDR(plli) & GPDMA_CLLR_LA_MASK);
+}
+
+//------------------------------------------------------------------------------
+// Helper to stop a channel, whatever it is doing
+// Returns false, with the channel left as it is, if it does not suspend
+static bool channel_stop(uint32_t ch) {
+    if (DMA_CH_REG(ch, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN) {
+        DMA_CH_REG(ch, GPDMA_CCR_OFFSET) |= GPDMA_CCR_SUSP;
+        uint32_t polls = 0;
+        while (!(DMA_CH_REG(ch, GPDMA_CSR_OFFSET) &
+                (GPDMA_CSR_SUSPF | GPDMA_CSR_IDLEF))) {
+            if (++polls >= GPDMA_SUSPEND_POLLS) {
+                return false;
+            }
+        }
+        DMA_CH_REG(ch, GPDMA_CCR_OFFSET) = GPDMA_CCR_RESET;
+    }
+    DMA_CH_REG(ch, GPDMA_CFCR_OFFSET) = GPDMA_CFCR_ALL;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_init(void) {
+    DMA_HW_EnableClocks();
+    bool stopped = true;
+    for (uint32_t ch = 0; ch < DMA_MAX_CHANNELS; ch++) {
+        stopped = channel_stop(ch) && stopped;
+        s_chan[ch] = (dma_chan_t){ 0 };
+    }
+    return stopped;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_load(uint32_t ch, const dma_config_t *pcfg,
+        const dma_block_t *pblocks, size_t n, bool ring) {
+    if (ch >= DMA_MAX_CHANNELS || n > DMA_CHAIN_MAX ||
+            (DMA_CH_REG(ch, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN)) {
+        return false;
+    }
+    uint32_t width = ((uint32_t)pcfg->width << GPDMA_CTR1_SDW_SHIFT) |
+        ((uint32_t)pcfg->width << GPDMA_CTR1_DDW_SHIFT);
+    uint32_t periph = DMA_BUS_ADDR(pcfg->pperiph);
+
+    for (size_t i = 0; i < n; i++) {
+        const dma_block_t *pb = &pblocks[i];
+        dma_lli_t *pl = &s_pool.lli[ch][i];
+        bool inc = !(pb->flags & DMA_BLOCK_FIXED);
+        switch (pcfg->dir) {
+        case DMA_DIR_MEM_TO_PERIPH:
+            pl->ctr1 = width | (inc ? GPDMA_CTR1_SINC : 0u);
+            pl->csar = DMA_BUS_ADDR(pb->psrc);
+            pl->cdar = periph;
+            break;
+        case DMA_DIR_PERIPH_TO_MEM:
+            pl->ctr1 = width | (inc ? GPDMA_CTR1_DINC : 0u);
+            pl->csar = periph;
+            pl->cdar = DMA_BUS_ADDR(pb->pdst);
+            break;
+        default:
+            // A fixed source fills the destination
+            pl->ctr1 = width | GPDMA_CTR1_DINC | (inc ? GPDMA_CTR1_SINC : 0u);
+            pl->csar = DMA_BUS_ADDR(pb->psrc);
+            pl->cdar = DMA_BUS_ADDR(pb->pdst);
+            break;
+        }
+        pl->cbr1 = pb->len & GPDMA_CBR1_BNDT_MASK;
+        if (i + 1u < n) {
+            pl->cllr = lli_link(&s_pool.lli[ch][i + 1u]);
+        } else {
+            pl->cllr = ring ? lli_link(&s_pool.lli[ch][0]) : 0u;
+        }
+    }
+
+    uint32_t ctr2;
+    if (pcfg->dir == DMA_DIR_MEM_TO_MEM) {
+        ctr2 = GPDMA_CTR2_SWREQ;
+    } else {
+        ctr2 = (pcfg->request & GPDMA_CTR2_REQSEL_MASK) |
+            ((pcfg->dir == DMA_DIR_MEM_TO_PERIPH) ? GPDMA_CTR2_DREQ : 0u);
+    }
+    s_chan[ch] = (dma_chan_t){ .ctr2 = ctr2 | GPDMA_CTR2_TCEM_BLOCK, .n = (uint32_t)n };
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Notes:
+//    - With a null block size the channel loads the first item before it
+//      transfers anything
+static bool hw_start(uint32_t ch, bool irq) {
+    if (ch >= DMA_MAX_CHANNELS || s_chan[ch].n == 0u ||
+            (DMA_CH_REG(ch, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN)) {
+        return false;
+    }
+    DMA_CH_REG(ch, GPDMA_CFCR_OFFSET) = GPDMA_CFCR_ALL;
+    DMA_CH_REG(ch, GPDMA_CLBAR_OFFSET) =
+        DMA_BUS_ADDR(&s_pool.lli[ch][0]) & GPDMA_CLBAR_LBA_MASK;
+    DMA_CH_REG(ch, GPDMA_CTR1_OFFSET) = 0u;
+    DMA_CH_REG(ch, GPDMA_CTR2_OFFSET) = s_chan[ch].ctr2;
+    DMA_CH_REG(ch, GPDMA_CBR1_OFFSET) = 0u;
+    DMA_CH_REG(ch, GPDMA_CSAR_OFFSET) = 0u;
+    DMA_CH_REG(ch, GPDMA_CDAR_OFFSET) = 0u;
+    DMA_CH_REG(ch, GPDMA_CLLR_OFFSET) = lli_link(&s_pool.lli[ch][0]);
+    DMA_CH_REG(ch, GPDMA_CCR_OFFSET) = (irq ? DMA_IRQ_EN : 0u) | GPDMA_CCR_EN;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_stop(uint32_t ch) {
+    return (ch < DMA_MAX_CHANNELS) && channel_stop(ch);
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_poll(uint32_t ch) {
+    uint32_t csr = DMA_CH_REG(ch, GPDMA_CSR_OFFSET);
+    DMA_CH_REG(ch, GPDMA_CFCR_OFFSET) = GPDMA_CSR_TCF | GPDMA_CSR_ERRORS;
+    return ((csr & GPDMA_CSR_TCF) ? DMA_EV_BLOCK : 0u) |
+        ((csr & GPDMA_CSR_ERRORS) ? DMA_EV_ERROR : 0u);
+}
+
+//------------------------------------------------------------------------------
+static bool hw_position(uint32_t ch, uint32_t *pblock, uint32_t *premaining) {
+    if (!(DMA_CH_REG(ch, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN)) {
+        // The channel disables itself after the last block
+        return false;
+    }
+    uint32_t n = s_chan[ch].n;
+    uint32_t cllr = DMA_CH_REG(ch, GPDMA_CLLR_OFFSET);
+    *premaining = DMA_CH_REG(ch, GPDMA_CBR1_OFFSET) & GPDMA_CBR1_BNDT_MASK;
+    if (!(cllr & GPDMA_CLLR_LA_MASK)) {
+        // On the last block of a linear chain
+        *pblock = n - 1u;
+    } else {
+        // On the block before the one the link points at
+        uint32_t next = ((cllr & GPDMA_CLLR_LA_MASK) -
+            (DMA_BUS_ADDR(&s_pool.lli[ch][0]) & GPDMA_CLLR_LA_MASK)) /
+            (uint32_t)sizeof(dma_lli_t);
+        *pblock = (next + n - 1u) % n;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static void hw_irq_enable(uint32_t ch, bool enable) {
+    if (enable) {
+        NVIC_EnableIRQn(GPDMA1_CH0_IRQN + ch);
+    } else {
+        NVIC_DisableIRQn(GPDMA1_CH0_IRQN + ch);
+    }
+}
+
+//------------------------------------------------------------------------------
+void dma_hw_install(dma_hw_vtable_t *pv) {
+    pv->hw_init = hw_init;
+    pv->hw_load = hw_load;
+    pv->hw_start = hw_start;
+    pv->hw_stop = hw_stop;
+    pv->hw_poll = hw_poll;
+    pv->hw_position = hw_position;
+    pv->hw_irq_enable = hw_irq_enable;
+}
+
+//------------------------------------------------------------------------------
+// Interrupt Service Routines
+//------------------------------------------------------------------------------
+// Every channel's interrupt goes to its owner through the allocator
+void GPDMA1_Channel0_IRQHandler(void) { dma_isr(0u); }
+void GPDMA1_Channel1_IRQHandler(void) { dma_isr(1u); }
+void GPDMA1_Channel2_IRQHandler(void) { dma_isr(2u); }
+void GPDMA1_Channel3_IRQHandler(void) { dma_isr(3u); }
+void GPDMA1_Channel4_IRQHandler(void) { dma_isr(4u); }
+void GPDMA1_Channel5_IRQHandler(void) { dma_isr(5u); }
+void GPDMA1_Channel6_IRQHandler(void) { dma_isr(6u); }
+void GPDMA1_Channel7_IRQHandler(void) { dma_isr(7u); }
@@ -0,0 +1,23 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_DMA_HW_H_
+#define INCLUDE_DMA_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the STM32H5 DMA backend: GPDMA1 channels running
+// linked lists, with each channel's interrupt routed to dma_isr().
+//
+//------------------------------------------------------------------------------
+
+#include "dma_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void dma_hw_install(dma_hw_vtable_t *pv);
+
+#endif // INCLUDE_DMA_HW_H_
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the STM32H5 embedded flash backend: sector erase and
+// 128-bit programming through the non-secure registers, started here and
+// finished by the controller while the caller goes on
+//
+// Notes:
+//    - Programming: with PG set, four word stores to one quad-word fill the
+//      write buffer and the controller starts on the fourth
+//    - Code fetched from a bank being written stalls until the operation
+//      ends; a caller running from that bank sees its interrupts delayed by
+//      up to one quad-word (tens of us) or one erase (milliseconds)
+//
+//------------------------------------------------------------------------------
+
+#include "flash_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define FLASH_REG(off)  REG32(FLASH_REGS_BASE + (off))
+
+#define FLASH_SR_ACTIVE (FLASH_SR_BSY | FLASH_SR_WBNE | FLASH_SR_DBNE)
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static inline bool in_flash(uint32_t addr, uint32_t len) {
+    return addr >= FLASH_MEM_BASE && (addr - FLASH_MEM_BASE) <= FLASH_MEM_BYTES - len;
+}
+
+//------------------------------------------------------------------------------
+// An operation can start: unlocked and idle
+static bool ready(void) {
+    return (FLASH_REG(FLASH_NSCR_OFFSET) & FLASH_CR_LOCK) == 0u &&
+        (FLASH_REG(FLASH_NSSR_OFFSET) & FLASH_SR_ACTIVE) == 0u;
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+static bool hw_unlock(void) {
+    if (FLASH_REG(FLASH_NSCR_OFFSET) & FLASH_CR_LOCK) {
+        FLASH_REG(FLASH_NSKEYR_OFFSET) = FLASH_KEY1;
+        FLASH_REG(FLASH_NSKEYR_OFFSET) = FLASH_KEY2;
+    }
+    return (FLASH_REG(FLASH_NSCR_OFFSET) & FLASH_CR_LOCK) == 0u;
+}
+
+//------------------------------------------------------------------------------
+static void hw_lock(void) {
+    FLASH_REG(FLASH_NSCR_OFFSET) = FLASH_CR_LOCK;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_erase_start(uint32_t addr) {
+    if (!in_flash(addr, 1u) || !ready()) {
+        return false;
+    }
+    uint32_t off = addr - FLASH_MEM_BASE;
+    uint32_t sector = (off % FLASH_BANK_BYTES) / FLASH_SECTOR_BYTES;
+    uint32_t cr = FLASH_CR_SER | (sector << FLASH_CR_SNB_SHIFT) |
+        ((off >= FLASH_BANK_BYTES) ? FLASH_CR_BKSEL : 0u);
+    // Select, then start in a second write
+    FLASH_REG(FLASH_NSCR_OFFSET) = cr;
+    FLASH_REG(FLASH_NSCR_OFFSET) = cr | FLASH_CR_STRT;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_program_start(uint32_t addr, const uint32_t *pqw) {
+    if ((addr % FLASH_QWORD_BYTES) != 0u || !in_flash(addr, FLASH_QWORD_BYTES) ||
+            !ready()) {
+        return false;
+    }
+    FLASH_REG(FLASH_NSCR_OFFSET) = FLASH_CR_PG;
+    for (uint32_t i = 0; i < FLASH_QWORD_WORDS; ++i) {
+        FLASH_STORE32(addr + 4u * i, pqw[i]);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static int hw_status(void) {
+    uint32_t sr = FLASH_REG(FLASH_NSSR_OFFSET);
+    if (sr & FLASH_SR_ACTIVE) {
+        return FLASH_BUSY;
+    }
+    if (sr & FLASH_SR_ERRORS) {
+        FLASH_REG(FLASH_NSCCR_OFFSET) = sr & (FLASH_SR_ERRORS | FLASH_SR_EOP);
+        return FLASH_ERROR;
+    }
+    if (sr & FLASH_SR_EOP) {
+        FLASH_REG(FLASH_NSCCR_OFFSET) = FLASH_SR_EOP;
+    }
+    return FLASH_OK;
+}
+
+//------------------------------------------------------------------------------
+// Aligned word reads only, as the host model resolves REG32() per word
+static void hw_read(uint32_t addr, uint8_t *pdst, size_t len) {
+    while (len) {
+        uint32_t word = REG32(addr & ~3u);
+        uint32_t skip = addr & 3u;
+        uint32_t n = 4u - skip;
+        if (n > len) {
+            n = (uint32_t)len;
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            *pdst++ = (uint8_t)(word >> (8u * (skip + i)));
+        }
+        addr += n;
+        len -= n;
+    }
+}
+
+//------------------------------------------------------------------------------
+void flash_hw_install(flash_hw_vtable_t *pv) {
+    pv->hw_unlock = hw_unlock;
+    pv->hw_lock = hw_lock;
+    pv->hw_erase_start = hw_erase_start;
+    pv->hw_program_start = hw_program_start;
+    pv->hw_status = hw_status;
+    pv->hw_read = hw_read;
+    pv->sector_bytes = FLASH_SECTOR_BYTES;
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_FLASH_HW_H_
+#define INCLUDE_FLASH_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the STM32H5 embedded flash backend (non-secure
+// registers, both banks addressed as one range).
+//
+//------------------------------------------------------------------------------
+
+#include "flash_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void flash_hw_install(flash_hw_vtable_t *pv);
+
+#endif // INCLUDE_FLASH_HW_H_
@@ -7,10 +7,14 @@
 // This module defines the common GPIO API for a bare metal implementation on an
 // STM32H5 platform.
 //
+// All writes go through BSRR: a single store sets and resets any pins of the
+// port, so no read-modify-write of ODR can race with an ISR touching other
+// pins of the same port.
+//
 //------------------------------------------------------------------------------
 
 #include "gpio_api.h"
-#include "platform_config.h"
+#include "gpio_hw.h"
 
 //------------------------------------------------------------------------------
 // API Instantiation
@@ -21,34 +25,42 @@ gpio_api_t gpio;
 //------------------------------------------------------------------------------
 // Function Definitions
 //------------------------------------------------------------------------------
-void gpio_write(uint32_t pin, uint8_t value) {
-    if (value) {
-        // Set pin value
-        GPIOB_ODR |= (1U << pin);
-    } else {
-        // Clear pin value
-        GPIOB_ODR &= ~(1U << pin);
-    }
+bool gpio_configure(gpio_pin_t pin, const gpio_config_t *pcfg) {
+    return gpio_hw_configure(pin, pcfg);
 }
 
 //------------------------------------------------------------------------------
-void gpio_toggle(uint32_t pin) {
-    GPIOB_ODR ^= (1U << pin);
+void gpio_write(gpio_pin_t pin, uint8_t value) {
+    gpio_hw_write(pin, value);
 }
 
 //------------------------------------------------------------------------------
-void gpio_init(void) {
-    // Enable GPIOB Clock (pin 1 in RCC) 
-    RCC_AHB4ENR |= (1 << 1);
+void gpio_toggle(gpio_pin_t pin) {
+    gpio_hw_toggle(pin);
+}
 
-    // Configure PB0 as output
-    //
-    // Clear mode pin 0 (bits 0..1)
-    GPIOB_MODER &= ~(3U);
-    // Set mode to output
-    GPIOB_MODER |= (1U);
+//------------------------------------------------------------------------------
+void gpio_write_mask(gpio_port_t port, uint32_t mask, uint32_t value) {
+    gpio_hw_write_mask(port, mask, value);
+}
 
+//------------------------------------------------------------------------------
+void gpio_set_mask(gpio_port_t port, uint32_t mask) {
+    gpio_hw_set_mask(port, mask);
+}
+
+//------------------------------------------------------------------------------
+void gpio_clear_mask(gpio_port_t port, uint32_t mask) {
+    gpio_hw_clear_mask(port, mask);
+}
+
+//------------------------------------------------------------------------------
+void gpio_init(void) {
     // Install API implementation
-    gpio.write  = gpio_write;
-    gpio.toggle = gpio_toggle;
+    gpio.configure  = gpio_configure;
+    gpio.write      = gpio_write;
+    gpio.toggle     = gpio_toggle;
+    gpio.write_mask = gpio_write_mask;
+    gpio.set_mask   = gpio_set_mask;
+    gpio.clear_mask = gpio_clear_mask;
 }
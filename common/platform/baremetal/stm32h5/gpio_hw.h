@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_GPIO_HW_H_
+#define INCLUDE_GPIO_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header defines the STM32H5 GPIO register operations behind gpio_api.h.
+//
+// Ports are evenly spaced from GPIOA, so a pin descriptor maps to its
+// registers by arithmetic alone. The operations are static inline: with a
+// constant descriptor they fold to stores at constant addresses, which lets
+// drivers (e.g., uart_hw.c) configure pins without going through gpio_api_t.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define GPIO_HW_PORT_BASE(port)  (GPIOA_BASE + (uintptr_t)(port) * GPIO_PORT_STRIDE)
+#define GPIO_HW_REG(port, off)   REG32(GPIO_HW_PORT_BASE(port) + (off))
+
+// Two-bit fields (MODER, OSPEEDR, PUPDR) and four-bit AF fields of a pin
+#define GPIO_HW_FIELD2(pin)      (0x3u << ((pin) * 2u))
+#define GPIO_HW_AFR_OFFSET(pin)  (((pin) < 8u) ? GPIO_AFRL_OFFSET : GPIO_AFRH_OFFSET)
+#define GPIO_HW_AF_SHIFT(pin)    (((pin) % 8u) * 4u)
+
+// Portable enums are defined in register encoding order
+_Static_assert(GPIO_MODE_AF == GPIO_MODER_AF, "gpio_mode_t must match MODER");
+_Static_assert(GPIO_SPEED_HIGH == GPIO_OSPEED_HI, "gpio_speed_t must match OSPEEDR");
+_Static_assert(GPIO_PULL_UP == GPIO_PUPDR_PU, "gpio_pull_t must match PUPDR");
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to replace one bit field of a configuration register
+static inline void gpio_hw_field(
+        gpio_port_t port, uint32_t offset, uint32_t mask, uint32_t value) {
+    GPIO_HW_REG(port, offset) = (GPIO_HW_REG(port, offset) & ~mask) | value;
+}
+
+//------------------------------------------------------------------------------
+static inline bool gpio_hw_configure(gpio_pin_t pin, const gpio_config_t *pcfg) {
+    gpio_port_t port = GPIO_PIN_PORT(pin);
+    uint32_t n = GPIO_PIN_NUM(pin);
+    if (port >= GPIO_PORT_COUNT || !pcfg) {
+        return false;
+    }
+
+    REG32(RCC_AHB2ENR_ADDR) |= RCC_EN_GPIO(port);
+    (void)REG32(RCC_AHB2ENR_ADDR);
+
+    // AF number before mode, so the pin never drives a stale function
+    if (pcfg->mode == GPIO_MODE_AF) {
+        gpio_hw_field(port, GPIO_HW_AFR_OFFSET(n), 0xFu << GPIO_HW_AF_SHIFT(n),
+            ((uint32_t)pcfg->af & 0xFu) << GPIO_HW_AF_SHIFT(n));
+    }
+    gpio_hw_field(port, GPIO_OTYPER_OFFSET, 1u << n, (uint32_t)pcfg->otype << n);
+    gpio_hw_field(port, GPIO_OSPEEDR_OFFSET, GPIO_HW_FIELD2(n),
+        (uint32_t)pcfg->speed << (n * 2u));
+    gpio_hw_field(port, GPIO_PUPDR_OFFSET, GPIO_HW_FIELD2(n),
+        (uint32_t)pcfg->pull << (n * 2u));
+    gpio_hw_field(port, GPIO_MODER_OFFSET, GPIO_HW_FIELD2(n),
+        (uint32_t)pcfg->mode << (n * 2u));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static inline void gpio_hw_write(gpio_pin_t pin, uint8_t value) {
+    uint32_t bit = GPIO_PIN_MASK(pin);
+    GPIO_HW_REG(GPIO_PIN_PORT(pin), GPIO_BSRR_OFFSET) =
+        value ? GPIO_BSRR(bit, 0u) : GPIO_BSRR(0u, bit);
+}
+
+//------------------------------------------------------------------------------
+static inline void gpio_hw_toggle(gpio_pin_t pin) {
+    // Only the state of this pin is read; the store cannot disturb others
+    uint32_t bit = GPIO_PIN_MASK(pin);
+    uint32_t odr = GPIO_HW_REG(GPIO_PIN_PORT(pin), GPIO_ODR_OFFSET);
+    GPIO_HW_REG(GPIO_PIN_PORT(pin), GPIO_BSRR_OFFSET) =
+        GPIO_BSRR(~odr & bit, odr & bit);
+}
+
+//------------------------------------------------------------------------------
+static inline void gpio_hw_write_mask(gpio_port_t port, uint32_t mask, uint32_t value) {
+    GPIO_HW_REG(port, GPIO_BSRR_OFFSET) = GPIO_BSRR(mask & value, mask & ~value);
+}
+
+//------------------------------------------------------------------------------
+static inline void gpio_hw_set_mask(gpio_port_t port, uint32_t mask) {
+    GPIO_HW_REG(port, GPIO_BSRR_OFFSET) = GPIO_BSRR(mask, 0u);
+}
+
+//------------------------------------------------------------------------------
+static inline void gpio_hw_clear_mask(gpio_port_t port, uint32_t mask) {
+    GPIO_HW_REG(port, GPIO_BSRR_OFFSET) = GPIO_BSRR(0u, mask);
+}
+
+#endif // INCLUDE_GPIO_HW_H_
@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the functionality to install and initialize the STM32H5
+// LED PWM hardware
+//
+// Steady PWM and blink are a timer channel in PWM mode 1. Sequences add a
+// basic timer whose update event requests one GPDMA transfer of the next
+// duty value into the channel's CCR. The table is a one-block ring on a
+// channel from the DMA allocator (dma_api.h), so it loops forever with no
+// interrupt and no CPU involvement.
+//
+// Notes:
+//    - dma_init() must run before led_pwm_init(), which takes the channel
+//
+//------------------------------------------------------------------------------
+
+#include "led_pwm_hw.h"
+#include "dma_api.h"
+#include "gpio_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define TIM_REG(base, offset)    REG32((uintptr_t)(base) + (offset))
+
+#define PWM_TIM   LED_PWM_HW_TIM
+#define PWM_CH    LED_PWM_HW_TIM_CH
+#define STEP_TIM  LED_PWM_HW_STEP_TIM
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Duty cycle channel, allocated once
+static uint32_t s_dma_ch;
+static bool s_dma_ready;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to set a timer's prescaler and reload for a total tick count
+// Return false if it cannot be represented
+static bool tim_set_ticks(uintptr_t tim, uint64_t ticks) {
+    uint64_t psc = (ticks + TIM_ARR16_MAX) / (TIM_ARR16_MAX + 1u);
+    if (psc == 0u || psc > (TIM_PSC_MAX + 1u)) {
+        return false;
+    }
+    TIM_REG(tim, TIM_PSC_OFFSET) = (uint32_t)(psc - 1u);
+    TIM_REG(tim, TIM_ARR_OFFSET) = (uint32_t)(ticks / psc) - 1u;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper to set the PWM channel's output compare mode
+static void pwm_set_mode(uint32_t ocm) {
+    uint32_t off = TIM_CCMR_OFFSET(PWM_CH);
+    TIM_REG(PWM_TIM, off) = (TIM_REG(PWM_TIM, off) & ~TIM_CCMR_MASK(PWM_CH)) |
+        ((ocm | TIM_CCMR_OCPE) << TIM_CCMR_SHIFT(PWM_CH));
+}
+
+//------------------------------------------------------------------------------
+static bool hw_init(void) {
+    static const gpio_config_t pin_cfg = {
+        .mode  = GPIO_MODE_AF,
+        .otype = GPIO_OTYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_LOW,
+        .pull  = GPIO_PULL_NONE,
+        .af    = LED_PWM_HW_AF,
+    };
+
+    static const dma_config_t dma_cfg = {
+        .request = LED_PWM_HW_DMA_REQ,
+        .dir     = DMA_DIR_MEM_TO_PERIPH,
+        .width   = DMA_WIDTH_16,
+        .pperiph = (volatile void *)(PWM_TIM + TIM_CCR_OFFSET(PWM_CH)),
+    };
+
+    if (!s_dma_ready && !dma_alloc(&dma_cfg, &s_dma_ch)) {
+        return false;
+    }
+    s_dma_ready = true;
+
+    LED_PWM_HW_EnableClocks();
+
+    // Output stays low until a mode starts
+    TIM_REG(PWM_TIM, TIM_CR1_OFFSET) = TIM_CR1_ARPE;
+    pwm_set_mode(TIM_CCMR_OCM_FORCE_LO);
+    TIM_REG(PWM_TIM, TIM_CCER_OFFSET) |= TIM_CCER_CCE(PWM_CH);
+    return gpio_hw_configure(LED_PWM_HW_PIN, &pin_cfg);
+}
+
+//------------------------------------------------------------------------------
+static bool hw_pwm(uint32_t counter_hz, uint32_t period, uint32_t duty) {
+    if (counter_hz == 0u || (TIM_APB1_CLK_HZ % counter_hz) != 0u ||
+            (TIM_APB1_CLK_HZ / counter_hz) > (TIM_PSC_MAX + 1u) ||
+            period == 0u || period > TIM_ARR16_MAX) {
+        return false;
+    }
+    TIM_REG(PWM_TIM, TIM_CR1_OFFSET) &= ~TIM_CR1_CEN;
+    TIM_REG(PWM_TIM, TIM_PSC_OFFSET) = (TIM_APB1_CLK_HZ / counter_hz) - 1u;
+    TIM_REG(PWM_TIM, TIM_ARR_OFFSET) = period - 1u;
+    // CCR past ARR holds the output active for the whole period
+    TIM_REG(PWM_TIM, TIM_CCR_OFFSET(PWM_CH)) = (duty > period) ? period : duty;
+    pwm_set_mode(TIM_CCMR_OCM_PWM1);
+
+    // Load the preloaded values, then run from zero
+    TIM_REG(PWM_TIM, TIM_CNT_OFFSET) = 0u;
+    TIM_REG(PWM_TIM, TIM_EGR_OFFSET) = TIM_EGR_UG;
+    TIM_REG(PWM_TIM, TIM_CR1_OFFSET) |= TIM_CR1_CEN;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_sequence(const uint16_t *pduty, size_t steps, uint32_t step_us) {
+    dma_block_t table = {
+        .psrc = pduty,
+        .len  = (uint32_t)(steps * sizeof(uint16_t)),
+    };
+    if (!pduty || steps == 0u || steps > DMA_BLOCK_MAX_BYTES / sizeof(uint16_t)) {
+        return false;
+    }
+
+    // Step clock: one update event (one DMA request) per step
+    TIM_REG(STEP_TIM, TIM_CR1_OFFSET) = 0u;
+    TIM_REG(STEP_TIM, TIM_DIER_OFFSET) = 0u;
+    if (!tim_set_ticks(STEP_TIM, (uint64_t)step_us * (TIM_APB1_CLK_HZ / 1000000u))) {
+        return false;
+    }
+    TIM_REG(STEP_TIM, TIM_EGR_OFFSET) = TIM_EGR_UG;
+    TIM_REG(STEP_TIM, TIM_SR_OFFSET) = 0u;
+
+    // One-block ring: the table loops back on itself; a channel that did not
+    // stop stays running and fails the load
+    (void)dma_stop(s_dma_ch);
+    if (!dma_load(s_dma_ch, &table, 1u, true) || !dma_start(s_dma_ch)) {
+        return false;
+    }
+
+    TIM_REG(STEP_TIM, TIM_DIER_OFFSET) = TIM_DIER_UDE;
+    TIM_REG(STEP_TIM, TIM_CR1_OFFSET) = TIM_CR1_CEN;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_stop(void) {
+    // Step clock first, so no request arrives while the channel stops
+    TIM_REG(STEP_TIM, TIM_CR1_OFFSET) = 0u;
+    TIM_REG(STEP_TIM, TIM_DIER_OFFSET) = 0u;
+
+    // A wedged channel is reported, not waited on forever
+    bool stopped = !s_dma_ready || dma_stop(s_dma_ch);
+
+    // Park the LED off, whatever phase the counter stopped in
+    TIM_REG(PWM_TIM, TIM_CR1_OFFSET) &= ~TIM_CR1_CEN;
+    pwm_set_mode(TIM_CCMR_OCM_FORCE_LO);
+    return stopped;
+}
+
+//------------------------------------------------------------------------------
+void led_pwm_hw_install(led_pwm_hw_vtable_t *pv) {
+    pv->hw_init = hw_init;
+    pv->hw_pwm = hw_pwm;
+    pv->hw_sequence = hw_sequence;
+    pv->hw_stop = hw_stop;
+}
@@ -0,0 +1,24 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_LED_PWM_HW_H_
+#define INCLUDE_LED_PWM_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the STM32H5 LED PWM backend: a general purpose timer
+// channel drives the LED, a basic timer paces a GPDMA ring (one channel from
+// the DMA allocator) that rewrites the duty cycle for sequences.
+//
+//------------------------------------------------------------------------------
+
+#include "led_pwm_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void led_pwm_hw_install(led_pwm_hw_vtable_t *pv);
+
+#endif // INCLUDE_LED_PWM_HW_H_
@@ -38,6 +38,14 @@
 #define RCC_BASE              0x44020C00u
 #endif
 
+// GPIOA..GPIOI follow each other at a fixed stride
+#ifndef GPIOA_BASE
+#define GPIOA_BASE            0x42020000u
+#endif
+#ifndef GPIO_PORT_STRIDE
+#define GPIO_PORT_STRIDE      0x00000400u
+#endif
+
 #ifndef GPIOD_BASE
 #define GPIOD_BASE            0x42020C00u
 #endif
@@ -46,8 +54,109 @@
 #define USART3_BASE           0x40004800u
 #endif
 
+#ifndef TIM3_BASE
+#define TIM3_BASE             0x40000400u
+#endif
+
+#ifndef TIM6_BASE
+#define TIM6_BASE             0x40001000u
+#endif
+
+#ifndef GPDMA1_BASE
+#define GPDMA1_BASE           0x40020000u
+#endif
+
+#ifndef SPI1_BASE
+#define SPI1_BASE             0x40013000u
+#endif
+
+// Embedded flash interface (non-secure register aliases)
+#ifndef FLASH_REGS_BASE
+#define FLASH_REGS_BASE       0x40022000u
+#endif
+
+// -------- Cortex-M33 core peripherals --------
+
+#ifndef SYST_CSR_ADDR
+#define SYST_CSR_ADDR         0xE000E010u
+#endif
+#ifndef SYST_RVR_ADDR
+#define SYST_RVR_ADDR         0xE000E014u
+#endif
+#ifndef SYST_CVR_ADDR
+#define SYST_CVR_ADDR         0xE000E018u
+#endif
+
+#ifndef NVIC_ISER_ADDR
+#define NVIC_ISER_ADDR        0xE000E100u
+#endif
+#ifndef NVIC_ICER_ADDR
+#define NVIC_ICER_ADDR        0xE000E180u
+#endif
+#ifndef NVIC_ICPR_ADDR
+#define NVIC_ICPR_ADDR        0xE000E280u
+#endif
+// Interrupt set-enable/clear registers, 32 lines each
+#ifndef NVIC_REG_COUNT
+#define NVIC_REG_COUNT        5u
+#endif
+
+#ifndef SCB_VTOR_ADDR
+#define SCB_VTOR_ADDR         0xE000ED08u
+#endif
+
+#ifndef DCB_DEMCR_ADDR
+#define DCB_DEMCR_ADDR        0xE000EDFCu
+#endif
+#ifndef DWT_CTRL_ADDR
+#define DWT_CTRL_ADDR         0xE0001000u
+#endif
+#ifndef DWT_CYCCNT_ADDR
+#define DWT_CYCCNT_ADDR       0xE0001004u
+#endif
+
+// -------- Embedded flash: 2 banks of 128 sectors of 8 KB --------
+
+#ifndef FLASH_MEM_BASE
+#define FLASH_MEM_BASE        0x08000000u
+#endif
+#ifndef FLASH_MEM_BYTES
+#define FLASH_MEM_BYTES       (2048u * 1024u)
+#endif
+#ifndef FLASH_BANK_BYTES
+#define FLASH_BANK_BYTES      (1024u * 1024u)
+#endif
+#ifndef FLASH_SECTOR_BYTES
+#define FLASH_SECTOR_BYTES    (8u * 1024u)
+#endif
+
+// -------- Core clock --------
+
+// Clock feeding the core, SysTick and the DWT cycle counter
+// TBD: Adjust if SystemInit() changes the system clock
+#ifndef SYSTEM_CORE_CLK_HZ
+#define SYSTEM_CORE_CLK_HZ    64000000u
+#endif
+
+// -------- Interrupt numbers (vector table position - 16) --------
+
+#ifndef SPI1_IRQN
+#define SPI1_IRQN             55u
+#endif
+#ifndef USART3_IRQN
+#define USART3_IRQN           60u
+#endif
+
+// GPDMA1 channels 0..7 are consecutive lines
+#ifndef GPDMA1_CH0_IRQN
+#define GPDMA1_CH0_IRQN       27u
+#endif
+
 // -------- RCC clock-enable register addresses & bitmasks --------
 
+#ifndef RCC_AHB1ENR_ADDR
+#define RCC_AHB1ENR_ADDR      (RCC_BASE + 0x00000088u)
+#endif
 #ifndef RCC_AHB2ENR_ADDR
 #define RCC_AHB2ENR_ADDR      (RCC_BASE + 0x0000008Cu)
 #endif
@@ -57,10 +166,18 @@
 #ifndef RCC_APB1LENR_ADDR
 #define RCC_APB1LENR_ADDR     (RCC_BASE + 0x0000009Cu)
 #endif
+#ifndef RCC_APB2ENR_ADDR
+#define RCC_APB2ENR_ADDR      (RCC_BASE + 0x000000A4u)
+#endif
+
+// Bit mask to enable a GPIO port clock in AHB2ENR, by port index (A = 0)
+#ifndef RCC_EN_GPIO
+#define RCC_EN_GPIO(port)     (1u << (port))
+#endif
 
 // Bit mask to enable GPIOD peripheral clock
 #ifndef RCC_EN_GPIOD
-#define RCC_EN_GPIOD          (1u << 3)
+#define RCC_EN_GPIOD          RCC_EN_GPIO(3u)
 #endif
 
 // Bit mask to enable USART3 peripheral clock
@@ -68,6 +185,59 @@
 #define RCC_EN_USART3         (1u << 18)
 #endif
 
+// Bit masks to enable timer clocks in APB1LENR
+#ifndef RCC_EN_TIM3
+#define RCC_EN_TIM3           (1u << 1)
+#endif
+#ifndef RCC_EN_TIM6
+#define RCC_EN_TIM6           (1u << 4)
+#endif
+
+// Bit mask to enable GPDMA1 clock in AHB1ENR
+#ifndef RCC_EN_GPDMA1
+#define RCC_EN_GPDMA1         (1u << 0)
+#endif
+
+// Bit mask to enable SPI1 clock in APB2ENR
+#ifndef RCC_EN_SPI1
+#define RCC_EN_SPI1           (1u << 12)
+#endif
+
+// -------- GPDMA1 hardware request lines (CTR2.REQSEL) --------
+
+// Numbers from the GPDMA1 request table of RM0481 (STM32H563/H573)
+#ifndef GPDMA1_REQ_TIM6_UP
+#define GPDMA1_REQ_TIM6_UP    4u  // tim6_upd_dma
+#endif
+#ifndef GPDMA1_REQ_SPI1_RX
+#define GPDMA1_REQ_SPI1_RX    6u  // spi1_rx_dma
+#endif
+#ifndef GPDMA1_REQ_SPI1_TX
+#define GPDMA1_REQ_SPI1_TX    7u  // spi1_tx_dma
+#endif
+
+// -------- GPDMA1 channels (see dma_api.h for the allocator) --------
+#ifndef GPDMA1_CHANNELS
+#define GPDMA1_CHANNELS       8u
+#endif
+// Polls of SUSPF/IDLEF before a suspending channel counts as wedged; a
+// channel suspends at the end of its current burst, within a few bus cycles
+#ifndef GPDMA_SUSPEND_POLLS
+#define GPDMA_SUSPEND_POLLS   10000u
+#endif
+// Clock for the shared DMA controller
+static inline void DMA_HW_EnableClocks(void) {
+    REG32(RCC_AHB1ENR_ADDR) |= RCC_EN_GPDMA1;
+    (void)REG32(RCC_AHB1ENR_ADDR);
+}
+
+// -------- Timer kernel clock --------
+
+// TBD: 64MHz APB1 timer clock, adjust if SystemInit() changes bus prescalers
+#ifndef TIM_APB1_CLK_HZ
+#define TIM_APB1_CLK_HZ       64000000u
+#endif
+
 // -------- UART pin mux (matching STM32H5xx routing) --------
 #ifndef UART_TX_GPIO_BASE
 #define UART_TX_GPIO_BASE     GPIOD_BASE
@@ -98,6 +268,19 @@
 #endif
 
 /* -------- Small helpers -------- */
+static inline void NVIC_EnableIRQn(uint32_t irqn) {
+    REG32(NVIC_ISER_ADDR + 4u * (irqn / 32u)) = 1u << (irqn % 32u);
+}
+
+// Masked once this returns: the barriers keep an interrupt already on its
+// way from being taken after the write
+static inline void NVIC_DisableIRQn(uint32_t irqn) {
+    REG32(NVIC_ICER_ADDR + 4u * (irqn / 32u)) = 1u << (irqn % 32u);
+#ifndef PERIPH_SIM
+    __asm__ volatile("dsb\n\tisb" ::: "memory");
+#endif
+}
+
 static inline void UART_EnableClocks(void) {
     REG32(RCC_AHB2ENR_ADDR)  |= RCC_EN_GPIOD;
     REG32(RCC_APB1LENR_ADDR) |= RCC_EN_USART3;
@@ -112,13 +295,34 @@ static inline void UART_EnableClocks(void) {
 ///------------------------------------------------------------------------------
 // Blinky App
 //
-// RCC and GPIO Register Values
-#define RCC_AHB4ENR (*(volatile uint32_t*)0x580244E0)
-#define GPIOB_MODER (*(volatile uint32_t*)0x58020400)
-#define GPIOB_ODR   (*(volatile uint32_t*)0x58020414)
+// LED pin is a GPIO descriptor, see BLINKY_LED_PIN in projects/blinky/src
 //
-// GPIOB Location
-#define GPIOB ((uint32_t*)0x58020400)
+// Hardware LED PWM: LD1 on PB0 is TIM3_CH3 on AF2. TIM6 paces a GPDMA1
+// channel from the allocator that feeds TIM3_CCR3 from a duty table for
+// breathe and pattern.
+#ifndef LED_PWM_HW_TIM
+#define LED_PWM_HW_TIM        TIM3_BASE
+#endif
+#ifndef LED_PWM_HW_TIM_CH
+#define LED_PWM_HW_TIM_CH     3u
+#endif
+#ifndef LED_PWM_HW_PIN
+#define LED_PWM_HW_PIN        GPIO_PIN(GPIO_PORT_B, 0u)
+#endif
+#ifndef LED_PWM_HW_AF
+#define LED_PWM_HW_AF         2u
+#endif
+#ifndef LED_PWM_HW_STEP_TIM
+#define LED_PWM_HW_STEP_TIM   TIM6_BASE
+#endif
+#ifndef LED_PWM_HW_DMA_REQ
+#define LED_PWM_HW_DMA_REQ    GPDMA1_REQ_TIM6_UP
+#endif
+// Clocks for the timers above
+static inline void LED_PWM_HW_EnableClocks(void) {
+    REG32(RCC_APB1LENR_ADDR) |= RCC_EN_TIM3 | RCC_EN_TIM6;
+    (void)REG32(RCC_APB1LENR_ADDR);
+}
 
 //------------------------------------------------------------------------------
 // UART App
@@ -134,6 +338,14 @@ static inline void UART_HW_EnableClocks(void) {
     UART_EnableClocks();
 }
 //
+// Interrupt line and vector of the configured USART
+#ifndef UART_HW_IRQN
+#define UART_HW_IRQN        USART3_IRQN
+#endif
+#ifndef UART_HW_IRQHandler
+#define UART_HW_IRQHandler  USART3_IRQHandler
+#endif
+//
 #ifndef UART_HW_TX_GPIO
 #define UART_HW_TX_GPIO     UART_TX_GPIO_BASE
 #endif
@@ -150,6 +362,17 @@ static inline void UART_HW_EnableClocks(void) {
 #define UART_HW_AF_NUM      UART_AF_NUM
 #endif
 //
+// Pin descriptors (GPIO_PIN() from gpio_api.h) for the pins above
+#define UART_HW_GPIO_PORT(base)  (((base) - GPIOA_BASE) / GPIO_PORT_STRIDE)
+#ifndef UART_HW_TX_GPIO_PIN
+#define UART_HW_TX_GPIO_PIN \
+    GPIO_PIN(UART_HW_GPIO_PORT(UART_HW_TX_GPIO), UART_HW_TX_PIN)
+#endif
+#ifndef UART_HW_RX_GPIO_PIN
+#define UART_HW_RX_GPIO_PIN \
+    GPIO_PIN(UART_HW_GPIO_PORT(UART_HW_RX_GPIO), UART_HW_RX_PIN)
+#endif
+//
 // Core clock feeding USART for BRR calculation
 // TBD: Adjust if clocking from different bus
 #ifndef UART_HW_USART_CLK_HZ
@@ -157,4 +380,81 @@ static inline void UART_HW_EnableClocks(void) {
 #define UART_HW_USART_CLK_HZ  64000000u
 #endif
 
+//------------------------------------------------------------------------------
+// SPI App
+//
+// SPI1 on the Arduino header of NUCLEO-H563ZI: SCK PA5 (D13), MISO PG9
+// (D12), MOSI PB5 (D11), all AF5, and chip select PD14 (D10) as a GPIO.
+// Two GPDMA1 channels from the allocator feed TXDR and drain RXDR; the Rx
+// channel's transfer complete interrupt reports finished transfers.
+// Pins from the Arduino connector table of UM3115 (MB1404, all revisions);
+// AF5 is SPI1 on PA5, PG9 and PB5 in the STM32H563 alternate function table.
+#ifndef SPI_HW_SPI
+#define SPI_HW_SPI            SPI1_BASE
+#endif
+#ifndef SPI_HW_SCK_PIN
+#define SPI_HW_SCK_PIN        GPIO_PIN(GPIO_PORT_A, 5u)
+#endif
+#ifndef SPI_HW_MISO_PIN
+#define SPI_HW_MISO_PIN       GPIO_PIN(GPIO_PORT_G, 9u)
+#endif
+#ifndef SPI_HW_MOSI_PIN
+#define SPI_HW_MOSI_PIN       GPIO_PIN(GPIO_PORT_B, 5u)
+#endif
+#ifndef SPI_HW_CS_PIN
+#define SPI_HW_CS_PIN         GPIO_PIN(GPIO_PORT_D, 14u)
+#endif
+#ifndef SPI_HW_AF_NUM
+#define SPI_HW_AF_NUM         5u
+#endif
+#ifndef SPI_HW_DMA_TX_REQ
+#define SPI_HW_DMA_TX_REQ     GPDMA1_REQ_SPI1_TX
+#endif
+#ifndef SPI_HW_DMA_RX_REQ
+#define SPI_HW_DMA_RX_REQ     GPDMA1_REQ_SPI1_RX
+#endif
+//
+// Interrupt line and vector of the SPI, for its error flags
+#ifndef SPI_HW_IRQN
+#define SPI_HW_IRQN           SPI1_IRQN
+#endif
+#ifndef SPI_HW_IRQHandler
+#define SPI_HW_IRQHandler     SPI1_IRQHandler
+#endif
+//
+// SPI kernel clock, divided by 2 to 256 for the bit rate
+// TBD: 64MHz, adjust if SystemInit() changes the SPI1 kernel clock source
+#ifndef SPI_HW_KER_CLK_HZ
+#define SPI_HW_KER_CLK_HZ     64000000u
+#endif
+//
+// Polls of SR.SUSP after CSUSP before the SPI is disabled anyway; it suspends
+// at the end of the current frame, 8 x 256 kernel clocks at the slowest rate
+#ifndef SPI_HW_SUSPEND_POLLS
+#define SPI_HW_SUSPEND_POLLS  10000u
+#endif
+//
+// Clocks for the SPI and its pins
+static inline void SPI_HW_EnableClocks(void) {
+    REG32(RCC_APB2ENR_ADDR) |= RCC_EN_SPI1;
+    // Ports A, B, D and G
+    REG32(RCC_AHB2ENR_ADDR) |= RCC_EN_GPIO(0u) | RCC_EN_GPIO(1u) |
+        RCC_EN_GPIO(3u) | RCC_EN_GPIO(6u);
+    (void)REG32(RCC_APB2ENR_ADDR);
+    (void)REG32(RCC_AHB2ENR_ADDR);
+}
+
+//------------------------------------------------------------------------------
+// Bootloader Layout
+//
+// Keep in step with common/linker/stm32h5/stm32h563xx_boot.ld and
+// stm32h563xx_app.ld: the bootloader owns the first 4 sectors, the
+// application the rest but the last sector, which holds the boot record.
+#ifndef BOOT_LOADER_BYTES
+#define BOOT_LOADER_BYTES   (4u * FLASH_SECTOR_BYTES)
+#endif
+#define BOOT_APP_BASE       (FLASH_MEM_BASE + BOOT_LOADER_BYTES)
+#define BOOT_RECORD_ADDR    (FLASH_MEM_BASE + FLASH_MEM_BYTES - FLASH_SECTOR_BYTES)
+#define BOOT_APP_MAX        (BOOT_RECORD_ADDR - BOOT_APP_BASE)
+
 #endif // INCLUDE_PLATFORM_CONFIG_H_
@@ -27,12 +27,27 @@
 //------------------------------------------------------------------------------
 
 // Generic 32-bit register convenience accessor
+// Host builds define PERIPH_SIM to resolve registers in a simulated
+// peripheral map instead (see common/unit_tests/stubs/periph_sim.h)
+#ifdef PERIPH_SIM
+#include "periph_sim.h"
+#else
 #define REG32(addr) (*(volatile uint32_t *)(uintptr_t)(addr))
+// Store to flash memory while programming; the host model needs to see every
+// store, even one that leaves the word unchanged
+#define FLASH_STORE32(addr, value) (REG32(addr) = (value))
+// Address of a memory object as DMA sees it; the host model maps its
+// pointers into a 32-bit bus instead
+#define DMA_BUS_ADDR(p) ((uint32_t)(uintptr_t)(p))
+#endif
 
 #define GPIO_MODER_OFFSET     0x00u
 #define GPIO_OTYPER_OFFSET    0x04u
 #define GPIO_OSPEEDR_OFFSET   0x08u
 #define GPIO_PUPDR_OFFSET     0x0Cu
+#define GPIO_IDR_OFFSET       0x10u
+#define GPIO_ODR_OFFSET       0x14u
+#define GPIO_BSRR_OFFSET      0x18u
 #define GPIO_AFRL_OFFSET      0x20u
 #define GPIO_AFRH_OFFSET      0x24u
 
@@ -44,19 +59,227 @@
 #define GPIO_OSPEED_HI        0x2u
 #define GPIO_PUPDR_PU         0x1u
 
+// BSRR: bits 0..15 set the pins, bits 16..31 reset them, in one store
+#define GPIO_PORT_PINS_MASK   0x0000FFFFu
+#define GPIO_BSRR_RESET_SHIFT 16u
+#define GPIO_BSRR(set, reset) \
+    (((set) & GPIO_PORT_PINS_MASK) | \
+     (((reset) & GPIO_PORT_PINS_MASK) << GPIO_BSRR_RESET_SHIFT))
+
 #define USART_CR1_OFFSET      0x00u
 #define USART_CR2_OFFSET      0x04u
 #define USART_CR3_OFFSET      0x08u
 #define USART_BRR_OFFSET      0x0Cu
+#define USART_RTOR_OFFSET     0x14u
 #define USART_ISR_OFFSET      0x1Cu
+#define USART_ICR_OFFSET      0x20u
 #define USART_RDR_OFFSET      0x24u
 #define USART_TDR_OFFSET      0x28u
 
 #define USART_CR1_UE          (1u << 0)  // USART enable
 #define USART_CR1_RE          (1u << 2)  // Receiver enable
 #define USART_CR1_TE          (1u << 3)  // Transmitter enable
+#define USART_CR1_RXNEIE      (1u << 5)  // RX not empty / RX FIFO not empty interrupt enable
+#define USART_CR1_TXEIE       (1u << 7)  // TX empty / TX FIFO not full interrupt enable
+#define USART_CR1_RTOIE       (1u << 26) // Receiver timeout interrupt enable
+#define USART_CR1_FIFOEN      (1u << 29) // FIFO mode enable (8-deep Rx/Tx FIFOs)
+
+#define USART_CR2_RTOEN       (1u << 23) // Receiver timeout enable
+
+#define USART_CR3_EIE         (1u << 0)  // Error (FE/NE/ORE) interrupt enable
+
+#define USART_RTOR_RTO_MASK   0x00FFFFFFu // Timeout in bit durations
 
+#define USART_ISR_PE          (1u << 0)  // Parity error
+#define USART_ISR_FE          (1u << 1)  // Framing error
+#define USART_ISR_NE          (1u << 2)  // Noise detected
+#define USART_ISR_ORE         (1u << 3)  // Overrun error
 #define USART_ISR_RXNE_RXFNE  (1u << 5)  // RX not empty / RX FIFO not empty
+#define USART_ISR_TC          (1u << 6)  // Transmission complete
 #define USART_ISR_TXE_TXFNF   (1u << 7)  // TX empty / TX FIFO not full
+#define USART_ISR_RTOF        (1u << 11) // Receiver timeout
+
+// Rx line error flags, cleared by writing the same bit positions to ICR
+#define USART_ISR_RX_ERRORS   (USART_ISR_PE | USART_ISR_FE | USART_ISR_NE | USART_ISR_ORE)
+
+#define USART_ICR_PECF        (1u << 0)  // Parity error clear
+#define USART_ICR_FECF        (1u << 1)  // Framing error clear
+#define USART_ICR_NECF        (1u << 2)  // Noise detected clear
+#define USART_ICR_ORECF       (1u << 3)  // Overrun error clear
+#define USART_ICR_RTOCF       (1u << 11) // Receiver timeout clear
+
+// General purpose (TIM2..TIM5) and basic (TIM6/TIM7) timers
+#define TIM_CR1_OFFSET        0x00u
+#define TIM_DIER_OFFSET       0x0Cu
+#define TIM_SR_OFFSET         0x10u
+#define TIM_EGR_OFFSET        0x14u
+#define TIM_CCMR1_OFFSET      0x18u
+#define TIM_CCMR2_OFFSET      0x1Cu
+#define TIM_CCER_OFFSET       0x20u
+#define TIM_CNT_OFFSET        0x24u
+#define TIM_PSC_OFFSET        0x28u
+#define TIM_ARR_OFFSET        0x2Cu
+#define TIM_CCR1_OFFSET       0x34u
+
+#define TIM_CR1_CEN           (1u << 0)  // Counter enable
+#define TIM_CR1_ARPE          (1u << 7)  // ARR preload enable
+#define TIM_DIER_UDE          (1u << 8)  // DMA request on update
+#define TIM_EGR_UG            (1u << 0)  // Generate update: load PSC/ARR/CCRx
+
+// Channel n (1..4): CCMR1 holds 1 and 2, CCMR2 holds 3 and 4, a byte each,
+// plus OCxM[3] at bit 16 (channels 1/3) or 24 (channels 2/4)
+#define TIM_CCMR_OFFSET(ch)   (((ch) <= 2u) ? TIM_CCMR1_OFFSET : TIM_CCMR2_OFFSET)
+#define TIM_CCMR_SHIFT(ch)    ((((ch) - 1u) & 1u) * 8u)
+#define TIM_CCMR_MASK(ch)     ((0xFFu << TIM_CCMR_SHIFT(ch)) | (1u << (16u + TIM_CCMR_SHIFT(ch))))
+#define TIM_CCMR_OCPE         (1u << 3)    // CCRx preload enable
+#define TIM_CCMR_OCM_FORCE_LO (0x4u << 4)  // Force inactive level
+#define TIM_CCMR_OCM_PWM1     (0x6u << 4)  // Active while CNT < CCRx
+#define TIM_CCER_CCE(ch)      (1u << (((ch) - 1u) * 4u))
+#define TIM_CCR_OFFSET(ch)    (TIM_CCR1_OFFSET + 4u * ((ch) - 1u))
+
+#define TIM_PSC_MAX           0xFFFFu
+#define TIM_ARR16_MAX         0xFFFFu
+
+// GPDMA channel x registers, relative to GPDMA_CH_OFFSET(x)
+#define GPDMA_CH_OFFSET(ch)   (0x50u + 0x80u * (ch))
+#define GPDMA_CLBAR_OFFSET    0x00u
+#define GPDMA_CFCR_OFFSET     0x0Cu
+#define GPDMA_CSR_OFFSET      0x10u
+#define GPDMA_CCR_OFFSET      0x14u
+#define GPDMA_CTR1_OFFSET     0x40u
+#define GPDMA_CTR2_OFFSET     0x44u
+#define GPDMA_CBR1_OFFSET     0x48u
+#define GPDMA_CSAR_OFFSET     0x4Cu
+#define GPDMA_CDAR_OFFSET     0x50u
+#define GPDMA_CLLR_OFFSET     0x7Cu
+
+#define GPDMA_CCR_EN          (1u << 0)  // Channel enable
+#define GPDMA_CCR_RESET       (1u << 1)  // Channel reset (when idle or suspended)
+#define GPDMA_CCR_SUSP        (1u << 2)  // Suspend
+#define GPDMA_CCR_TCIE        (1u << 8)  // Transfer complete interrupt enable
+#define GPDMA_CCR_DTEIE       (1u << 10) // Data transfer error interrupt enable
+#define GPDMA_CCR_ULEIE       (1u << 11) // Update link error interrupt enable
+#define GPDMA_CCR_USEIE       (1u << 12) // User setting error interrupt enable
+#define GPDMA_CSR_IDLEF       (1u << 0)  // Channel idle
+#define GPDMA_CSR_TCF         (1u << 8)  // Transfer complete (end of a block)
+#define GPDMA_CSR_DTEF        (1u << 10) // Data transfer error
+#define GPDMA_CSR_ULEF        (1u << 11) // Update link transfer error
+#define GPDMA_CSR_USEF        (1u << 12) // User setting error
+#define GPDMA_CSR_SUSPF       (1u << 13) // Channel suspended
+#define GPDMA_CSR_ERRORS      (GPDMA_CSR_DTEF | GPDMA_CSR_ULEF | GPDMA_CSR_USEF)
+#define GPDMA_CFCR_TCF        GPDMA_CSR_TCF   // Flags clear at the CSR bit positions
+#define GPDMA_CFCR_SUSPF      GPDMA_CSR_SUSPF
+#define GPDMA_CFCR_ALL        (0x7Fu << 8) // Clear TC/HT/DTE/ULE/USE/SUSP/TO flags
+
+#define GPDMA_CTR1_SDW_SHIFT  0u         // Source data width, log2 bytes
+#define GPDMA_CTR1_SDW_MASK   (3u << 0)
+#define GPDMA_CTR1_SDW_HALF   (1u << 0)  // Source data width 16-bit
+#define GPDMA_CTR1_SINC       (1u << 3)  // Source address increment
+#define GPDMA_CTR1_DDW_SHIFT  16u        // Destination data width, log2 bytes
+#define GPDMA_CTR1_DDW_MASK   (3u << 16)
+#define GPDMA_CTR1_DDW_HALF   (1u << 16) // Destination data width 16-bit
+#define GPDMA_CTR1_DINC       (1u << 19) // Destination address increment
+#define GPDMA_CTR2_REQSEL_MASK 0x7Fu     // Hardware request selection
+#define GPDMA_CTR2_SWREQ      (1u << 9)  // Software request (memory to memory)
+#define GPDMA_CTR2_DREQ       (1u << 10) // Request paces the destination
+#define GPDMA_CTR2_TCEM_BLOCK (0u << 30) // TC event at the end of each block
+#define GPDMA_CBR1_BNDT_MASK  0xFFFFu    // Block size in bytes
+
+// Linked-list item pointer: low address bits of the next item, and which
+// registers it reloads (stored in this order: CTR1, CTR2, CBR1, CSAR, CDAR,
+// CLLR, each only if selected)
+#define GPDMA_CLLR_LA_MASK    0xFFFCu
+#define GPDMA_CLLR_ULL        (1u << 16) // Reload CLLR
+#define GPDMA_CLLR_UDA        (1u << 27) // Reload CDAR
+#define GPDMA_CLLR_USA        (1u << 28) // Reload CSAR
+#define GPDMA_CLLR_UB1        (1u << 29) // Reload CBR1
+#define GPDMA_CLLR_UT2        (1u << 30) // Reload CTR2
+#define GPDMA_CLLR_UT1        (1u << 31) // Reload CTR1
+#define GPDMA_CLBAR_LBA_MASK  0xFFFF0000u
+
+// SPI (full-duplex master; SPI1..SPI3 share the layout)
+#define SPI_CR1_OFFSET        0x00u
+#define SPI_CR2_OFFSET        0x04u
+#define SPI_CFG1_OFFSET       0x08u
+#define SPI_CFG2_OFFSET       0x0Cu
+#define SPI_IER_OFFSET        0x10u
+#define SPI_SR_OFFSET         0x14u
+#define SPI_IFCR_OFFSET       0x18u
+#define SPI_TXDR_OFFSET       0x20u
+#define SPI_RXDR_OFFSET       0x30u
+
+#define SPI_CR1_SPE           (1u << 0)  // SPI enable
+#define SPI_CR1_MASRX         (1u << 8)  // Master suspends on a full Rx FIFO
+#define SPI_CR1_CSTART        (1u << 9)  // Master transfer start
+#define SPI_CR1_CSUSP         (1u << 10) // Master suspend request
+#define SPI_CR1_SSI           (1u << 12) // Internal SS level (with SSM)
+
+#define SPI_CR2_TSIZE_MASK    0xFFFFu    // Frames per transfer, 0: endless
+
+#define SPI_CFG1_DSIZE_8BIT   (7u << 0)  // Frame size - 1
+#define SPI_CFG1_RXDMAEN      (1u << 14) // Rx DMA stream enable
+#define SPI_CFG1_TXDMAEN      (1u << 15) // Tx DMA stream enable
+#define SPI_CFG1_MBR_SHIFT    28u        // Clock divider 2^(MBR + 1)
+#define SPI_CFG1_MBR_MAX      7u
+
+#define SPI_CFG2_MASTER       (1u << 22) // Master mode
+#define SPI_CFG2_CPHA         (1u << 24) // Clock phase
+#define SPI_CFG2_CPOL         (1u << 25) // Clock polarity
+#define SPI_CFG2_SSM          (1u << 26) // Software slave management
+#define SPI_CFG2_AFCNTR       (1u << 31) // Keep driving the pins while disabled
+
+#define SPI_IER_UDRIE         (1u << 5)  // Underrun interrupt
+#define SPI_IER_OVRIE         (1u << 6)  // Overrun interrupt
+#define SPI_IER_MODFIE        (1u << 9)  // Mode fault interrupt
+#define SPI_IER_ERRORS        (SPI_IER_UDRIE | SPI_IER_OVRIE | SPI_IER_MODFIE)
+
+#define SPI_SR_UDR            (1u << 5)  // Underrun
+#define SPI_SR_OVR            (1u << 6)  // Overrun
+#define SPI_SR_MODF           (1u << 9)  // Mode fault
+#define SPI_SR_SUSP           (1u << 11) // Master suspended
+#define SPI_SR_ERRORS         (SPI_SR_UDR | SPI_SR_OVR | SPI_SR_MODF)
+#define SPI_IFCR_ALL          0x0BF8u    // Clear EOT..MODF and SUSP flags
+
+// Embedded flash interface, non-secure registers
+#define FLASH_NSKEYR_OFFSET   0x04u
+#define FLASH_NSSR_OFFSET     0x20u
+#define FLASH_NSCR_OFFSET     0x28u
+#define FLASH_NSCCR_OFFSET    0x30u  // Clears NSSR flags at the same bit positions
+
+#define FLASH_KEY1            0x45670123u
+#define FLASH_KEY2            0xCDEF89ABu
+
+#define FLASH_SR_BSY          (1u << 0)  // Operation in progress
+#define FLASH_SR_WBNE         (1u << 1)  // Write buffer not empty
+#define FLASH_SR_DBNE         (1u << 3)  // Data buffer not empty
+#define FLASH_SR_EOP          (1u << 16) // End of operation
+#define FLASH_SR_WRPERR       (1u << 17) // Write protection error
+#define FLASH_SR_PGSERR       (1u << 18) // Programming sequence error
+#define FLASH_SR_STRBERR      (1u << 19) // Strobe error (word written twice)
+#define FLASH_SR_INCERR       (1u << 20) // Inconsistency (quad-word left unfinished)
+#define FLASH_SR_OPTCHANGEERR (1u << 23) // Option byte change error
+#define FLASH_SR_ERRORS       (FLASH_SR_WRPERR | FLASH_SR_PGSERR | FLASH_SR_STRBERR | \
+                               FLASH_SR_INCERR | FLASH_SR_OPTCHANGEERR)
+
+#define FLASH_CR_LOCK         (1u << 0)  // Register lock, cleared by the key sequence
+#define FLASH_CR_PG           (1u << 1)  // Programming
+#define FLASH_CR_SER          (1u << 2)  // Sector erase
+#define FLASH_CR_STRT         (1u << 5)  // Start erase
+#define FLASH_CR_SNB_SHIFT    6u         // Sector number in the bank
+#define FLASH_CR_SNB_MASK     (0x7Fu << FLASH_CR_SNB_SHIFT)
+#define FLASH_CR_BKSEL        (1u << 31) // Bank 2 selected for erase
+
+// Programming unit: a 128-bit quad-word, written as four words in address order
+#define FLASH_QWORD_WORDS     4u
+
+// Cortex-M33 SysTick
+#define SYST_CSR_ENABLE       (1u << 0)  // Counter enable
+#define SYST_CSR_TICKINT      (1u << 1)  // Exception on reaching zero
+#define SYST_CSR_CLKSOURCE    (1u << 2)  // Processor clock (not external ref)
+#define SYST_RVR_MAX          0x00FFFFFFu // 24-bit reload value
+
+// Cortex-M33 debug and trace: free-running cycle counter
+#define DCB_DEMCR_TRCENA      (1u << 24) // Enable DWT and ITM
+#define DWT_CTRL_CYCCNTENA    (1u << 0)  // Enable cycle counter
 
 #endif // INCLUDE_REGISTER_DEFS_H_
\ No newline at end of file
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the functionality to install the Cortex-M33 scheduler
+// backend
+//
+//------------------------------------------------------------------------------
+
+#include "sched_hw.h"
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+static bool hw_init(void) {
+    // Free-running cycle counter for per-task accounting
+    REG32(DCB_DEMCR_ADDR) |= DCB_DEMCR_TRCENA;
+    REG32(DWT_CTRL_ADDR) |= DWT_CTRL_CYCCNTENA;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_irq_save(void) {
+    uint32_t primask;
+    __asm__ volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask) :: "memory");
+    return primask;
+}
+
+//------------------------------------------------------------------------------
+static void hw_irq_restore(uint32_t state) {
+    __asm__ volatile("msr primask, %0" :: "r"(state) : "memory");
+}
+
+//------------------------------------------------------------------------------
+static void hw_idle(void) {
+    // With PRIMASK set, a pending interrupt still ends WFI; it is then taken
+    // once the caller restores the mask
+    __asm__ volatile("dsb\n\twfi" ::: "memory");
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_cycles(void) {
+    return REG32(DWT_CYCCNT_ADDR);
+}
+
+//------------------------------------------------------------------------------
+void sched_hw_install(sched_hw_vtable_t *pv) {
+    pv->hw_init = hw_init;
+    pv->hw_irq_save = hw_irq_save;
+    pv->hw_irq_restore = hw_irq_restore;
+    pv->hw_idle = hw_idle;
+    pv->hw_cycles = hw_cycles;
+}
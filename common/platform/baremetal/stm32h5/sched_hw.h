@@ -0,0 +1,23 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SCHED_HW_H_
+#define INCLUDE_SCHED_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the Cortex-M33 scheduler backend: PRIMASK for
+// critical sections, WFI for idle, DWT for run-time accounting.
+//
+//------------------------------------------------------------------------------
+
+#include "sched_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void sched_hw_install(sched_hw_vtable_t *pv);
+
+#endif // INCLUDE_SCHED_HW_H_
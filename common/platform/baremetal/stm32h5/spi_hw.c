@@ -0,0 +1,467 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the functionality to install and initialize the STM32H5
+// SPI hardware
+//
+// The SPI runs as master with an endless transfer size (TSIZE 0) while a
+// chain is on the bus, so it clocks for as long as the Tx channel feeds it.
+// Each transfer is one linked-list item on each channel: the Tx channel
+// copies memory (or the fill byte) to TXDR, the Rx channel copies RXDR to
+// memory (or a sink byte). Chaining a transfer points the last item of both
+// lists at the new ones, so the channels load them with no CPU involvement.
+// The Rx channel raises transfer complete at the end of each item; which
+// item it is on tells how many transfers have finished. Errors on either
+// channel, and SPI mode faults and overruns, raise an interrupt too: a
+// failed Tx channel stops the clock, so the Rx channel would never finish.
+//
+// Notes:
+//    - Both channels come from the DMA allocator (dma_api.h), which must be
+//      initialized first; the backend programs them itself, since it extends
+//      both lists in lockstep while they run
+//    - Both lists sit in one aligned block, so they share the 64 KiB
+//      region CLBAR selects; a spare word first keeps every item off the
+//      null link address, which ends a list
+//    - MASRX suspends the clock while the Rx FIFO is full, so a late Rx
+//      channel never loses data
+//
+//------------------------------------------------------------------------------
+
+#include <stdatomic.h>
+#include "spi_hw.h"
+#include "dma_api.h"
+#include "gpio_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define SPI_REG(offset)          REG32((uintptr_t)SPI_HW_SPI + (offset))
+#define DMA_CH_REG(ch, offset)   REG32(GPDMA1_BASE + GPDMA_CH_OFFSET(ch) + (offset))
+
+#define TX_CH     s_tx_ch
+#define RX_CH     s_rx_ch
+#define SLOT_MASK (SPI_HW_CHAIN_MAX - 1u)
+
+// Registers each item reloads: Tx sets the source, Rx the destination
+#define TX_LLI_UPDATE  (GPDMA_CLLR_UT1 | GPDMA_CLLR_UB1 | GPDMA_CLLR_USA | GPDMA_CLLR_ULL)
+#define RX_LLI_UPDATE  (GPDMA_CLLR_UT1 | GPDMA_CLLR_UB1 | GPDMA_CLLR_UDA | GPDMA_CLLR_ULL)
+
+#define DMA_ERROR_IE   (GPDMA_CCR_DTEIE | GPDMA_CCR_ULEIE | GPDMA_CCR_USEIE)
+
+// Storage for both lists, a power of two to align it to
+#define LLI_POOL_ALIGN 512u
+
+_Static_assert((SPI_HW_CHAIN_MAX & SLOT_MASK) == 0u,
+    "SPI_HW_CHAIN_MAX must be a power of two");
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// GPDMA linked-list item, in the order the channel reads it for
+// CLLR.UT1 | UB1 | USA | ULL (Tx: addr is CSAR) or UT1 | UB1 | UDA | ULL
+// (Rx: addr is CDAR)
+typedef struct {
+    uint32_t ctr1;
+    uint32_t cbr1;
+    uint32_t addr;
+    uint32_t cllr;
+} dma_lli_t;
+
+typedef struct {
+    uint32_t reserved;
+    dma_lli_t tx[SPI_HW_CHAIN_MAX];
+    dma_lli_t rx[SPI_HW_CHAIN_MAX];
+} dma_lists_t;
+
+_Static_assert(sizeof(dma_lists_t) <= LLI_POOL_ALIGN,
+    "LLI_POOL_ALIGN too small for the lists");
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Read by the DMA channels as they move from one transfer to the next
+static dma_lists_t s_lli __attribute__((aligned(LLI_POOL_ALIGN)));
+
+// Fill byte for transfers with no Tx buffer, sink for those with no Rx one
+static const uint8_t s_fill = SPI_FILL_BYTE;
+static uint8_t s_sink;
+
+// Transfers with the DMA: [s_head, s_tail), slot = sequence & SLOT_MASK
+static uint32_t s_head;
+static uint32_t s_tail;
+static uint32_t s_flags[SPI_HW_CHAIN_MAX];
+static bool s_cs_held;
+
+// Channels, allocated once, and the instance their interrupt serves
+static uint32_t s_tx_ch;
+static uint32_t s_rx_ch;
+static bool s_dma_ready;
+static spi_t *s_irq_ps;
+
+// SCK and MOSI driven, MISO an input through the same alternate function
+static const gpio_config_t s_pin_cfg = {
+    .mode  = GPIO_MODE_AF,
+    .otype = GPIO_OTYPE_PUSH_PULL,
+    .speed = GPIO_SPEED_HIGH,
+    .pull  = GPIO_PULL_NONE,
+    .af    = SPI_HW_AF_NUM,
+};
+
+static const gpio_config_t s_cs_cfg = {
+    .mode  = GPIO_MODE_OUTPUT,
+    .otype = GPIO_OTYPE_PUSH_PULL,
+    .speed = GPIO_SPEED_HIGH,
+    .pull  = GPIO_PULL_NONE,
+    .af    = 0u,
+};
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper for the CLLR value that loads an item next
+static inline uint32_t lli_link(const dma_lli_t *plli, uint32_t update) {
+    return update | (DMA_BUS_ADDR(plli) & GPDMA_CLLR_LA_MASK);
+}
+
+//------------------------------------------------------------------------------
+// Helper to describe a transfer in a slot, as the last item of both lists
+static void slot_fill(uint32_t slot, const spi_xfer_t *px) {
+    dma_lli_t *ptx = &s_lli.tx[slot];
+    dma_lli_t *prx = &s_lli.rx[slot];
+    ptx->ctr1 = px->ptx ? GPDMA_CTR1_SINC : 0u;
+    ptx->cbr1 = (uint32_t)px->len;
+    ptx->addr = px->ptx ? DMA_BUS_ADDR(px->ptx) : DMA_BUS_ADDR(&s_fill);
+    ptx->cllr = 0u;
+    prx->ctr1 = px->prx ? GPDMA_CTR1_DINC : 0u;
+    prx->cbr1 = (uint32_t)px->len;
+    prx->addr = px->prx ? DMA_BUS_ADDR(px->prx) : DMA_BUS_ADDR(&s_sink);
+    prx->cllr = 0u;
+    s_flags[slot] = px->flags;
+}
+
+//------------------------------------------------------------------------------
+// Helper to suspend a channel, waiting at most GPDMA_SUSPEND_POLLS reads
+// Return false, with SUSP still set, if it does not suspend
+static bool chan_suspend(uint32_t ch) {
+    DMA_CH_REG(ch, GPDMA_CCR_OFFSET) |= GPDMA_CCR_SUSP;
+    uint32_t polls = 0;
+    while (!(DMA_CH_REG(ch, GPDMA_CSR_OFFSET) &
+            (GPDMA_CSR_SUSPF | GPDMA_CSR_IDLEF))) {
+        if (++polls >= GPDMA_SUSPEND_POLLS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper to stop a channel, whatever it is doing
+// Return false, with the channel left as it is, if it does not suspend
+static bool chan_stop(uint32_t ch) {
+    if (DMA_CH_REG(ch, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN) {
+        if (!chan_suspend(ch)) {
+            return false;
+        }
+        DMA_CH_REG(ch, GPDMA_CCR_OFFSET) = GPDMA_CCR_RESET;
+    }
+    DMA_CH_REG(ch, GPDMA_CFCR_OFFSET) = GPDMA_CFCR_ALL;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper to start a channel on a list: with a null block size the channel
+// loads the first item before it transfers anything
+static void chan_start(uint32_t ch, uint32_t ctr2, uint32_t csar, uint32_t cdar,
+        uint32_t cllr, uint32_t ccr) {
+    DMA_CH_REG(ch, GPDMA_CFCR_OFFSET) = GPDMA_CFCR_ALL;
+    DMA_CH_REG(ch, GPDMA_CLBAR_OFFSET) =
+        DMA_BUS_ADDR(&s_lli) & GPDMA_CLBAR_LBA_MASK;
+    DMA_CH_REG(ch, GPDMA_CTR1_OFFSET) = 0u;
+    DMA_CH_REG(ch, GPDMA_CTR2_OFFSET) = ctr2;
+    DMA_CH_REG(ch, GPDMA_CBR1_OFFSET) = 0u;
+    DMA_CH_REG(ch, GPDMA_CSAR_OFFSET) = csar;
+    DMA_CH_REG(ch, GPDMA_CDAR_OFFSET) = cdar;
+    DMA_CH_REG(ch, GPDMA_CLLR_OFFSET) = cllr;
+    DMA_CH_REG(ch, GPDMA_CCR_OFFSET) = ccr | GPDMA_CCR_EN;
+}
+
+//------------------------------------------------------------------------------
+// Helper to take the SPI off the bus at the end of a chain
+// Notes:
+//    - The suspend wait is bounded by SPI_HW_SUSPEND_POLLS; past it, clearing
+//      SPE cuts the frame short rather than hang the caller
+static void spi_stop(void) {
+    if (SPI_REG(SPI_CR1_OFFSET) & SPI_CR1_SPE) {
+        SPI_REG(SPI_CR1_OFFSET) |= SPI_CR1_CSUSP;
+        uint32_t polls = 0;
+        while (!(SPI_REG(SPI_SR_OFFSET) & SPI_SR_SUSP) &&
+                ++polls < SPI_HW_SUSPEND_POLLS) {
+        }
+    }
+    SPI_REG(SPI_CR1_OFFSET) = SPI_CR1_SSI;
+    SPI_REG(SPI_IFCR_OFFSET) = SPI_IFCR_ALL;
+    SPI_REG(SPI_CFG1_OFFSET) &= ~(SPI_CFG1_TXDMAEN | SPI_CFG1_RXDMAEN);
+}
+
+//------------------------------------------------------------------------------
+// Context: either channel's interrupt, via dma_isr()
+static void chan_event(void *pctx, uint32_t ch, uint32_t block, uint32_t events) {
+    (void)pctx;
+    (void)ch;
+    (void)block;
+    (void)events;
+    if (s_irq_ps) {
+        (void)spi_isr(s_irq_ps);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper to take both channels from the allocator, the first time through
+static bool dma_claim(void) {
+    static const dma_config_t tx_cfg = { .raw = true, .on_event = chan_event };
+    static const dma_config_t rx_cfg = { .raw = true, .on_event = chan_event };
+    if (s_dma_ready) {
+        return true;
+    }
+    if (!dma_alloc(&tx_cfg, &s_tx_ch)) {
+        return false;
+    }
+    if (!dma_alloc(&rx_cfg, &s_rx_ch)) {
+        dma_free(s_tx_ch);
+        return false;
+    }
+    // Masked until spi_hw_enable_irq()
+    dma_irq_mask(s_tx_ch, s_irq_ps == NULL);
+    dma_irq_mask(s_rx_ch, s_irq_ps == NULL);
+    s_dma_ready = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static inline void cs_release(void) {
+    gpio_hw_write(SPI_HW_CS_PIN, 1u);
+    s_cs_held = false;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_init(uint32_t clock_hz, spi_mode_t mode) {
+    // Slowest divider is 256
+    if (clock_hz < SPI_HW_KER_CLK_HZ / 256u) {
+        return false;
+    }
+    uint32_t mbr = 0u;
+    while ((SPI_HW_KER_CLK_HZ >> (mbr + 1u)) > clock_hz) {
+        mbr++;
+    }
+
+    if (!dma_claim()) {
+        return false;
+    }
+    SPI_HW_EnableClocks();
+
+    // Chip select idles high
+    gpio_hw_write(SPI_HW_CS_PIN, 1u);
+    (void)gpio_hw_configure(SPI_HW_CS_PIN, &s_cs_cfg);
+    (void)gpio_hw_configure(SPI_HW_SCK_PIN, &s_pin_cfg);
+    (void)gpio_hw_configure(SPI_HW_MISO_PIN, &s_pin_cfg);
+    (void)gpio_hw_configure(SPI_HW_MOSI_PIN, &s_pin_cfg);
+
+    // A channel that does not stop is still running a list: fail
+    bool stopped = chan_stop(TX_CH);
+    stopped = chan_stop(RX_CH) && stopped;
+    if (!stopped) {
+        return false;
+    }
+
+    // Disable -> Configure 8-bit master, software NSS -> Enable per chain
+    SPI_REG(SPI_CR1_OFFSET) = 0u;
+    SPI_REG(SPI_CFG1_OFFSET) = (mbr << SPI_CFG1_MBR_SHIFT) | SPI_CFG1_DSIZE_8BIT;
+    SPI_REG(SPI_CFG2_OFFSET) = SPI_CFG2_MASTER | SPI_CFG2_SSM | SPI_CFG2_AFCNTR |
+        (((uint32_t)mode & 2u) ? SPI_CFG2_CPOL : 0u) |
+        (((uint32_t)mode & 1u) ? SPI_CFG2_CPHA : 0u);
+    SPI_REG(SPI_CR1_OFFSET) = SPI_CR1_SSI;
+    SPI_REG(SPI_IFCR_OFFSET) = SPI_IFCR_ALL;
+    SPI_REG(SPI_IER_OFFSET) = SPI_IER_ERRORS;
+
+    s_head = 0u;
+    s_tail = 0u;
+    s_cs_held = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_start(const spi_xfer_t *px) {
+    // Busy as well while a channel that did not stop still runs
+    if (s_tail != s_head ||
+            ((DMA_CH_REG(TX_CH, GPDMA_CCR_OFFSET) |
+              DMA_CH_REG(RX_CH, GPDMA_CCR_OFFSET)) & GPDMA_CCR_EN)) {
+        return false;
+    }
+    uint32_t slot = s_tail & SLOT_MASK;
+    slot_fill(slot, px);
+    s_tail++;
+    // The lists are in memory before the channels read them
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (!s_cs_held) {
+        gpio_hw_write(SPI_HW_CS_PIN, 0u);
+        s_cs_held = true;
+    }
+
+    // Rx DMA, then Tx DMA, then the SPI (reference manual order)
+    SPI_REG(SPI_IFCR_OFFSET) = SPI_IFCR_ALL;
+    SPI_REG(SPI_CR2_OFFSET) = 0u;
+    SPI_REG(SPI_CFG1_OFFSET) |= SPI_CFG1_RXDMAEN;
+    chan_start(RX_CH, SPI_HW_DMA_RX_REQ & GPDMA_CTR2_REQSEL_MASK,
+        (uint32_t)(SPI_HW_SPI + SPI_RXDR_OFFSET), 0u,
+        lli_link(&s_lli.rx[slot], RX_LLI_UPDATE), GPDMA_CCR_TCIE | DMA_ERROR_IE);
+    chan_start(TX_CH, (SPI_HW_DMA_TX_REQ & GPDMA_CTR2_REQSEL_MASK) | GPDMA_CTR2_DREQ,
+        0u, (uint32_t)(SPI_HW_SPI + SPI_TXDR_OFFSET),
+        lli_link(&s_lli.tx[slot], TX_LLI_UPDATE), DMA_ERROR_IE);
+    SPI_REG(SPI_CFG1_OFFSET) |= SPI_CFG1_TXDMAEN;
+    SPI_REG(SPI_CR1_OFFSET) = SPI_CR1_SSI | SPI_CR1_MASRX | SPI_CR1_SPE;
+    SPI_REG(SPI_CR1_OFFSET) |= SPI_CR1_CSTART;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Notes:
+//    - The Tx channel is suspended while the lists are extended: it runs
+//      ahead of the Rx channel, so if it has not loaded its last item yet
+//      neither has the Rx channel, and both will load the new link. The
+//      SPI FIFO keeps the bus busy for the few cycles this takes
+//    - A channel that does not suspend in time is not linked: the transfer
+//      waits for the chain to end and starts on its own
+static bool hw_link(const spi_xfer_t *px) {
+    if (s_tail == s_head || (s_tail - s_head) >= SPI_HW_CHAIN_MAX) {
+        return false;
+    }
+    uint32_t slot = s_tail & SLOT_MASK;
+    uint32_t prev = (s_tail - 1u) & SLOT_MASK;
+    slot_fill(slot, px);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // A null link means the last item is loaded: too late
+    bool linked = chan_suspend(TX_CH) &&
+        (DMA_CH_REG(TX_CH, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN) &&
+        DMA_CH_REG(TX_CH, GPDMA_CLLR_OFFSET) != 0u;
+    if (linked) {
+        s_lli.rx[prev].cllr = lli_link(&s_lli.rx[slot], RX_LLI_UPDATE);
+        s_lli.tx[prev].cllr = lli_link(&s_lli.tx[slot], TX_LLI_UPDATE);
+        atomic_thread_fence(memory_order_seq_cst);
+        s_tail++;
+    }
+    DMA_CH_REG(TX_CH, GPDMA_CCR_OFFSET) &= ~GPDMA_CCR_SUSP;
+    DMA_CH_REG(TX_CH, GPDMA_CFCR_OFFSET) = GPDMA_CFCR_SUSPF;
+    return linked;
+}
+
+//------------------------------------------------------------------------------
+static size_t hw_poll_done(void) {
+    uint32_t inflight = s_tail - s_head;
+    // An error also disables the channel; hw_error() reports that one
+    if (inflight == 0u ||
+            (DMA_CH_REG(RX_CH, GPDMA_CSR_OFFSET) & GPDMA_CSR_ERRORS)) {
+        return 0u;
+    }
+    // Clear first: an item finishing after the position is read raises the
+    // flag again, and with it another interrupt
+    DMA_CH_REG(RX_CH, GPDMA_CFCR_OFFSET) = GPDMA_CFCR_TCF;
+    uint32_t done;
+    if (!(DMA_CH_REG(RX_CH, GPDMA_CCR_OFFSET) & GPDMA_CCR_EN)) {
+        // The whole chain: the channel disables itself after the last item
+        done = inflight;
+    } else {
+        uint32_t cllr = DMA_CH_REG(RX_CH, GPDMA_CLLR_OFFSET);
+        if (cllr == 0u) {
+            // On the last item
+            done = inflight - 1u;
+        } else {
+            // On the item before the one the link points at
+            uint32_t next = ((cllr & GPDMA_CLLR_LA_MASK) -
+                (DMA_BUS_ADDR(s_lli.rx) & GPDMA_CLLR_LA_MASK)) /
+                (uint32_t)sizeof(dma_lli_t);
+            uint32_t ahead = (next - s_head) & SLOT_MASK;
+            done = ahead ? ahead - 1u : 0u;
+        }
+    }
+    if (done == inflight) {
+        spi_stop();
+        if (!(s_flags[(s_tail - 1u) & SLOT_MASK] & SPI_XFER_CS_HOLD)) {
+            cs_release();
+        }
+    }
+    s_head += done;
+    return done;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_error(void) {
+    uint32_t dma = (DMA_CH_REG(TX_CH, GPDMA_CSR_OFFSET) |
+        DMA_CH_REG(RX_CH, GPDMA_CSR_OFFSET)) & GPDMA_CSR_ERRORS;
+    uint32_t spi = SPI_REG(SPI_SR_OFFSET) & SPI_SR_ERRORS;
+    if (!dma && !spi) {
+        return false;
+    }
+    // Abandon the chain, and leave the bus idle for the next start; a channel
+    // that does not stop keeps hw_start() failing as busy
+    (void)chan_stop(TX_CH);
+    (void)chan_stop(RX_CH);
+    SPI_REG(SPI_CR1_OFFSET) = SPI_CR1_SSI;
+    SPI_REG(SPI_IFCR_OFFSET) = SPI_IFCR_ALL;
+    SPI_REG(SPI_CFG1_OFFSET) &= ~(SPI_CFG1_TXDMAEN | SPI_CFG1_RXDMAEN);
+    cs_release();
+    s_head = s_tail;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static void hw_irq_mask(bool masked) {
+    if (s_dma_ready && (masked || s_irq_ps)) {
+        dma_irq_mask(TX_CH, masked);
+        dma_irq_mask(RX_CH, masked);
+        if (masked) {
+            NVIC_DisableIRQn(SPI_HW_IRQN);
+        } else {
+            NVIC_EnableIRQn(SPI_HW_IRQN);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void spi_hw_install(spi_hw_vtable_t *pv) {
+    pv->hw_init = hw_init;
+    pv->hw_start = hw_start;
+    pv->hw_poll_done = hw_poll_done;
+    pv->hw_link = hw_link;
+    pv->hw_error = hw_error;
+    pv->hw_irq_mask = hw_irq_mask;
+}
+
+//------------------------------------------------------------------------------
+void spi_hw_enable_irq(spi_t *ps) {
+    // Transfer complete of the Rx channel and errors of both, enabled per
+    // start; SPI errors, enabled by hw_init()
+    s_irq_ps = ps;
+    if (s_dma_ready) {
+        dma_irq_mask(TX_CH, false);
+        dma_irq_mask(RX_CH, false);
+    }
+    NVIC_EnableIRQn(SPI_HW_IRQN);
+}
+
+//------------------------------------------------------------------------------
+// Interrupt Service Routines
+//------------------------------------------------------------------------------
+// Mode fault or overrun: hw_error() reports it and clears the flags
+void SPI_HW_IRQHandler(void) {
+    if (s_irq_ps) {
+        (void)spi_isr(s_irq_ps);
+    }
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SPI_HW_H_
+#define INCLUDE_SPI_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the selected STM32H5 SPI hardware backend: SPI_HW_SPI
+// as master, fed and drained by two GPDMA1 channels from the DMA allocator.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "spi_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Transfers with the DMA at once (started plus chained), a power of two
+#ifndef SPI_HW_CHAIN_MAX
+#define SPI_HW_CHAIN_MAX  8u
+#endif
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void spi_hw_install(spi_hw_vtable_t *pv);
+
+//------------------------------------------------------------------------------
+// Run spi_isr() on ps from the Rx channel's interrupt at the end of each
+// transfer, and from SPI_HW_IRQN or either channel's interrupt on an error
+void spi_hw_enable_irq(spi_t *ps);
+
+//------------------------------------------------------------------------------
+// SPI_HW_IRQN vector, defined by the backend
+void SPI_HW_IRQHandler(void);
+
+#endif // INCLUDE_SPI_HW_H_
@@ -17,13 +17,35 @@ g_pfnVectors:
     .word Default_Handler   /* DebugMon */
     .word 0                 /* Reserved */
     .word Default_Handler   /* PendSV */
-    .word Default_Handler   /* SysTick */
+    .word SysTick_Handler
+    /* Peripheral interrupts, IRQ 0 onwards */
+    .rept 27
+    .word Default_Handler   /* IRQ 0..26 */
+    .endr
+    .word GPDMA1_Channel0_IRQHandler /* IRQ 27 */
+    .word GPDMA1_Channel1_IRQHandler /* IRQ 28 */
+    .word GPDMA1_Channel2_IRQHandler /* IRQ 29 */
+    .word GPDMA1_Channel3_IRQHandler /* IRQ 30 */
+    .word GPDMA1_Channel4_IRQHandler /* IRQ 31 */
+    .word GPDMA1_Channel5_IRQHandler /* IRQ 32 */
+    .word GPDMA1_Channel6_IRQHandler /* IRQ 33 */
+    .word GPDMA1_Channel7_IRQHandler /* IRQ 34 */
+    .rept 20
+    .word Default_Handler   /* IRQ 35..54 */
+    .endr
+    .word SPI1_IRQHandler   /* IRQ 55 */
+    .rept 4
+    .word Default_Handler   /* IRQ 56..59 */
+    .endr
+    .word USART3_IRQHandler /* IRQ 60 */
     /* Extend for peripherals ... */
 
     .text
     .thumb
     .align 2
     .global Reset_Handler
+    .type Reset_Handler, %function
+    .thumb_func
 Reset_Handler:
     /* Copy .data from FLASH to RAM */
     ldr r0, =_sdata
@@ -39,7 +61,7 @@ Reset_Handler:
     /* Zero out bss */
     ldr r0, =_sbss
     ldr r1, =_ebss
-    movs r0, #0
+    movs r2, #0
 2:
     cmp r0, r1
     itt lt
@@ -55,5 +77,31 @@ Reset_Handler:
 3:  b 3b
 
     .weak Default_Handler
+    .type Default_Handler, %function
+    .thumb_func
 Default_Handler:
     b Default_Handler
+
+    /* Handlers a driver may override, default to spinning */
+    .weak SysTick_Handler
+    .thumb_set SysTick_Handler, Default_Handler
+    .weak SPI1_IRQHandler
+    .thumb_set SPI1_IRQHandler, Default_Handler
+    .weak USART3_IRQHandler
+    .thumb_set USART3_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel0_IRQHandler
+    .thumb_set GPDMA1_Channel0_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel1_IRQHandler
+    .thumb_set GPDMA1_Channel1_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel2_IRQHandler
+    .thumb_set GPDMA1_Channel2_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel3_IRQHandler
+    .thumb_set GPDMA1_Channel3_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel4_IRQHandler
+    .thumb_set GPDMA1_Channel4_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel5_IRQHandler
+    .thumb_set GPDMA1_Channel5_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel6_IRQHandler
+    .thumb_set GPDMA1_Channel6_IRQHandler, Default_Handler
+    .weak GPDMA1_Channel7_IRQHandler
+    .thumb_set GPDMA1_Channel7_IRQHandler, Default_Handler
@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the functionality to install and initialize the STM32H5
+// timebase hardware: SysTick drives the tick, DWT counts core cycles.
+//
+//------------------------------------------------------------------------------
+
+#include "timebase_hw.h"
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+static bool hw_init(uint32_t tick_hz) {
+    uint32_t reload = SYSTEM_CORE_CLK_HZ / tick_hz;
+    if (reload == 0u || (reload - 1u) > SYST_RVR_MAX) {
+        return false;
+    }
+
+    // Free-running cycle counter for now()
+    REG32(DCB_DEMCR_ADDR) |= DCB_DEMCR_TRCENA;
+    REG32(DWT_CYCCNT_ADDR) = 0u;
+    REG32(DWT_CTRL_ADDR) |= DWT_CTRL_CYCCNTENA;
+
+    // Stop -> Configure -> Start with interrupt from the processor clock
+    REG32(SYST_CSR_ADDR) = 0u;
+    REG32(SYST_RVR_ADDR) = reload - 1u;
+    REG32(SYST_CVR_ADDR) = 0u;
+    REG32(SYST_CSR_ADDR) =
+        SYST_CSR_CLKSOURCE | SYST_CSR_TICKINT | SYST_CSR_ENABLE;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_cycles(void) {
+    return REG32(DWT_CYCCNT_ADDR);
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_cycle_hz(void) {
+    return SYSTEM_CORE_CLK_HZ;
+}
+
+//------------------------------------------------------------------------------
+void timebase_hw_install(timebase_hw_vtable_t *pv) {
+    pv->hw_init = hw_init;
+    pv->hw_cycles = hw_cycles;
+    pv->hw_cycle_hz = hw_cycle_hz;
+}
+
+//------------------------------------------------------------------------------
+// SysTick exception, overrides the weak default in the startup vector table
+void SysTick_Handler(void) {
+    timebase_isr_tick();
+}
@@ -0,0 +1,24 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TIMEBASE_HW_H_
+#define INCLUDE_TIMEBASE_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the STM32H5 timebase backend: SysTick for the tick,
+// DWT for the cycle counter. Initializing it also enables the cycle counter
+// that the UART backend uses for Rx arrival timestamps.
+//
+//------------------------------------------------------------------------------
+
+#include "timebase_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void timebase_hw_install(timebase_hw_vtable_t *pv);
+
+#endif // INCLUDE_TIMEBASE_HW_H_
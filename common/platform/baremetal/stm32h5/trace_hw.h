@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TRACE_HW_H_
+#define INCLUDE_TRACE_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header defines the STM32H5 trace backend: trace point id n drives pin
+// TRACE_HW_FIRST_PIN + n of TRACE_HW_PORT, high on enter and low on exit,
+// each with a single BSRR store to a constant address.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "gpio_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Reserved pins, PE2..PE7 by default (Zio/morpho header on NUCLEO-H563ZI)
+#ifndef TRACE_HW_PORT
+#define TRACE_HW_PORT       GPIO_PORT_E
+#endif
+#ifndef TRACE_HW_FIRST_PIN
+#define TRACE_HW_FIRST_PIN  2u
+#endif
+#ifndef TRACE_HW_CHANNELS
+#define TRACE_HW_CHANNELS   6u
+#endif
+
+_Static_assert(TRACE_HW_FIRST_PIN + TRACE_HW_CHANNELS <= GPIO_PORT_PINS,
+    "trace channels must fit in one port");
+
+#define TRACE_HW_BIT(id)    (1u << (TRACE_HW_FIRST_PIN + (id)))
+#define TRACE_HW_BSRR       GPIO_HW_REG(TRACE_HW_PORT, GPIO_BSRR_OFFSET)
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+static inline void trace_backend_init(void) {
+    static const gpio_config_t cfg = {
+        .mode  = GPIO_MODE_OUTPUT,
+        .otype = GPIO_OTYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_VERY_HIGH,
+        .pull  = GPIO_PULL_NONE,
+    };
+    for (uint32_t id = 0; id < TRACE_HW_CHANNELS; ++id) {
+        (void)gpio_hw_configure(
+            GPIO_PIN(TRACE_HW_PORT, TRACE_HW_FIRST_PIN + id), &cfg);
+    }
+    TRACE_HW_BSRR = GPIO_BSRR(0u, TRACE_HW_BIT(0) * ((1u << TRACE_HW_CHANNELS) - 1u));
+}
+
+//------------------------------------------------------------------------------
+// Identifiers past the reserved channels are dropped at compile time
+static inline void trace_backend_enter(uint32_t id) {
+    if (id < TRACE_HW_CHANNELS) {
+        TRACE_HW_BSRR = GPIO_BSRR(TRACE_HW_BIT(id), 0u);
+    }
+}
+
+//------------------------------------------------------------------------------
+static inline void trace_backend_exit(uint32_t id) {
+    if (id < TRACE_HW_CHANNELS) {
+        TRACE_HW_BSRR = GPIO_BSRR(0u, TRACE_HW_BIT(id));
+    }
+}
+
+#endif // INCLUDE_TRACE_HW_H_
@@ -10,44 +10,55 @@
 //------------------------------------------------------------------------------
 
 #include "uart_hw.h"
+#include "gpio_hw.h"
 
 //------------------------------------------------------------------------------
 // Constants
 //------------------------------------------------------------------------------
 
-#define GPIO_REG(base, offset)   REG32((uintptr_t)(base) + (offset))
 #define USART_REG(base, offset)  REG32((uintptr_t)(base) + (offset))
 
-#define GPIO_MODE_MASK(pin)      (0x3u << ((pin) * 2u))
-#define GPIO_AF_MASK(pin)        (0xFu << (((pin) % 8u) * 4u))
-#define GPIO_AFR_OFFSET(pin)     (((pin) < 8u) ? GPIO_AFRL_OFFSET : GPIO_AFRH_OFFSET)
+// Bit durations per character for the 8N1 frame configured by hw_init()
+#define UART_HW_BITS_PER_CHAR    10u
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Rx line errors cleared in HW but not yet reported to the core
+static volatile uint32_t s_rx_errors;
+
+// Tx/Rx pins: alternate function, high speed, pull-up, push-pull
+static const gpio_config_t s_pin_cfg = {
+    .mode  = GPIO_MODE_AF,
+    .otype = GPIO_OTYPE_PUSH_PULL,
+    .speed = GPIO_SPEED_HIGH,
+    .pull  = GPIO_PULL_UP,
+    .af    = UART_HW_AF_NUM,
+};
 
 //------------------------------------------------------------------------------
 // Function Definitions
 //------------------------------------------------------------------------------
-// Helper to set GPIO alternate function
-static inline void gpio_set_af(uintptr_t gpio_base, uint32_t pin, uint32_t af) {
-    uint32_t af_shift = (pin % 8u) * 4u;
-    uint32_t mode_shift = pin * 2u;
-
-    // Set GPIO Mode: 10 = Alternate Function
-    GPIO_REG(gpio_base, GPIO_MODER_OFFSET) =
-        (GPIO_REG(gpio_base, GPIO_MODER_OFFSET) & ~GPIO_MODE_MASK(pin)) |
-        (GPIO_MODER_AF << mode_shift);
-
-    // Set Alternate Function: AFRL for 0..7, AFRH for 8..15.
-    GPIO_REG(gpio_base, GPIO_AFR_OFFSET(pin)) =
-        (GPIO_REG(gpio_base, GPIO_AFR_OFFSET(pin)) & ~GPIO_AF_MASK(pin)) |
-        ((af & 0xFu) << af_shift);
-
-    // Set high speed, pull-up, push-pull.
-    GPIO_REG(gpio_base, GPIO_OSPEEDR_OFFSET) =
-        (GPIO_REG(gpio_base, GPIO_OSPEEDR_OFFSET) & ~GPIO_MODE_MASK(pin)) |
-        (GPIO_OSPEED_HI << mode_shift);
-    GPIO_REG(gpio_base, GPIO_PUPDR_OFFSET) =
-        (GPIO_REG(gpio_base, GPIO_PUPDR_OFFSET) & ~GPIO_MODE_MASK(pin)) |
-        (GPIO_PUPDR_PU << mode_shift);
-    GPIO_REG(gpio_base, GPIO_OTYPER_OFFSET) &= ~(1u << pin);
+// Helper to clear any Rx line errors found in a sampled ISR value
+// Notes:
+//    - ORE stops the receiver from loading RDR until it is cleared, so it
+//      must be cleared as soon as it is seen, not when the core asks for it
+//    - The mapping to core error kinds is latched for hw_rx_errors()
+static inline void rx_errors_clear(uint32_t isr) {
+    uint32_t flags = isr & USART_ISR_RX_ERRORS;
+    if (flags == 0u) {
+        return;
+    }
+    // ICR clear bits share the ISR bit positions
+    USART_REG(UART_HW_USART, USART_ICR_OFFSET) = flags;
+
+    uint32_t err_mask = 0u;
+    if (flags & USART_ISR_ORE) err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN);
+    if (flags & USART_ISR_FE)  err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_FRAMING);
+    if (flags & USART_ISR_NE)  err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_NOISE);
+    if (flags & USART_ISR_PE)  err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_PARITY);
+    s_rx_errors |= err_mask;
 }
 
 //------------------------------------------------------------------------------
@@ -57,8 +68,9 @@ static bool hw_init(uint32_t baud) {
     }
 
     UART_HW_EnableClocks();
-    gpio_set_af(UART_HW_TX_GPIO, UART_HW_TX_PIN, UART_HW_AF_NUM);
-    gpio_set_af(UART_HW_RX_GPIO, UART_HW_RX_PIN, UART_HW_AF_NUM);
+
+    (void)gpio_hw_configure(UART_HW_TX_GPIO_PIN, &s_pin_cfg);
+    (void)gpio_hw_configure(UART_HW_RX_GPIO_PIN, &s_pin_cfg);
 
     // Disable -> Configure 8N1 -> Enable
     USART_REG(UART_HW_USART, USART_CR1_OFFSET) &= ~USART_CR1_UE;
@@ -72,6 +84,10 @@ static bool hw_init(uint32_t baud) {
     USART_REG(UART_HW_USART, USART_CR1_OFFSET) =
         USART_CR1_TE | USART_CR1_RE | USART_CR1_UE;
 
+    // Drop any errors latched against the previous configuration
+    USART_REG(UART_HW_USART, USART_ICR_OFFSET) = USART_ISR_RX_ERRORS;
+    s_rx_errors = 0u;
+
     return true;
 }
 
@@ -88,8 +104,10 @@ static void hw_tx_write(uint8_t byte) {
 
 //------------------------------------------------------------------------------
 static bool hw_rx_available(void) {
-    return (USART_REG(UART_HW_USART, USART_ISR_OFFSET) &
-        USART_ISR_RXNE_RXFNE) != 0u;
+    // Sample once: error flags and RXNE are checked from the same snapshot
+    uint32_t isr = USART_REG(UART_HW_USART, USART_ISR_OFFSET);
+    rx_errors_clear(isr);
+    return (isr & USART_ISR_RXNE_RXFNE) != 0u;
 }
 
 //------------------------------------------------------------------------------
@@ -97,6 +115,57 @@ static uint8_t hw_rx_read(void) {
     return (uint8_t)USART_REG(UART_HW_USART, USART_RDR_OFFSET);
 }
 
+//------------------------------------------------------------------------------
+static uint32_t hw_rx_errors(void) {
+    // Pick up anything raised since the last availability check
+    rx_errors_clear(USART_REG(UART_HW_USART, USART_ISR_OFFSET));
+    uint32_t err_mask = s_rx_errors;
+    s_rx_errors = 0u;
+    return err_mask;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_rx_timeout_config(uint32_t char_times) {
+    uint32_t cr1 = USART_REG(UART_HW_USART, USART_CR1_OFFSET);
+
+    if (char_times == 0u) {
+        USART_REG(UART_HW_USART, USART_CR2_OFFSET) &= ~USART_CR2_RTOEN;
+        USART_REG(UART_HW_USART, USART_ICR_OFFSET) = USART_ICR_RTOCF;
+        return true;
+    }
+    if (char_times > (USART_RTOR_RTO_MASK / UART_HW_BITS_PER_CHAR)) {
+        return false;
+    }
+
+    // RTOR counts bit durations from the end of the last stop bit
+    USART_REG(UART_HW_USART, USART_RTOR_OFFSET) =
+        (USART_REG(UART_HW_USART, USART_RTOR_OFFSET) & ~USART_RTOR_RTO_MASK) |
+        (char_times * UART_HW_BITS_PER_CHAR);
+
+    // Disable -> Enable timeout -> Restore
+    USART_REG(UART_HW_USART, USART_CR1_OFFSET) = cr1 & ~USART_CR1_UE;
+    USART_REG(UART_HW_USART, USART_CR2_OFFSET) |= USART_CR2_RTOEN;
+    USART_REG(UART_HW_USART, USART_ICR_OFFSET) = USART_ICR_RTOCF;
+    USART_REG(UART_HW_USART, USART_CR1_OFFSET) = cr1;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_rx_timeout_expired(void) {
+    if ((USART_REG(UART_HW_USART, USART_ISR_OFFSET) & USART_ISR_RTOF) == 0u) {
+        return false;
+    }
+    USART_REG(UART_HW_USART, USART_ICR_OFFSET) = USART_ICR_RTOCF;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_timestamp(void) {
+    // Core clock cycles, wraps every 2^32 cycles; reads 0 until startup code
+    // enables the cycle counter
+    return REG32(DWT_CYCCNT_ADDR);
+}
+
 //------------------------------------------------------------------------------
 void uart_hw_install(uart_hw_vtable_t *pv) {
     pv->hw_init = hw_init;
@@ -104,8 +173,42 @@ void uart_hw_install(uart_hw_vtable_t *pv) {
     pv->hw_tx_write = hw_tx_write;
     pv->hw_rx_available = hw_rx_available;
     pv->hw_rx_read = hw_rx_read;
+    pv->hw_rx_errors = hw_rx_errors;
+    pv->hw_rx_timeout_config = hw_rx_timeout_config;
+    pv->hw_rx_timeout_expired = hw_rx_timeout_expired;
+    pv->hw_timestamp = hw_timestamp;
+    // Byte-wide data registers: no block transfers
+    pv->hw_rx_read_block = NULL;
+    pv->hw_tx_write_block = NULL;
 }
 
 bool uart_hw_reinit(uint32_t baud) {
     return hw_init(baud);
 }
+
+//------------------------------------------------------------------------------
+void uart_hw_enable_rx_irq(void) {
+    // Timeout interrupt only fires while RTOEN is set by hw_rx_timeout_config()
+    USART_REG(UART_HW_USART, USART_CR1_OFFSET) |=
+        USART_CR1_RXNEIE | USART_CR1_RTOIE;
+    USART_REG(UART_HW_USART, USART_CR3_OFFSET) |= USART_CR3_EIE;
+    NVIC_EnableIRQn(UART_HW_IRQN);
+}
+
+//------------------------------------------------------------------------------
+void uart_hw_arm_tx_irq(void) {
+    USART_REG(UART_HW_USART, USART_CR1_OFFSET) |= USART_CR1_TXEIE;
+    NVIC_EnableIRQn(UART_HW_IRQN);
+}
+
+//------------------------------------------------------------------------------
+bool uart_hw_tx_irq_fired(void) {
+    uint32_t cr1 = USART_REG(UART_HW_USART, USART_CR1_OFFSET);
+    if ((cr1 & USART_CR1_TXEIE) == 0u || !hw_tx_ready()) {
+        return false;
+    }
+    // TXE stays set until TDR is written, so disarm before returning to the
+    // task that will write it
+    USART_REG(UART_HW_USART, USART_CR1_OFFSET) = cr1 & ~USART_CR1_TXEIE;
+    return true;
+}
@@ -9,6 +9,11 @@
 //
 // This header specifies the selected STM32H5 UART hardware backend.
 //
+// Rx arrival timestamps read the DWT cycle counter, which this backend does
+// not enable: the timebase (timebase_hw.h) or scheduler (sched_hw.h) backend,
+// or the application's startup code, must do so before Rx timestamps are
+// meaningful.
+//
 //------------------------------------------------------------------------------
 
 #include <stdbool.h>
@@ -25,4 +30,21 @@ void uart_hw_install(uart_hw_vtable_t *pv);
 // Change baud at run-time
 bool uart_hw_reinit(uint32_t baud);
 
+//------------------------------------------------------------------------------
+// Raise UART_HW_IRQN on Rx data, Rx errors and Rx timeout; the application's
+// UART_HW_IRQHandler is then expected to call uart_poll_rx()
+void uart_hw_enable_rx_irq(void);
+
+//------------------------------------------------------------------------------
+// Raise UART_HW_IRQN once the Tx data register can take another byte
+// Notes:
+//    - One-shot: arm it from task context while bytes wait in the Tx FIFO,
+//      and let the handler disarm it with uart_hw_tx_irq_fired()
+void uart_hw_arm_tx_irq(void);
+
+//------------------------------------------------------------------------------
+// From UART_HW_IRQHandler: true if the armed Tx interrupt fired, in which case
+// it is disarmed again
+bool uart_hw_tx_irq_fired(void);
+
 #endif // INCLUDE_UART_HW_H_
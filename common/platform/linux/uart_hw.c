@@ -0,0 +1,333 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the Linux UART backend over termios and epoll
+//
+//------------------------------------------------------------------------------
+
+// cfmakeraw() and the extended baud rates
+#define _DEFAULT_SOURCE
+
+#include "uart_hw.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Bit durations per character for the 8N1 frame configured by hw_init()
+#define UART_HW_BITS_PER_CHAR  10u
+
+// Supported rates
+typedef struct {
+    uint32_t baud;
+    speed_t  speed;
+} baud_map_t;
+
+static const baud_map_t s_bauds[] = {
+    { 1200u,    B1200    }, { 2400u,    B2400    }, { 4800u,    B4800    },
+    { 9600u,    B9600    }, { 19200u,   B19200   }, { 38400u,   B38400   },
+    { 57600u,   B57600   }, { 115200u,  B115200  }, { 230400u,  B230400  },
+    { 460800u,  B460800  }, { 921600u,  B921600  }, { 1000000u, B1000000 },
+    { 1500000u, B1500000 }, { 2000000u, B2000000 }, { 3000000u, B3000000 },
+    { 4000000u, B4000000 },
+};
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static const char *s_path;
+static int s_fd = -1;
+static int s_epfd = -1;
+static uint32_t s_baud;
+
+// EPOLLOUT is only armed while the kernel pushes back on Tx
+static bool s_tx_armed;
+
+// Receiver timeout emulated from the time of the last read
+static uint32_t s_rx_timeout_us;
+static uint32_t s_rx_last_us;
+static bool s_rx_silence_pending;
+
+// Line error counters from the serial driver (not available on ptys)
+static bool s_have_icount;
+static struct serial_icounter_struct s_icount;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper for a wrapping microsecond clock
+static uint32_t now_us(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+//------------------------------------------------------------------------------
+// Helper to change the epoll interest set only when Tx backpressure changes
+static void tx_arm(bool arm) {
+    if (arm == s_tx_armed) {
+        return;
+    }
+    struct epoll_event ev = {
+        .events = EPOLLIN | (arm ? EPOLLOUT : 0u),
+        .data.fd = s_fd,
+    };
+    if (epoll_ctl(s_epfd, EPOLL_CTL_MOD, s_fd, &ev) == 0) {
+        s_tx_armed = arm;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper to mark Rx activity for the emulated receiver timeout
+static inline void rx_activity(void) {
+    if (s_rx_timeout_us) {
+        s_rx_last_us = now_us();
+        s_rx_silence_pending = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+static bool hw_init(uint32_t baud) {
+    speed_t speed = 0;
+    bool found = false;
+    for (size_t i = 0; i < sizeof(s_bauds) / sizeof(s_bauds[0]); ++i) {
+        if (s_bauds[i].baud == baud) {
+            speed = s_bauds[i].speed;
+            found = true;
+            break;
+        }
+    }
+    if (!found || !s_path) {
+        return false;
+    }
+
+    uart_hw_close();
+    s_fd = open(s_path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (s_fd < 0) {
+        return false;
+    }
+
+    // Raw 8N1, no flow control, reads never block (VMIN = VTIME = 0)
+    struct termios tio;
+    if (tcgetattr(s_fd, &tio) != 0) {
+        uart_hw_close();
+        return false;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if (cfsetispeed(&tio, speed) != 0 || cfsetospeed(&tio, speed) != 0 ||
+            tcsetattr(s_fd, TCSANOW, &tio) != 0) {
+        uart_hw_close();
+        return false;
+    }
+    // Drop anything received before we were configured
+    (void)tcflush(s_fd, TCIFLUSH);
+
+    s_epfd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev = { .events = EPOLLIN, .data.fd = s_fd };
+    if (s_epfd < 0 || epoll_ctl(s_epfd, EPOLL_CTL_ADD, s_fd, &ev) != 0) {
+        uart_hw_close();
+        return false;
+    }
+    s_tx_armed = false;
+    s_baud = baud;
+    s_rx_silence_pending = false;
+
+    // Baseline for line error deltas
+    s_have_icount = (ioctl(s_fd, TIOCGICOUNT, &s_icount) == 0);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_tx_ready(void) {
+    struct pollfd pfd = { .fd = s_fd, .events = POLLOUT };
+    return (poll(&pfd, 1, 0) == 1) && (pfd.revents & POLLOUT);
+}
+
+//------------------------------------------------------------------------------
+static void hw_tx_write(uint8_t byte) {
+    // Only called after hw_tx_ready(), so a one byte write is accepted
+    (void)write(s_fd, &byte, 1);
+}
+
+//------------------------------------------------------------------------------
+static bool hw_rx_available(void) {
+    int n = 0;
+    return (ioctl(s_fd, FIONREAD, &n) == 0) && (n > 0);
+}
+
+//------------------------------------------------------------------------------
+static uint8_t hw_rx_read(void) {
+    uint8_t byte = 0;
+    if (read(s_fd, &byte, 1) == 1) {
+        rx_activity();
+    }
+    return byte;
+}
+
+//------------------------------------------------------------------------------
+static size_t hw_rx_read_block(uint8_t *pdst, size_t max) {
+    ssize_t n = read(s_fd, pdst, max);
+    if (n <= 0) {
+        // EAGAIN: drained; EIO: pty peer closed; either way nothing read
+        return 0;
+    }
+    rx_activity();
+    return (size_t)n;
+}
+
+//------------------------------------------------------------------------------
+static size_t hw_tx_write_block(const uint8_t *psrc, size_t len) {
+    ssize_t n = write(s_fd, psrc, len);
+    if (n < 0) {
+        n = 0;
+    }
+    // Wait for EPOLLOUT only while the kernel buffer is full
+    tx_arm((size_t)n < len);
+    return (size_t)n;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_rx_errors(void) {
+    struct serial_icounter_struct now;
+    if (!s_have_icount || ioctl(s_fd, TIOCGICOUNT, &now) != 0) {
+        return 0;
+    }
+    uint32_t err_mask = 0;
+    if (now.overrun != s_icount.overrun ||
+            now.buf_overrun != s_icount.buf_overrun) {
+        err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN);
+    }
+    if (now.frame != s_icount.frame || now.brk != s_icount.brk) {
+        err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_FRAMING);
+    }
+    if (now.parity != s_icount.parity) {
+        err_mask |= UART_RX_ERR_MASK(UART_RX_ERR_PARITY);
+    }
+    s_icount = now;
+    return err_mask;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_rx_timeout_config(uint32_t char_times) {
+    // Character times at the configured rate, rounded up
+    uint64_t us = ((uint64_t)char_times * UART_HW_BITS_PER_CHAR * 1000000u +
+        s_baud - 1u) / (s_baud ? s_baud : 1u);
+    if (us > UINT32_MAX / 2u) {
+        return false;
+    }
+    s_rx_timeout_us = (uint32_t)us;
+    s_rx_silence_pending = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool hw_rx_timeout_expired(void) {
+    if (!s_rx_silence_pending ||
+            (now_us() - s_rx_last_us) < s_rx_timeout_us) {
+        return false;
+    }
+    s_rx_silence_pending = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t hw_timestamp(void) {
+    // Microseconds, wraps every ~71 minutes
+    return now_us();
+}
+
+//------------------------------------------------------------------------------
+void uart_hw_install(uart_hw_vtable_t *pv) {
+    pv->hw_init = hw_init;
+    pv->hw_tx_ready = hw_tx_ready;
+    pv->hw_tx_write = hw_tx_write;
+    pv->hw_rx_available = hw_rx_available;
+    pv->hw_rx_read = hw_rx_read;
+    pv->hw_rx_errors = hw_rx_errors;
+    pv->hw_rx_timeout_config = hw_rx_timeout_config;
+    pv->hw_rx_timeout_expired = hw_rx_timeout_expired;
+    pv->hw_timestamp = hw_timestamp;
+    pv->hw_rx_read_block = hw_rx_read_block;
+    pv->hw_tx_write_block = hw_tx_write_block;
+}
+
+//------------------------------------------------------------------------------
+void uart_hw_set_device(const char *path) {
+    s_path = path;
+}
+
+//------------------------------------------------------------------------------
+bool uart_hw_reinit(uint32_t baud) {
+    return hw_init(baud);
+}
+
+//------------------------------------------------------------------------------
+void uart_hw_close(void) {
+    if (s_epfd >= 0) {
+        (void)close(s_epfd);
+        s_epfd = -1;
+    }
+    if (s_fd >= 0) {
+        (void)close(s_fd);
+        s_fd = -1;
+    }
+    s_tx_armed = false;
+}
+
+//------------------------------------------------------------------------------
+int uart_hw_fd(void) {
+    return s_fd;
+}
+
+//------------------------------------------------------------------------------
+int uart_hw_epoll_fd(void) {
+    return s_epfd;
+}
+
+//------------------------------------------------------------------------------
+int uart_hw_wait(int timeout_ms) {
+    if (s_epfd < 0) {
+        return -1;
+    }
+    // Wake in time to report a pending receiver timeout
+    if (s_rx_silence_pending) {
+        uint32_t elapsed = now_us() - s_rx_last_us;
+        uint32_t left_ms = (elapsed >= s_rx_timeout_us) ? 0u :
+            (s_rx_timeout_us - elapsed + 999u) / 1000u;
+        if (timeout_ms < 0 || (uint32_t)timeout_ms > left_ms) {
+            timeout_ms = (int)left_ms;
+        }
+    }
+    struct epoll_event ev;
+    int n = epoll_wait(s_epfd, &ev, 1, timeout_ms);
+    if (n < 0) {
+        return (errno == EINTR) ? 0 : -1;
+    }
+    int events = 0;
+    if (n == 1) {
+        if (ev.events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+            events |= UART_HW_EV_RX;
+        }
+        if (ev.events & EPOLLOUT) {
+            events |= UART_HW_EV_TX;
+        }
+    }
+    return events;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_UART_HW_H_
+#define INCLUDE_UART_HW_H_
+//------------------------------------------------------------------------------
+//
+// This header specifies the Linux UART backend: a termios serial device or
+// pty in raw 8N1 mode, non-blocking, with an epoll set for the event loop.
+//
+// Like the MCU backends, the vtable carries no context, so one process drives
+// one device through this backend.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Event bits returned by uart_hw_wait()
+#define UART_HW_EV_RX  (1u << 0)
+#define UART_HW_EV_TX  (1u << 1)
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void uart_hw_install(uart_hw_vtable_t *pv);
+
+//------------------------------------------------------------------------------
+// Select the device (e.g., /dev/ttyUSB0 or a pty slave) opened by hw_init;
+// the path is not copied and must outlive the backend
+void uart_hw_set_device(const char *path);
+
+//------------------------------------------------------------------------------
+// Change baud at run-time
+bool uart_hw_reinit(uint32_t baud);
+
+//------------------------------------------------------------------------------
+// Close the device and the epoll set
+void uart_hw_close(void);
+
+//------------------------------------------------------------------------------
+// Device and epoll descriptors, -1 when closed; the epoll descriptor can be
+// nested in an application's own epoll set
+int uart_hw_fd(void);
+int uart_hw_epoll_fd(void);
+
+//------------------------------------------------------------------------------
+// Sleep until the device is readable, writable after Tx backpressure, or a
+// configured Rx timeout falls due; then call uart_poll_rx() and
+// uart_service_tx()
+// Returns UART_HW_EV_* bits, 0 on timeout, -1 on error
+int uart_hw_wait(int timeout_ms);
+
+#endif // INCLUDE_UART_HW_H_
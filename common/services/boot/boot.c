@@ -0,0 +1,406 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the UART bootloader core
+//
+// Notes:
+//    - Commands are handled as their frames are decoded; work that waits on
+//      the flash (erasing, programming, read-back) moves on one step per
+//      boot_poll(), so received data keeps being drained in between
+//    - Buffers form a ring: DATA fills buf[(head + count) % buffers], the
+//      flash empties buf[head]
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "boot_api.h"
+#include "crc_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define ST_IDLE       0u
+#define ST_ERASING    1u
+#define ST_RECEIVING  2u
+// END received: programming the last buffers
+#define ST_FINISHING  3u
+#define ST_VERIFYING  4u
+#define ST_RECORDING  5u
+#define ST_DONE       6u
+
+// Flash read back per poll
+#define VERIFY_CHUNK  256u
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static inline uint32_t get32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+        ((uint32_t)p[3] << 24);
+}
+
+//------------------------------------------------------------------------------
+static inline void put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+//------------------------------------------------------------------------------
+static uint32_t flash_crc(const flash_hw_vtable_t *pf, uint32_t crc,
+        uint32_t addr, uint32_t len) {
+    uint8_t chunk[VERIFY_CHUNK];
+    while (len) {
+        uint32_t n = (len < sizeof(chunk)) ? len : (uint32_t)sizeof(chunk);
+        pf->hw_read(addr, chunk, n);
+        crc = crc32_update(crc, chunk, n);
+        addr += n;
+        len -= n;
+    }
+    return crc;
+}
+
+//------------------------------------------------------------------------------
+// Queue a reply; one is outstanding at most, as the host waits for it
+static void reply(boot_t *pb, uint8_t cmd, uint8_t status, uint32_t value) {
+    uint8_t payload[BOOT_REPLY_BYTES];
+    payload[0] = cmd | BOOT_REPLY;
+    payload[1] = status;
+    put32(&payload[2], value);
+    pb->out_len = frame_encode(payload, sizeof(payload), pb->out, sizeof(pb->out));
+    pb->out_due = true;
+}
+
+//------------------------------------------------------------------------------
+// Abandon the update, answering the command waiting on it, or else the next
+// one
+static void fail(boot_t *pb, uint8_t status) {
+    pb->state = ST_IDLE;
+    pb->count = 0;
+    pb->error = status;
+    if (pb->waiting) {
+        reply(pb, pb->waiting, status, pb->next);
+        pb->waiting = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+static inline uint8_t state_error(const boot_t *pb) {
+    return pb->error ? pb->error : BOOT_ERR_STATE;
+}
+
+//------------------------------------------------------------------------------
+static void on_begin(boot_t *pb, const uint8_t *p, size_t len) {
+    if (len != 9u) {
+        reply(pb, BOOT_CMD_BEGIN, BOOT_ERR_CMD, 0u);
+        return;
+    }
+    uint32_t size = get32(&p[1]);
+    if (size == 0u || size > pb->layout.app_max) {
+        reply(pb, BOOT_CMD_BEGIN, BOOT_ERR_SIZE, pb->layout.app_max);
+        return;
+    }
+    if (!pb->flash.hw_unlock()) {
+        reply(pb, BOOT_CMD_BEGIN, BOOT_ERR_FLASH, 0u);
+        return;
+    }
+    uint32_t sector = pb->flash.sector_bytes;
+    pb->size = size;
+    pb->crc = get32(&p[5]);
+    pb->next = 0;
+    pb->head = 0;
+    pb->count = 0;
+    pb->error = 0;
+    pb->erase_record = true;
+    pb->erase_addr = pb->layout.app_base;
+    pb->erase_end = pb->layout.app_base + (size + sector - 1u) / sector * sector;
+    pb->state = ST_ERASING;
+    pb->waiting = BOOT_CMD_BEGIN;
+}
+
+//------------------------------------------------------------------------------
+static void on_data(boot_t *pb, const uint8_t *p, size_t len) {
+    if (pb->state != ST_RECEIVING) {
+        reply(pb, BOOT_CMD_DATA, state_error(pb), pb->next);
+        return;
+    }
+    uint32_t offset = get32(&p[1]);
+    uint32_t n = (uint32_t)(len - BOOT_DATA_HDR_BYTES);
+    if (offset < pb->next) {
+        // Its reply was lost
+        pb->stats.dups++;
+        reply(pb, BOOT_CMD_DATA, BOOT_OK, pb->next);
+        return;
+    }
+    if (offset > pb->next) {
+        reply(pb, BOOT_CMD_DATA, BOOT_ERR_SEQ, pb->next);
+        return;
+    }
+    // Only the last block may end off a quad-word boundary
+    if (n == 0u || n > BOOT_BLOCK_BYTES || n > pb->size - offset ||
+            ((n % FLASH_QWORD_BYTES) != 0u && offset + n != pb->size)) {
+        reply(pb, BOOT_CMD_DATA, BOOT_ERR_SIZE, pb->next);
+        return;
+    }
+    boot_buf_t *pbuf = &pb->buf[(pb->head + pb->count) % pb->buffers];
+    uint32_t padded = (n + FLASH_QWORD_BYTES - 1u) / FLASH_QWORD_BYTES *
+        FLASH_QWORD_BYTES;
+    memcpy(pbuf->data, &p[BOOT_DATA_HDR_BYTES], n);
+    memset(&pbuf->data[n], 0xFF, padded - n);
+    pbuf->addr = pb->layout.app_base + offset;
+    pbuf->len = padded;
+    pbuf->done = 0;
+    pb->count++;
+    pb->next += n;
+    pb->stats.blocks++;
+    if (pb->count < pb->buffers) {
+        reply(pb, BOOT_CMD_DATA, BOOT_OK, pb->next);
+    } else {
+        // Room for the next block once the oldest is programmed
+        pb->waiting = BOOT_CMD_DATA;
+        pb->stats.held++;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void on_end(boot_t *pb) {
+    if (pb->state == ST_DONE) {
+        reply(pb, BOOT_CMD_END, BOOT_OK, pb->crc);
+    } else if (pb->state != ST_RECEIVING) {
+        reply(pb, BOOT_CMD_END, state_error(pb), pb->next);
+    } else if (pb->next != pb->size) {
+        reply(pb, BOOT_CMD_END, BOOT_ERR_SIZE, pb->next);
+    } else {
+        pb->state = ST_FINISHING;
+        pb->waiting = BOOT_CMD_END;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void on_run(boot_t *pb) {
+    if (pb->state == ST_DONE ||
+            (pb->state == ST_IDLE && boot_app_valid(&pb->flash, &pb->layout))) {
+        pb->flash.hw_lock();
+        pb->run = true;
+        reply(pb, BOOT_CMD_RUN, BOOT_OK, pb->layout.app_base);
+    } else {
+        reply(pb, BOOT_CMD_RUN, BOOT_ERR_STATE, 0u);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Context: frame_decoder_feed() in boot_poll()
+static void on_frame(void *pctx, const uint8_t *ppayload, size_t len) {
+    boot_t *pb = (boot_t*)pctx;
+    pb->contacted = true;
+    if (pb->waiting || pb->run) {
+        // A resend while the reply is pending: it follows in due course
+        return;
+    }
+    switch (ppayload[0]) {
+    case BOOT_CMD_HELLO:
+        reply(pb, BOOT_CMD_HELLO, BOOT_OK, BOOT_BLOCK_BYTES);
+        break;
+    case BOOT_CMD_BEGIN:
+        on_begin(pb, ppayload, len);
+        break;
+    case BOOT_CMD_DATA:
+        if (len > BOOT_DATA_HDR_BYTES) {
+            on_data(pb, ppayload, len);
+        } else {
+            reply(pb, BOOT_CMD_DATA, BOOT_ERR_CMD, pb->next);
+        }
+        break;
+    case BOOT_CMD_END:
+        on_end(pb);
+        break;
+    case BOOT_CMD_RUN:
+        on_run(pb);
+        break;
+    default:
+        reply(pb, ppayload[0] & (uint8_t)~BOOT_REPLY, BOOT_ERR_CMD, 0u);
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void erase_step(boot_t *pb) {
+    uint32_t addr;
+    if (pb->erase_record) {
+        pb->erase_record = false;
+        addr = pb->layout.record_addr;
+    } else if (pb->erase_addr < pb->erase_end) {
+        addr = pb->erase_addr;
+        pb->erase_addr += pb->flash.sector_bytes;
+    } else {
+        pb->state = ST_RECEIVING;
+        reply(pb, BOOT_CMD_BEGIN, BOOT_OK, pb->size);
+        pb->waiting = 0;
+        return;
+    }
+    if (!pb->flash.hw_erase_start(addr)) {
+        fail(pb, BOOT_ERR_FLASH);
+        return;
+    }
+    pb->stats.erases++;
+}
+
+//------------------------------------------------------------------------------
+static void program_step(boot_t *pb) {
+    boot_buf_t *pbuf = &pb->buf[pb->head];
+    if (pbuf->done == pbuf->len) {
+        // Buffer free: release the reply held for it
+        pb->head = (pb->head + 1u) % pb->buffers;
+        pb->count--;
+        if (pb->waiting == BOOT_CMD_DATA) {
+            reply(pb, BOOT_CMD_DATA, BOOT_OK, pb->next);
+            pb->waiting = 0;
+        }
+        return;
+    }
+    uint32_t qw[FLASH_QWORD_BYTES / 4u];
+    memcpy(qw, &pbuf->data[pbuf->done], sizeof(qw));
+    if (!pb->flash.hw_program_start(pbuf->addr + pbuf->done, qw)) {
+        fail(pb, BOOT_ERR_FLASH);
+        return;
+    }
+    pbuf->done += FLASH_QWORD_BYTES;
+    pb->stats.qwords++;
+}
+
+//------------------------------------------------------------------------------
+static void verify_step(boot_t *pb) {
+    uint32_t n = pb->size - pb->verify_off;
+    if (n > VERIFY_CHUNK) {
+        n = VERIFY_CHUNK;
+    }
+    pb->verify_crc = flash_crc(&pb->flash, pb->verify_crc,
+        pb->layout.app_base + pb->verify_off, n);
+    pb->verify_off += n;
+    if (pb->verify_off < pb->size) {
+        return;
+    }
+    if (crc32_final(pb->verify_crc) != pb->crc) {
+        fail(pb, BOOT_ERR_CRC);
+        return;
+    }
+    uint32_t rec[FLASH_QWORD_BYTES / 4u] = {
+        BOOT_RECORD_MAGIC, pb->size, pb->crc, ~BOOT_RECORD_MAGIC
+    };
+    if (!pb->flash.hw_program_start(pb->layout.record_addr, rec)) {
+        fail(pb, BOOT_ERR_FLASH);
+        return;
+    }
+    pb->state = ST_RECORDING;
+}
+
+//------------------------------------------------------------------------------
+// One step of flash work, once the previous one has finished
+static void flash_step(boot_t *pb) {
+    if (pb->state == ST_IDLE || pb->state == ST_DONE) {
+        return;
+    }
+    int status = pb->flash.hw_status();
+    if (status == FLASH_BUSY) {
+        return;
+    }
+    if (status == FLASH_ERROR) {
+        pb->stats.flash_errors++;
+        fail(pb, BOOT_ERR_FLASH);
+        return;
+    }
+    switch (pb->state) {
+    case ST_ERASING:
+        erase_step(pb);
+        break;
+    case ST_RECEIVING:
+        if (pb->count) {
+            program_step(pb);
+        }
+        break;
+    case ST_FINISHING:
+        if (pb->count) {
+            program_step(pb);
+        } else {
+            pb->verify_off = 0;
+            pb->verify_crc = CRC32_INIT;
+            pb->state = ST_VERIFYING;
+        }
+        break;
+    case ST_VERIFYING:
+        verify_step(pb);
+        break;
+    case ST_RECORDING:
+        pb->state = ST_DONE;
+        pb->flash.hw_lock();
+        reply(pb, BOOT_CMD_END, BOOT_OK, pb->crc);
+        pb->waiting = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool boot_init(boot_t *pb, uart_t *pu, const flash_hw_vtable_t *pflash,
+        const boot_layout_t *playout, uint32_t buffers) {
+    if (!pb || !pu || !pflash || !playout || buffers == 0u ||
+            buffers > BOOT_BUFFERS || !pflash->sector_bytes ||
+            (playout->app_base % pflash->sector_bytes) != 0u ||
+            (playout->record_addr % pflash->sector_bytes) != 0u) {
+        return false;
+    }
+    memset(pb, 0, sizeof(*pb));
+    pb->pu = pu;
+    pb->flash = *pflash;
+    pb->layout = *playout;
+    pb->buffers = buffers;
+    pb->state = ST_IDLE;
+    frame_decoder_init(&pb->dec, pb->dec_buf, sizeof(pb->dec_buf), on_frame, pb);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool boot_poll(boot_t *pb) {
+    const uint8_t *p;
+    size_t n;
+    while ((n = uart_rx_peek(pb->pu, &p)) > 0u) {
+        (void)frame_decoder_feed(&pb->dec, p, n);
+        uart_rx_consume(pb->pu, n);
+    }
+
+    flash_step(pb);
+
+    if (pb->out_due && uart_tx_space(pb->pu) >= pb->out_len) {
+        (void)uart_write(pb->pu, pb->out, pb->out_len);
+        pb->out_due = false;
+    }
+    return pb->run && !pb->out_due && uart_tx_queued(pb->pu) == 0u;
+}
+
+//------------------------------------------------------------------------------
+bool boot_contacted(const boot_t *pb) {
+    return pb->contacted;
+}
+
+//------------------------------------------------------------------------------
+bool boot_app_valid(const flash_hw_vtable_t *pflash, const boot_layout_t *playout) {
+    uint8_t raw[sizeof(boot_record_t)];
+    pflash->hw_read(playout->record_addr, raw, sizeof(raw));
+    boot_record_t rec = {
+        get32(&raw[0]), get32(&raw[4]), get32(&raw[8]), get32(&raw[12])
+    };
+    if (rec.magic != BOOT_RECORD_MAGIC || rec.magic_inv != ~BOOT_RECORD_MAGIC ||
+            rec.size == 0u || rec.size > playout->app_max) {
+        return false;
+    }
+    return crc32_final(flash_crc(pflash, CRC32_INIT, playout->app_base, rec.size))
+        == rec.crc;
+}
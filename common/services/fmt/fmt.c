@@ -0,0 +1,431 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the heap-free printf-style formatter
+//
+// Notes:
+//    - Output goes to a sink: one span of writable bytes, refilled from the
+//      UART Tx FIFO when it runs out (fmt_uart) or not at all (fmt_buf)
+//    - Numbers are converted right to left into a FMT_DIGITS_MAX scratch
+//      buffer; values that fit 32 bits never use 64-bit division
+//
+//------------------------------------------------------------------------------
+
+#include "fmt_api.h"
+#include <stdbool.h>
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t *p;
+    // Room left in the current span, bytes written to it, bytes in total
+    size_t  left;
+    size_t  span;
+    size_t  count;
+    // Tx FIFO to refill from, NULL for a plain buffer
+    uart_t  *pu;
+    bool    full;
+} sink_t;
+
+// One parsed conversion specification
+typedef struct {
+    bool     left;
+    bool     zero;
+    char     sign;
+    uint32_t width;
+    int32_t  prec;
+    uint8_t  length;
+} spec_t;
+
+// Length modifiers, by argument size
+enum { LEN_INT = 0, LEN_CHAR, LEN_SHORT, LEN_LONG, LEN_LLONG, LEN_SIZE };
+
+//------------------------------------------------------------------------------
+// Sink
+//------------------------------------------------------------------------------
+static bool sink_refill(sink_t *ps) {
+    if (!ps->pu || ps->full) {
+        ps->full = true;
+        return false;
+    }
+    uart_tx_commit(ps->pu, ps->span);
+    ps->span = 0;
+    ps->left = uart_tx_reserve(ps->pu, &ps->p);
+    ps->full = (ps->left == 0u);
+    return !ps->full;
+}
+
+//------------------------------------------------------------------------------
+static void put_n(sink_t *ps, const char *ps_src, size_t n) {
+    while (n) {
+        if (!ps->left && !sink_refill(ps)) {
+            return;
+        }
+        size_t k = (n < ps->left) ? n : ps->left;
+        for (size_t i = 0; i < k; ++i) {
+            ps->p[i] = (uint8_t)ps_src[i];
+        }
+        ps->p += k;
+        ps->left -= k;
+        ps->span += k;
+        ps->count += k;
+        ps_src += k;
+        n -= k;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void put_rep(sink_t *ps, char c, size_t n) {
+    while (n) {
+        if (!ps->left && !sink_refill(ps)) {
+            return;
+        }
+        size_t k = (n < ps->left) ? n : ps->left;
+        for (size_t i = 0; i < k; ++i) {
+            ps->p[i] = (uint8_t)c;
+        }
+        ps->p += k;
+        ps->left -= k;
+        ps->span += k;
+        ps->count += k;
+        n -= k;
+    }
+}
+
+//------------------------------------------------------------------------------
+static inline void put_c(sink_t *ps, char c) {
+    if (ps->left || sink_refill(ps)) {
+        *ps->p++ = (uint8_t)c;
+        ps->left--;
+        ps->span++;
+        ps->count++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Conversion Helpers
+//------------------------------------------------------------------------------
+// Write v in base 10 or 16 ending just before pend; returns the digit count
+static size_t utoa_rev(char *pend, uint64_t v, unsigned base, bool upper) {
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char *p = pend;
+    if (v <= UINT32_MAX) {
+        uint32_t w = (uint32_t)v;
+        do {
+            *--p = digits[w % base];
+            w /= base;
+        } while (w);
+    } else {
+        do {
+            *--p = digits[v % base];
+            v /= base;
+        } while (v);
+    }
+    return (size_t)(pend - p);
+}
+
+//------------------------------------------------------------------------------
+// Emit prefix, precision zeros and body, padded out to the field width
+static void emit_field(sink_t *ps, const spec_t *psp, const char *pprefix,
+        size_t prefix_len, size_t zeros, const char *pbody, size_t body_len) {
+    size_t total = prefix_len + zeros + body_len;
+    size_t pad = (psp->width > total) ? psp->width - total : 0u;
+    if (!psp->left && !psp->zero) {
+        put_rep(ps, ' ', pad);
+    }
+    put_n(ps, pprefix, prefix_len);
+    if (!psp->left && psp->zero) {
+        put_rep(ps, '0', pad);
+    }
+    put_rep(ps, '0', zeros);
+    put_n(ps, pbody, body_len);
+    if (psp->left) {
+        put_rep(ps, ' ', pad);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void emit_int(sink_t *ps, const spec_t *psp, uint64_t mag, bool neg,
+        unsigned base, bool upper, const char *pradix) {
+    char tmp[FMT_DIGITS_MAX];
+    char prefix[3];
+    size_t np = 0;
+    size_t n = 0;
+    // An explicit zero precision prints nothing for zero
+    if (mag != 0u || psp->prec != 0) {
+        n = utoa_rev(&tmp[sizeof(tmp)], mag, base, upper);
+    }
+    if (neg) {
+        prefix[np++] = '-';
+    } else if (psp->sign) {
+        prefix[np++] = psp->sign;
+    }
+    for (; pradix && *pradix; ++pradix) {
+        prefix[np++] = *pradix;
+    }
+    size_t zeros = (psp->prec > 0 && (size_t)psp->prec > n) ?
+        (size_t)psp->prec - n : 0u;
+    spec_t sp = *psp;
+    sp.zero = psp->zero && psp->prec < 0;
+    emit_field(ps, &sp, prefix, np, zeros, &tmp[sizeof(tmp) - n], n);
+}
+
+//------------------------------------------------------------------------------
+// Integer part and decimals, e.g. from %k or %q
+static void emit_fixed(sink_t *ps, const spec_t *psp, uint64_t ipart,
+        uint32_t frac, uint32_t decimals, bool neg) {
+    char tmp[FMT_DIGITS_MAX];
+    char *pend = &tmp[sizeof(tmp)];
+    char *p = pend;
+    char prefix = neg ? '-' : psp->sign;
+    for (uint32_t i = 0; i < decimals; ++i) {
+        *--p = (char)('0' + frac % 10u);
+        frac /= 10u;
+    }
+    if (decimals) {
+        *--p = '.';
+    }
+    p -= utoa_rev(p, ipart, 10u, false);
+    emit_field(ps, psp, &prefix, prefix ? 1u : 0u, 0u, p, (size_t)(pend - p));
+}
+
+//------------------------------------------------------------------------------
+static uint64_t pow10_u64(uint32_t n) {
+    uint64_t v = 1u;
+    while (n--) {
+        v *= 10u;
+    }
+    return v;
+}
+
+//------------------------------------------------------------------------------
+static int64_t arg_signed(va_list *pap, uint8_t length) {
+    switch (length) {
+    case LEN_CHAR:  return (signed char)va_arg(*pap, int);
+    case LEN_SHORT: return (short)va_arg(*pap, int);
+    case LEN_LONG:  return va_arg(*pap, long);
+    case LEN_LLONG: return va_arg(*pap, long long);
+    case LEN_SIZE:  return (int64_t)va_arg(*pap, size_t);
+    default:        return va_arg(*pap, int);
+    }
+}
+
+//------------------------------------------------------------------------------
+static uint64_t arg_unsigned(va_list *pap, uint8_t length) {
+    switch (length) {
+    case LEN_CHAR:  return (unsigned char)va_arg(*pap, unsigned);
+    case LEN_SHORT: return (unsigned short)va_arg(*pap, unsigned);
+    case LEN_LONG:  return va_arg(*pap, unsigned long);
+    case LEN_LLONG: return va_arg(*pap, unsigned long long);
+    case LEN_SIZE:  return va_arg(*pap, size_t);
+    default:        return va_arg(*pap, unsigned);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Parse flags, width, precision and length; returns the conversion character
+static const char *parse_spec(const char *f, spec_t *psp, va_list *pap) {
+    *psp = (spec_t){ .prec = -1 };
+    for (;; ++f) {
+        if (*f == '-') {
+            psp->left = true;
+        } else if (*f == '0') {
+            psp->zero = true;
+        } else if (*f == '+') {
+            psp->sign = '+';
+        } else if (*f == ' ') {
+            psp->sign = psp->sign ? psp->sign : ' ';
+        } else {
+            break;
+        }
+    }
+    if (*f == '*') {
+        int w = va_arg(*pap, int);
+        psp->left = psp->left || w < 0;
+        psp->width = (uint32_t)(w < 0 ? -w : w);
+        f++;
+    } else {
+        while (*f >= '0' && *f <= '9') {
+            psp->width = psp->width * 10u + (uint32_t)(*f++ - '0');
+        }
+    }
+    if (*f == '.') {
+        f++;
+        psp->prec = 0;
+        if (*f == '*') {
+            int pr = va_arg(*pap, int);
+            psp->prec = (pr < 0) ? -1 : pr;
+            f++;
+        } else {
+            while (*f >= '0' && *f <= '9') {
+                psp->prec = psp->prec * 10 + (*f++ - '0');
+            }
+        }
+    }
+    if (f[0] == 'h') {
+        psp->length = (f[1] == 'h') ? LEN_CHAR : LEN_SHORT;
+        f += (f[1] == 'h') ? 2 : 1;
+    } else if (f[0] == 'l') {
+        psp->length = (f[1] == 'l') ? LEN_LLONG : LEN_LONG;
+        f += (f[1] == 'l') ? 2 : 1;
+    } else if (f[0] == 'z') {
+        psp->length = LEN_SIZE;
+        f++;
+    }
+    return f;
+}
+
+//------------------------------------------------------------------------------
+static void format(sink_t *ps, const char *fmt, va_list ap) {
+    va_list args;
+    va_copy(args, ap);
+    while (*fmt) {
+        // Copy literal runs in one go
+        const char *run = fmt;
+        while (*fmt && *fmt != '%') {
+            fmt++;
+        }
+        put_n(ps, run, (size_t)(fmt - run));
+        if (!*fmt) {
+            break;
+        }
+
+        spec_t sp;
+        fmt = parse_spec(fmt + 1, &sp, &args);
+        char conv = *fmt;
+        if (!conv) {
+            break;
+        }
+        fmt++;
+        switch (conv) {
+        case 'd':
+        case 'i': {
+            int64_t v = arg_signed(&args, sp.length);
+            uint64_t mag = (v < 0) ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+            emit_int(ps, &sp, mag, v < 0, 10u, false, NULL);
+            break;
+        }
+        case 'u':
+            sp.sign = 0;
+            emit_int(ps, &sp, arg_unsigned(&args, sp.length), false, 10u,
+                false, NULL);
+            break;
+        case 'x':
+        case 'X':
+            sp.sign = 0;
+            emit_int(ps, &sp, arg_unsigned(&args, sp.length), false, 16u,
+                conv == 'X', NULL);
+            break;
+        case 'p':
+            sp = (spec_t){ .width = sp.width, .left = sp.left, .prec = -1 };
+            emit_int(ps, &sp, (uintptr_t)va_arg(args, void*), false, 16u,
+                false, "0x");
+            break;
+        case 'c': {
+            char c = (char)va_arg(args, int);
+            sp.zero = false;
+            emit_field(ps, &sp, NULL, 0u, 0u, &c, 1u);
+            break;
+        }
+        case 's': {
+            const char *s = va_arg(args, const char*);
+            size_t n = 0;
+            s = s ? s : "(null)";
+            while (s[n] && (sp.prec < 0 || n < (size_t)sp.prec)) {
+                n++;
+            }
+            sp.zero = false;
+            emit_field(ps, &sp, NULL, 0u, 0u, s, n);
+            break;
+        }
+        case 'k': {
+            uint32_t dec = (sp.prec < 0) ? 3u : (uint32_t)sp.prec;
+            dec = (dec > 9u) ? 9u : dec;
+            int64_t v = (sp.length == LEN_LONG || sp.length == LEN_LLONG) ?
+                arg_signed(&args, sp.length) : va_arg(args, int32_t);
+            uint64_t mag = (v < 0) ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+            uint64_t scale = pow10_u64(dec);
+            emit_fixed(ps, &sp, mag / scale, (uint32_t)(mag % scale), dec,
+                v < 0);
+            break;
+        }
+        case 'q': {
+            uint32_t dec = (sp.prec < 0) ? 3u : (uint32_t)sp.prec;
+            dec = (dec > 9u) ? 9u : dec;
+            int32_t v = va_arg(args, int32_t);
+            uint32_t mag = (v < 0) ? 0u - (uint32_t)v : (uint32_t)v;
+            uint64_t scale = pow10_u64(dec);
+            uint64_t ipart = mag >> 16;
+            // Round the 16 fraction bits to dec decimals, carrying over
+            uint64_t frac = ((mag & 0xFFFFu) * scale + 0x8000u) >> 16;
+            if (frac >= scale) {
+                frac -= scale;
+                ipart++;
+            }
+            emit_fixed(ps, &sp, ipart, (uint32_t)frac, dec, v < 0);
+            break;
+        }
+        case '%':
+            put_c(ps, '%');
+            break;
+        default:
+            // Unknown conversion: show it rather than consume an argument
+            put_c(ps, '%');
+            put_c(ps, conv);
+            break;
+        }
+    }
+    va_end(args);
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+size_t fmt_vbuf(char *pout, size_t cap, const char *fmt, va_list ap) {
+    if (!pout || cap == 0u) {
+        return 0;
+    }
+    sink_t sink = { .p = (uint8_t*)pout, .left = cap - 1u };
+    if (fmt) {
+        format(&sink, fmt, ap);
+    }
+    *sink.p = '\0';
+    return sink.count;
+}
+
+//------------------------------------------------------------------------------
+size_t fmt_buf(char *pout, size_t cap, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    size_t n = fmt_vbuf(pout, cap, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+//------------------------------------------------------------------------------
+size_t fmt_vuart(uart_t *pu, const char *fmt, va_list ap) {
+    if (!pu || !fmt) {
+        return 0;
+    }
+    sink_t sink = { .pu = pu };
+    sink.left = uart_tx_reserve(pu, &sink.p);
+    format(&sink, fmt, ap);
+    if (sink.span) {
+        uart_tx_commit(pu, sink.span);
+    }
+    return sink.count;
+}
+
+//------------------------------------------------------------------------------
+size_t fmt_uart(uart_t *pu, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    size_t n = fmt_vuart(pu, fmt, ap);
+    va_end(ap);
+    return n;
+}
@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines COBS + CRC-16 packet framing
+//
+//------------------------------------------------------------------------------
+
+#include "frame_api.h"
+#include "crc_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Longest COBS block: code byte plus 254 non-zero bytes
+#define COBS_BLOCK_MAX  0xFFu
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Encoder position; the code byte of the open block is written when it closes
+typedef struct {
+    uint8_t *pout;
+    size_t  pos;
+    size_t  code_pos;
+    uint8_t code;
+} cobs_enc_t;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+static inline void enc_close_block(cobs_enc_t *pe) {
+    pe->pout[pe->code_pos] = pe->code;
+    pe->code_pos = pe->pos++;
+    pe->code = 1u;
+}
+
+//------------------------------------------------------------------------------
+static void enc_bytes(cobs_enc_t *pe, const uint8_t *pdata, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if (pdata[i] == FRAME_DELIM) {
+            enc_close_block(pe);
+            continue;
+        }
+        pe->pout[pe->pos++] = pdata[i];
+        if (++pe->code == COBS_BLOCK_MAX) {
+            enc_close_block(pe);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+size_t frame_encode(const uint8_t *ppayload, size_t len, uint8_t *pout, size_t cap) {
+    if (!pout || (len && !ppayload) || cap < FRAME_ENCODED_MAX(len)) {
+        return 0;
+    }
+    uint16_t crc = crc16_ccitt(ppayload, len);
+    const uint8_t trailer[FRAME_CRC_BYTES] = {
+        (uint8_t)(crc >> 8), (uint8_t)crc
+    };
+    cobs_enc_t enc = { .pout = pout, .pos = 1u, .code_pos = 0u, .code = 1u };
+    enc_bytes(&enc, ppayload, len);
+    enc_bytes(&enc, trailer, sizeof(trailer));
+    pout[enc.code_pos] = enc.code;
+    pout[enc.pos++] = FRAME_DELIM;
+    return enc.pos;
+}
+
+//------------------------------------------------------------------------------
+void frame_decoder_init(
+        frame_decoder_t *pd,
+        void            *pbuf,
+        size_t          cap,
+        frame_rx_fn     on_frame,
+        void            *pctx) {
+    pd->pbuf = (uint8_t*)pbuf;
+    pd->cap = cap;
+    pd->len = 0;
+    pd->code = 0;
+    pd->left = 0;
+    pd->overrun = false;
+    pd->on_frame = on_frame;
+    pd->pctx = pctx;
+    pd->frames = 0;
+    pd->crc_errors = 0;
+    pd->malformed = 0;
+}
+
+//------------------------------------------------------------------------------
+// Helper to check and deliver the frame closed by a delimiter
+static bool dec_end_frame(frame_decoder_t *pd) {
+    bool delivered = false;
+    if (pd->overrun || pd->left != 0u ||
+            (pd->code != 0u && pd->len < FRAME_CRC_BYTES)) {
+        pd->malformed++;
+    } else if (pd->code != 0u) {
+        // CRC over payload and MSB-first trailer leaves a zero remainder
+        if (crc16_ccitt(pd->pbuf, pd->len) == 0u) {
+            pd->frames++;
+            if (pd->on_frame) {
+                pd->on_frame(pd->pctx, pd->pbuf, pd->len - FRAME_CRC_BYTES);
+            }
+            delivered = true;
+        } else {
+            pd->crc_errors++;
+        }
+    }
+    // Back-to-back delimiters (code still 0) are idle fill, not errors
+    pd->len = 0;
+    pd->code = 0;
+    pd->left = 0;
+    pd->overrun = false;
+    return delivered;
+}
+
+//------------------------------------------------------------------------------
+size_t frame_decoder_feed(frame_decoder_t *pd, const uint8_t *pdata, size_t len) {
+    size_t delivered = 0;
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t b = pdata[i];
+        if (b == FRAME_DELIM) {
+            delivered += dec_end_frame(pd) ? 1u : 0u;
+            continue;
+        }
+        if (pd->overrun) {
+            continue;
+        }
+        if (pd->left == 0u) {
+            // Code byte: a block shorter than the maximum implies a zero
+            if (pd->code != 0u && pd->code != COBS_BLOCK_MAX) {
+                if (pd->len == pd->cap) {
+                    pd->overrun = true;
+                    continue;
+                }
+                pd->pbuf[pd->len++] = FRAME_DELIM;
+            }
+            pd->code = b;
+            pd->left = (uint8_t)(b - 1u);
+            continue;
+        }
+        if (pd->len == pd->cap) {
+            pd->overrun = true;
+            continue;
+        }
+        pd->pbuf[pd->len++] = b;
+        pd->left--;
+    }
+    return delivered;
+}
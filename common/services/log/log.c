@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines deferred binary logging
+//
+// Notes:
+//    - Writers reserve a slot by compare-and-swap on head, fill it, then mark
+//      it full; the drain only takes the slot at tail once it is marked, so a
+//      writer preempted mid-record (by an ISR that logs too) just holds the
+//      drain back until it finishes
+//    - The drain marks a slot empty before moving tail past it, and writers
+//      check space against tail, so a slot is never reused while being read
+//
+//------------------------------------------------------------------------------
+
+#include "log_api.h"
+#include "frame_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define SLOT_EMPTY  0u
+#define SLOT_FULL   1u
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static struct {
+    log_slot_t       *pslots;
+    uint32_t         mask;
+    log_time_fn      now;
+    // Next slot to reserve (writers) and to send (drain)
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    _Atomic uint32_t dropped;
+    // Drops already reported; drain only
+    uint32_t         dropped_sent;
+} s_log;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+// LEB128: 7 bits per byte, low first, high bit set on all but the last
+static size_t put_varint(uint8_t *pout, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80u) {
+        pout[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    pout[n++] = (uint8_t)v;
+    return n;
+}
+
+//------------------------------------------------------------------------------
+static size_t encode_record(uint8_t *pout, uint16_t id, uint32_t ts,
+        const uint32_t *pargs, size_t nargs) {
+    size_t n = 0;
+    pout[n++] = (uint8_t)id;
+    pout[n++] = (uint8_t)(id >> 8);
+    n += put_varint(&pout[n], ts);
+    for (size_t i = 0; i < nargs; ++i) {
+        n += put_varint(&pout[n], pargs[i]);
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+// Queue one framed record, only if it fits whole
+static bool send_record(uart_t *pu, const uint8_t *ppayload, size_t len) {
+    uint8_t frame[FRAME_ENCODED_MAX(LOG_PAYLOAD_MAX)];
+    size_t n = frame_encode(ppayload, len, frame, sizeof(frame));
+    if (n == 0u || uart_tx_space(pu) < n) {
+        return false;
+    }
+    return uart_write(pu, frame, n) == n;
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool log_init(log_slot_t *pslots, size_t count, log_time_fn now) {
+    if (!pslots || count < 2u || (count & (count - 1u)) != 0u ||
+            count > 0x80000000u) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        atomic_store_explicit(&pslots[i].state, SLOT_EMPTY, memory_order_relaxed);
+    }
+    s_log.pslots = pslots;
+    s_log.mask = (uint32_t)(count - 1u);
+    s_log.now = now;
+    atomic_store_explicit(&s_log.head, 0u, memory_order_relaxed);
+    atomic_store_explicit(&s_log.tail, 0u, memory_order_relaxed);
+    atomic_store_explicit(&s_log.dropped, 0u, memory_order_relaxed);
+    s_log.dropped_sent = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool log_write(uint16_t id, const uint32_t *pargs, size_t nargs) {
+    if (!s_log.pslots) {
+        return false;
+    }
+    if (nargs > LOG_ARGS_MAX) {
+        nargs = LOG_ARGS_MAX;
+    }
+    uint32_t head = atomic_load_explicit(&s_log.head, memory_order_relaxed);
+    do {
+        uint32_t tail = atomic_load_explicit(&s_log.tail, memory_order_acquire);
+        if (head - tail > s_log.mask) {
+            atomic_fetch_add_explicit(&s_log.dropped, 1u, memory_order_relaxed);
+            return false;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&s_log.head, &head,
+        head + 1u, memory_order_relaxed, memory_order_relaxed));
+
+    log_slot_t *ps = &s_log.pslots[head & s_log.mask];
+    ps->id = id;
+    ps->nargs = (uint8_t)nargs;
+    ps->ts = s_log.now ? s_log.now() : 0u;
+    for (size_t i = 0; i < nargs; ++i) {
+        ps->args[i] = pargs[i];
+    }
+    atomic_store_explicit(&ps->state, SLOT_FULL, memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t log_drain(uart_t *pu, size_t max_records) {
+    uint8_t payload[LOG_PAYLOAD_MAX];
+    size_t sent = 0;
+    if (!s_log.pslots || !pu) {
+        return 0;
+    }
+    while (sent < max_records) {
+        // Report drops ahead of the records that follow them
+        uint32_t dropped = atomic_load_explicit(&s_log.dropped,
+            memory_order_relaxed);
+        if (dropped != s_log.dropped_sent) {
+            uint32_t n = dropped - s_log.dropped_sent;
+            size_t len = encode_record(payload, LOG_ID_DROPPED,
+                s_log.now ? s_log.now() : 0u, &n, 1u);
+            if (!send_record(pu, payload, len)) {
+                break;
+            }
+            s_log.dropped_sent = dropped;
+            sent++;
+            continue;
+        }
+
+        uint32_t tail = atomic_load_explicit(&s_log.tail, memory_order_relaxed);
+        log_slot_t *ps = &s_log.pslots[tail & s_log.mask];
+        if (atomic_load_explicit(&ps->state, memory_order_acquire) != SLOT_FULL) {
+            break;
+        }
+        size_t len = encode_record(payload, ps->id, ps->ts, ps->args, ps->nargs);
+        if (!send_record(pu, payload, len)) {
+            break;
+        }
+        atomic_store_explicit(&ps->state, SLOT_EMPTY, memory_order_relaxed);
+        atomic_store_explicit(&s_log.tail, tail + 1u, memory_order_release);
+        sent++;
+    }
+    return sent;
+}
+
+//------------------------------------------------------------------------------
+size_t log_pending(void) {
+    uint32_t tail = atomic_load_explicit(&s_log.tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&s_log.head, memory_order_acquire);
+    return (size_t)(head - tail);
+}
+
+//------------------------------------------------------------------------------
+uint32_t log_dropped(void) {
+    return atomic_load_explicit(&s_log.dropped, memory_order_relaxed);
+}
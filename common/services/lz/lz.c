@@ -0,0 +1,288 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the streaming LZ77 compressor and decompressor
+//
+// Notes:
+//    - Match finding: one hash table slot per 3-byte prefix holds the latest
+//      position it was seen at; the candidate is checked byte by byte, so a
+//      stale or colliding slot only costs the comparison
+//    - Matches start and end inside the current call's input but reach back
+//      LZ_WINDOW bytes into the history, which spans earlier calls
+//    - Output goes to a sink as in fmt.c: the current Tx FIFO span, refilled
+//      from the next one, or a plain buffer. The input accepted is limited
+//      up front so that its worst-case output fits, so a token is never cut
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "lz_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define WINDOW_MASK   (LZ_WINDOW - 1u)
+#define TOKEN_MATCH   0x80u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t *p;
+    // Room left in the current span, bytes written to it, bytes in total
+    size_t  left;
+    size_t  span;
+    size_t  count;
+    // Tx FIFO to refill from, NULL for a plain buffer
+    uart_t  *pu;
+} sink_t;
+
+//------------------------------------------------------------------------------
+// Sink
+//------------------------------------------------------------------------------
+static void put_n(sink_t *ps, const uint8_t *psrc, size_t n) {
+    while (n) {
+        if (!ps->left) {
+            if (!ps->pu) {
+                return;
+            }
+            uart_tx_commit(ps->pu, ps->span);
+            ps->span = 0;
+            ps->left = uart_tx_reserve(ps->pu, &ps->p);
+            if (!ps->left) {
+                return;
+            }
+        }
+        size_t k = (n < ps->left) ? n : ps->left;
+        memcpy(ps->p, psrc, k);
+        ps->p += k;
+        ps->left -= k;
+        ps->span += k;
+        ps->count += k;
+        psrc += k;
+        n -= k;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Input whose worst-case output fits in space
+static size_t fit(size_t len, size_t space) {
+    if (space == 0u) {
+        return 0u;
+    }
+    size_t n = (space - 1u) - (space - 1u) / (LZ_LITERAL_MAX + 1u);
+    while (n && LZ_BOUND(n) > space) {
+        n--;
+    }
+    return (n < len) ? n : len;
+}
+
+//------------------------------------------------------------------------------
+// Encoder
+//------------------------------------------------------------------------------
+static inline uint32_t hash3(const uint8_t *p) {
+    uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (v * 2654435761u) >> (32u - LZ_HASH_BITS);
+}
+
+//------------------------------------------------------------------------------
+static inline void push(lz_encoder_t *pz, uint8_t b) {
+    pz->hist[pz->pos & WINDOW_MASK] = b;
+    pz->pos++;
+}
+
+//------------------------------------------------------------------------------
+// Length of the match at distance d for the avail bytes at p; bytes from
+// before p come from the history, the rest (an overlapping match) from p
+static uint32_t match_len(const lz_encoder_t *pz, const uint8_t *p, size_t avail,
+        uint32_t d) {
+    uint32_t max = (avail < LZ_MATCH_MAX) ? (uint32_t)avail : LZ_MATCH_MAX;
+    uint32_t k = 0;
+    uint32_t from = pz->pos - d;
+    for (; k < max && k < d; ++k) {
+        if (pz->hist[(from + k) & WINDOW_MASK] != p[k]) {
+            return k;
+        }
+    }
+    for (; k < max; ++k) {
+        if (p[k - d] != p[k]) {
+            break;
+        }
+    }
+    return k;
+}
+
+//------------------------------------------------------------------------------
+static void flush_literals(lz_encoder_t *pz, sink_t *ps) {
+    if (pz->nlit) {
+        uint8_t token = (uint8_t)(pz->nlit - 1u);
+        put_n(ps, &token, 1u);
+        put_n(ps, pz->lit, pz->nlit);
+        pz->nlit = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void compress(lz_encoder_t *pz, sink_t *ps, const uint8_t *p, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        uint32_t len = 0;
+        uint32_t d = 0;
+        if (n - i >= LZ_MATCH_MIN) {
+            uint16_t *pslot = &pz->head[hash3(&p[i])];
+            d = (uint16_t)(pz->pos - *pslot);
+            *pslot = (uint16_t)pz->pos;
+            if (d != 0u && d <= LZ_WINDOW && d <= pz->pos) {
+                len = match_len(pz, &p[i], n - i, d);
+            }
+        }
+        if (len >= LZ_MATCH_MIN) {
+            flush_literals(pz, ps);
+            uint8_t token[2] = {
+                (uint8_t)(TOKEN_MATCH | ((len - LZ_MATCH_MIN) << 2) | ((d - 1u) >> 8)),
+                (uint8_t)(d - 1u)
+            };
+            put_n(ps, token, sizeof(token));
+            // Index the positions inside the match too
+            push(pz, p[i]);
+            for (uint32_t k = 1; k < len; ++k) {
+                if (n - (i + k) >= LZ_MATCH_MIN) {
+                    pz->head[hash3(&p[i + k])] = (uint16_t)pz->pos;
+                }
+                push(pz, p[i + k]);
+            }
+            i += len;
+        } else {
+            pz->lit[pz->nlit++] = p[i];
+            if (pz->nlit == LZ_LITERAL_MAX) {
+                flush_literals(pz, ps);
+            }
+            push(pz, p[i]);
+            i++;
+        }
+    }
+    flush_literals(pz, ps);
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void lz_encoder_init(lz_encoder_t *pz) {
+    memset(pz, 0, sizeof(*pz));
+}
+
+//------------------------------------------------------------------------------
+size_t lz_write(lz_encoder_t *pz, uart_t *pu, const uint8_t *pdata, size_t len) {
+    size_t n = fit(len, uart_tx_space(pu));
+    if (!n) {
+        return 0u;
+    }
+    sink_t s = { .pu = pu };
+    s.left = uart_tx_reserve(pu, &s.p);
+    compress(pz, &s, pdata, n);
+    uart_tx_commit(pu, s.span);
+    pz->stats.in += n;
+    pz->stats.out += s.count;
+    return n;
+}
+
+//------------------------------------------------------------------------------
+size_t lz_encode(lz_encoder_t *pz, const uint8_t *pdata, size_t len,
+        uint8_t *pout, size_t cap, size_t *pn) {
+    size_t n = fit(len, cap);
+    sink_t s = { .p = pout, .left = cap };
+    compress(pz, &s, pdata, n);
+    pz->stats.in += n;
+    pz->stats.out += s.count;
+    *pn = s.count;
+    return n;
+}
+
+//------------------------------------------------------------------------------
+uint32_t lz_ratio_q16(const lz_stats_t *ps) {
+    if (ps->out == 0u) {
+        return 1u << 16;
+    }
+    uint64_t q = (ps->in << 16) / ps->out;
+    return (q > UINT32_MAX) ? UINT32_MAX : (uint32_t)q;
+}
+
+//------------------------------------------------------------------------------
+void lz_decoder_init(lz_decoder_t *pd) {
+    memset(pd, 0, sizeof(*pd));
+}
+
+//------------------------------------------------------------------------------
+size_t lz_decode(lz_decoder_t *pd, const uint8_t *pin, size_t len, size_t *pused,
+        uint8_t *pout, size_t cap) {
+    size_t used = 0;
+    size_t out = 0;
+    while (out < cap) {
+        if (pd->copy_left) {
+            uint32_t from = pd->pos - pd->dist;
+            size_t k = (pd->copy_left < cap - out) ? pd->copy_left : cap - out;
+            for (size_t j = 0; j < k; ++j) {
+                uint8_t b = pd->hist[(from + j) & WINDOW_MASK];
+                pd->hist[(pd->pos + j) & WINDOW_MASK] = b;
+                pout[out + j] = b;
+            }
+            pd->pos += (uint32_t)k;
+            pd->copy_left -= (uint32_t)k;
+            out += k;
+            continue;
+        }
+        if (used == len) {
+            break;
+        }
+        if (pd->lit_left) {
+            size_t k = pd->lit_left;
+            k = (k < len - used) ? k : len - used;
+            k = (k < cap - out) ? k : cap - out;
+            for (size_t j = 0; j < k; ++j) {
+                pd->hist[(pd->pos + j) & WINDOW_MASK] = pin[used + j];
+            }
+            memcpy(&pout[out], &pin[used], k);
+            pd->pos += (uint32_t)k;
+            pd->lit_left -= (uint32_t)k;
+            used += k;
+            out += k;
+            continue;
+        }
+        uint8_t b = pin[used++];
+        if (pd->token) {
+            pd->copy_left = ((pd->token >> 2) & 0x1Fu) + LZ_MATCH_MIN;
+            pd->dist = ((((uint32_t)pd->token & 0x03u) << 8) | b) + 1u;
+            pd->token = 0;
+        } else if (b & TOKEN_MATCH) {
+            pd->token = b;
+        } else {
+            pd->lit_left = (uint32_t)b + 1u;
+        }
+    }
+    pd->stats.in += used;
+    pd->stats.out += out;
+    *pused = used;
+    return out;
+}
+
+//------------------------------------------------------------------------------
+size_t lz_read(lz_decoder_t *pd, uart_t *pu, uint8_t *pout, size_t cap) {
+    size_t used;
+    // The rest of a match cut short by the last call
+    size_t total = lz_decode(pd, NULL, 0u, &used, pout, cap);
+    const uint8_t *p;
+    size_t n;
+    while (total < cap && (n = uart_rx_peek(pu, &p)) > 0u) {
+        total += lz_decode(pd, p, n, &used, &pout[total], cap - total);
+        uart_rx_consume(pu, used);
+        if (used < n) {
+            break;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines a run-to-completion cooperative scheduler.
+//
+// Each priority owns one bit of a ready bitmap. Selecting the next task is a
+// single count-leading-zeros of the bitmap (one CLZ instruction on
+// Cortex-M33), independent of the number of tasks. Event bits are pending per
+// task and handed over in one batch per dispatch.
+//
+//------------------------------------------------------------------------------
+
+#include "sched_api.h"
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    sched_task_fn      fn;
+    void               *pctx;
+    volatile uint32_t  events;
+    sched_task_stats_t stats;
+} sched_task_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Installed backend
+static sched_hw_vtable_t s_hw;
+
+static sched_task_t s_task[SCHED_MAX_TASKS];
+
+// Bit n set: task at priority n has pending events
+static volatile uint32_t s_ready;
+
+static uint64_t s_idle_cycles;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+// Helper to read the cycle counter, or 0 when accounting is unavailable
+static inline uint32_t cycles(void) {
+    return s_hw.hw_cycles ? s_hw.hw_cycles() : 0u;
+}
+
+//------------------------------------------------------------------------------
+bool sched_init(const sched_hw_vtable_t *phw) {
+    // Initial sanity checks
+    if (!phw || !phw->hw_irq_save || !phw->hw_irq_restore || !phw->hw_idle) {
+        return false;
+    }
+    // Install hardware API
+    s_hw = *phw;
+    memset(s_task, 0, sizeof(s_task));
+    s_ready = 0u;
+    s_idle_cycles = 0u;
+    return s_hw.hw_init ? s_hw.hw_init() : true;
+}
+
+//------------------------------------------------------------------------------
+bool sched_task_create(uint32_t prio, sched_task_fn fn, void *pctx) {
+    if (prio >= SCHED_MAX_TASKS || !fn || s_task[prio].fn) {
+        return false;
+    }
+    s_task[prio].pctx = pctx;
+    s_task[prio].events = 0u;
+    s_task[prio].fn = fn;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void sched_post(uint32_t prio, uint32_t events) {
+    if (prio >= SCHED_MAX_TASKS || !events || !s_task[prio].fn) {
+        return;
+    }
+    // Read-modify-write of shared words: keep other ISRs out
+    uint32_t state = s_hw.hw_irq_save();
+    s_task[prio].events |= events;
+    s_ready |= (1u << prio);
+    s_hw.hw_irq_restore(state);
+}
+
+//------------------------------------------------------------------------------
+bool sched_dispatch(void) {
+    uint32_t state = s_hw.hw_irq_save();
+    uint32_t ready = s_ready;
+    if (!ready) {
+        s_hw.hw_irq_restore(state);
+        return false;
+    }
+    // Highest set bit is the highest ready priority
+    uint32_t prio = 31u - (uint32_t)__builtin_clz(ready);
+    sched_task_t *pt = &s_task[prio];
+    uint32_t events = pt->events;
+    pt->events = 0u;
+    s_ready = ready & ~(1u << prio);
+    s_hw.hw_irq_restore(state);
+
+    uint32_t t0 = cycles();
+    pt->fn(pt->pctx, events);
+    uint32_t dt = cycles() - t0;
+
+    pt->stats.runs++;
+    pt->stats.cycles += dt;
+    if (dt > pt->stats.cycles_max) {
+        pt->stats.cycles_max = dt;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void sched_idle(void) {
+    // Check and sleep with interrupts masked: a post landing after the check
+    // leaves its interrupt pending, which ends the sleep at once
+    uint32_t state = s_hw.hw_irq_save();
+    if (!s_ready) {
+        uint32_t t0 = cycles();
+        s_hw.hw_idle();
+        s_idle_cycles += cycles() - t0;
+    }
+    s_hw.hw_irq_restore(state);
+}
+
+//------------------------------------------------------------------------------
+void sched_run(void) {
+    while (1) {
+        if (!sched_dispatch()) {
+            sched_idle();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool sched_task_stats(uint32_t prio, sched_task_stats_t *pstats) {
+    if (prio >= SCHED_MAX_TASKS || !s_task[prio].fn || !pstats) {
+        return false;
+    }
+    *pstats = s_task[prio].stats;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+uint64_t sched_idle_cycles(void) {
+    return s_idle_cycles;
+}
+
+//------------------------------------------------------------------------------
+void sched_stats_clear(void) {
+    for (uint32_t i = 0; i < SCHED_MAX_TASKS; ++i) {
+        memset(&s_task[i].stats, 0, sizeof(s_task[i].stats));
+    }
+    s_idle_cycles = 0u;
+}
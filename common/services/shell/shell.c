@@ -0,0 +1,330 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the UART command shell
+//
+// Notes:
+//    - Input is edited byte by byte straight out of the Rx FIFO spans
+//      (uart_rx_peek/consume); while a command is unfinished, input stays in
+//      the FIFO, since argv[] still points into the line buffer
+//    - Lookup: bucket = phash(0) % count; a bucket's displacement is either
+//      the seed of a second hash giving the slot, or the slot itself
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "shell_api.h"
+#include "fmt_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define CH_CTRL_C  0x03u
+#define CH_BS      0x08u
+#define CH_CTRL_U  0x15u
+#define CH_ESC     0x1Bu
+#define CH_DEL     0x7Fu
+
+// Escape sequence states: ESC seen, inside ESC [ ... (CSI)
+#define ESC_NONE   0u
+#define ESC_START  1u
+#define ESC_CSI    2u
+
+// Column the help text starts at
+#define HELP_NAME_WIDTH  12
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+// FNV-1a with the seed folded into the basis, then a final mix so the low
+// bits taken by the modulo depend on every input bit; tools/shell_gen.py
+// matches it
+static uint32_t phash(uint32_t seed, const char *p, size_t len) {
+    uint32_t h = 0x811C9DC5u ^ seed;
+    for (size_t i = 0; i < len; ++i) {
+        h = (h ^ (uint8_t)p[i]) * 0x01000193u;
+    }
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    return h;
+}
+
+//------------------------------------------------------------------------------
+static void put_str(shell_t *psh, const char *ps) {
+    (void)shell_write(psh, ps, strlen(ps));
+}
+
+//------------------------------------------------------------------------------
+static void prompt(shell_t *psh) {
+    put_str(psh, psh->prompt);
+}
+
+//------------------------------------------------------------------------------
+// Call the running command; report its result once it finishes
+static void run(shell_t *psh) {
+    int rc = psh->prun->fn(psh, psh->argc, psh->argv);
+    if (rc == SHELL_MORE) {
+        return;
+    }
+    if (rc == SHELL_ERR_USAGE) {
+        (void)shell_printf(psh, "usage: %s %s\r\n", psh->prun->name,
+            psh->prun->help);
+    } else if (rc < 0) {
+        (void)shell_printf(psh, "%s: error %d\r\n", psh->prun->name, rc);
+    }
+    psh->prun = NULL;
+    prompt(psh);
+}
+
+//------------------------------------------------------------------------------
+static void exec_line(shell_t *psh) {
+    psh->pline[psh->len] = '\0';
+    psh->len = 0;
+    int argc = shell_tokenize(psh->pline, psh->argv, SHELL_ARGS_MAX);
+    if (argc <= 0) {
+        if (argc < 0) {
+            put_str(psh, "error: unbalanced quote or too many arguments\r\n");
+        }
+        prompt(psh);
+        return;
+    }
+    const shell_cmd_t *pc = shell_find(psh->ptable, psh->argv[0],
+        strlen(psh->argv[0]));
+    if (!pc) {
+        (void)shell_printf(psh, "%s: command not found\r\n", psh->argv[0]);
+        prompt(psh);
+        return;
+    }
+    psh->prun = pc;
+    psh->argc = argc;
+    psh->state = 0;
+    run(psh);
+}
+
+//------------------------------------------------------------------------------
+// Apply one input byte to the line
+static void edit(shell_t *psh, uint8_t c) {
+    // Swallow escape sequences (arrow keys and the like)
+    if (psh->esc == ESC_START) {
+        psh->esc = (c == '[') ? ESC_CSI : ESC_NONE;
+        return;
+    }
+    if (psh->esc == ESC_CSI) {
+        if (c >= 0x40u && c <= 0x7Eu) {
+            psh->esc = ESC_NONE;
+        }
+        return;
+    }
+
+    // CR, LF and CR LF each end one line
+    bool lf_after_cr = (c == '\n') && psh->cr;
+    psh->cr = (c == '\r');
+    if (c == '\r' || c == '\n') {
+        if (!lf_after_cr) {
+            put_str(psh, "\r\n");
+            exec_line(psh);
+        }
+        return;
+    }
+
+    switch (c) {
+    case CH_BS:
+    case CH_DEL:
+        if (psh->len) {
+            psh->len--;
+            put_str(psh, "\b \b");
+        }
+        break;
+    case CH_CTRL_U:
+        psh->len = 0;
+        put_str(psh, "\r\x1b[K");
+        prompt(psh);
+        break;
+    case CH_CTRL_C:
+        psh->len = 0;
+        put_str(psh, "^C\r\n");
+        prompt(psh);
+        break;
+    case CH_ESC:
+        psh->esc = ESC_START;
+        break;
+    default:
+        if (c < 0x20u || c > 0x7Eu) {
+            break;
+        }
+        if (psh->len + 1u < psh->cap) {
+            psh->pline[psh->len++] = (char)c;
+            (void)shell_write(psh, (const char*)&c, 1u);
+        } else {
+            put_str(psh, "\a");
+        }
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool shell_init(shell_t *psh, uart_t *pu, const shell_table_t *ptable,
+        char *pline, size_t cap, const char *prompt_text) {
+    if (!psh || !pu || !ptable || !ptable->count || !pline || cap < 2u) {
+        return false;
+    }
+    memset(psh, 0, sizeof(*psh));
+    psh->pu = pu;
+    psh->ptable = ptable;
+    psh->prompt = prompt_text ? prompt_text : "";
+    psh->pline = pline;
+    psh->cap = cap;
+    prompt(psh);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool shell_poll(shell_t *psh) {
+    const uint8_t *p;
+    size_t n;
+
+    if (psh->prun) {
+        // Ctrl-C typed while the command runs cancels it
+        if (uart_rx_peek(psh->pu, &p) && p[0] == CH_CTRL_C) {
+            uart_rx_consume(psh->pu, 1u);
+            psh->prun = NULL;
+            put_str(psh, "^C\r\n");
+            prompt(psh);
+        } else if (uart_tx_queued(psh->pu) > uart_tx_space(psh->pu)) {
+            // Resume once the Tx FIFO is at most half full
+            return true;
+        } else {
+            run(psh);
+            if (psh->prun) {
+                return true;
+            }
+        }
+    }
+
+    while (!psh->prun && (n = uart_rx_peek(psh->pu, &p)) > 0u) {
+        size_t i = 0;
+        while (i < n && !psh->prun) {
+            edit(psh, p[i++]);
+        }
+        uart_rx_consume(psh->pu, i);
+    }
+    return psh->prun != NULL;
+}
+
+//------------------------------------------------------------------------------
+const shell_cmd_t *shell_find(const shell_table_t *ptable, const char *pname,
+        size_t len) {
+    if (!ptable || !ptable->count || !pname) {
+        return NULL;
+    }
+    uint32_t n = ptable->count;
+    int32_t d = ptable->pdisp[phash(0u, pname, len) % n];
+    uint32_t slot = (d < 0) ? (uint32_t)(-d - 1)
+                            : phash((uint32_t)d, pname, len) % n;
+    const shell_cmd_t *pc = &ptable->pcmds[slot];
+    if (strncmp(pc->name, pname, len) != 0 || pc->name[len] != '\0') {
+        return NULL;
+    }
+    return pc;
+}
+
+//------------------------------------------------------------------------------
+int shell_tokenize(char *pline, char **argv, int max) {
+    // Arguments are compacted towards the start of the line as quotes and
+    // escapes are dropped, so the write position never passes the read one
+    char *prd = pline;
+    char *pwr = pline;
+    int argc = 0;
+    for (;;) {
+        while (*prd == ' ' || *prd == '\t') {
+            prd++;
+        }
+        if (*prd == '\0') {
+            break;
+        }
+        if (argc == max) {
+            return -1;
+        }
+        argv[argc++] = pwr;
+        bool quoted = false;
+        while (*prd && (quoted || (*prd != ' ' && *prd != '\t'))) {
+            if (*prd == '"') {
+                quoted = !quoted;
+                prd++;
+                continue;
+            }
+            if (*prd == '\\' && prd[1]) {
+                prd++;
+            }
+            *pwr++ = *prd++;
+        }
+        if (quoted) {
+            return -1;
+        }
+        char end = *prd;
+        *pwr++ = '\0';
+        if (end == '\0') {
+            break;
+        }
+        prd++;
+    }
+    return argc;
+}
+
+//------------------------------------------------------------------------------
+size_t shell_printf(shell_t *psh, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    size_t n = fmt_vuart(psh->pu, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+//------------------------------------------------------------------------------
+size_t shell_write(shell_t *psh, const char *pdata, size_t len) {
+    return uart_write(psh->pu, (const uint8_t*)pdata, len);
+}
+
+//------------------------------------------------------------------------------
+size_t shell_tx_space(const shell_t *psh) {
+    return uart_tx_space(psh->pu);
+}
+
+//------------------------------------------------------------------------------
+uart_t *shell_uart(const shell_t *psh) {
+    return psh->pu;
+}
+
+//------------------------------------------------------------------------------
+uint32_t *shell_state(shell_t *psh) {
+    return &psh->state;
+}
+
+//------------------------------------------------------------------------------
+int shell_cmd_help(shell_t *psh, int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    const shell_table_t *pt = psh->ptable;
+    uint32_t *pi = shell_state(psh);
+    while (*pi < pt->count) {
+        const shell_cmd_t *pc = &pt->pcmds[*pi];
+        size_t name = strlen(pc->name);
+        size_t need = ((name > HELP_NAME_WIDTH) ? name : HELP_NAME_WIDTH) +
+            2u + strlen(pc->help) + 2u;
+        // Wait for room, unless the line could never fit
+        if (shell_tx_space(psh) < need && uart_tx_queued(psh->pu) > 0u) {
+            return SHELL_MORE;
+        }
+        (void)shell_printf(psh, "%-*s  %s\r\n", HELP_NAME_WIDTH, pc->name,
+            pc->help);
+        (*pi)++;
+    }
+    return SHELL_OK;
+}
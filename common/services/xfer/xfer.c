@@ -0,0 +1,334 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// This module defines the selective-repeat sliding-window transfer
+//
+// Notes:
+//    - Frame payloads, little-endian:
+//        DATA  type, seq(2), data(0..XFER_SEG_MAX)
+//        ACK   type, cum(2), bitmap(4), window(1)
+//      cum is the next sequence number the receiver expects; bitmap bit i is
+//      set when cum + 1 + i has been received
+//    - Sequence numbers are counted in 32 bits at both ends and sent as their
+//      low 16 bits; a window never spans more than XFER_WINDOW_MAX of them,
+//      so the full value is recovered relative to base or expected
+//    - Slots are indexed by sequence number modulo the window, and the
+//      segment's frame payload is built in place in its slot
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "xfer_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define TYPE_DATA    0x01u
+#define TYPE_ACK     0x02u
+
+// Send slots
+#define TX_EMPTY     0u
+#define TX_QUEUED    1u   // never sent
+#define TX_SENT      2u
+#define TX_LOST      3u   // to be resent
+#define TX_ACKED     4u
+
+// Receive slots
+#define RX_EMPTY     0u
+#define RX_FULL      1u
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static inline void put16(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+//------------------------------------------------------------------------------
+static inline uint32_t get16(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+//------------------------------------------------------------------------------
+static inline xfer_slot_t *tx_slot(const xfer_t *px, uint32_t seq) {
+    return &px->ptx[seq % px->cfg.window];
+}
+
+//------------------------------------------------------------------------------
+static inline xfer_slot_t *rx_slot(const xfer_t *px, uint32_t seq) {
+    return &px->prx[seq % px->cfg.window];
+}
+
+//------------------------------------------------------------------------------
+static inline uint32_t now(const xfer_t *px) {
+    return px->cfg.now ? px->cfg.now() : 0u;
+}
+
+//------------------------------------------------------------------------------
+// Queue one frame, only if it fits whole
+static bool send_frame(xfer_t *px, const uint8_t *ppayload, size_t len) {
+    uint8_t frame[FRAME_ENCODED_MAX(XFER_HDR_BYTES + XFER_SEG_MAX)];
+    // Checked against the worst case first, so a full Tx FIFO costs no
+    // encoding
+    if (uart_tx_space(px->pu) < FRAME_ENCODED_MAX(len)) {
+        return false;
+    }
+    size_t n = frame_encode(ppayload, len, frame, sizeof(frame));
+    return n != 0u && uart_write(px->pu, frame, n) == n;
+}
+
+//------------------------------------------------------------------------------
+static bool send_data(xfer_t *px, xfer_slot_t *ps) {
+    ps->frame[0] = TYPE_DATA;
+    put16(&ps->frame[1], ps->seq);
+    if (!send_frame(px, ps->frame, XFER_HDR_BYTES + ps->len)) {
+        return false;
+    }
+    ps->state = TX_SENT;
+    ps->sent_at = now(px);
+    ps->stamp = ++px->stamp;
+    px->stats.segs_sent++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool send_ack(xfer_t *px) {
+    uint8_t ack[XFER_ACK_BYTES];
+    uint32_t bitmap = 0;
+    for (uint32_t i = 0; i + 1u < px->cfg.window; ++i) {
+        uint32_t seq = px->expected + 1u + i;
+        const xfer_slot_t *ps = rx_slot(px, seq);
+        if (ps->state == RX_FULL && ps->seq == (uint16_t)seq) {
+            bitmap |= 1u << i;
+        }
+    }
+    ack[0] = TYPE_ACK;
+    put16(&ack[1], px->expected);
+    put16(&ack[3], bitmap);
+    put16(&ack[5], bitmap >> 16);
+    ack[7] = (uint8_t)px->cfg.window;
+    if (!send_frame(px, ack, sizeof(ack))) {
+        return false;
+    }
+    px->stats.acks_sent++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static void deliver(xfer_t *px, const uint8_t *pdata, size_t len) {
+    px->expected++;
+    px->stats.segs_rcvd++;
+    if (px->on_rx) {
+        px->on_rx(px->pctx, len ? pdata : NULL, len);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void on_data(xfer_t *px, const uint8_t *ppayload, size_t len) {
+    uint16_t seq = (uint16_t)get16(&ppayload[1]);
+    uint32_t d = (uint16_t)(seq - (uint16_t)px->expected);
+    px->ack_due = true;
+    if (d >= px->cfg.window) {
+        // Resent after its ACK was lost, or beyond our window
+        px->stats.dups++;
+        return;
+    }
+    if (d == 0u) {
+        // In order: deliver straight from the decoder, then whatever was
+        // waiting behind it
+        deliver(px, &ppayload[XFER_HDR_BYTES], len - XFER_HDR_BYTES);
+        for (;;) {
+            xfer_slot_t *ps = rx_slot(px, px->expected);
+            if (ps->state != RX_FULL || ps->seq != (uint16_t)px->expected) {
+                break;
+            }
+            ps->state = RX_EMPTY;
+            deliver(px, &ps->frame[XFER_HDR_BYTES], ps->len);
+        }
+        return;
+    }
+    xfer_slot_t *ps = rx_slot(px, px->expected + d);
+    if (ps->state == RX_FULL && ps->seq == seq) {
+        px->stats.dups++;
+        return;
+    }
+    ps->seq = seq;
+    ps->len = (uint16_t)(len - XFER_HDR_BYTES);
+    ps->state = RX_FULL;
+    memcpy(ps->frame, ppayload, len);
+}
+
+//------------------------------------------------------------------------------
+static void ack_slot(xfer_t *px, xfer_slot_t *ps) {
+    if (ps->state != TX_SENT && ps->state != TX_LOST) {
+        return;
+    }
+    ps->state = TX_ACKED;
+    if ((int32_t)(ps->stamp - px->acked_stamp) > 0) {
+        px->acked_stamp = ps->stamp;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void on_ack(xfer_t *px, const uint8_t *ppayload) {
+    uint32_t d = (uint16_t)(get16(&ppayload[1]) - (uint16_t)px->base);
+    uint32_t in_flight = px->next - px->base;
+    if (d > in_flight) {
+        // Stale, from before base moved on
+        return;
+    }
+    px->stats.acks_rcvd++;
+    uint32_t window = ppayload[7];
+    px->peer_window = (window == 0u) ? 1u
+                    : (window > XFER_WINDOW_MAX) ? XFER_WINDOW_MAX : window;
+
+    uint32_t cum = px->base + d;
+    for (uint32_t seq = px->base; seq != cum; ++seq) {
+        ack_slot(px, tx_slot(px, seq));
+    }
+    uint32_t bitmap = get16(&ppayload[3]) | (get16(&ppayload[5]) << 16);
+    for (uint32_t i = 0; bitmap != 0u; ++i, bitmap >>= 1) {
+        uint32_t seq = cum + 1u + i;
+        if ((bitmap & 1u) && seq - px->base < in_flight) {
+            ack_slot(px, tx_slot(px, seq));
+        }
+    }
+    while (px->base != px->next && tx_slot(px, px->base)->state == TX_ACKED) {
+        tx_slot(px, px->base)->state = TX_EMPTY;
+        px->base++;
+    }
+    // The link keeps order: anything transmitted before a segment that got
+    // through, yet not acknowledged, was lost
+    for (uint32_t seq = px->base; seq != px->next; ++seq) {
+        xfer_slot_t *ps = tx_slot(px, seq);
+        if (ps->state == TX_SENT && (int32_t)(ps->stamp - px->acked_stamp) < 0) {
+            ps->state = TX_LOST;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Context: frame_decoder_feed() in xfer_poll()
+static void on_frame(void *pctx, const uint8_t *ppayload, size_t len) {
+    xfer_t *px = (xfer_t*)pctx;
+    if (len >= XFER_HDR_BYTES && ppayload[0] == TYPE_DATA) {
+        on_data(px, ppayload, len);
+    } else if (len == XFER_ACK_BYTES && ppayload[0] == TYPE_ACK) {
+        on_ack(px, ppayload);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool xfer_init(xfer_t *px, uart_t *pu, xfer_slot_t *ptx, xfer_slot_t *prx,
+        const xfer_config_t *pcfg, xfer_rx_fn on_rx, void *pctx) {
+    if (!px || !pu || !ptx || !prx || !pcfg || pcfg->window == 0u ||
+            pcfg->window > XFER_WINDOW_MAX || pcfg->rto == 0u) {
+        return false;
+    }
+    memset(px, 0, sizeof(*px));
+    px->pu = pu;
+    px->cfg = *pcfg;
+    px->ptx = ptx;
+    px->prx = prx;
+    px->peer_window = pcfg->window;
+    px->on_rx = on_rx;
+    px->pctx = pctx;
+    for (uint32_t i = 0; i < pcfg->window; ++i) {
+        ptx[i].state = TX_EMPTY;
+        prx[i].state = RX_EMPTY;
+    }
+    frame_decoder_init(&px->dec, px->dec_buf, sizeof(px->dec_buf), on_frame, px);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t xfer_send_space(const xfer_t *px) {
+    uint32_t window = (px->peer_window < px->cfg.window) ? px->peer_window
+                                                         : px->cfg.window;
+    uint32_t used = px->next - px->base;
+    return (used < window) ? (size_t)(window - used) : 0u;
+}
+
+//------------------------------------------------------------------------------
+size_t xfer_send(xfer_t *px, const uint8_t *pdata, size_t len) {
+    if (len == 0u || xfer_send_space(px) == 0u) {
+        return 0;
+    }
+    if (len > XFER_SEG_MAX) {
+        len = XFER_SEG_MAX;
+    }
+    xfer_slot_t *ps = tx_slot(px, px->next);
+    memcpy(&ps->frame[XFER_HDR_BYTES], pdata, len);
+    ps->seq = (uint16_t)px->next;
+    ps->len = (uint16_t)len;
+    ps->state = TX_QUEUED;
+    px->next++;
+    return len;
+}
+
+//------------------------------------------------------------------------------
+bool xfer_send_end(xfer_t *px) {
+    if (xfer_send_space(px) == 0u) {
+        return false;
+    }
+    xfer_slot_t *ps = tx_slot(px, px->next);
+    ps->seq = (uint16_t)px->next;
+    ps->len = 0;
+    ps->state = TX_QUEUED;
+    px->next++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool xfer_idle(const xfer_t *px) {
+    return px->base == px->next;
+}
+
+//------------------------------------------------------------------------------
+void xfer_poll(xfer_t *px) {
+    const uint8_t *p;
+    size_t n;
+    while ((n = uart_rx_peek(px->pu, &p)) > 0u) {
+        (void)frame_decoder_feed(&px->dec, p, n);
+        uart_rx_consume(px->pu, n);
+    }
+
+    // ACKs go first: the peer's window moves on them
+    if (px->ack_due && send_ack(px)) {
+        px->ack_due = false;
+    }
+
+    // Nothing acknowledged for a while: resend the oldest
+    if (px->base != px->next) {
+        xfer_slot_t *ps = tx_slot(px, px->base);
+        if (ps->state == TX_SENT && now(px) - ps->sent_at >= px->cfg.rto) {
+            if (!send_data(px, ps)) {
+                return;
+            }
+            px->stats.resent_rto++;
+        }
+    }
+
+    // Lost segments, then new ones, in sequence order (all lost ones are
+    // older than any never sent)
+    for (uint32_t seq = px->base; seq != px->next; ++seq) {
+        xfer_slot_t *ps = tx_slot(px, seq);
+        if (ps->state != TX_LOST && ps->state != TX_QUEUED) {
+            continue;
+        }
+        bool lost = (ps->state == TX_LOST);
+        if (!send_data(px, ps)) {
+            return;
+        }
+        if (lost) {
+            px->stats.resent_lost++;
+        }
+    }
+}
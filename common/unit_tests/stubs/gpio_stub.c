@@ -6,10 +6,15 @@
 //
 // GPIO API implementation for unit testing application code
 //
+// Each port is modelled as one output word updated with set/reset semantics,
+// matching a BSRR store on target: pins outside the mask never change.
+//
 //------------------------------------------------------------------------------
 
 #include "gpio_api.h"
-#include <stdio.h>
+#include "gpio_stub.h"
+#include <stddef.h>
+#include <string.h>
 
 //------------------------------------------------------------------------------
 // API Instantiation
@@ -21,28 +26,100 @@ gpio_api_t gpio;
 // Variables
 //------------------------------------------------------------------------------
 
-static uint8_t pin_states[32] = {0};
+static uint32_t port_state[GPIO_PORT_COUNT];
+static uint32_t port_stores;
+
+static gpio_config_t pin_cfg[GPIO_PORT_COUNT][GPIO_PORT_PINS];
+static uint32_t port_configured[GPIO_PORT_COUNT];
 
 //------------------------------------------------------------------------------
 // Function Definitions
 //------------------------------------------------------------------------------
-void gpio_write(uint32_t pin, uint8_t value) {
-    pin_states[pin] = value;
+// Helper modelling one BSRR store: set wins over reset, as on target
+static void port_store(gpio_port_t port, uint32_t set, uint32_t reset) {
+    set &= 0xFFFFu;
+    reset &= 0xFFFFu;
+    port_state[port] = (port_state[port] & ~reset) | set;
+    port_stores++;
+}
+
+//------------------------------------------------------------------------------
+bool gpio_configure(gpio_pin_t pin, const gpio_config_t *pcfg) {
+    gpio_port_t port = GPIO_PIN_PORT(pin);
+    if (port >= GPIO_PORT_COUNT || !pcfg) {
+        return false;
+    }
+    pin_cfg[port][GPIO_PIN_NUM(pin)] = *pcfg;
+    port_configured[port] |= GPIO_PIN_MASK(pin);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void gpio_write(gpio_pin_t pin, uint8_t value) {
+    uint32_t bit = GPIO_PIN_MASK(pin);
+    if (value) {
+        port_store(GPIO_PIN_PORT(pin), bit, 0U);
+    } else {
+        port_store(GPIO_PIN_PORT(pin), 0U, bit);
+    }
+}
+
+//------------------------------------------------------------------------------
+void gpio_toggle(gpio_pin_t pin) {
+    gpio_port_t port = GPIO_PIN_PORT(pin);
+    uint32_t bit = GPIO_PIN_MASK(pin);
+    port_store(port, ~port_state[port] & bit, port_state[port] & bit);
+}
+
+//------------------------------------------------------------------------------
+void gpio_write_mask(gpio_port_t port, uint32_t mask, uint32_t value) {
+    port_store(port, mask & value, mask & ~value);
+}
+
+//------------------------------------------------------------------------------
+void gpio_set_mask(gpio_port_t port, uint32_t mask) {
+    port_store(port, mask, 0U);
 }
 
 //------------------------------------------------------------------------------
-void gpio_toggle(uint32_t pin) {
-    pin_states[pin] ^= 1U;
+void gpio_clear_mask(gpio_port_t port, uint32_t mask) {
+    port_store(port, 0U, mask);
 }
 
 //------------------------------------------------------------------------------
 void gpio_init(void) {
+    memset(port_state, 0, sizeof(port_state));
+    memset(port_configured, 0, sizeof(port_configured));
+    port_stores = 0U;
     // Install API implementation
-    gpio.write  = gpio_write;
-    gpio.toggle = gpio_toggle;
+    gpio.configure  = gpio_configure;
+    gpio.write      = gpio_write;
+    gpio.toggle     = gpio_toggle;
+    gpio.write_mask = gpio_write_mask;
+    gpio.set_mask   = gpio_set_mask;
+    gpio.clear_mask = gpio_clear_mask;
+}
+
+//------------------------------------------------------------------------------
+uint8_t gpio_get_pin(gpio_pin_t pin) {
+    return (uint8_t)((port_state[GPIO_PIN_PORT(pin)] >> GPIO_PIN_NUM(pin)) & 1U);
+}
+
+//------------------------------------------------------------------------------
+uint32_t gpio_get_port(gpio_port_t port) {
+    return port_state[port];
+}
+
+//------------------------------------------------------------------------------
+const gpio_config_t *gpio_stub_config(gpio_pin_t pin) {
+    gpio_port_t port = GPIO_PIN_PORT(pin);
+    if (port >= GPIO_PORT_COUNT || !(port_configured[port] & GPIO_PIN_MASK(pin))) {
+        return NULL;
+    }
+    return &pin_cfg[port][GPIO_PIN_NUM(pin)];
 }
 
 //------------------------------------------------------------------------------
-uint8_t gpio_get_pin(uint32_t pin) {
-    return pin_states[pin];
+uint32_t gpio_stub_store_count(void) {
+    return port_stores;
 }
@@ -11,6 +11,22 @@
 //
 //------------------------------------------------------------------------------
 
-// Add any externally needed data types or functions
+#include <stdint.h>
+#include "gpio_api.h"
 
-// INCLUDE_GPIO_STUB_H_
\ No newline at end of file
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Current output level of one pin, or of a whole port
+uint8_t gpio_get_pin(gpio_pin_t pin);
+uint32_t gpio_get_port(gpio_port_t port);
+
+//------------------------------------------------------------------------------
+// Last configuration applied to a pin, NULL if never configured
+const gpio_config_t *gpio_stub_config(gpio_pin_t pin);
+
+//------------------------------------------------------------------------------
+// Port stores issued since gpio_init(): one per API call, as BSRR on target
+uint32_t gpio_stub_store_count(void);
+
+#endif // INCLUDE_GPIO_STUB_H_
@@ -0,0 +1,222 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Threaded ISR/main harness for the UART core
+//
+//------------------------------------------------------------------------------
+
+// pthread_setaffinity_np(), CPU_SET()
+#define _GNU_SOURCE
+
+#include "isr_harness.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ringbuf.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Largest producer burst and consumer read
+#define HARNESS_CHUNK_MAX  256u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    uart_t *pu;
+    const isr_harness_config_t *pcfg;
+    atomic_bool done;
+    uint64_t produced;
+    uint64_t consumed;
+    uint64_t sequence_errors;
+    bool     producer_pinned;
+    bool     consumer_pinned;
+} harness_run_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static atomic_uint s_preempt_every;
+static atomic_uint s_preempt_calls;
+static atomic_uint s_preemptions;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+// Pin the calling thread; CPUs beyond those online wrap around
+static bool pin_self(int cpu) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpu < 0 || online <= 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((unsigned)cpu % (unsigned)online, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 &&
+        cpu < online;
+}
+
+//------------------------------------------------------------------------------
+// Preemption point hook for ringbuf.h (RINGBUF_PREEMPT_HOOK)
+void ringbuf_preempt_point(void) {
+    unsigned every = atomic_load_explicit(&s_preempt_every, memory_order_relaxed);
+    if (!every) {
+        return;
+    }
+    unsigned n = atomic_fetch_add_explicit(&s_preempt_calls, 1u,
+        memory_order_relaxed);
+    if ((n % every) == every - 1u) {
+        atomic_fetch_add_explicit(&s_preemptions, 1u, memory_order_relaxed);
+        sched_yield();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Threads
+//------------------------------------------------------------------------------
+static void *producer(void *parg) {
+    harness_run_t *pr = (harness_run_t*)parg;
+    const isr_harness_config_t *pc = pr->pcfg;
+    uint8_t burst[HARNESS_CHUNK_MAX];
+    uint32_t len = pc->isr_burst ? pc->isr_burst : 1u;
+    uint64_t start = now_ns();
+    pr->producer_pinned = pin_self(pc->producer_cpu);
+
+    while (pr->produced < pc->total_bytes) {
+        // Pace to the configured rate, letting the consumer run meanwhile
+        if (pc->rx_bytes_per_s &&
+                now_ns() - start <
+                pr->produced * 1000000000u / pc->rx_bytes_per_s) {
+            sched_yield();
+            continue;
+        }
+        uint64_t left = pc->total_bytes - pr->produced;
+        uint32_t n = (left < len) ? (uint32_t)left : len;
+        for (uint32_t i = 0; i < n; ++i) {
+            burst[i] = (uint8_t)(pr->produced + i);
+        }
+        if (n == 1u) {
+            uart_isr_rx_byte(pr->pu, burst[0]);
+        } else {
+            uart_isr_rx_block(pr->pu, burst, n);
+        }
+        pr->produced += n;
+    }
+    atomic_store_explicit(&pr->done, true, memory_order_release);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static void *consumer(void *parg) {
+    harness_run_t *pr = (harness_run_t*)parg;
+    const isr_harness_config_t *pc = pr->pcfg;
+    uint8_t buf[HARNESS_CHUNK_MAX];
+    size_t chunk = pc->read_chunk ? pc->read_chunk : 1u;
+    uint8_t expect = 0;
+    pr->consumer_pinned = pin_self(pc->consumer_cpu);
+
+    for (;;) {
+        // Sample done first: anything pushed before it is read below
+        bool done = atomic_load_explicit(&pr->done, memory_order_acquire);
+        uint32_t ts;
+        size_t n = uart_read_ts(pr->pu, buf, chunk, &ts);
+        for (size_t i = 0; i < n; ++i) {
+            if (buf[i] != expect) {
+                pr->sequence_errors++;
+            }
+            expect = (uint8_t)(buf[i] + 1u);
+        }
+        pr->consumed += n;
+        if (!n) {
+            if (done) {
+                break;
+            }
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Backend Function Definitions
+//------------------------------------------------------------------------------
+static bool h_init(uint32_t baud) { (void)baud; return true; }
+static bool h_tx_ready(void) { return true; }
+static void h_tx_write(uint8_t byte) { (void)byte; }
+static bool h_rx_available(void) { return false; }
+static uint8_t h_rx_read(void) { return 0u; }
+static uint32_t h_timestamp(void) { return (uint32_t)(now_ns() / 1000u); }
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void isr_harness_install(uart_hw_vtable_t *pv) {
+    *pv = (uart_hw_vtable_t){
+        .hw_init = h_init,
+        .hw_tx_ready = h_tx_ready,
+        .hw_tx_write = h_tx_write,
+        .hw_rx_available = h_rx_available,
+        .hw_rx_read = h_rx_read,
+        .hw_timestamp = h_timestamp,
+    };
+}
+
+//------------------------------------------------------------------------------
+bool isr_harness_run(uart_t *pu, const isr_harness_config_t *pcfg,
+        isr_harness_result_t *pres) {
+    if (!pu || !pcfg || !pres || pcfg->isr_burst > HARNESS_CHUNK_MAX ||
+            pcfg->read_chunk > HARNESS_CHUNK_MAX) {
+        return false;
+    }
+    harness_run_t run = { .pu = pu, .pcfg = pcfg };
+    atomic_init(&run.done, false);
+    atomic_store(&s_preempt_every, pcfg->preempt_every);
+    atomic_store(&s_preempt_calls, 0u);
+    atomic_store(&s_preemptions, 0u);
+    uint32_t overflow0 = uart_rx_overflow_count(pu);
+
+    pthread_t tp;
+    pthread_t tc;
+    uint64_t t0 = now_ns();
+    if (pthread_create(&tc, NULL, consumer, &run) != 0) {
+        return false;
+    }
+    if (pthread_create(&tp, NULL, producer, &run) != 0) {
+        atomic_store(&run.done, true);
+        (void)pthread_join(tc, NULL);
+        return false;
+    }
+    (void)pthread_join(tp, NULL);
+    (void)pthread_join(tc, NULL);
+    uint64_t t1 = now_ns();
+    atomic_store(&s_preempt_every, 0u);
+
+    memset(pres, 0, sizeof(*pres));
+    pres->produced = run.produced;
+    pres->consumed = run.consumed;
+    pres->overflow = uart_rx_overflow_count(pu) - overflow0;
+    pres->sequence_errors = run.sequence_errors;
+    pres->preemptions = atomic_load(&s_preemptions);
+    pres->elapsed_ns = t1 - t0;
+    pres->consumed_bytes_per_s = pres->elapsed_ns ?
+        (double)run.consumed * 1e9 / (double)pres->elapsed_ns : 0.0;
+    pres->pinned = run.producer_pinned && run.consumer_pinned;
+    return true;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_ISR_HARNESS_H_
+#define INCLUDE_ISR_HARNESS_H_
+//------------------------------------------------------------------------------
+//
+// Threaded ISR/main harness for the UART core
+//
+// Runs the Rx producer (standing in for the ISR) and the consumer (main loop)
+// on separate threads, optionally pinned to CPUs, so ordering bugs and
+// contention in the ISR/main split show up on the host. Build with
+// RINGBUF_PREEMPT_HOOK to yield at the ring buffer's preemption points, and
+// with -fsanitize=thread to have every unsynchronized access reported.
+//
+// The producer sends a counting byte sequence; the consumer checks it and
+// the run reports throughput, loss and sequence errors.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    // Bytes the producer sends
+    uint64_t total_bytes;
+    // Producer rate in bytes/s (0 = as fast as it can)
+    uint32_t rx_bytes_per_s;
+    // Bytes per producer call: 1 uses uart_isr_rx_byte(), more use
+    // uart_isr_rx_block() as a DMA/idle-line ISR would
+    uint32_t isr_burst;
+    // Consumer read size
+    size_t   read_chunk;
+    // CPU per thread (-1 = not pinned)
+    int      producer_cpu;
+    int      consumer_cpu;
+    // Every nth preemption point yields the CPU (0 = never)
+    uint32_t preempt_every;
+} isr_harness_config_t;
+
+typedef struct {
+    uint64_t produced;
+    uint64_t consumed;
+    // Bytes dropped by the core because the Rx FIFO was full
+    uint64_t overflow;
+    // Bytes out of sequence; only meaningful when nothing overflowed
+    uint64_t sequence_errors;
+    uint64_t preemptions;
+    uint64_t elapsed_ns;
+    double   consumed_bytes_per_s;
+    // Both threads got the CPU they asked for
+    bool     pinned;
+} isr_harness_result_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Backend for the harness: Tx discards, Rx comes only from the producer,
+// timestamps are microseconds of CLOCK_MONOTONIC
+void isr_harness_install(uart_hw_vtable_t *pv);
+
+//------------------------------------------------------------------------------
+// Run both threads to completion on an initialized instance
+bool isr_harness_run(uart_t *pu, const isr_harness_config_t *pcfg,
+    isr_harness_result_t *pres);
+
+#endif // INCLUDE_ISR_HARNESS_H_
@@ -0,0 +1,94 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// LED PWM backend implementation for unit testing application code
+//
+//------------------------------------------------------------------------------
+
+#include "led_pwm_stub.h"
+
+//------------------------------------------------------------------------------
+// Stubbed LED PWM object
+//------------------------------------------------------------------------------
+
+static led_pwm_stub_ctx_t *pGlobalctx;
+
+//------------------------------------------------------------------------------
+// Stub Function Definitions
+//------------------------------------------------------------------------------
+static bool s_init(void) {
+    pGlobalctx->inits++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool s_pwm(uint32_t counter_hz, uint32_t period, uint32_t duty) {
+    // Same limits as a 16-bit timer
+    if (counter_hz == 0u || period == 0u || period > 0xFFFFu) {
+        return false;
+    }
+    pGlobalctx->running = true;
+    pGlobalctx->counter_hz = counter_hz;
+    pGlobalctx->period = period;
+    pGlobalctx->duty = duty;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool s_sequence(const uint16_t *pduty, size_t steps, uint32_t step_us) {
+    if (!pGlobalctx->sequencer || !pduty || !steps || !step_us) {
+        return false;
+    }
+    pGlobalctx->pduty = pduty;
+    pGlobalctx->steps = steps;
+    pGlobalctx->step_us = step_us;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool s_stop(void) {
+    pGlobalctx->stops++;
+    if (pGlobalctx->wedged) {
+        return false;
+    }
+    pGlobalctx->running = false;
+    pGlobalctx->pduty = NULL;
+    pGlobalctx->steps = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void led_pwm_stub_create(led_pwm_hw_vtable_t *pv, led_pwm_stub_ctx_t *pctx) {
+    pGlobalctx = pctx;
+    // Install stub implementation
+    pv->hw_init = s_init;
+    pv->hw_pwm = s_pwm;
+    pv->hw_sequence = s_sequence;
+    pv->hw_stop = s_stop;
+}
+
+//------------------------------------------------------------------------------
+uint32_t led_pwm_stub_duty_at(uint64_t t_us) {
+    if (!pGlobalctx->running) {
+        return 0u;
+    }
+    if (pGlobalctx->pduty) {
+        return pGlobalctx->pduty[(t_us / pGlobalctx->step_us) % pGlobalctx->steps];
+    }
+    return pGlobalctx->duty;
+}
+
+//------------------------------------------------------------------------------
+bool led_pwm_stub_output(uint64_t t_us) {
+    if (!pGlobalctx->running) {
+        return false;
+    }
+    // Counter position within the PWM period, as in PWM mode 1
+    uint64_t ticks = (t_us * pGlobalctx->counter_hz) / 1000000u;
+    return (ticks % pGlobalctx->period) < led_pwm_stub_duty_at(t_us);
+}
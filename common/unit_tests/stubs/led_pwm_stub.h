@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_LED_PWM_STUB_H_
+#define INCLUDE_LED_PWM_STUB_H_
+//------------------------------------------------------------------------------
+//
+// LED PWM stub specification for unit testing application code: records the
+// timer settings and models the LED output over time
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "led_pwm_api.h"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Context
+typedef struct {
+    // Set false to model a backend without a hardware sequencer
+    bool sequencer;
+    // Set true to model a sequencer that does not stop
+    bool wedged;
+    // Steady PWM, as last given to hw_pwm
+    bool running;
+    uint32_t counter_hz;
+    uint32_t period;
+    uint32_t duty;
+    // Sequence, pduty NULL when none
+    const uint16_t *pduty;
+    size_t steps;
+    uint32_t step_us;
+    // Call counts
+    uint32_t inits;
+    uint32_t stops;
+} led_pwm_stub_ctx_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void led_pwm_stub_create(led_pwm_hw_vtable_t *pv, led_pwm_stub_ctx_t *pctx);
+
+//------------------------------------------------------------------------------
+// Duty (in counter ticks) in effect t_us after the mode started
+uint32_t led_pwm_stub_duty_at(uint64_t t_us);
+// LED level (on/off) t_us after the mode started
+bool led_pwm_stub_output(uint64_t t_us);
+
+#endif // INCLUDE_LED_PWM_STUB_H_
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Simulated serial line between two stub UARTs
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "lossy_link.h"
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static const lossy_link_t *s_active;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+// xorshift32: deterministic for a given seed
+static uint32_t rng_next(lossy_link_t *plink) {
+    uint32_t x = plink->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    plink->rng = x;
+    return x;
+}
+
+//------------------------------------------------------------------------------
+static bool chance(lossy_link_t *plink, uint32_t ppm) {
+    return ppm && (rng_next(plink) % 1000000u) < ppm;
+}
+
+//------------------------------------------------------------------------------
+// Send one step's worth from one end into its delay line, and deliver what
+// has come out of the other side of it
+static void move(lossy_link_t *plink, lossy_link_end_t *pfrom, uart_t *pto) {
+    uint32_t slot = plink->step % (plink->cfg.delay_steps + 1u);
+
+    pfrom->carry_ns += plink->cfg.step_ns;
+    uint64_t budget = pfrom->carry_ns / plink->char_ns;
+    if (budget > LOSSY_LINK_CHUNK_MAX) {
+        budget = LOSSY_LINK_CHUNK_MAX;
+    }
+    pfrom->ctx.ptx_buf = pfrom->chunk[slot];
+    pfrom->ctx.tx_capacity = LOSSY_LINK_CHUNK_MAX;
+    pfrom->ctx.tx_len = 0;
+    pfrom->ctx.tx_bytes = (int)budget;
+    uart_service_tx(pfrom->pu);
+    pfrom->ctx.tx_bytes = 0;
+    size_t n = pfrom->ctx.tx_len;
+    // An idle line does not bank time
+    pfrom->carry_ns = (n == budget) ? pfrom->carry_ns - n * plink->char_ns : 0u;
+    pfrom->sent += n;
+
+    // Damage in place; dropped bytes are squeezed out
+    uint8_t *p = pfrom->chunk[slot];
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (chance(plink, plink->cfg.drop_ppm)) {
+            pfrom->dropped++;
+            continue;
+        }
+        uint8_t b = p[i];
+        if (chance(plink, plink->cfg.corrupt_ppm)) {
+            b ^= (uint8_t)(1u << (rng_next(plink) & 7u));
+            pfrom->corrupted++;
+        }
+        p[kept++] = b;
+    }
+    pfrom->chunk_len[slot] = kept;
+
+    // The chunk sent delay_steps ago arrives now
+    uint32_t out = (plink->step + 1u) % (plink->cfg.delay_steps + 1u);
+    if (pfrom->chunk_len[out]) {
+        uart_isr_rx_block(pto, pfrom->chunk[out], pfrom->chunk_len[out]);
+        pfrom->chunk_len[out] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool lossy_link_create(lossy_link_t *plink, const lossy_link_config_t *pcfg,
+        uart_hw_vtable_t *pv_a, uart_hw_vtable_t *pv_b) {
+    if (!plink || !pcfg || !pcfg->baud || !pcfg->bits_per_char ||
+            !pcfg->step_ns || pcfg->delay_steps > LOSSY_LINK_DELAY_MAX) {
+        return false;
+    }
+    memset(plink, 0, sizeof(*plink));
+    plink->cfg = *pcfg;
+    plink->char_ns = (uint32_t)((1000000000ull * pcfg->bits_per_char +
+        pcfg->baud - 1u) / pcfg->baud);
+    if ((uint64_t)pcfg->step_ns / plink->char_ns > LOSSY_LINK_CHUNK_MAX) {
+        return false;
+    }
+    plink->rng = pcfg->seed ? pcfg->seed : 1u;
+    for (size_t i = 0; i < 2u; ++i) {
+        plink->end[i].ctx.block_io = true;
+    }
+    s_active = plink;
+    return uart_hw_stub_create_instance(pv_a, &plink->end[0].ctx, 0) &&
+        uart_hw_stub_create_instance(pv_b, &plink->end[1].ctx, 1);
+}
+
+//------------------------------------------------------------------------------
+void lossy_link_connect(lossy_link_t *plink, uart_t *pu_a, uart_t *pu_b) {
+    plink->end[0].pu = pu_a;
+    plink->end[1].pu = pu_b;
+}
+
+//------------------------------------------------------------------------------
+void lossy_link_step(lossy_link_t *plink) {
+    move(plink, &plink->end[0], plink->end[1].pu);
+    move(plink, &plink->end[1], plink->end[0].pu);
+    plink->step++;
+    plink->now_ns += plink->cfg.step_ns;
+}
+
+//------------------------------------------------------------------------------
+uint32_t lossy_link_now_us(void) {
+    return s_active ? (uint32_t)(s_active->now_ns / 1000u) : 0u;
+}
+
+//------------------------------------------------------------------------------
+double lossy_link_char_rate(const lossy_link_t *plink) {
+    return 1e9 / (double)plink->char_ns;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_LOSSY_LINK_H_
+#define INCLUDE_LOSSY_LINK_H_
+//------------------------------------------------------------------------------
+//
+// Two UART instances on stub backends joined by a simulated serial line, on
+// a virtual clock
+//
+// Each step moves at most one step's worth of characters at the baud rate
+// from each end's Tx FIFO, damages bytes at the configured rates, and hands
+// them to the other end's Rx FIFO after the configured line delay (e.g., a
+// USB-serial adapter's latency).
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "uart_api.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Characters one step may carry, and the longest line delay in steps
+#define LOSSY_LINK_CHUNK_MAX   256u
+#define LOSSY_LINK_DELAY_MAX   64u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Configuration
+typedef struct {
+    uint32_t baud;
+    // Bits per character on the line (10 for 8N1)
+    uint32_t bits_per_char;
+    uint32_t step_ns;
+    uint32_t delay_steps;
+    // Per byte and direction, in parts per million: one bit flipped, or the
+    // byte lost
+    uint32_t corrupt_ppm;
+    uint32_t drop_ppm;
+    uint32_t seed;
+} lossy_link_config_t;
+
+// One direction of the line
+typedef struct {
+    uart_stub_ctx_t ctx;
+    uart_t   *pu;
+    // Delay line, one chunk per step
+    uint8_t  chunk[LOSSY_LINK_DELAY_MAX + 1u][LOSSY_LINK_CHUNK_MAX];
+    size_t   chunk_len[LOSSY_LINK_DELAY_MAX + 1u];
+    // Character time left over from the previous step, in ns
+    uint64_t carry_ns;
+    // Counters
+    uint64_t sent;
+    uint64_t corrupted;
+    uint64_t dropped;
+} lossy_link_end_t;
+
+// Link state; treat as opaque
+typedef struct {
+    lossy_link_config_t cfg;
+    uint64_t now_ns;
+    uint32_t char_ns;
+    uint32_t step;
+    uint32_t rng;
+    lossy_link_end_t end[2];
+} lossy_link_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Prepare the link and install stub backends for both ends (stub instances 0
+// and 1); false on bad configuration
+// Then initialize a UART on each vtable and connect them
+// Only one link is active at a time (lossy_link_now_us reads it)
+bool lossy_link_create(lossy_link_t *plink, const lossy_link_config_t *pcfg,
+    uart_hw_vtable_t *pv_a, uart_hw_vtable_t *pv_b);
+
+//------------------------------------------------------------------------------
+void lossy_link_connect(lossy_link_t *plink, uart_t *pu_a, uart_t *pu_b);
+
+//------------------------------------------------------------------------------
+// Advance the clock one step and move bytes both ways
+void lossy_link_step(lossy_link_t *plink);
+
+//------------------------------------------------------------------------------
+// Virtual time of the active link, for time source callbacks
+uint32_t lossy_link_now_us(void);
+
+//------------------------------------------------------------------------------
+// Characters the line can carry in one direction per second
+double lossy_link_char_rate(const lossy_link_t *plink);
+
+#endif // INCLUDE_LOSSY_LINK_H_
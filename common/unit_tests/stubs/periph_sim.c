@@ -0,0 +1,980 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Register-level STM32H5 peripheral model behind REG32() on the host
+//
+//------------------------------------------------------------------------------
+
+#include "periph_sim.h"
+#include <stdbool.h>
+#include <string.h>
+#include "gpio_api.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Distinct registers touched by a test, power of two
+#define SIM_MAP_WORDS      1024u
+
+// Peripheral blocks
+#define SIM_USART          ((uintptr_t)USART3_BASE)
+#define SIM_USART_SIZE     0x400u
+#define SIM_GPIO_SIZE      (GPIO_PORT_COUNT * GPIO_PORT_STRIDE)
+
+#define SIM_USART_BITS     10u
+#define SIM_FIFO_DEPTH     8u
+// TDR content before a store: no byte write can produce it
+#define SIM_TDR_EMPTY      0xFFFFFFFFu
+// ISR flags latched until cleared through ICR
+#define SIM_ISR_LATCHED    (USART_ISR_RX_ERRORS | USART_ISR_RTOF)
+
+// Flash: typical 128-bit program and 8 KB sector erase times
+#define SIM_FLASH          ((uintptr_t)FLASH_MEM_BASE)
+#define SIM_FLASH_REGS     ((uintptr_t)FLASH_REGS_BASE)
+#define SIM_FLASH_REGS_SIZE 0x400u
+#define SIM_FLASH_PROG_NS  50000u
+#define SIM_FLASH_ERASE_NS 2000000u
+#define SIM_QWORD_BYTES    (4u * FLASH_QWORD_WORDS)
+#define SIM_QWORD_FULL     ((1u << FLASH_QWORD_WORDS) - 1u)
+
+// GPDMA1, and the peripheral space its channels address as is
+#define SIM_GPDMA          ((uintptr_t)GPDMA1_BASE)
+#define SIM_GPDMA_SIZE     0x1000u
+#define SIM_PERIPH         0x40000000u
+#define SIM_PERIPH_SIZE    0x20000000u
+// Host memory on the DMA bus: 64 KiB windows handed out in pairs, so an
+// object starting in the first may run into the second
+#define SIM_BUS            0x20000000u
+#define SIM_BUS_WINDOW     0x10000u
+#define SIM_BUS_WINDOWS    32u
+// Beats a software-request channel moves per model update, so a ring
+// cannot hang the model
+#define SIM_DMA_SWREQ_BEATS 0x10000u
+#define SIM_DMA_REG(ch, offset) (SIM_GPDMA + GPDMA_CH_OFFSET(ch) + (offset))
+#define SIM_DMA_STRIDE     (GPDMA_CH_OFFSET(1) - GPDMA_CH_OFFSET(0))
+
+// Line-side queues
+#define SIM_RXQ            4096u
+#define SIM_TXQ            4096u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    uintptr_t addr;
+    volatile uint32_t value;
+    bool used;
+} sim_word_t;
+
+typedef struct {
+    uint64_t t_ns;
+    uint32_t flags;
+    uint8_t  byte;
+} sim_char_t;
+
+// GPDMA channel state beyond its registers
+typedef struct {
+    bool active;
+    bool susp;
+    // Fail the next beat
+    bool fault;
+    // Never report SUSPF or IDLEF
+    bool wedged;
+    // CSR flags latched until cleared through CFCR
+    uint32_t flags;
+} sim_dma_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static sim_word_t s_map[SIM_MAP_WORDS];
+// Unclocked peripherals read zero and drop writes
+static volatile uint32_t s_dead;
+// Register yielded by the previous access, committed at the next one
+static uintptr_t s_last;
+
+static uint64_t s_now_ns;
+static uint32_t s_access_ns;
+static periph_sim_stats_t s_stats;
+
+// USART3 state beyond its registers
+static uint8_t  s_rx_fifo[SIM_FIFO_DEPTH];
+static uint32_t s_rx_head;
+static uint32_t s_rx_count;
+static uint32_t s_flags;
+static uint32_t s_cr1;
+static uint64_t s_rx_last_ns;
+static bool     s_rto_armed;
+static sim_char_t s_rxq[SIM_RXQ];
+static uint32_t s_rxq_head;
+static uint32_t s_rxq_count;
+static uint64_t s_rxq_tail_ns;
+static sim_char_t s_txq[SIM_TXQ];
+static uint32_t s_txq_head;
+static uint32_t s_txq_count;
+static uint64_t s_tx_free_ns;
+
+// Flash memory, controller state beyond its registers, and the write buffer
+static uint8_t  s_flash[FLASH_MEM_BYTES];
+static volatile uint32_t s_flash_word;
+static uint32_t s_fl_cr;
+static uint32_t s_fl_flags;
+static uint32_t s_fl_keys;
+static bool     s_fl_busy;
+static uint64_t s_fl_done_ns;
+static uint32_t s_fl_wbuf[FLASH_QWORD_WORDS];
+static uint32_t s_fl_wmask;
+static uintptr_t s_fl_waddr;
+
+// GPDMA channels, and the host windows mapped onto the DMA bus
+static sim_dma_t s_dma[GPDMA1_CHANNELS];
+static uintptr_t s_win[SIM_BUS_WINDOWS];
+static uint32_t s_win_count;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static void commit(void);
+static volatile uint32_t *access(uintptr_t addr);
+
+//------------------------------------------------------------------------------
+// Register storage, created on first use
+static volatile uint32_t *word(uintptr_t addr) {
+    uint32_t i = (uint32_t)(addr >> 2) & (SIM_MAP_WORDS - 1u);
+    for (uint32_t n = 0; n < SIM_MAP_WORDS; ++n) {
+        sim_word_t *pw = &s_map[(i + n) & (SIM_MAP_WORDS - 1u)];
+        if (!pw->used) {
+            pw->used = true;
+            pw->addr = addr;
+            pw->value = 0u;
+            return &pw->value;
+        }
+        if (pw->addr == addr) {
+            return &pw->value;
+        }
+    }
+    // Map full: the test touches far more registers than any backend
+    s_dead = 0u;
+    return &s_dead;
+}
+
+//------------------------------------------------------------------------------
+static inline uint32_t rd(uintptr_t addr) {
+    return *word(addr);
+}
+
+//------------------------------------------------------------------------------
+static inline bool in_block(uintptr_t addr, uintptr_t base, uintptr_t size) {
+    return addr >= base && (addr - base) < size;
+}
+
+//------------------------------------------------------------------------------
+static bool usart_clocked(void) {
+    return (rd(RCC_APB1LENR_ADDR) & RCC_EN_USART3) != 0u;
+}
+
+//------------------------------------------------------------------------------
+static bool gpio_clocked(uintptr_t addr) {
+    uint32_t port = (uint32_t)((addr - GPIOA_BASE) / GPIO_PORT_STRIDE);
+    return (rd(RCC_AHB2ENR_ADDR) & RCC_EN_GPIO(port)) != 0u;
+}
+
+//------------------------------------------------------------------------------
+// Duration of a number of bit times at the BRR setting (x16 oversampling)
+static uint64_t bits_ns(uint64_t bits) {
+    uint64_t brr = rd(SIM_USART + USART_BRR_OFFSET) & 0xFFFFu;
+    return (bits * brr * 1000000000ull) / UART_HW_USART_CLK_HZ;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t fifo_depth(void) {
+    return (s_cr1 & USART_CR1_FIFOEN) ? SIM_FIFO_DEPTH : 1u;
+}
+
+//------------------------------------------------------------------------------
+// Characters in the Tx shift register and FIFO
+static uint64_t tx_pending(void) {
+    uint64_t char_ns = bits_ns(SIM_USART_BITS);
+    if (s_tx_free_ns <= s_now_ns || !char_ns) {
+        return 0u;
+    }
+    return (s_tx_free_ns - s_now_ns + char_ns - 1u) / char_ns;
+}
+
+//------------------------------------------------------------------------------
+static bool usart_on(uint32_t bit) {
+    return usart_clocked() && (s_cr1 & USART_CR1_UE) && (s_cr1 & bit);
+}
+
+//------------------------------------------------------------------------------
+// Land every Rx character due by now and raise the receiver timeout
+static void usart_update(void) {
+    while (s_rxq_count && s_rxq[s_rxq_head].t_ns <= s_now_ns) {
+        const sim_char_t *pc = &s_rxq[s_rxq_head];
+        s_rxq_head = (s_rxq_head + 1u) % SIM_RXQ;
+        s_rxq_count--;
+        bool on = usart_on(USART_CR1_RE);
+        if (!on || (s_flags & USART_ISR_ORE)) {
+            // Receiver off, or held off until ORE is cleared
+            s_stats.rx_lost++;
+        } else if (s_rx_count < fifo_depth()) {
+            s_rx_fifo[(s_rx_head + s_rx_count) % SIM_FIFO_DEPTH] = pc->byte;
+            s_rx_count++;
+            s_flags |= pc->flags & USART_ISR_RX_ERRORS;
+        } else {
+            s_flags |= USART_ISR_ORE;
+            s_stats.rx_lost++;
+        }
+        s_rx_last_ns = pc->t_ns;
+        s_rto_armed = on;
+    }
+    uint32_t rtor = rd(SIM_USART + USART_RTOR_OFFSET) & USART_RTOR_RTO_MASK;
+    if (s_rto_armed && (rd(SIM_USART + USART_CR2_OFFSET) & USART_CR2_RTOEN) &&
+            s_now_ns >= s_rx_last_ns + bits_ns(rtor)) {
+        s_flags |= USART_ISR_RTOF;
+        s_rto_armed = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void tx_byte(uint8_t byte) {
+    if (!usart_on(USART_CR1_TE)) {
+        return;
+    }
+    if (tx_pending() >= (uint64_t)fifo_depth() + 1u) {
+        // No room: the byte replaces the last one queued
+        s_stats.tdr_overwrites++;
+        if (s_txq_count) {
+            s_txq[(s_txq_head + s_txq_count - 1u) % SIM_TXQ].byte = byte;
+        }
+        return;
+    }
+    uint64_t start = (s_tx_free_ns > s_now_ns) ? s_tx_free_ns : s_now_ns;
+    s_tx_free_ns = start + bits_ns(SIM_USART_BITS);
+    if (s_txq_count < SIM_TXQ) {
+        s_txq[(s_txq_head + s_txq_count) % SIM_TXQ] =
+            (sim_char_t){ .t_ns = s_tx_free_ns, .byte = byte };
+        s_txq_count++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Disabling the USART resets its state machines and flags
+static void usart_cr1_write(uint32_t cr1) {
+    bool was_on = (s_cr1 & USART_CR1_UE) != 0u;
+    s_cr1 = cr1;
+    if (was_on && !(cr1 & USART_CR1_UE)) {
+        s_rx_count = 0u;
+        s_flags = 0u;
+        s_rto_armed = false;
+        // Characters not yet fully sent are dropped
+        while (s_txq_count &&
+                s_txq[(s_txq_head + s_txq_count - 1u) % SIM_TXQ].t_ns > s_now_ns) {
+            s_txq_count--;
+        }
+        s_tx_free_ns = s_now_ns;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Flash Model
+//------------------------------------------------------------------------------
+static void flash_update(void) {
+    if (s_fl_busy && s_now_ns >= s_fl_done_ns) {
+        s_fl_busy = false;
+        s_fl_flags |= FLASH_SR_EOP;
+    }
+}
+
+//------------------------------------------------------------------------------
+// The bus holds an access to the flash until the operation ends
+static void flash_stall(void) {
+    flash_update();
+    if (s_fl_busy) {
+        s_stats.flash_stall_ns += s_fl_done_ns - s_now_ns;
+        s_now_ns = s_fl_done_ns;
+        flash_update();
+    }
+}
+
+//------------------------------------------------------------------------------
+static void flash_start(uint64_t ns) {
+    s_fl_busy = true;
+    s_fl_done_ns = s_now_ns + ns;
+    s_stats.flash_busy_ns += ns;
+}
+
+//------------------------------------------------------------------------------
+static void flash_erase(uint32_t cr) {
+    if (s_fl_busy || s_fl_wmask) {
+        s_fl_flags |= FLASH_SR_PGSERR;
+        return;
+    }
+    uint32_t sector = (cr & FLASH_CR_SNB_MASK) >> FLASH_CR_SNB_SHIFT;
+    uint32_t off = ((cr & FLASH_CR_BKSEL) ? FLASH_BANK_BYTES : 0u) +
+        sector * FLASH_SECTOR_BYTES;
+    memset(&s_flash[off], 0xFF, FLASH_SECTOR_BYTES);
+    s_stats.flash_erases++;
+    flash_start(SIM_FLASH_ERASE_NS);
+}
+
+//------------------------------------------------------------------------------
+// NSCR ignores writes while locked; LOCK can only be set
+static void flash_cr_write(uint32_t cr) {
+    if (s_fl_cr & FLASH_CR_LOCK) {
+        return;
+    }
+    if (cr & FLASH_CR_LOCK) {
+        s_fl_cr = FLASH_CR_LOCK;
+        s_fl_keys = 0u;
+        return;
+    }
+    if ((cr & (FLASH_CR_SER | FLASH_CR_STRT)) == (FLASH_CR_SER | FLASH_CR_STRT)) {
+        flash_erase(cr);
+    }
+    s_fl_cr = cr & ~FLASH_CR_STRT;
+}
+
+//------------------------------------------------------------------------------
+static void flash_keyr_write(uint32_t key) {
+    if (key == 0u) {
+        return;
+    }
+    if (s_fl_keys == 0u && key == FLASH_KEY1) {
+        s_fl_keys = 1u;
+    } else if (s_fl_keys == 1u && key == FLASH_KEY2) {
+        s_fl_cr &= ~FLASH_CR_LOCK;
+        s_fl_keys = 0u;
+    } else {
+        s_fl_keys = 0u;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Write the full buffer to an erased quad-word
+static void flash_program(void) {
+    uint8_t *p = &s_flash[s_fl_waddr - SIM_FLASH];
+    s_fl_wmask = 0u;
+    for (uint32_t i = 0; i < SIM_QWORD_BYTES; ++i) {
+        if (p[i] != 0xFFu) {
+            s_fl_flags |= FLASH_SR_PGSERR;
+            return;
+        }
+    }
+    for (uint32_t i = 0; i < SIM_QWORD_BYTES; ++i) {
+        p[i] = (uint8_t)(s_fl_wbuf[i / 4u] >> (8u * (i % 4u)));
+    }
+    s_stats.flash_programs++;
+    flash_start(SIM_FLASH_PROG_NS);
+}
+
+//------------------------------------------------------------------------------
+// GPDMA Model
+//------------------------------------------------------------------------------
+static bool dma_clocked(void) {
+    return (rd(RCC_AHB1ENR_ADDR) & RCC_EN_GPDMA1) != 0u;
+}
+
+//------------------------------------------------------------------------------
+// Host location of a DMA bus address; NULL where nothing is mapped
+static uint8_t *bus_host(uint32_t addr) {
+    if (addr < SIM_BUS || (addr - SIM_BUS) / SIM_BUS_WINDOW >= s_win_count) {
+        return NULL;
+    }
+    return (uint8_t *)(s_win[(addr - SIM_BUS) / SIM_BUS_WINDOW] +
+        (addr % SIM_BUS_WINDOW));
+}
+
+//------------------------------------------------------------------------------
+// One beat: peripheral registers with their side effects, memory as is
+static bool bus_beat(uint32_t src, uint32_t dst, uint32_t size) {
+    uint32_t value = 0u;
+    if (in_block(src, SIM_PERIPH, SIM_PERIPH_SIZE)) {
+        value = *access(src & ~3u) >> (8u * (src & 3u));
+        commit();
+    } else if (bus_host(src)) {
+        memcpy(&value, bus_host(src), size);
+    } else {
+        return false;
+    }
+    if (size < 4u) {
+        value &= (1u << (8u * size)) - 1u;
+    }
+    if (in_block(dst, SIM_PERIPH, SIM_PERIPH_SIZE)) {
+        *access(dst & ~3u) = value;
+        commit();
+    } else if (bus_host(dst)) {
+        memcpy(bus_host(dst), &value, size);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Disabled: at the end of the list, after an error or by reset
+static void dma_end(uint32_t ch) {
+    s_dma[ch].active = false;
+    s_dma[ch].susp = false;
+    *word(SIM_DMA_REG(ch, GPDMA_CCR_OFFSET)) &= ~(GPDMA_CCR_EN | GPDMA_CCR_SUSP);
+}
+
+//------------------------------------------------------------------------------
+static void dma_error(uint32_t ch, uint32_t flag) {
+    s_dma[ch].flags |= flag;
+    dma_end(ch);
+}
+
+//------------------------------------------------------------------------------
+// Load the registers the link selects from the item at CLBAR | LA, or end
+// the list on a null link
+static void dma_next(uint32_t ch) {
+    static const struct {
+        uint32_t bit;
+        uint32_t offset;
+    } k_fields[] = {
+        { GPDMA_CLLR_UT1, GPDMA_CTR1_OFFSET }, { GPDMA_CLLR_UT2, GPDMA_CTR2_OFFSET },
+        { GPDMA_CLLR_UB1, GPDMA_CBR1_OFFSET }, { GPDMA_CLLR_USA, GPDMA_CSAR_OFFSET },
+        { GPDMA_CLLR_UDA, GPDMA_CDAR_OFFSET }, { GPDMA_CLLR_ULL, GPDMA_CLLR_OFFSET },
+    };
+    uint32_t cllr = rd(SIM_DMA_REG(ch, GPDMA_CLLR_OFFSET));
+    if (!(cllr & GPDMA_CLLR_LA_MASK)) {
+        dma_end(ch);
+        return;
+    }
+    uint32_t addr = (rd(SIM_DMA_REG(ch, GPDMA_CLBAR_OFFSET)) & GPDMA_CLBAR_LBA_MASK) |
+        (cllr & GPDMA_CLLR_LA_MASK);
+    if (!(cllr & GPDMA_CLLR_ULL)) {
+        // Nothing to link to after this item
+        *word(SIM_DMA_REG(ch, GPDMA_CLLR_OFFSET)) = 0u;
+    }
+    for (size_t i = 0; i < sizeof(k_fields) / sizeof(k_fields[0]); ++i) {
+        if (!(cllr & k_fields[i].bit)) {
+            continue;
+        }
+        const uint8_t *p = bus_host(addr);
+        if (!p) {
+            dma_error(ch, GPDMA_CSR_ULEF);
+            return;
+        }
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        *word(SIM_DMA_REG(ch, k_fields[i].offset)) = value;
+        addr += 4u;
+    }
+    s_stats.dma_links++;
+    if (!(rd(SIM_DMA_REG(ch, GPDMA_CBR1_OFFSET)) & GPDMA_CBR1_BNDT_MASK)) {
+        dma_error(ch, GPDMA_CSR_USEF);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Move up to a number of beats on a running channel, loading each item as
+// the block before it ends; returns the beats moved
+static uint32_t dma_run(uint32_t ch, uint32_t beats) {
+    sim_dma_t *pd = &s_dma[ch];
+    uint32_t moved = 0u;
+    while (moved < beats && pd->active && !pd->susp) {
+        uint32_t ctr1 = rd(SIM_DMA_REG(ch, GPDMA_CTR1_OFFSET));
+        uint32_t size = 1u << ((ctr1 & GPDMA_CTR1_SDW_MASK) >> GPDMA_CTR1_SDW_SHIFT);
+        uint32_t src = rd(SIM_DMA_REG(ch, GPDMA_CSAR_OFFSET));
+        uint32_t dst = rd(SIM_DMA_REG(ch, GPDMA_CDAR_OFFSET));
+        uint32_t bndt = rd(SIM_DMA_REG(ch, GPDMA_CBR1_OFFSET)) & GPDMA_CBR1_BNDT_MASK;
+        if (pd->fault || !bus_beat(src, dst, size)) {
+            pd->fault = false;
+            dma_error(ch, GPDMA_CSR_DTEF);
+            break;
+        }
+        moved++;
+        s_stats.dma_beats++;
+        *word(SIM_DMA_REG(ch, GPDMA_CSAR_OFFSET)) =
+            src + ((ctr1 & GPDMA_CTR1_SINC) ? size : 0u);
+        *word(SIM_DMA_REG(ch, GPDMA_CDAR_OFFSET)) =
+            dst + ((ctr1 & GPDMA_CTR1_DINC) ? size : 0u);
+        bndt = (bndt > size) ? bndt - size : 0u;
+        *word(SIM_DMA_REG(ch, GPDMA_CBR1_OFFSET)) = bndt;
+        if (!bndt) {
+            pd->flags |= GPDMA_CSR_TCF;
+            dma_next(ch);
+        }
+    }
+    return moved;
+}
+
+//------------------------------------------------------------------------------
+// Software-request channels run as soon as they are enabled
+static void dma_update(void) {
+    for (uint32_t ch = 0; ch < GPDMA1_CHANNELS; ++ch) {
+        if (s_dma[ch].active &&
+                (rd(SIM_DMA_REG(ch, GPDMA_CTR2_OFFSET)) & GPDMA_CTR2_SWREQ)) {
+            (void)dma_run(ch, SIM_DMA_SWREQ_BEATS);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// EN cannot be cleared by a write: the channel is suspended, then reset
+static void dma_ccr_write(uint32_t ch, volatile uint32_t *preg) {
+    sim_dma_t *pd = &s_dma[ch];
+    uint32_t ccr = *preg;
+    if (ccr & GPDMA_CCR_RESET) {
+        dma_end(ch);
+        *preg = 0u;
+        return;
+    }
+    if ((ccr & GPDMA_CCR_EN) && !pd->active) {
+        pd->active = true;
+        *preg = ccr;
+        // An empty block loads the first item right away
+        if (!(rd(SIM_DMA_REG(ch, GPDMA_CBR1_OFFSET)) & GPDMA_CBR1_BNDT_MASK)) {
+            if (rd(SIM_DMA_REG(ch, GPDMA_CLLR_OFFSET)) & GPDMA_CLLR_LA_MASK) {
+                dma_next(ch);
+            } else {
+                dma_error(ch, GPDMA_CSR_USEF);
+            }
+        }
+    }
+    pd->susp = pd->active && (ccr & GPDMA_CCR_SUSP);
+    *preg = pd->active ? (ccr | GPDMA_CCR_EN) : (ccr & ~GPDMA_CCR_EN);
+}
+
+//------------------------------------------------------------------------------
+// Channel and register offset of a GPDMA address; false outside the channels
+static bool dma_decode(uintptr_t addr, uint32_t *pch, uint32_t *poffset) {
+    uint32_t off = (uint32_t)(addr - SIM_GPDMA);
+    if (off < GPDMA_CH_OFFSET(0) || off >= GPDMA_CH_OFFSET(GPDMA1_CHANNELS)) {
+        return false;
+    }
+    *pch = (off - GPDMA_CH_OFFSET(0)) / SIM_DMA_STRIDE;
+    *poffset = (off - GPDMA_CH_OFFSET(0)) % SIM_DMA_STRIDE;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static void dma_commit(uintptr_t addr, volatile uint32_t *preg) {
+    uint32_t ch;
+    uint32_t off;
+    if (!dma_decode(addr, &ch, &off)) {
+        return;
+    }
+    switch (off) {
+    case GPDMA_CCR_OFFSET:
+        dma_ccr_write(ch, preg);
+        break;
+    case GPDMA_CFCR_OFFSET:
+        s_dma[ch].flags &= ~(*preg & GPDMA_CFCR_ALL);
+        *preg = 0u;
+        break;
+    default:
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Apply the store, if any, made through the previous access
+static void commit(void) {
+    uintptr_t addr = s_last;
+    s_last = 0u;
+    if (!addr) {
+        return;
+    }
+    volatile uint32_t *preg = word(addr);
+    if (in_block(addr, SIM_USART, SIM_USART_SIZE)) {
+        switch (addr - SIM_USART) {
+        case USART_TDR_OFFSET:
+            if (*preg != SIM_TDR_EMPTY) {
+                tx_byte((uint8_t)*preg);
+            }
+            *preg = 0u;
+            break;
+        case USART_ICR_OFFSET:
+            s_flags &= ~(*preg & SIM_ISR_LATCHED);
+            *preg = 0u;
+            break;
+        case USART_CR1_OFFSET:
+            usart_cr1_write(*preg);
+            break;
+        default:
+            break;
+        }
+    } else if (in_block(addr, GPIOA_BASE, SIM_GPIO_SIZE) &&
+            ((addr - GPIOA_BASE) % GPIO_PORT_STRIDE) == GPIO_BSRR_OFFSET) {
+        // Set wins over reset for the same pin
+        uintptr_t odr = addr - GPIO_BSRR_OFFSET + GPIO_ODR_OFFSET;
+        uint32_t bsrr = *preg;
+        *word(odr) = (rd(odr) & ~(bsrr >> GPIO_BSRR_RESET_SHIFT)) |
+            (bsrr & GPIO_PORT_PINS_MASK);
+        *preg = 0u;
+    } else if (in_block(addr, SIM_FLASH_REGS, SIM_FLASH_REGS_SIZE)) {
+        switch (addr - SIM_FLASH_REGS) {
+        case FLASH_NSKEYR_OFFSET:
+            flash_keyr_write(*preg);
+            break;
+        case FLASH_NSCR_OFFSET:
+            flash_cr_write(*preg);
+            break;
+        case FLASH_NSCCR_OFFSET:
+            s_fl_flags &= ~(*preg & (FLASH_SR_ERRORS | FLASH_SR_EOP));
+            break;
+        default:
+            break;
+        }
+    } else if (in_block(addr, SIM_GPDMA, SIM_GPDMA_SIZE)) {
+        dma_commit(addr, preg);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void sync(void) {
+    commit();
+    usart_update();
+    flash_update();
+    dma_update();
+}
+
+//------------------------------------------------------------------------------
+// Read side effects and values computed from the model state
+static volatile uint32_t *usart_access(uintptr_t addr) {
+    volatile uint32_t *preg = word(addr);
+    switch (addr - SIM_USART) {
+    case USART_ISR_OFFSET: {
+        uint64_t pending = tx_pending();
+        uint32_t isr = s_flags;
+        isr |= s_rx_count ? USART_ISR_RXNE_RXFNE : 0u;
+        isr |= (pending < (uint64_t)fifo_depth() + 1u) ? USART_ISR_TXE_TXFNF : 0u;
+        isr |= pending ? 0u : USART_ISR_TC;
+        *preg = isr;
+        break;
+    }
+    case USART_RDR_OFFSET:
+        if (s_rx_count) {
+            *preg = s_rx_fifo[s_rx_head];
+            s_rx_head = (s_rx_head + 1u) % SIM_FIFO_DEPTH;
+            s_rx_count--;
+        }
+        break;
+    case USART_TDR_OFFSET:
+        *preg = SIM_TDR_EMPTY;
+        break;
+    case USART_ICR_OFFSET:
+        *preg = 0u;
+        break;
+    default:
+        break;
+    }
+    return preg;
+}
+
+//------------------------------------------------------------------------------
+// Register values computed from the model state; write-only registers read
+// as zero
+static volatile uint32_t *flash_access(uintptr_t addr) {
+    volatile uint32_t *preg = word(addr);
+    switch (addr - SIM_FLASH_REGS) {
+    case FLASH_NSSR_OFFSET:
+        *preg = s_fl_flags | (s_fl_busy ? FLASH_SR_BSY : 0u) |
+            (s_fl_wmask ? FLASH_SR_WBNE : 0u);
+        break;
+    case FLASH_NSCR_OFFSET:
+        *preg = s_fl_cr;
+        break;
+    case FLASH_NSKEYR_OFFSET:
+    case FLASH_NSCCR_OFFSET:
+        *preg = 0u;
+        break;
+    default:
+        break;
+    }
+    return preg;
+}
+
+//------------------------------------------------------------------------------
+// Flags are latched; IDLEF and SUSPF follow the channel
+static volatile uint32_t *dma_access(uintptr_t addr) {
+    volatile uint32_t *preg = word(addr);
+    uint32_t ch;
+    uint32_t off;
+    if (dma_decode(addr, &ch, &off)) {
+        if (off == GPDMA_CSR_OFFSET) {
+            *preg = s_dma[ch].flags | (s_dma[ch].active ? 0u : GPDMA_CSR_IDLEF) |
+                (s_dma[ch].susp ? GPDMA_CSR_SUSPF : 0u);
+            if (s_dma[ch].wedged) {
+                *preg &= ~(GPDMA_CSR_SUSPF | GPDMA_CSR_IDLEF);
+            }
+        } else if (off == GPDMA_CFCR_OFFSET) {
+            *preg = 0u;
+        }
+    }
+    return preg;
+}
+
+//------------------------------------------------------------------------------
+// Register at addr with its read side effects, committed at the next access
+static volatile uint32_t *access(uintptr_t addr) {
+    if (in_block(addr, SIM_FLASH, FLASH_MEM_BYTES)) {
+        // Read-only view of the word; programming goes through FLASH_STORE32()
+        flash_stall();
+        const uint8_t *p = &s_flash[(addr & ~(uintptr_t)3u) - SIM_FLASH];
+        s_flash_word = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+            ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        return &s_flash_word;
+    }
+
+    volatile uint32_t *preg;
+    if (in_block(addr, SIM_USART, SIM_USART_SIZE)) {
+        if (!usart_clocked()) {
+            s_stats.unclocked++;
+            s_dead = 0u;
+            return &s_dead;
+        }
+        preg = usart_access(addr);
+    } else if (in_block(addr, GPIOA_BASE, SIM_GPIO_SIZE)) {
+        if (!gpio_clocked(addr)) {
+            s_stats.unclocked++;
+            s_dead = 0u;
+            return &s_dead;
+        }
+        preg = word(addr);
+        uint32_t off = (uint32_t)((addr - GPIOA_BASE) % GPIO_PORT_STRIDE);
+        if (off == GPIO_IDR_OFFSET) {
+            *preg = rd(addr - GPIO_IDR_OFFSET + GPIO_ODR_OFFSET);
+        } else if (off == GPIO_BSRR_OFFSET) {
+            *preg = 0u;
+        }
+    } else if (in_block(addr, SIM_FLASH_REGS, SIM_FLASH_REGS_SIZE)) {
+        preg = flash_access(addr);
+    } else if (in_block(addr, SIM_GPDMA, SIM_GPDMA_SIZE)) {
+        if (!dma_clocked()) {
+            s_stats.unclocked++;
+            s_dead = 0u;
+            return &s_dead;
+        }
+        preg = dma_access(addr);
+    } else if (addr == DWT_CYCCNT_ADDR) {
+        preg = word(addr);
+        if ((rd(DCB_DEMCR_ADDR) & DCB_DEMCR_TRCENA) &&
+                (rd(DWT_CTRL_ADDR) & DWT_CTRL_CYCCNTENA)) {
+            *preg = (uint32_t)((s_now_ns * (SYSTEM_CORE_CLK_HZ / 1000000u)) / 1000u);
+        }
+    } else {
+        preg = word(addr);
+    }
+    s_last = addr;
+    return preg;
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+volatile uint32_t *periph_sim_reg(uintptr_t addr) {
+    commit();
+    s_stats.accesses++;
+    s_now_ns += s_access_ns;
+    usart_update();
+    flash_update();
+    dma_update();
+    return access(addr);
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_reset(void) {
+    memset(s_map, 0, sizeof(s_map));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_last = 0u;
+    s_now_ns = 0u;
+    s_access_ns = 0u;
+    s_rx_head = s_rx_count = 0u;
+    s_flags = s_cr1 = 0u;
+    s_rx_last_ns = 0u;
+    s_rto_armed = false;
+    s_rxq_head = s_rxq_count = 0u;
+    s_rxq_tail_ns = 0u;
+    s_txq_head = s_txq_count = 0u;
+    s_tx_free_ns = 0u;
+    memset(s_flash, 0xFF, sizeof(s_flash));
+    s_fl_cr = FLASH_CR_LOCK;
+    s_fl_flags = s_fl_keys = 0u;
+    s_fl_busy = false;
+    s_fl_done_ns = 0u;
+    s_fl_wmask = 0u;
+    s_fl_waddr = 0u;
+    memset(s_dma, 0, sizeof(s_dma));
+    memset(s_win, 0, sizeof(s_win));
+    s_win_count = 0u;
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_set_access_ns(uint32_t ns) {
+    s_access_ns = ns;
+}
+
+//------------------------------------------------------------------------------
+uint64_t periph_sim_now(void) {
+    return s_now_ns;
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_advance(uint64_t ns) {
+    commit();
+    s_now_ns += ns;
+    usart_update();
+    flash_update();
+    dma_update();
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_usart_rx(const uint8_t *pdata, size_t len, uint32_t isr_flags) {
+    sync();
+    uint64_t t = (s_rxq_tail_ns > s_now_ns) ? s_rxq_tail_ns : s_now_ns;
+    uint64_t char_ns = bits_ns(SIM_USART_BITS);
+    for (size_t i = 0; i < len; ++i) {
+        t += char_ns;
+        if (s_rxq_count >= SIM_RXQ) {
+            s_stats.rx_lost++;
+            continue;
+        }
+        s_rxq[(s_rxq_head + s_rxq_count) % SIM_RXQ] = (sim_char_t){
+            .t_ns = t, .byte = pdata[i], .flags = i ? 0u : isr_flags };
+        s_rxq_count++;
+    }
+    s_rxq_tail_ns = t;
+}
+
+//------------------------------------------------------------------------------
+size_t periph_sim_usart_tx_take(uint8_t *pout, size_t max) {
+    sync();
+    size_t n = 0;
+    while (n < max && s_txq_count && s_txq[s_txq_head].t_ns <= s_now_ns) {
+        pout[n++] = s_txq[s_txq_head].byte;
+        s_txq_head = (s_txq_head + 1u) % SIM_TXQ;
+        s_txq_count--;
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+uint32_t periph_sim_usart_baud(void) {
+    sync();
+    uint32_t brr = rd(SIM_USART + USART_BRR_OFFSET) & 0xFFFFu;
+    return brr ? (uint32_t)(UART_HW_USART_CLK_HZ / brr) : 0u;
+}
+
+//------------------------------------------------------------------------------
+uint32_t periph_sim_usart_char_ns(void) {
+    sync();
+    return (uint32_t)bits_ns(SIM_USART_BITS);
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_flash_store(uintptr_t addr, uint32_t value) {
+    commit();
+    s_stats.accesses++;
+    s_now_ns += s_access_ns;
+    usart_update();
+    if (!in_block(addr, SIM_FLASH, FLASH_MEM_BYTES)) {
+        *word(addr) = value;
+        return;
+    }
+    flash_stall();
+    if ((s_fl_cr & (FLASH_CR_LOCK | FLASH_CR_PG)) != FLASH_CR_PG || (addr & 3u)) {
+        s_fl_flags |= FLASH_SR_PGSERR;
+        return;
+    }
+    uintptr_t qaddr = addr & ~(uintptr_t)(SIM_QWORD_BYTES - 1u);
+    uint32_t bit = 1u << ((addr / 4u) % FLASH_QWORD_WORDS);
+    if (s_fl_wmask && qaddr != s_fl_waddr) {
+        // Previous quad-word left unfinished: its words are discarded
+        s_fl_flags |= FLASH_SR_INCERR;
+        s_fl_wmask = 0u;
+    }
+    if (s_fl_wmask & bit) {
+        s_fl_flags |= FLASH_SR_STRBERR;
+        return;
+    }
+    s_fl_waddr = qaddr;
+    s_fl_wbuf[(addr / 4u) % FLASH_QWORD_WORDS] = value;
+    s_fl_wmask |= bit;
+    if (s_fl_wmask == SIM_QWORD_FULL) {
+        flash_program();
+    }
+}
+
+//------------------------------------------------------------------------------
+uint8_t *periph_sim_flash(uintptr_t addr) {
+    sync();
+    return in_block(addr, SIM_FLASH, FLASH_MEM_BYTES) ? &s_flash[addr - SIM_FLASH]
+                                                      : NULL;
+}
+
+//------------------------------------------------------------------------------
+// Peripheral addresses pass through; host memory is mapped a window at a time
+uint32_t periph_sim_bus_addr(const volatile void *p) {
+    uintptr_t addr = (uintptr_t)p;
+    if (!addr || in_block(addr, SIM_PERIPH, SIM_PERIPH_SIZE)) {
+        return (uint32_t)addr;
+    }
+    uintptr_t base = addr & ~(uintptr_t)(SIM_BUS_WINDOW - 1u);
+    uint32_t i = 0u;
+    while (i < s_win_count && s_win[i] != base) {
+        i += 2u;
+    }
+    if (i == s_win_count) {
+        if (s_win_count + 2u > SIM_BUS_WINDOWS) {
+            // Out of windows: the channel faults on it
+            return 0u;
+        }
+        s_win[i] = base;
+        s_win[i + 1u] = base + SIM_BUS_WINDOW;
+        s_win_count += 2u;
+    }
+    return SIM_BUS + i * SIM_BUS_WINDOW + (uint32_t)(addr - base);
+}
+
+//------------------------------------------------------------------------------
+uint32_t periph_sim_dma_request(uint32_t req, uint32_t beats) {
+    sync();
+    for (uint32_t ch = 0; ch < GPDMA1_CHANNELS; ++ch) {
+        uint32_t ctr2 = rd(SIM_DMA_REG(ch, GPDMA_CTR2_OFFSET));
+        if (s_dma[ch].active && !(ctr2 & GPDMA_CTR2_SWREQ) &&
+                (ctr2 & GPDMA_CTR2_REQSEL_MASK) == req) {
+            return dma_run(ch, beats);
+        }
+    }
+    return 0u;
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_dma_fault(uint32_t ch) {
+    sync();
+    s_dma[ch].fault = true;
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_dma_wedge(uint32_t ch, bool wedged) {
+    sync();
+    s_dma[ch].wedged = wedged;
+}
+
+//------------------------------------------------------------------------------
+bool periph_sim_dma_irq(uint32_t ch) {
+    sync();
+    uint32_t ccr = rd(SIM_DMA_REG(ch, GPDMA_CCR_OFFSET));
+    uint32_t flags = s_dma[ch].flags;
+    return ((flags & GPDMA_CSR_TCF) && (ccr & GPDMA_CCR_TCIE)) ||
+        ((flags & GPDMA_CSR_DTEF) && (ccr & GPDMA_CCR_DTEIE)) ||
+        ((flags & GPDMA_CSR_ULEF) && (ccr & GPDMA_CCR_ULEIE)) ||
+        ((flags & GPDMA_CSR_USEF) && (ccr & GPDMA_CCR_USEIE));
+}
+
+//------------------------------------------------------------------------------
+void periph_sim_stats(periph_sim_stats_t *ps) {
+    sync();
+    *ps = s_stats;
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_PERIPH_SIM_H_
+#define INCLUDE_PERIPH_SIM_H_
+//------------------------------------------------------------------------------
+//
+// Register-level STM32H5 peripheral model, so the bare-metal backends run on
+// the host unchanged
+//
+// Built with PERIPH_SIM defined, register_defs.h maps REG32() here: every
+// access resolves to a word in a simulated peripheral map, with side effects
+// applied on a virtual clock:
+//    - USART3: BRR sets the character time, TDR feeds the line (TXE/TC follow
+//      the shift register), RDR pops received data, ORE/FE/NE/PE/RTOF latch
+//      in ISR until cleared through ICR, CR1.FIFOEN selects 8-deep FIFOs
+//    - RCC: a peripheral reads as zero and ignores writes until its clock is
+//      enabled (USART3, GPIO ports, GPDMA1)
+//    - GPIO: BSRR sets/resets ODR, IDR reads back ODR
+//    - DWT: CYCCNT counts core clocks of virtual time once enabled
+//    - FLASH: NSKEYR unlock sequence, sector erase and quad-word programming
+//      with BSY held for typical erase/program times, EOP and error flags in
+//      NSSR cleared through NSCCR; flash memory reads stall while busy, and
+//      a quad-word that is not erased cannot be programmed
+//    - GPDMA1: channels run linked lists from host memory, loading the
+//      registers each item selects; software-request channels run as soon as
+//      enabled, the others a beat per request delivered; TCF and the error
+//      flags latch in CSR until cleared through CFCR, IDLEF and SUSPF follow
+//      the channel, and a reset stops it. Beats take no virtual time
+// Any other address behaves as plain memory.
+//
+// Writes take effect at the next access or model call, since REG32() only
+// yields the location written.
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Register Access
+//------------------------------------------------------------------------------
+
+#define REG32(addr) (*periph_sim_reg((uintptr_t)(addr)))
+#define FLASH_STORE32(addr, value) \
+    periph_sim_flash_store((uintptr_t)(addr), (value))
+#define DMA_BUS_ADDR(p) periph_sim_bus_addr((const volatile void *)(p))
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    // Register accesses made by the code under test
+    uint64_t accesses;
+    // Accesses to a peripheral whose clock was off
+    uint64_t unclocked;
+    // TDR written while TXE was clear (byte replaced on the line)
+    uint64_t tdr_overwrites;
+    // Rx bytes lost: overrun, or receiver disabled
+    uint64_t rx_lost;
+    // Flash operations completed or started, and time spent on them
+    uint64_t flash_programs;
+    uint64_t flash_erases;
+    uint64_t flash_busy_ns;
+    // Time flash reads waited for a running operation
+    uint64_t flash_stall_ns;
+    // DMA data beats moved and linked-list items loaded
+    uint64_t dma_beats;
+    uint64_t dma_links;
+} periph_sim_stats_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+volatile uint32_t *periph_sim_reg(uintptr_t addr);
+
+//------------------------------------------------------------------------------
+// Reset every register and the virtual clock
+void periph_sim_reset(void);
+
+//------------------------------------------------------------------------------
+// CPU time charged per register access (default 0)
+void periph_sim_set_access_ns(uint32_t ns);
+
+//------------------------------------------------------------------------------
+// Virtual clock
+uint64_t periph_sim_now(void);
+void periph_sim_advance(uint64_t ns);
+
+//------------------------------------------------------------------------------
+// USART3 line side
+// Queue bytes to arrive back-to-back at the configured baud, after any
+// already queued; isr_flags (FE/NE/PE) latch as the first byte lands
+void periph_sim_usart_rx(const uint8_t *pdata, size_t len, uint32_t isr_flags);
+// Bytes that have finished transmission, in order
+size_t periph_sim_usart_tx_take(uint8_t *pout, size_t max);
+// Baud rate and character time implied by BRR (0 before configuration)
+uint32_t periph_sim_usart_baud(void);
+uint32_t periph_sim_usart_char_ns(void);
+
+//------------------------------------------------------------------------------
+// Flash
+// Store made while programming (FLASH_STORE32())
+void periph_sim_flash_store(uintptr_t addr, uint32_t value);
+// Contents at addr, e.g., to load an image as a debugger would; NULL outside
+// the flash
+uint8_t *periph_sim_flash(uintptr_t addr);
+
+//------------------------------------------------------------------------------
+// GPDMA1
+// Address of a memory object on the DMA bus (DMA_BUS_ADDR()); peripheral
+// addresses are their own
+uint32_t periph_sim_bus_addr(const volatile void *p);
+// Peripheral asserts a request line for up to beats beats; returns the beats
+// the channel serving it moved
+uint32_t periph_sim_dma_request(uint32_t req, uint32_t beats);
+// Fail the channel's next beat with a data transfer error
+void periph_sim_dma_fault(uint32_t ch);
+// Hang the channel, as on a stuck bus transfer: it stops reporting SUSPF and
+// IDLEF, so a suspend never completes, until released with wedged false
+void periph_sim_dma_wedge(uint32_t ch, bool wedged);
+// A flag is set whose interrupt the channel enables
+bool periph_sim_dma_irq(uint32_t ch);
+
+//------------------------------------------------------------------------------
+void periph_sim_stats(periph_sim_stats_t *ps);
+
+#endif // INCLUDE_PERIPH_SIM_H_
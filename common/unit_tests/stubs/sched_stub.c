@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Scheduler backend implementation for unit testing application code
+//
+//------------------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 199309L
+#include "sched_stub.h"
+#include <time.h>
+
+//------------------------------------------------------------------------------
+// Stubbed scheduler backend object
+//------------------------------------------------------------------------------
+
+static sched_stub_ctx_t *pGlobalctx;
+
+//------------------------------------------------------------------------------
+// Stub Function Definitions
+//------------------------------------------------------------------------------
+static uint32_t s_irq_save(void) {
+    uint32_t state = pGlobalctx->irq_masked ? 1u : 0u;
+    pGlobalctx->irq_masked = true;
+    pGlobalctx->irq_saves++;
+    return state;
+}
+
+//------------------------------------------------------------------------------
+static void s_irq_restore(uint32_t state) {
+    pGlobalctx->irq_masked = (state != 0u);
+}
+
+//------------------------------------------------------------------------------
+static void s_idle(void) {
+    pGlobalctx->idle_calls++;
+    // The "interrupt" that ends the sleep
+    if (pGlobalctx->on_idle) {
+        pGlobalctx->on_idle(pGlobalctx->on_idle_ctx);
+    }
+}
+
+//------------------------------------------------------------------------------
+static uint32_t s_cycles(void) {
+    if (pGlobalctx->use_host_clock) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+    }
+    pGlobalctx->cycles += pGlobalctx->cycles_step;
+    return pGlobalctx->cycles;
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void sched_stub_create(sched_hw_vtable_t *pv, sched_stub_ctx_t *pctx) {
+    pGlobalctx = pctx;
+    // Install stub implementation
+    pv->hw_init = NULL;
+    pv->hw_irq_save = s_irq_save;
+    pv->hw_irq_restore = s_irq_restore;
+    pv->hw_idle = s_idle;
+    pv->hw_cycles = s_cycles;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SCHED_STUB_H_
+#define INCLUDE_SCHED_STUB_H_
+//------------------------------------------------------------------------------
+//
+// Scheduler stub specification for unit testing application code on the host
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sched_api.h"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Context
+typedef struct {
+    // Interrupt mask state and nesting checks
+    bool     irq_masked;
+    uint32_t irq_saves;
+    // Sleeps taken, and an optional "interrupt" that ends each one
+    uint32_t idle_calls;
+    void     (*on_idle)(void *pctx);
+    void     *on_idle_ctx;
+    // Virtual cycle counter: advanced by cycles_step on every read, or a
+    // monotonic host clock in nanoseconds when use_host_clock is set
+    uint32_t cycles;
+    uint32_t cycles_step;
+    bool     use_host_clock;
+} sched_stub_ctx_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void sched_stub_create(sched_hw_vtable_t *pv, sched_stub_ctx_t *pctx);
+
+#endif // INCLUDE_SCHED_STUB_H_
@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// SPI backend implementation for unit testing application code
+//
+//------------------------------------------------------------------------------
+
+#include "spi_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Stubbed SPI objects
+//------------------------------------------------------------------------------
+
+// The backend vtable carries no context, so each instance gets its own set of
+// entry points bound to one slot here
+static spi_stub_ctx_t *pSlotctx[SPI_HW_STUB_MAX_INSTANCES];
+
+//------------------------------------------------------------------------------
+// Stub Function Definitions
+//------------------------------------------------------------------------------
+static bool ctx_init(spi_stub_ctx_t *pctx, uint32_t clock_hz, spi_mode_t mode) {
+    pctx->clock_hz = clock_hz;
+    pctx->mode = mode;
+    pctx->cs_asserted = false;
+    pctx->inflight_len = 0;
+    return !pctx->init_fail;
+}
+
+//------------------------------------------------------------------------------
+static bool ctx_start(spi_stub_ctx_t *pctx, const spi_xfer_t *px) {
+    // Only on an idle bus
+    if (pctx->inflight_len != 0u) {
+        return false;
+    }
+    if (!pctx->cs_asserted) {
+        pctx->cs_asserted = true;
+        pctx->cs_cycles++;
+    }
+    pctx->inflight[pctx->inflight_len++] = px;
+    pctx->starts++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool ctx_link(spi_stub_ctx_t *pctx, const spi_xfer_t *px) {
+    if (pctx->late || pctx->inflight_len == 0u ||
+            pctx->inflight_len >= pctx->link_max) {
+        return false;
+    }
+    pctx->inflight[pctx->inflight_len++] = px;
+    pctx->links++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper to clock one transfer over the bus
+static void clock_xfer(spi_stub_ctx_t *pctx, const spi_xfer_t *px) {
+    for (size_t i = 0; i < px->len; i++) {
+        uint8_t mosi = px->ptx ? px->ptx[i] : SPI_FILL_BYTE;
+        if (pctx->mosi_len < pctx->mosi_capacity) {
+            pctx->pmosi_buf[pctx->mosi_len++] = mosi;
+        }
+        uint8_t miso = SPI_FILL_BYTE;
+        if (pctx->loopback) {
+            miso = mosi;
+        } else if (pctx->miso_idx < pctx->miso_len) {
+            miso = pctx->pmiso_src[pctx->miso_idx++];
+        }
+        if (px->prx) {
+            px->prx[i] = miso;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+static size_t ctx_poll_done(spi_stub_ctx_t *pctx) {
+    // An error stops the bus before anything more finishes
+    if (pctx->error) {
+        return 0;
+    }
+    size_t n = pctx->inflight_len;
+    if (pctx->done_max && pctx->done_max < n) {
+        n = pctx->done_max;
+    }
+    for (size_t i = 0; i < n; i++) {
+        const spi_xfer_t *px = pctx->inflight[i];
+        clock_xfer(pctx, px);
+        if (!(px->flags & SPI_XFER_CS_HOLD)) {
+            pctx->cs_asserted = false;
+        }
+    }
+    // Close up the rest
+    for (size_t i = n; i < pctx->inflight_len; i++) {
+        pctx->inflight[i - n] = pctx->inflight[i];
+    }
+    pctx->inflight_len -= n;
+    return n;
+}
+
+//------------------------------------------------------------------------------
+static bool ctx_error(spi_stub_ctx_t *pctx) {
+    if (!pctx->error) {
+        return false;
+    }
+    pctx->error = false;
+    pctx->inflight_len = 0;
+    pctx->cs_asserted = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static void ctx_irq_mask(spi_stub_ctx_t *pctx, bool masked) {
+    pctx->masked = masked;
+    if (masked) {
+        pctx->mask_calls++;
+    } else {
+        pctx->unmask_calls++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Per-slot entry points
+//------------------------------------------------------------------------------
+#define SPI_HW_STUB_SLOT(n)                                                    \
+    static bool s_init_##n(uint32_t clock_hz, spi_mode_t mode) {               \
+        return ctx_init(pSlotctx[n], clock_hz, mode);                          \
+    }                                                                          \
+    static bool s_start_##n(const spi_xfer_t *px) {                            \
+        return ctx_start(pSlotctx[n], px);                                     \
+    }                                                                          \
+    static bool s_link_##n(const spi_xfer_t *px) {                             \
+        return ctx_link(pSlotctx[n], px);                                      \
+    }                                                                          \
+    static size_t s_poll_done_##n(void) { return ctx_poll_done(pSlotctx[n]); } \
+    static bool s_error_##n(void) { return ctx_error(pSlotctx[n]); }           \
+    static void s_irq_mask_##n(bool masked) {                                  \
+        ctx_irq_mask(pSlotctx[n], masked);                                     \
+    }
+
+#define SPI_HW_STUB_SLOT_VTABLE(n)                                             \
+    {                                                                          \
+        .hw_init = s_init_##n,                                                 \
+        .hw_start = s_start_##n,                                               \
+        .hw_poll_done = s_poll_done_##n,                                       \
+        .hw_link = s_link_##n,                                                 \
+        .hw_error = s_error_##n,                                               \
+        .hw_irq_mask = s_irq_mask_##n,                                         \
+    }
+
+SPI_HW_STUB_SLOT(0)
+SPI_HW_STUB_SLOT(1)
+
+static const spi_hw_vtable_t slot_vtables[SPI_HW_STUB_MAX_INSTANCES] = {
+    SPI_HW_STUB_SLOT_VTABLE(0),
+    SPI_HW_STUB_SLOT_VTABLE(1),
+};
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void spi_hw_stub_create(spi_hw_vtable_t *pv, spi_stub_ctx_t *pctx) {
+    (void)spi_hw_stub_create_instance(pv, pctx, 0);
+}
+
+//------------------------------------------------------------------------------
+bool spi_hw_stub_create_instance(
+        spi_hw_vtable_t *pv, spi_stub_ctx_t *pctx, size_t index) {
+    if (index >= SPI_HW_STUB_MAX_INSTANCES) {
+        return false;
+    }
+    pSlotctx[index] = pctx;
+    // Install stub implementation
+    *pv = slot_vtables[index];
+    if (!pctx->link_max) {
+        pv->hw_link = NULL;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_SPI_HW_STUB_H_
+#define INCLUDE_SPI_HW_STUB_H_
+//------------------------------------------------------------------------------
+//
+// SPI stub specification for unit testing application code: models a bus
+// whose transfers finish when hw_poll_done is called, recording MOSI and
+// chip select
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "spi_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Number of stub backends that can be live at once
+#define SPI_HW_STUB_MAX_INSTANCES  2u
+
+// Most transfers the stub holds at once (started plus linked)
+#define SPI_HW_STUB_INFLIGHT_MAX  16u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Context
+typedef struct {
+    // Simulate MOSI: every byte clocked out
+    uint8_t *pmosi_buf;
+    size_t mosi_capacity;
+    size_t mosi_len;
+    // Simulate MISO: clocked in from here, then SPI_FILL_BYTE; or the MOSI
+    // byte with loopback (a jumper)
+    const uint8_t *pmiso_src;
+    size_t miso_len;
+    size_t miso_idx;
+    bool loopback;
+    // Transfers the next hw_poll_done finishes, 0 for all in flight
+    size_t done_max;
+    // Transfers hw_link takes in flight (set before create), 0 for no hw_link
+    size_t link_max;
+    // Simulate the bus stopping before a link lands
+    bool late;
+    // Simulate a bus error, cleared when read
+    bool error;
+    // Simulate an init failure
+    bool init_fail;
+    // Settings from hw_init
+    uint32_t clock_hz;
+    spi_mode_t mode;
+    // Chip select level and number of assertions
+    bool cs_asserted;
+    uint32_t cs_cycles;
+    // Interrupt mask state and calls
+    bool masked;
+    uint32_t mask_calls;
+    uint32_t unmask_calls;
+    // Call counts
+    uint32_t starts;
+    uint32_t links;
+    // With the stub: [0, inflight_len)
+    const spi_xfer_t *inflight[SPI_HW_STUB_INFLIGHT_MAX];
+    size_t inflight_len;
+} spi_stub_ctx_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Install the stub for instance 0
+void spi_hw_stub_create(spi_hw_vtable_t *pv, spi_stub_ctx_t *pctx);
+
+//------------------------------------------------------------------------------
+// Install the stub for one of several instances, e.g., two buses
+bool spi_hw_stub_create_instance(
+    spi_hw_vtable_t *pv, spi_stub_ctx_t *pctx, size_t index);
+
+#endif // INCLUDE_SPI_HW_STUB_H_
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Timebase API implementation for unit testing application code
+//
+//------------------------------------------------------------------------------
+
+#include "timebase_stub.h"
+
+//------------------------------------------------------------------------------
+// Stubbed timebase object
+//------------------------------------------------------------------------------
+
+static timebase_stub_ctx_t *pGlobalctx;
+
+//------------------------------------------------------------------------------
+// Stub Function Definitions
+//------------------------------------------------------------------------------
+static bool s_init(uint32_t tick_hz) {
+    pGlobalctx->tick_hz = tick_hz;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t s_cycles(void) {
+    return pGlobalctx->cycles;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t s_cycle_hz(void) {
+    return pGlobalctx->cycle_hz;
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void timebase_stub_create(timebase_hw_vtable_t *pv, timebase_stub_ctx_t *pctx) {
+    pGlobalctx = pctx;
+    // Install stub implementation
+    pv->hw_init = s_init;
+    pv->hw_cycles = s_cycles;
+    pv->hw_cycle_hz = s_cycle_hz;
+}
+
+//------------------------------------------------------------------------------
+void timebase_stub_advance_ticks(uint32_t ticks) {
+    uint32_t cycles_per_tick = pGlobalctx->cycle_hz / pGlobalctx->tick_hz;
+    for (uint32_t i = 0; i < ticks; ++i) {
+        pGlobalctx->cycles += cycles_per_tick;
+        timebase_isr_tick();
+    }
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TIMEBASE_STUB_H_
+#define INCLUDE_TIMEBASE_STUB_H_
+//------------------------------------------------------------------------------
+//
+// Timebase stub specification for unit testing application code on a virtual
+// clock
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timebase_api.h"
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// Context
+typedef struct {
+    // Virtual cycle counter and its rate
+    uint32_t cycles;
+    uint32_t cycle_hz;
+    // Tick rate given to hw_init, 0 until initialized
+    uint32_t tick_hz;
+} timebase_stub_ctx_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+void timebase_stub_create(timebase_hw_vtable_t *pv, timebase_stub_ctx_t *pctx);
+
+//------------------------------------------------------------------------------
+// Advance the virtual clock, running the tick ISR once per tick elapsed
+void timebase_stub_advance_ticks(uint32_t ticks);
+
+#endif // INCLUDE_TIMEBASE_STUB_H_
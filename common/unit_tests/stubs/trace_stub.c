@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Trace backend implementation for unit testing: records trace points
+//
+//------------------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 199309L
+#include "trace_stub.h"
+#include <time.h>
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static trace_stub_event_t events[TRACE_STUB_DEPTH];
+static size_t event_count;
+static uint32_t dropped;
+static trace_stub_clock_fn clock_fn;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+static uint64_t host_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+void trace_stub_reset(trace_stub_clock_fn clock) {
+    event_count = 0;
+    dropped = 0;
+    clock_fn = clock ? clock : host_clock_ns;
+}
+
+//------------------------------------------------------------------------------
+void trace_stub_record(uint32_t id, bool enter) {
+    if (event_count >= TRACE_STUB_DEPTH) {
+        dropped++;
+        return;
+    }
+    if (!clock_fn) {
+        clock_fn = host_clock_ns;
+    }
+    events[event_count++] = (trace_stub_event_t){
+        .id = id, .enter = enter, .ts = clock_fn() };
+}
+
+//------------------------------------------------------------------------------
+size_t trace_stub_count(void) {
+    return event_count;
+}
+
+//------------------------------------------------------------------------------
+const trace_stub_event_t *trace_stub_event(size_t index) {
+    return (index < event_count) ? &events[index] : NULL;
+}
+
+//------------------------------------------------------------------------------
+uint32_t trace_stub_dropped(void) {
+    return dropped;
+}
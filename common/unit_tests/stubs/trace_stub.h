@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_TRACE_STUB_H_
+#define INCLUDE_TRACE_STUB_H_
+//------------------------------------------------------------------------------
+//
+// Trace backend stub for unit testing: build with TRACE_ENABLE and
+// TRACE_BACKEND_H="trace_stub.h" to record trace points with timestamps
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define TRACE_STUB_DEPTH  256u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// One recorded edge
+typedef struct {
+    uint32_t id;
+    bool     enter;
+    uint64_t ts;
+} trace_stub_event_t;
+
+// Timestamp source, e.g., a test's virtual clock
+typedef uint64_t (*trace_stub_clock_fn)(void);
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Clear the record; a NULL clock selects the host monotonic clock (ns)
+void trace_stub_reset(trace_stub_clock_fn clock);
+
+//------------------------------------------------------------------------------
+void trace_stub_record(uint32_t id, bool enter);
+size_t trace_stub_count(void);
+const trace_stub_event_t *trace_stub_event(size_t index);
+// Events lost because the record was full
+uint32_t trace_stub_dropped(void);
+
+//------------------------------------------------------------------------------
+// Backend hooks used by trace_api.h
+//------------------------------------------------------------------------------
+static inline void trace_backend_init(void) {
+}
+
+static inline void trace_backend_enter(uint32_t id) {
+    trace_stub_record(id, true);
+}
+
+static inline void trace_backend_exit(uint32_t id) {
+    trace_stub_record(id, false);
+}
+
+#endif // INCLUDE_TRACE_STUB_H_
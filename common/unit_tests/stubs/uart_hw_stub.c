@@ -11,10 +11,12 @@
 #include "uart_hw_stub.h"
 
 //------------------------------------------------------------------------------
-// Stubbed UART object
+// Stubbed UART objects
 //------------------------------------------------------------------------------
 
-static uart_stub_ctx_t *pGlobalctx;
+// The backend vtable carries no context, so each instance gets its own set of
+// entry points bound to one slot here
+static uart_stub_ctx_t *pSlotctx[UART_HW_STUB_MAX_INSTANCES];
 
 //------------------------------------------------------------------------------
 // Stub Function Definitions
@@ -26,45 +28,159 @@ static bool s_init(uint32_t baud) {
 }
 
 //------------------------------------------------------------------------------
-static bool s_tx_ready(void) {
+static bool ctx_tx_ready(const uart_stub_ctx_t *pctx) {
     // Any bytes not sent?
-    return pGlobalctx->tx_bytes > 0;
+    return pctx->tx_bytes > 0;
 }
 
 //------------------------------------------------------------------------------
-static void s_tx_write(uint8_t byte) {
+static void ctx_tx_write(uart_stub_ctx_t *pctx, uint8_t byte) {
     // Write the byte if there is room
-    if (pGlobalctx->tx_len < pGlobalctx->tx_capacity) {
-        pGlobalctx->ptx_buf[pGlobalctx->tx_len++] = byte;
+    if (pctx->tx_len < pctx->tx_capacity) {
+        pctx->ptx_buf[pctx->tx_len++] = byte;
     }
     // Apply flow control
-    if (pGlobalctx->tx_bytes > 0) { 
-        pGlobalctx->tx_bytes--;
+    if (pctx->tx_bytes > 0) {
+        pctx->tx_bytes--;
     }
 }
 
 //------------------------------------------------------------------------------
-static bool s_rx_available(void) {
+static bool ctx_rx_available(const uart_stub_ctx_t *pctx) {
     // More Rx data to get?
-    return pGlobalctx->rx_idx < pGlobalctx->rx_len;
+    return pctx->rx_idx < pctx->rx_len;
 }
 
 //------------------------------------------------------------------------------
-static uint8_t s_rx_read(void) {
+static uint8_t ctx_rx_read(uart_stub_ctx_t *pctx) {
     // Return the next Rx byte, if any, otherwise return 0
-    return (pGlobalctx->rx_idx < pGlobalctx->rx_len) ? 
-        (pGlobalctx->prx_src[pGlobalctx->rx_idx++]) : 0;
+    return (pctx->rx_idx < pctx->rx_len) ?
+        (pctx->prx_src[pctx->rx_idx++]) : 0;
 }
 
+//------------------------------------------------------------------------------
+static uint32_t ctx_rx_errors(uart_stub_ctx_t *pctx) {
+    // Report and clear any injected line errors
+    uint32_t err_mask = pctx->rx_errors;
+    pctx->rx_errors = 0;
+    return err_mask;
+}
+
+//------------------------------------------------------------------------------
+static bool ctx_rx_timeout_config(uart_stub_ctx_t *pctx, uint32_t char_times) {
+    pctx->rx_timeout_chars = char_times;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool ctx_rx_timeout_expired(uart_stub_ctx_t *pctx) {
+    // Report and clear any injected line silence
+    bool expired = pctx->rx_timeout;
+    pctx->rx_timeout = false;
+    return expired;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t ctx_timestamp(const uart_stub_ctx_t *pctx) {
+    return pctx->now;
+}
+
+//------------------------------------------------------------------------------
+static size_t ctx_rx_read_block(uart_stub_ctx_t *pctx, uint8_t *pdst, size_t max) {
+    pctx->rx_block_calls++;
+    size_t n = 0;
+    while (n < max && ctx_rx_available(pctx)) {
+        pdst[n++] = ctx_rx_read(pctx);
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+static size_t ctx_tx_write_block(
+        uart_stub_ctx_t *pctx, const uint8_t *psrc, size_t len) {
+    pctx->tx_block_calls++;
+    size_t n = 0;
+    while (n < len && ctx_tx_ready(pctx)) {
+        ctx_tx_write(pctx, psrc[n++]);
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+// Per-slot entry points
+//------------------------------------------------------------------------------
+#define UART_HW_STUB_SLOT(n)                                                   \
+    static bool s_tx_ready_##n(void) { return ctx_tx_ready(pSlotctx[n]); }     \
+    static void s_tx_write_##n(uint8_t byte) {                                 \
+        ctx_tx_write(pSlotctx[n], byte);                                       \
+    }                                                                          \
+    static bool s_rx_available_##n(void) {                                     \
+        return ctx_rx_available(pSlotctx[n]);                                  \
+    }                                                                          \
+    static uint8_t s_rx_read_##n(void) { return ctx_rx_read(pSlotctx[n]); }   \
+    static uint32_t s_rx_errors_##n(void) {                                    \
+        return ctx_rx_errors(pSlotctx[n]);                                     \
+    }                                                                          \
+    static bool s_rx_timeout_config_##n(uint32_t char_times) {                 \
+        return ctx_rx_timeout_config(pSlotctx[n], char_times);                 \
+    }                                                                          \
+    static bool s_rx_timeout_expired_##n(void) {                               \
+        return ctx_rx_timeout_expired(pSlotctx[n]);                            \
+    }                                                                          \
+    static uint32_t s_timestamp_##n(void) { return ctx_timestamp(pSlotctx[n]); } \
+    static size_t s_rx_read_block_##n(uint8_t *pdst, size_t max) {            \
+        return ctx_rx_read_block(pSlotctx[n], pdst, max);                      \
+    }                                                                          \
+    static size_t s_tx_write_block_##n(const uint8_t *psrc, size_t len) {      \
+        return ctx_tx_write_block(pSlotctx[n], psrc, len);                     \
+    }
+
+#define UART_HW_STUB_SLOT_VTABLE(n)                                            \
+    {                                                                          \
+        .hw_init = s_init,                                                     \
+        .hw_tx_ready = s_tx_ready_##n,                                         \
+        .hw_tx_write = s_tx_write_##n,                                         \
+        .hw_rx_available = s_rx_available_##n,                                 \
+        .hw_rx_read = s_rx_read_##n,                                           \
+        .hw_rx_errors = s_rx_errors_##n,                                       \
+        .hw_rx_timeout_config = s_rx_timeout_config_##n,                       \
+        .hw_rx_timeout_expired = s_rx_timeout_expired_##n,                     \
+        .hw_timestamp = s_timestamp_##n,                                       \
+        .hw_rx_read_block = s_rx_read_block_##n,                               \
+        .hw_tx_write_block = s_tx_write_block_##n,                             \
+    }
+
+UART_HW_STUB_SLOT(0)
+UART_HW_STUB_SLOT(1)
+UART_HW_STUB_SLOT(2)
+UART_HW_STUB_SLOT(3)
+
+static const uart_hw_vtable_t slot_vtables[UART_HW_STUB_MAX_INSTANCES] = {
+    UART_HW_STUB_SLOT_VTABLE(0),
+    UART_HW_STUB_SLOT_VTABLE(1),
+    UART_HW_STUB_SLOT_VTABLE(2),
+    UART_HW_STUB_SLOT_VTABLE(3),
+};
+
 //------------------------------------------------------------------------------
 // Function Definitions
 //------------------------------------------------------------------------------
 void uart_hw_stub_create(uart_hw_vtable_t *pv, uart_stub_ctx_t *pctx) {
-    pGlobalctx = pctx;
+    (void)uart_hw_stub_create_instance(pv, pctx, 0);
+}
+
+//------------------------------------------------------------------------------
+bool uart_hw_stub_create_instance(
+        uart_hw_vtable_t *pv, uart_stub_ctx_t *pctx, size_t index) {
+    if (index >= UART_HW_STUB_MAX_INSTANCES) {
+        return false;
+    }
+    pSlotctx[index] = pctx;
     // Install stub implementation
-    pv->hw_init = s_init;
-    pv->hw_tx_ready = s_tx_ready;
-    pv->hw_tx_write = s_tx_write;
-    pv->hw_rx_available = s_rx_available;
-    pv->hw_rx_read = s_rx_read;
+    *pv = slot_vtables[index];
+    if (!pctx->block_io) {
+        pv->hw_rx_read_block = NULL;
+        pv->hw_tx_write_block = NULL;
+    }
+    return true;
 }
@@ -15,6 +15,13 @@
 #include <stdbool.h>
 #include "uart_api.h"
 
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Number of stub backends that can be live at once
+#define UART_HW_STUB_MAX_INSTANCES  4u
+
 //------------------------------------------------------------------------------
 // Types
 //------------------------------------------------------------------------------
@@ -31,11 +38,28 @@ typedef struct {
     size_t rx_idx;
     // Simulate flow control (how many bytes HW is ready to send)
     int tx_bytes;
+    // Simulate Rx line errors (UART_RX_ERR_MASK() bits, cleared when read)
+    uint32_t rx_errors;
+    // Simulate receiver timeout (configured value, event cleared when read)
+    uint32_t rx_timeout_chars;
+    bool rx_timeout;
+    // Injectable clock for Rx arrival timestamps
+    uint32_t now;
+    // Install block entries too (set before create), with call counts
+    bool block_io;
+    uint32_t rx_block_calls;
+    uint32_t tx_block_calls;
 } uart_stub_ctx_t;
 
 //------------------------------------------------------------------------------
 // Function Declarations
 //------------------------------------------------------------------------------
+// Install the stub for instance 0
 void uart_hw_stub_create(uart_hw_vtable_t *pv, uart_stub_ctx_t *pctx);
 
+//------------------------------------------------------------------------------
+// Install the stub for one of several instances, e.g., both ends of a bridge
+bool uart_hw_stub_create_instance(
+    uart_hw_vtable_t *pv, uart_stub_ctx_t *pctx, size_t index);
+
 #endif // INCLUDE_UART_HW_STUB_H_
\ No newline at end of file
@@ -0,0 +1,376 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Baud-accurate UART simulator backend on a virtual clock
+//
+//------------------------------------------------------------------------------
+
+#include "uart_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// The backend vtable carries no context, so one simulator is active at a time
+static uart_sim_t *s_psim;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static void lat_sample(uart_sim_lat_t *pl, uint64_t ns) {
+    if (pl && pl->count < pl->cap) {
+        pl->psamples[pl->count++] = (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void next_event(uart_sim_t *psim) {
+    psim->have_next = psim->gen && psim->gen(psim->gen_ctx, &psim->next);
+    if (psim->have_next) {
+        psim->next.t_ns += psim->gen_base_ns;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Deliver every arrival due by now into the hardware Rx FIFO
+static void sim_update(uart_sim_t *psim) {
+    while (psim->have_next && psim->next.t_ns <= psim->now_ns) {
+        psim->rx_arrived++;
+        psim->rx_last_ns = psim->next.t_ns;
+        psim->rx_timeout_armed = true;
+        if (psim->rx_count < psim->cfg.rx_fifo_depth) {
+            uint32_t slot = (psim->rx_head + psim->rx_count) % UART_SIM_RX_FIFO_MAX;
+            psim->rx_fifo[slot] = psim->next.byte;
+            psim->rx_fifo_t[slot] = psim->next.t_ns;
+            psim->rx_count++;
+        } else {
+            // Receiver full: the byte in the shift register is lost
+            psim->rx_overruns++;
+            psim->rx_errors |= UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN);
+        }
+        next_event(psim);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Every register access costs CPU time
+static uart_sim_t *sim_access(void) {
+    s_psim->now_ns += s_psim->cfg.access_ns;
+    sim_update(s_psim);
+    return s_psim;
+}
+
+//------------------------------------------------------------------------------
+// Characters still on the line or queued in the Tx FIFO
+static uint64_t tx_pending(const uart_sim_t *psim) {
+    if (psim->tx_free_ns <= psim->now_ns || !psim->char_ns) {
+        return 0;
+    }
+    return (psim->tx_free_ns - psim->now_ns + psim->char_ns - 1u) / psim->char_ns;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t percentile(const uart_sim_lat_t *pl, unsigned pct) {
+    if (!pl || !pl->count) {
+        return 0;
+    }
+    return pl->psamples[((pl->count - 1u) * pct) / 100u];
+}
+
+//------------------------------------------------------------------------------
+static int cmp_u32(const void *pa, const void *pb) {
+    uint32_t a = *(const uint32_t*)pa;
+    uint32_t b = *(const uint32_t*)pb;
+    return (a > b) - (a < b);
+}
+
+//------------------------------------------------------------------------------
+// Backend Function Definitions
+//------------------------------------------------------------------------------
+static bool sim_init(uint32_t baud) {
+    uart_sim_t *psim = s_psim;
+    if (!baud) {
+        return false;
+    }
+    psim->char_ns = (uint32_t)((psim->cfg.bits_per_char * 1000000000ull +
+        baud / 2u) / baud);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+static bool sim_tx_ready(void) {
+    uart_sim_t *psim = sim_access();
+    // Shift register plus FIFO
+    return tx_pending(psim) < (uint64_t)psim->cfg.tx_fifo_depth + 1u;
+}
+
+//------------------------------------------------------------------------------
+static void sim_tx_write(uint8_t byte) {
+    uart_sim_t *psim = sim_access();
+    uint64_t start = (psim->tx_free_ns > psim->now_ns) ?
+        psim->tx_free_ns : psim->now_ns;
+    psim->tx_free_ns = start + psim->char_ns;
+    psim->tx_busy_ns += psim->char_ns;
+    psim->tx_written++;
+    if (psim->tx_captured < psim->cfg.tx_capture_cap) {
+        psim->cfg.ptx_capture[psim->tx_captured++] = byte;
+    }
+    // Pair with the oldest byte read, as an echo would
+    if (psim->inflight_count) {
+        lat_sample(psim->pecho_lat,
+            psim->tx_free_ns - psim->inflight[psim->inflight_head]);
+        psim->inflight_head = (psim->inflight_head + 1u) % UART_SIM_INFLIGHT_MAX;
+        psim->inflight_count--;
+    }
+}
+
+//------------------------------------------------------------------------------
+static bool sim_rx_available(void) {
+    return sim_access()->rx_count != 0u;
+}
+
+//------------------------------------------------------------------------------
+static uint8_t sim_rx_read(void) {
+    uart_sim_t *psim = sim_access();
+    if (!psim->rx_count) {
+        return 0;
+    }
+    uint8_t byte = psim->rx_fifo[psim->rx_head];
+    uint64_t t_arrival = psim->rx_fifo_t[psim->rx_head];
+    psim->rx_head = (psim->rx_head + 1u) % UART_SIM_RX_FIFO_MAX;
+    psim->rx_count--;
+    psim->rx_read++;
+    lat_sample(psim->prx_lat, psim->now_ns - t_arrival);
+    if (psim->inflight_count < UART_SIM_INFLIGHT_MAX) {
+        uint32_t slot = (psim->inflight_head + psim->inflight_count) %
+            UART_SIM_INFLIGHT_MAX;
+        psim->inflight[slot] = t_arrival;
+        psim->inflight_count++;
+    }
+    return byte;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t sim_rx_errors(void) {
+    uart_sim_t *psim = sim_access();
+    uint32_t err_mask = psim->rx_errors;
+    psim->rx_errors = 0;
+    return err_mask;
+}
+
+//------------------------------------------------------------------------------
+static bool sim_rx_timeout_config(uint32_t char_times) {
+    uart_sim_t *psim = sim_access();
+    psim->rx_timeout_chars = char_times;
+    psim->rx_timeout_armed = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Fires once per burst, char_times of silence after its last byte
+static bool sim_rx_timeout_expired(void) {
+    uart_sim_t *psim = sim_access();
+    if (!psim->rx_timeout_chars || !psim->rx_timeout_armed ||
+            psim->now_ns < psim->rx_last_ns +
+            (uint64_t)psim->rx_timeout_chars * psim->char_ns) {
+        return false;
+    }
+    psim->rx_timeout_armed = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Virtual microseconds, as on the Linux backend
+static uint32_t sim_timestamp(void) {
+    return (uint32_t)(sim_access()->now_ns / 1000u);
+}
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+bool uart_sim_create(uart_hw_vtable_t *pv, uart_sim_t *psim,
+        const uart_sim_config_t *pcfg) {
+    if (!pv || !psim || !pcfg || pcfg->rx_fifo_depth > UART_SIM_RX_FIFO_MAX ||
+            (pcfg->tx_capture_cap && !pcfg->ptx_capture)) {
+        return false;
+    }
+    memset(psim, 0, sizeof(*psim));
+    psim->cfg = *pcfg;
+    if (!psim->cfg.bits_per_char) {
+        psim->cfg.bits_per_char = 10u;
+    }
+    if (!psim->cfg.rx_fifo_depth) {
+        psim->cfg.rx_fifo_depth = 1u;
+    }
+    if (!psim->cfg.tx_fifo_depth) {
+        psim->cfg.tx_fifo_depth = 1u;
+    }
+    s_psim = psim;
+
+    *pv = (uart_hw_vtable_t){
+        .hw_init = sim_init,
+        .hw_tx_ready = sim_tx_ready,
+        .hw_tx_write = sim_tx_write,
+        .hw_rx_available = sim_rx_available,
+        .hw_rx_read = sim_rx_read,
+        .hw_rx_errors = sim_rx_errors,
+        .hw_rx_timeout_config = sim_rx_timeout_config,
+        .hw_rx_timeout_expired = sim_rx_timeout_expired,
+        .hw_timestamp = sim_timestamp,
+        // Registers are modelled one byte at a time
+        .hw_rx_read_block = NULL,
+        .hw_tx_write_block = NULL,
+    };
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_set_rx_source(uart_sim_t *psim, uart_sim_gen_fn gen, void *pctx) {
+    psim->gen = gen;
+    psim->gen_ctx = pctx;
+    psim->gen_base_ns = psim->now_ns;
+    next_event(psim);
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_set_latency(uart_sim_t *psim,
+        uart_sim_lat_t *prx_lat, uart_sim_lat_t *pecho_lat) {
+    psim->prx_lat = prx_lat;
+    psim->pecho_lat = pecho_lat;
+}
+
+//------------------------------------------------------------------------------
+uint64_t uart_sim_now(const uart_sim_t *psim) {
+    return psim->now_ns;
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_advance(uart_sim_t *psim, uint64_t ns) {
+    psim->now_ns += ns;
+    sim_update(psim);
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_run(uart_sim_t *psim, uint64_t period_ns, uint64_t duration_ns,
+        void (*step)(void *pctx), void *pctx) {
+    if (!period_ns || !step) {
+        return;
+    }
+    uint64_t end = psim->now_ns + duration_ns;
+    uint64_t due = psim->now_ns;
+    while (psim->now_ns < end) {
+        if (psim->now_ns < due) {
+            uart_sim_advance(psim, due - psim->now_ns);
+            if (psim->now_ns >= end) {
+                break;
+            }
+        }
+        step(pctx);
+        due += period_ns;
+    }
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_report(uart_sim_t *psim, uart_sim_report_t *prep) {
+    memset(prep, 0, sizeof(*prep));
+    uint64_t pending = tx_pending(psim);
+    uint64_t busy_ahead = (psim->tx_free_ns > psim->now_ns) ?
+        psim->tx_free_ns - psim->now_ns : 0u;
+    prep->elapsed_ns = psim->now_ns - psim->start_ns;
+    prep->rx_arrived = psim->rx_arrived;
+    prep->rx_read = psim->rx_read;
+    prep->rx_overruns = psim->rx_overruns;
+    prep->tx_sent = psim->tx_written - pending;
+    if (prep->elapsed_ns) {
+        double secs = (double)prep->elapsed_ns / 1e9;
+        prep->rx_bytes_per_s = (double)prep->rx_read / secs;
+        prep->tx_bytes_per_s = (double)prep->tx_sent / secs;
+        prep->tx_line_busy = (double)(psim->tx_busy_ns - busy_ahead) /
+            (double)prep->elapsed_ns;
+    }
+    uart_sim_lat_t *pl = psim->prx_lat;
+    if (pl && pl->count) {
+        qsort(pl->psamples, pl->count, sizeof(pl->psamples[0]), cmp_u32);
+        prep->rx_lat_p50 = percentile(pl, 50u);
+        prep->rx_lat_p99 = percentile(pl, 99u);
+        prep->rx_lat_max = pl->psamples[pl->count - 1u];
+    }
+    pl = psim->pecho_lat;
+    if (pl && pl->count) {
+        qsort(pl->psamples, pl->count, sizeof(pl->psamples[0]), cmp_u32);
+        prep->echo_lat_p50 = percentile(pl, 50u);
+        prep->echo_lat_p99 = percentile(pl, 99u);
+        prep->echo_lat_max = pl->psamples[pl->count - 1u];
+    }
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_report_print(const uart_sim_report_t *prep, FILE *pf) {
+    fprintf(pf, "uart_sim: %.3f ms, rx %llu arrived / %llu read / %llu overrun, "
+        "tx %llu sent\n", (double)prep->elapsed_ns / 1e6,
+        (unsigned long long)prep->rx_arrived, (unsigned long long)prep->rx_read,
+        (unsigned long long)prep->rx_overruns, (unsigned long long)prep->tx_sent);
+    fprintf(pf, "uart_sim: rx %.0f B/s, tx %.0f B/s, tx line busy %.1f%%\n",
+        prep->rx_bytes_per_s, prep->tx_bytes_per_s, prep->tx_line_busy * 100.0);
+    fprintf(pf, "uart_sim: rx latency p50/p99/max %u/%u/%u ns, "
+        "echo latency p50/p99/max %u/%u/%u ns\n",
+        prep->rx_lat_p50, prep->rx_lat_p99, prep->rx_lat_max,
+        prep->echo_lat_p50, prep->echo_lat_p99, prep->echo_lat_max);
+}
+
+//------------------------------------------------------------------------------
+// Generators
+//------------------------------------------------------------------------------
+void uart_sim_stream_init(uart_sim_stream_t *ps, const uart_sim_t *psim,
+        uint64_t total_bytes, uint32_t burst_len, uint64_t period_ns) {
+    memset(ps, 0, sizeof(*ps));
+    ps->remaining = total_bytes;
+    ps->char_ns = psim->char_ns;
+    // No burst length: one back-to-back stream
+    ps->burst_len = burst_len ? burst_len : UINT32_MAX;
+    ps->period_ns = period_ns;
+}
+
+//------------------------------------------------------------------------------
+bool uart_sim_stream_gen(void *pctx, uart_sim_event_t *pev) {
+    uart_sim_stream_t *ps = (uart_sim_stream_t*)pctx;
+    if (!ps->remaining) {
+        return false;
+    }
+    if (ps->index && (ps->index % ps->burst_len) == 0u) {
+        // Next burst starts on its period, or right away if the last overran
+        uint64_t start = (ps->index / ps->burst_len) * ps->period_ns;
+        if (start > ps->t_ns) {
+            ps->t_ns = start;
+        }
+    }
+    ps->t_ns += ps->char_ns;
+    pev->t_ns = ps->t_ns;
+    pev->byte = (uint8_t)ps->index;
+    ps->index++;
+    ps->remaining--;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void uart_sim_trace_init(uart_sim_trace_t *pt,
+        const uart_sim_event_t *pevents, size_t count) {
+    pt->pevents = pevents;
+    pt->count = count;
+    pt->index = 0;
+}
+
+//------------------------------------------------------------------------------
+bool uart_sim_trace_gen(void *pctx, uart_sim_event_t *pev) {
+    uart_sim_trace_t *pt = (uart_sim_trace_t*)pctx;
+    if (pt->index >= pt->count) {
+        return false;
+    }
+    *pev = pt->pevents[pt->index++];
+    return true;
+}
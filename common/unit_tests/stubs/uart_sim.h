@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_UART_SIM_H_
+#define INCLUDE_UART_SIM_H_
+//------------------------------------------------------------------------------
+//
+// Baud-accurate UART simulator on a virtual clock, for sizing FIFOs and pump
+// budgets on the host
+//
+// Models a USART with Rx/Tx hardware FIFOs at a configured baud rate: bytes
+// arrive from a schedule (trace or generator) and are lost with an overrun
+// when the Rx FIFO is full, Tx bytes take one character time each on the
+// line, and every register access can be charged CPU time. The application
+// loop runs at a chosen cadence through uart_sim_run().
+//
+//------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "uart_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Deepest hardware Rx FIFO modelled
+#define UART_SIM_RX_FIFO_MAX   64u
+
+// Bytes read but not yet echoed, tracked for echo latency
+#define UART_SIM_INFLIGHT_MAX  4096u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// One Rx byte, fully received (stop bit done) at t_ns
+typedef struct {
+    uint64_t t_ns;
+    uint8_t  byte;
+} uart_sim_event_t;
+
+// Arrival schedule: produce the next event, in time order; false when done
+typedef bool (*uart_sim_gen_fn)(void *pctx, uart_sim_event_t *pev);
+
+// Latency samples (ns), caller-owned; sampling stops when full
+typedef struct {
+    uint32_t *psamples;
+    size_t   cap;
+    size_t   count;
+} uart_sim_lat_t;
+
+// Configuration; the baud rate comes from hw_init (uart_init)
+typedef struct {
+    // Bits per character on the line (10 for 8N1)
+    uint32_t bits_per_char;
+    // Hardware FIFO depths in characters (1 = plain data register)
+    uint32_t rx_fifo_depth;
+    uint32_t tx_fifo_depth;
+    // CPU time charged per backend call, to model the cost of the pump
+    uint32_t access_ns;
+    // Optional capture of bytes sent on the line
+    uint8_t  *ptx_capture;
+    size_t   tx_capture_cap;
+} uart_sim_config_t;
+
+// Results
+typedef struct {
+    uint64_t elapsed_ns;
+    uint64_t rx_arrived;
+    uint64_t rx_read;
+    uint64_t rx_overruns;
+    uint64_t tx_sent;
+    // Sustained throughput over the elapsed time, bytes/s
+    double   rx_bytes_per_s;
+    double   tx_bytes_per_s;
+    // Fraction of the elapsed time the Tx line was busy
+    double   tx_line_busy;
+    // Rx arrival -> read from hardware, and Rx arrival -> echoed byte sent
+    uint32_t rx_lat_p50, rx_lat_p99, rx_lat_max;
+    uint32_t echo_lat_p50, echo_lat_p99, echo_lat_max;
+} uart_sim_report_t;
+
+// Simulator state; treat as opaque
+typedef struct {
+    uart_sim_config_t cfg;
+    uint64_t now_ns;
+    uint64_t start_ns;
+    uint32_t char_ns;
+    // Arrival schedule, with one event of lookahead
+    uart_sim_gen_fn gen;
+    void     *gen_ctx;
+    uint64_t gen_base_ns;
+    uart_sim_event_t next;
+    bool     have_next;
+    // Rx hardware FIFO, bytes with their arrival times
+    uint8_t  rx_fifo[UART_SIM_RX_FIFO_MAX];
+    uint64_t rx_fifo_t[UART_SIM_RX_FIFO_MAX];
+    uint32_t rx_head;
+    uint32_t rx_count;
+    uint32_t rx_errors;
+    uint64_t rx_last_ns;
+    uint32_t rx_timeout_chars;
+    bool     rx_timeout_armed;
+    // Tx line: time the last queued character finishes
+    uint64_t tx_free_ns;
+    uint64_t tx_busy_ns;
+    size_t   tx_captured;
+    // Arrival times of bytes read, matched in order to bytes sent
+    uint64_t inflight[UART_SIM_INFLIGHT_MAX];
+    uint32_t inflight_head;
+    uint32_t inflight_count;
+    // Counters
+    uint64_t rx_arrived;
+    uint64_t rx_read;
+    uint64_t rx_overruns;
+    uint64_t tx_written;
+    uart_sim_lat_t *prx_lat;
+    uart_sim_lat_t *pecho_lat;
+} uart_sim_t;
+
+// Built-in generators
+// Back-to-back bytes at line rate, or bursts of burst_len every period_ns
+typedef struct {
+    uint64_t t_ns;
+    uint64_t remaining;
+    uint32_t char_ns;
+    uint32_t burst_len;
+    uint64_t period_ns;
+    uint32_t index;
+} uart_sim_stream_t;
+
+// Replay of a recorded trace
+typedef struct {
+    const uart_sim_event_t *pevents;
+    size_t count;
+    size_t index;
+} uart_sim_trace_t;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Install the simulator backend; false on bad configuration
+// Only one simulator is active at a time; uart_init() sets the baud rate
+bool uart_sim_create(uart_hw_vtable_t *pv, uart_sim_t *psim,
+    const uart_sim_config_t *pcfg);
+
+//------------------------------------------------------------------------------
+// Arrival schedule (times relative to the current virtual time)
+void uart_sim_set_rx_source(uart_sim_t *psim, uart_sim_gen_fn gen, void *pctx);
+
+//------------------------------------------------------------------------------
+// Latency sample buffers (either may be NULL)
+void uart_sim_set_latency(uart_sim_t *psim,
+    uart_sim_lat_t *prx_lat, uart_sim_lat_t *pecho_lat);
+
+//------------------------------------------------------------------------------
+// Virtual clock
+uint64_t uart_sim_now(const uart_sim_t *psim);
+void uart_sim_advance(uart_sim_t *psim, uint64_t ns);
+
+//------------------------------------------------------------------------------
+// Run an application step every period_ns for duration_ns of virtual time;
+// a step that overruns its period (charged access time) delays the next one
+void uart_sim_run(uart_sim_t *psim, uint64_t period_ns, uint64_t duration_ns,
+    void (*step)(void *pctx), void *pctx);
+
+//------------------------------------------------------------------------------
+// Results so far; sorts the latency samples in place
+void uart_sim_report(uart_sim_t *psim, uart_sim_report_t *prep);
+void uart_sim_report_print(const uart_sim_report_t *prep, FILE *pf);
+
+//------------------------------------------------------------------------------
+// Generators
+void uart_sim_stream_init(uart_sim_stream_t *ps, const uart_sim_t *psim,
+    uint64_t total_bytes, uint32_t burst_len, uint64_t period_ns);
+bool uart_sim_stream_gen(void *pctx, uart_sim_event_t *pev);
+void uart_sim_trace_init(uart_sim_trace_t *pt,
+    const uart_sim_event_t *pevents, size_t count);
+bool uart_sim_trace_gen(void *pctx, uart_sim_event_t *pev);
+
+#endif // INCLUDE_UART_SIM_H_
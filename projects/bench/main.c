@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// On-target benchmark: runs the shared kernels under the DWT cycle counter
+// and reports cycles/byte over the UART as JSON, one case per line, in the
+// same layout as the host suites in benchmarks/
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "bench_kernels.h"
+#include "platform_config.h"
+#include "uart_core.h"
+#include "uart_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Runs per kernel; the fewest cycles are kept (first run warms the caches)
+#define BENCH_FW_REPS  5u
+
+//------------------------------------------------------------------------------
+// UART Instance
+//------------------------------------------------------------------------------
+
+// Report port only; the kernels drive their own UART core instance
+UART_DEFINE_INSTANCE(uart_report, 16, 256);
+
+//------------------------------------------------------------------------------
+// Output Helpers
+//------------------------------------------------------------------------------
+// Queue text and wait for it to leave, so reporting never overlaps a run
+static void put_str(const char *ps) {
+    size_t len = 0;
+    while (ps[len]) {
+        len++;
+    }
+    size_t done = 0;
+    while (done < len) {
+        done += uart_write(uart_report.pu, (const uint8_t*)&ps[done], len - done);
+        uart_service_tx(uart_report.pu);
+    }
+    while (uart_tx_queued(uart_report.pu)) {
+        uart_service_tx(uart_report.pu);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void put_u32(uint32_t value) {
+    char digits[11];
+    size_t i = sizeof(digits) - 1u;
+    digits[i] = '\0';
+    do {
+        digits[--i] = (char)('0' + (value % 10u));
+        value /= 10u;
+    } while (value);
+    put_str(&digits[i]);
+}
+
+//------------------------------------------------------------------------------
+// Fixed point with two decimals, e.g., 1234 -> "12.34"
+static void put_centi(uint32_t centi) {
+    put_u32(centi / 100u);
+    put_str((centi % 100u) < 10u ? ".0" : ".");
+    put_u32(centi % 100u);
+}
+
+//------------------------------------------------------------------------------
+// Measurement
+//------------------------------------------------------------------------------
+static inline uint32_t cycles(void) {
+    return REG32(DWT_CYCCNT_ADDR);
+}
+
+//------------------------------------------------------------------------------
+// Cost of the timing reads themselves, subtracted from every run
+static uint32_t timer_overhead(void) {
+    uint32_t best = UINT32_MAX;
+    for (uint32_t r = 0; r < BENCH_FW_REPS; ++r) {
+        uint32_t t0 = cycles();
+        uint32_t t1 = cycles();
+        if (t1 - t0 < best) {
+            best = t1 - t0;
+        }
+    }
+    return best;
+}
+
+//------------------------------------------------------------------------------
+static volatile uint32_t s_sink;
+
+static uint32_t run_kernel(const bench_kernel_t *pk, uint32_t overhead) {
+    uint32_t best = UINT32_MAX;
+    for (uint32_t r = 0; r < BENCH_FW_REPS; ++r) {
+        if (pk->setup) {
+            pk->setup();
+        }
+        uint32_t t0 = cycles();
+        uint32_t result = pk->run();
+        uint32_t t1 = cycles();
+        s_sink ^= result;
+        if (t1 - t0 < best) {
+            best = t1 - t0;
+        }
+    }
+    return (best > overhead) ? best - overhead : 0u;
+}
+
+//------------------------------------------------------------------------------
+static void run_all(void) {
+    uint32_t overhead = timer_overhead();
+    put_str("{\r\n  \"suite\": \"kernels_target\",\r\n  \"cpu_hz\": ");
+    put_u32(SYSTEM_CORE_CLK_HZ);
+    put_str(",\r\n  \"results\": [\r\n");
+    for (size_t i = 0; i < bench_kernel_count; ++i) {
+        const bench_kernel_t *pk = &bench_kernels[i];
+        uint32_t c = run_kernel(pk, overhead);
+        put_str("    {\"name\": \"");
+        put_str(pk->name);
+        put_str("\", \"bytes\": ");
+        put_u32(pk->bytes);
+        put_str(", \"cycles\": ");
+        put_u32(c);
+        put_str(", \"cycles_per_byte\": ");
+        put_centi((uint32_t)(((uint64_t)c * 100u) / pk->bytes));
+        put_str((i + 1u < bench_kernel_count) ? "},\r\n" : "}\r\n");
+    }
+    put_str("  ]\r\n}\r\n");
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    // Free-running cycle counter
+    REG32(DCB_DEMCR_ADDR) |= DCB_DEMCR_TRCENA;
+    REG32(DWT_CTRL_ADDR) |= DWT_CTRL_CYCCNTENA;
+
+    uart_hw_vtable_t hw;
+    uart_hw_install(&hw);
+    (void)uart_init_instance(&uart_report, &hw, 115200);
+
+    bench_kernels_init();
+
+    // No interrupts are enabled, so nothing preempts a timed run
+    run_all();
+
+    // Any received byte runs the suite again
+    for (;;) {
+        if (uart_poll_rx(uart_report.pu)) {
+            uint8_t discard[16];
+            while (uart_read(uart_report.pu, discard, sizeof(discard))) {
+            }
+            run_all();
+        }
+    }
+}
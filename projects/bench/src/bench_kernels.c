@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define the benchmark kernels shared by target and host
+//
+//------------------------------------------------------------------------------
+
+#include "bench_kernels.h"
+#include <stdio.h>
+#include "crc_api.h"
+#include "fmt_api.h"
+#include "frame_api.h"
+#include "ringbuf.h"
+#include "uart_core.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define RING_BYTES     256u
+#define MSG_BYTES      16u
+#define FRAME_PAYLOAD  256u
+#define FRAME_COUNT    (BENCH_KERNEL_BYTES / FRAME_PAYLOAD)
+// Formatter kernels: fixed-width 32-byte lines
+#define FMT_LINE       32u
+#define FMT_LINES      (BENCH_KERNEL_BYTES / FMT_LINE)
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static uint8_t s_data[BENCH_KERNEL_BYTES];
+static uint8_t s_out[BENCH_KERNEL_BYTES];
+static uint8_t s_ring[RING_BYTES];
+
+// UART core over a backend that accepts every byte at once
+UART_DEFINE_INSTANCE(s_uart, BENCH_KERNEL_BYTES, BENCH_KERNEL_BYTES);
+static uint32_t s_sink;
+
+// Pre-encoded frames for the decoder
+static uint8_t s_frames[FRAME_COUNT * FRAME_ENCODED_MAX(FRAME_PAYLOAD)];
+static size_t s_frames_len;
+static uint8_t s_frame_buf[FRAME_DECODE_BUF(FRAME_PAYLOAD)];
+static frame_decoder_t s_dec;
+
+//------------------------------------------------------------------------------
+// Sink Backend
+//------------------------------------------------------------------------------
+static bool sink_init(uint32_t baud) { (void)baud; return true; }
+static bool sink_tx_ready(void) { return true; }
+static void sink_tx_write(uint8_t byte) { s_sink += byte; }
+static bool sink_rx_available(void) { return false; }
+static uint8_t sink_rx_read(void) { return 0u; }
+
+static const uart_hw_vtable_t s_sink_hw = {
+    .hw_init = sink_init,
+    .hw_tx_ready = sink_tx_ready,
+    .hw_tx_write = sink_tx_write,
+    .hw_rx_available = sink_rx_available,
+    .hw_rx_read = sink_rx_read,
+};
+
+//------------------------------------------------------------------------------
+// Kernels
+//------------------------------------------------------------------------------
+static uint32_t k_ringbuf(void) {
+    ringbuf_t rb;
+    uint8_t byte = 0;
+    uint32_t sum = 0;
+    ringbuf_init(&rb, s_ring, sizeof(s_ring));
+    for (uint32_t done = 0; done < BENCH_KERNEL_BYTES; done += RING_BYTES) {
+        for (uint32_t i = 0; i < RING_BYTES; ++i) {
+            (void)ringbuf_push(&rb, s_data[done + i]);
+        }
+        while (ringbuf_pop(&rb, &byte)) {
+            sum += byte;
+        }
+    }
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+static void setup_uart(void) {
+    (void)uart_init_instance(&s_uart, &s_sink_hw, 115200);
+}
+
+static uint32_t k_uart_write(void) {
+    for (uint32_t done = 0; done < BENCH_KERNEL_BYTES; done += MSG_BYTES) {
+        (void)uart_write(s_uart.pu, &s_data[done], MSG_BYTES);
+    }
+    return s_sink;
+}
+
+//------------------------------------------------------------------------------
+static void setup_uart_rx(void) {
+    setup_uart();
+    uart_isr_rx_block(s_uart.pu, s_data, BENCH_KERNEL_BYTES);
+}
+
+static uint32_t k_uart_read(void) {
+    uint32_t done = 0;
+    size_t n;
+    while ((n = uart_read(s_uart.pu, &s_out[done], MSG_BYTES)) != 0u) {
+        done += (uint32_t)n;
+    }
+    return done;
+}
+
+static uint32_t k_uart_echo(void) {
+    uart_echo_pump(s_uart.pu);
+    return s_sink;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t k_crc16(void) {
+    return crc16_ccitt(s_data, BENCH_KERNEL_BYTES);
+}
+
+static uint32_t k_crc32(void) {
+    return crc32(s_data, BENCH_KERNEL_BYTES);
+}
+
+//------------------------------------------------------------------------------
+static uint32_t k_frame_encode(void) {
+    size_t n = 0;
+    for (uint32_t f = 0; f < FRAME_COUNT; ++f) {
+        n += frame_encode(&s_data[f * FRAME_PAYLOAD], FRAME_PAYLOAD,
+            &s_frames[n], sizeof(s_frames) - n);
+    }
+    return (uint32_t)n;
+}
+
+static void setup_frame_decode(void) {
+    frame_decoder_init(&s_dec, s_frame_buf, sizeof(s_frame_buf), NULL, NULL);
+}
+
+static uint32_t k_frame_decode(void) {
+    return (uint32_t)frame_decoder_feed(&s_dec, s_frames, s_frames_len);
+}
+
+//------------------------------------------------------------------------------
+// Lines of "> <hex> <signed> <fixed 2 decimals>\r\n", field widths fixed
+static uint32_t k_fmt_buf(void) {
+    char line[FMT_LINE + 1u];
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < FMT_LINES; ++i) {
+        const uint8_t *p = &s_data[i * FMT_LINE];
+        int32_t v = (int32_t)(p[0] | (p[1] << 8)) - 32768;
+        sum += (uint32_t)fmt_buf(line, sizeof(line), "> %08x %+8d %10.2k\r\n",
+            ((uint32_t)p[2] << 24 | p[3]), v, (int32_t)(p[4] << 8 | p[5]));
+        sum += (uint8_t)line[5];
+    }
+    return sum;
+}
+
+static uint32_t k_snprintf(void) {
+    char line[FMT_LINE + 1u];
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < FMT_LINES; ++i) {
+        const uint8_t *p = &s_data[i * FMT_LINE];
+        int32_t v = (int32_t)(p[0] | (p[1] << 8)) - 32768;
+        int32_t k = (int32_t)(p[4] << 8 | p[5]);
+        int n = snprintf(line, sizeof(line), "> %08lx %+8ld %7ld.%02ld\r\n",
+            (unsigned long)((uint32_t)p[2] << 24 | p[3]), (long)v, (long)(k / 100),
+            (long)(k % 100));
+        sum += (uint32_t)n + (uint8_t)line[5];
+    }
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+// Kernel Table
+//------------------------------------------------------------------------------
+// Frame kernels count payload bytes, so they compare with the CRC kernels;
+// formatter kernels count output bytes
+const bench_kernel_t bench_kernels[] = {
+    { "ringbuf_push_pop", BENCH_KERNEL_BYTES, NULL,               k_ringbuf      },
+    { "uart_write",       BENCH_KERNEL_BYTES, setup_uart,         k_uart_write   },
+    { "uart_read",        BENCH_KERNEL_BYTES, setup_uart_rx,      k_uart_read    },
+    { "uart_echo_pump",   BENCH_KERNEL_BYTES, setup_uart_rx,      k_uart_echo    },
+    { "crc16_ccitt",      BENCH_KERNEL_BYTES, NULL,               k_crc16        },
+    { "crc32",            BENCH_KERNEL_BYTES, NULL,               k_crc32        },
+    { "frame_encode",     BENCH_KERNEL_BYTES, NULL,               k_frame_encode },
+    { "frame_decode",     BENCH_KERNEL_BYTES, setup_frame_decode, k_frame_decode },
+    { "fmt_buf",          BENCH_KERNEL_BYTES, NULL,               k_fmt_buf      },
+    { "snprintf",         BENCH_KERNEL_BYTES, NULL,               k_snprintf     },
+};
+
+const size_t bench_kernel_count = sizeof(bench_kernels) / sizeof(bench_kernels[0]);
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+void bench_kernels_init(void) {
+    // Mostly non-zero, with zeros often enough to exercise COBS blocks
+    for (uint32_t i = 0; i < BENCH_KERNEL_BYTES; ++i) {
+        s_data[i] = (i % 61u == 0u) ? 0u : (uint8_t)(i * 13u + 7u);
+    }
+    s_frames_len = k_frame_encode();
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+#ifndef INCLUDE_BENCH_KERNELS_H_
+#define INCLUDE_BENCH_KERNELS_H_
+//------------------------------------------------------------------------------
+//
+// Benchmark kernels shared by the on-target firmware (DWT cycles) and the
+// host suite (nanoseconds), so both report the same cases under the same
+// names.
+//
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Bytes processed by one run of each kernel
+#define BENCH_KERNEL_BYTES  1024u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    const char *name;
+    // Bytes processed per run
+    uint32_t   bytes;
+    // Untimed preparation before each run (may be NULL)
+    void       (*setup)(void);
+    // Timed work; the result keeps the optimizer from dropping it
+    uint32_t   (*run)(void);
+} bench_kernel_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+extern const bench_kernel_t bench_kernels[];
+extern const size_t bench_kernel_count;
+
+//------------------------------------------------------------------------------
+// Function Declarations
+//------------------------------------------------------------------------------
+// Fill the shared input data; call once before running any kernel
+void bench_kernels_init(void);
+
+#endif // INCLUDE_BENCH_KERNELS_H_
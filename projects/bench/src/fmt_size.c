@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define the formatter code size probe. It is built three times: with no
+// formatter, with fmt_buf() (FMT_SIZE_FMT) and with snprintf()
+// (FMT_SIZE_SNPRINTF). Each build is linked with unused sections removed, so
+// the .text differences show what each formatter costs. The firmware build
+// links against newlib-nano, and the host build (benchmarks/) against the
+// host C library.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include "fmt_api.h"
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Input and output, so nothing is folded away
+volatile uint32_t g_fmt_size_io;
+
+//------------------------------------------------------------------------------
+int main(void) {
+    char line[64];
+    size_t n;
+    unsigned v = (unsigned)g_fmt_size_io * 1234u;
+#if defined(FMT_SIZE_SNPRINTF)
+    int m = snprintf(line, sizeof(line), "v=%u x=%08x %-6s %d\r\n",
+        v, v, "ok", -(int)v);
+    n = (m > 0) ? (size_t)m : 0u;
+#elif defined(FMT_SIZE_FMT)
+    n = fmt_buf(line, sizeof(line), "v=%u x=%08x %-6s %d\r\n",
+        v, v, "ok", -(int)v);
+#else
+    line[0] = (char)('0' + v % 10u);
+    n = 1u;
+#endif
+    g_fmt_size_io = (uint32_t)n + (uint8_t)line[0];
+    return 0;
+}
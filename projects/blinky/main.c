@@ -5,21 +5,92 @@
 //------------------------------------------------------------------------------
 
 #include "blinky.h"
+#include "dma_hw.h"
+#include "led_pwm_hw.h"
+#include "sched_api.h"
+#include "sched_hw.h"
+#include "timebase_hw.h"
+#include "timer_wheel.h"
 #include <stdint.h>
 
 //------------------------------------------------------------------------------
-void delay(void) {
-    // Simple delay ... TBI - replace with SysTick
-    for (volatile uint32_t i = 0; i < 300000; ++i) {
-        __asm__ volatile("nop");
+// Constants
+//------------------------------------------------------------------------------
+
+#define TICK_HZ          1000u
+#define MODE_PERIOD_MS   6000u
+
+// Longest the timer task sleeps with no timer due
+#define TIMER_MAX_SLEEP_TICKS  1000u
+
+// Task priorities (higher runs first)
+#define TASK_TIMERS  1u
+
+// Task events
+#define EV_TIMER_DUE  (1u << 0)
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static timer_wheel_t wheel;
+static tw_timer_t mode_timer;
+
+// Tick at which the timer task next has work, written by the task only
+static volatile uint32_t timer_next_due;
+
+//------------------------------------------------------------------------------
+static void on_mode(tw_timer_t *pt, void *pctx) {
+    (void)pt;
+    (void)pctx;
+    blinky_pwm_next_mode();
+}
+
+//------------------------------------------------------------------------------
+// Tick ISR hook: wake the timer task only on ticks where a timer is due
+static void on_tick(void *pctx, uint32_t tick) {
+    (void)pctx;
+    if ((int32_t)(tick - timer_next_due) >= 0) {
+        sched_post(TASK_TIMERS, EV_TIMER_DUE);
     }
 }
 
+//------------------------------------------------------------------------------
+static void timers_task(void *pctx, uint32_t events) {
+    (void)pctx;
+    (void)events;
+    uint32_t now = (uint32_t)timebase_ticks();
+    (void)timer_wheel_advance(&wheel, now);
+    timer_next_due = now + timer_wheel_next_delay(&wheel, TIMER_MAX_SLEEP_TICKS);
+}
+
 //------------------------------------------------------------------------------
 int main(void) {
-    blinky_init();
-    while (1) {
-        blinky_toggle();
-        delay();
-    }
-}
\ No newline at end of file
+    sched_hw_vtable_t sched_hw;
+    sched_hw_install(&sched_hw);
+    (void)sched_init(&sched_hw);
+    (void)sched_task_create(TASK_TIMERS, timers_task, NULL);
+
+    timebase_hw_vtable_t tb;
+    timebase_hw_install(&tb);
+    (void)timebase_init(&tb, TICK_HZ);
+
+    // Timers and DMA own the LED waveform, the core only changes modes; the
+    // backend takes its channel from the allocator
+    dma_hw_vtable_t dma_hw;
+    dma_hw_install(&dma_hw);
+    (void)dma_init(&dma_hw);
+    led_pwm_hw_vtable_t led_hw;
+    led_pwm_hw_install(&led_hw);
+    (void)blinky_pwm_start(&led_hw);
+
+    uint32_t period = timebase_ms_to_ticks(MODE_PERIOD_MS);
+    uint32_t now = (uint32_t)timebase_ticks();
+    timer_wheel_init(&wheel, now);
+    timer_wheel_start(&wheel, &mode_timer, period, period, on_mode, NULL);
+    timer_next_due = now + timer_wheel_next_delay(&wheel, TIMER_MAX_SLEEP_TICKS);
+    timebase_set_tick_hook(on_tick, NULL);
+
+    // Sleeps in WFI between due ticks
+    sched_run();
+}
@@ -6,20 +6,54 @@
 
 #include "blinky.h"
 #include "gpio_api.h"
+#include "led_pwm_api.h"
 
 //------------------------------------------------------------------------------
 // Constants
 //------------------------------------------------------------------------------
 
-#define LED_PIN 0
+static const gpio_config_t LED_CFG = {
+    .mode  = GPIO_MODE_OUTPUT,
+    .otype = GPIO_OTYPE_PUSH_PULL,
+    .speed = GPIO_SPEED_LOW,
+    .pull  = GPIO_PULL_NONE,
+};
 
 //------------------------------------------------------------------------------
 // Function Definitions
 //------------------------------------------------------------------------------
 void blinky_init(void) {
     gpio_init();
+    (void)gpio.configure(BLINKY_LED_PIN, &LED_CFG);
 }
 
 void blinky_toggle(void) {
-    gpio.toggle(LED_PIN);
-}
\ No newline at end of file
+    gpio.toggle(BLINKY_LED_PIN);
+}
+
+bool blinky_pwm_start(const led_pwm_hw_vtable_t *phw) {
+    if (!led_pwm_init(phw)) {
+        return false;
+    }
+    return led_pwm_blink(BLINKY_PWM_BLINK_PERIOD_MS, BLINKY_PWM_BLINK_ON_MS);
+}
+
+void blinky_pwm_next_mode(void) {
+    switch (led_pwm_mode()) {
+    case LED_PWM_BLINK:
+        if (led_pwm_breathe(BLINKY_PWM_BREATHE_PERIOD_MS)) {
+            return;
+        }
+        break;
+    case LED_PWM_BREATHE:
+        if (led_pwm_pattern(BLINKY_PWM_PATTERN_BITS, BLINKY_PWM_PATTERN_NBITS,
+                            BLINKY_PWM_PATTERN_STEP_MS)) {
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    // Blink needs no sequencer, so it is also the fallback
+    (void)led_pwm_blink(BLINKY_PWM_BLINK_PERIOD_MS, BLINKY_PWM_BLINK_ON_MS);
+}
@@ -7,7 +7,31 @@
 #ifndef INCLUDE_BLINKY_H_
 #define INCLUDE_BLINKY_H_
 
+#include "gpio_api.h"
+#include "led_pwm_api.h"
+#include <stdbool.h>
+
+// User LED LD1 (green) on NUCLEO-H563ZI: PB0
+#ifndef BLINKY_LED_PIN
+#define BLINKY_LED_PIN  GPIO_PIN(GPIO_PORT_B, 0)
+#endif
+
+// Hardware-timed LED modes
+#define BLINKY_PWM_BLINK_PERIOD_MS    500u
+#define BLINKY_PWM_BLINK_ON_MS        100u
+#define BLINKY_PWM_BREATHE_PERIOD_MS  3000u
+#define BLINKY_PWM_PATTERN_STEP_MS    150u
+
+// Short-short-long repeating every 16 steps
+#define BLINKY_PWM_PATTERN_BITS       0x0075u
+#define BLINKY_PWM_PATTERN_NBITS      16u
+
 void blinky_init(void);
 void blinky_toggle(void);
 
-#endif // INCLUDE_BLINKY_H_
\ No newline at end of file
+// Start the LED in blink mode on the given PWM backend
+bool blinky_pwm_start(const led_pwm_hw_vtable_t *phw);
+// Advance blink -> breathe -> pattern -> blink
+void blinky_pwm_next_mode(void);
+
+#endif // INCLUDE_BLINKY_H_
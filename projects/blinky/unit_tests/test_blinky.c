@@ -20,13 +20,8 @@
 
 #include "blinky.h"
 #include "gpio_api.h"
-
-//------------------------------------------------------------------------------
-// Function Declarations
-//------------------------------------------------------------------------------
-
-// From gpio_stub
-uint8_t gpio_get_pin(uint32_t pin);
+#include "gpio_stub.h"
+#include "led_pwm_stub.h"
 
 //------------------------------------------------------------------------------
 // Function Definitions
@@ -45,18 +40,111 @@ static int setup(void **state) {
 //------------------------------------------------------------------------------
 static void test_toggle(void **state) {
     (void)state;
-    gpio.write(0, 0);
-    assert_int_equal(0, gpio_get_pin(0));
+    gpio.write(BLINKY_LED_PIN, 0);
+    assert_int_equal(0, gpio_get_pin(BLINKY_LED_PIN));
     blinky_toggle();
-    assert_int_equal(1, gpio_get_pin(0));
+    assert_int_equal(1, gpio_get_pin(BLINKY_LED_PIN));
     blinky_toggle();
-    assert_int_equal(0, gpio_get_pin(0));
+    assert_int_equal(0, gpio_get_pin(BLINKY_LED_PIN));
+}
+
+//------------------------------------------------------------------------------
+static void test_led_configured_as_output(void **state) {
+    (void)state;
+    const gpio_config_t *pcfg = gpio_stub_config(BLINKY_LED_PIN);
+    assert_non_null(pcfg);
+    assert_int_equal(GPIO_MODE_OUTPUT, pcfg->mode);
+    assert_int_equal(GPIO_OTYPE_PUSH_PULL, pcfg->otype);
+    assert_null(gpio_stub_config(GPIO_PIN(GPIO_PORT_B, 1)));
+}
+
+//------------------------------------------------------------------------------
+static void test_pin_descriptors(void **state) {
+    (void)state;
+    gpio_pin_t pd8 = GPIO_PIN(GPIO_PORT_D, 8);
+    assert_int_equal(GPIO_PORT_D, GPIO_PIN_PORT(pd8));
+    assert_int_equal(8, GPIO_PIN_NUM(pd8));
+    assert_int_equal(0x100u, GPIO_PIN_MASK(pd8));
+
+    // Same pin number on different ports are different pins
+    gpio.write(GPIO_PIN(GPIO_PORT_A, 3), 1);
+    assert_int_equal(1, gpio_get_pin(GPIO_PIN(GPIO_PORT_A, 3)));
+    assert_int_equal(0, gpio_get_pin(GPIO_PIN(GPIO_PORT_I, 3)));
+
+    const gpio_config_t af = { .mode = GPIO_MODE_AF, .af = 7 };
+    assert_true(gpio.configure(pd8, &af));
+    assert_int_equal(7, gpio_stub_config(pd8)->af);
+    assert_false(gpio.configure(GPIO_PIN(GPIO_PORT_COUNT, 0), &af));
+    assert_false(gpio.configure(pd8, NULL));
+}
+
+//------------------------------------------------------------------------------
+static void test_mask_ops_leave_other_pins(void **state) {
+    (void)state;
+    gpio.write(GPIO_PIN(GPIO_PORT_C, 15), 1);
+    gpio.set_mask(GPIO_PORT_C, 0x000Fu);
+    assert_int_equal(0x800Fu, gpio_get_port(GPIO_PORT_C));
+    gpio.clear_mask(GPIO_PORT_C, 0x0005u);
+    assert_int_equal(0x800Au, gpio_get_port(GPIO_PORT_C));
+
+    // Parallel bus style write: pins 4..11 take the byte, others unchanged
+    gpio.write_mask(GPIO_PORT_C, 0x0FF0u, 0xA5u << 4);
+    assert_int_equal(0x8A5Au, gpio_get_port(GPIO_PORT_C));
+    gpio.write_mask(GPIO_PORT_C, 0x0FF0u, 0x3Cu << 4);
+    assert_int_equal(0x83CAu, gpio_get_port(GPIO_PORT_C));
+
+    // Bits in value outside the mask are ignored
+    gpio.write_mask(GPIO_PORT_C, 0x1u, 0xFFFFFFFEu);
+    assert_int_equal(0x83CAu, gpio_get_port(GPIO_PORT_C));
+
+    // Other ports, including the LED's, are untouched
+    assert_int_equal(0u, gpio_get_port(GPIO_PORT_B));
+}
+
+//------------------------------------------------------------------------------
+static void test_mask_ops_single_store(void **state) {
+    (void)state;
+    uint32_t before = gpio_stub_store_count();
+    gpio.write_mask(GPIO_PORT_E, 0xFFFFu, 0x1234u);
+    gpio.set_mask(GPIO_PORT_E, 0xC000u);
+    gpio.clear_mask(GPIO_PORT_E, 0x0F00u);
+    assert_int_equal(3, gpio_stub_store_count() - before);
+    assert_int_equal(0xD034u, gpio_get_port(GPIO_PORT_E));
+}
+
+//------------------------------------------------------------------------------
+static void test_pwm_mode_cycle(void **state) {
+    (void)state;
+    led_pwm_hw_vtable_t VTable;
+    led_pwm_stub_ctx_t ctx = { .sequencer = true };
+    led_pwm_stub_create(&VTable, &ctx);
+
+    assert_true(blinky_pwm_start(&VTable));
+    assert_int_equal(LED_PWM_BLINK, led_pwm_mode());
+    blinky_pwm_next_mode();
+    assert_int_equal(LED_PWM_BREATHE, led_pwm_mode());
+    blinky_pwm_next_mode();
+    assert_int_equal(LED_PWM_PATTERN, led_pwm_mode());
+    assert_int_equal(BLINKY_PWM_PATTERN_NBITS, ctx.steps);
+    blinky_pwm_next_mode();
+    assert_int_equal(LED_PWM_BLINK, led_pwm_mode());
+
+    // Without a sequencer the cycle stays on blink
+    ctx.sequencer = false;
+    blinky_pwm_next_mode();
+    assert_int_equal(LED_PWM_BLINK, led_pwm_mode());
+    assert_true(ctx.running);
 }
 
 //------------------------------------------------------------------------------
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup(test_toggle, setup),
+        cmocka_unit_test_setup(test_led_configured_as_output, setup),
+        cmocka_unit_test_setup(test_pin_descriptors, setup),
+        cmocka_unit_test_setup(test_mask_ops_leave_other_pins, setup),
+        cmocka_unit_test_setup(test_mask_ops_single_store, setup),
+        cmocka_unit_test(test_pwm_mode_cycle),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
\ No newline at end of file
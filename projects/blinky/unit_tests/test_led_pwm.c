@@ -0,0 +1,195 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define LED PWM unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+
+#include "led_pwm_api.h"
+#include "led_pwm_stub.h"
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static led_pwm_stub_ctx_t CTX;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+
+// Reusable Test Setup
+static int setup(void **state) {
+    (void)state;
+    led_pwm_hw_vtable_t VTable;
+    CTX = (led_pwm_stub_ctx_t){ .sequencer = true };
+    led_pwm_stub_create(&VTable, &CTX);
+    return led_pwm_init(&VTable) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+// Test Cases
+//------------------------------------------------------------------------------
+static void test_init_validation(void **state) {
+    (void)state;
+    led_pwm_hw_vtable_t VTable;
+    led_pwm_stub_create(&VTable, &CTX);
+
+    assert_false(led_pwm_init(NULL));
+    led_pwm_hw_vtable_t invalid = VTable;
+    invalid.hw_pwm = NULL;
+    assert_false(led_pwm_init(&invalid));
+
+    // Sequencer is optional
+    VTable.hw_sequence = NULL;
+    assert_true(led_pwm_init(&VTable));
+    assert_int_equal(LED_PWM_OFF, led_pwm_mode());
+    assert_false(CTX.running);
+}
+
+//------------------------------------------------------------------------------
+static void test_blink_timing(void **state) {
+    (void)state;
+    assert_true(led_pwm_blink(500, 100));
+    assert_int_equal(LED_PWM_BLINK, led_pwm_mode());
+    assert_null(CTX.pduty);
+
+    assert_true(led_pwm_stub_output(0));
+    assert_true(led_pwm_stub_output(99900));
+    assert_false(led_pwm_stub_output(100000));
+    assert_false(led_pwm_stub_output(499900));
+    assert_true(led_pwm_stub_output(500000));
+    assert_true(led_pwm_stub_output(10u * 500000u + 50000u));
+
+    // Long periods fall back to a coarser counter, still exact in ms
+    assert_true(led_pwm_blink(10000, 2500));
+    assert_true(led_pwm_stub_output(2499000));
+    assert_false(led_pwm_stub_output(2500000));
+    assert_true(led_pwm_stub_output(10000000));
+
+    assert_false(led_pwm_blink(100000, 1));
+    assert_false(led_pwm_blink(100, 101));
+    assert_false(led_pwm_blink(1, 1));
+    assert_int_equal(LED_PWM_OFF, led_pwm_mode());
+    assert_false(CTX.running);
+}
+
+//------------------------------------------------------------------------------
+static void test_breathe_table(void **state) {
+    (void)state;
+    assert_true(led_pwm_breathe(2048));
+    assert_int_equal(LED_PWM_BREATHE, led_pwm_mode());
+    assert_int_equal(LED_PWM_MAX_STEPS, CTX.steps);
+    assert_int_equal(2048000u / LED_PWM_MAX_STEPS, CTX.step_us);
+    assert_int_equal(LED_PWM_LEVELS, CTX.period);
+    assert_int_equal(LED_PWM_CARRIER_HZ * LED_PWM_LEVELS, CTX.counter_hz);
+
+    // Dark at both ends, fully on at the turning point, non-decreasing ramp
+    // mirrored about the middle
+    assert_int_equal(0, CTX.pduty[0]);
+    assert_int_equal(0, CTX.pduty[CTX.steps - 1u]);
+    assert_int_equal(LED_PWM_LEVELS, CTX.pduty[CTX.steps / 2u - 1u]);
+    for (size_t i = 1; i < CTX.steps / 2u; ++i) {
+        assert_true(CTX.pduty[i] >= CTX.pduty[i - 1u]);
+        assert_int_equal(CTX.pduty[i], CTX.pduty[CTX.steps - 1u - i]);
+    }
+
+    // Modelled output follows the table: a quarter in, it is on part-time
+    uint32_t on = 0;
+    for (uint64_t t = 512000u; t < 513000u; ++t) {
+        on += led_pwm_stub_output(t) ? 1u : 0u;
+    }
+    assert_true(on > 0u && on < 1000u);
+
+    assert_false(led_pwm_breathe(10));
+}
+
+//------------------------------------------------------------------------------
+static void test_pattern_steps(void **state) {
+    (void)state;
+    // Short-short-long: on, off, on, off, on, on, on, off
+    assert_true(led_pwm_pattern(0x75u, 8, 125));
+    assert_int_equal(LED_PWM_PATTERN, led_pwm_mode());
+    assert_int_equal(8, CTX.steps);
+    assert_int_equal(125000u, CTX.step_us);
+
+    static const bool expected[8] = { 1, 0, 1, 0, 1, 1, 1, 0 };
+    for (uint32_t loop = 0; loop < 2u; ++loop) {
+        for (uint32_t i = 0; i < 8u; ++i) {
+            uint64_t t = (uint64_t)(loop * 8u + i) * 125000u + 60000u;
+            assert_int_equal(expected[i], led_pwm_stub_output(t));
+        }
+    }
+
+    assert_false(led_pwm_pattern(1, 0, 100));
+    assert_false(led_pwm_pattern(1, 33, 100));
+    assert_false(led_pwm_pattern(1, 1, 0));
+    assert_int_equal(LED_PWM_OFF, led_pwm_mode());
+}
+
+//------------------------------------------------------------------------------
+static void test_steady_off_and_no_sequencer(void **state) {
+    (void)state;
+    assert_true(led_pwm_steady(LED_PWM_LEVELS));
+    assert_true(led_pwm_stub_output(123));
+    assert_true(led_pwm_steady(0));
+    assert_false(led_pwm_stub_output(123));
+    assert_false(led_pwm_steady(LED_PWM_LEVELS + 1u));
+
+    assert_true(led_pwm_pattern(1, 1, 10));
+    uint32_t stops = CTX.stops;
+    led_pwm_off();
+    assert_int_equal(stops + 1u, CTX.stops);
+    assert_int_equal(LED_PWM_OFF, led_pwm_mode());
+    assert_false(CTX.running);
+
+    // Without a sequencer, sequences fail cleanly and blink still works
+    CTX.sequencer = false;
+    assert_false(led_pwm_breathe(1000));
+    assert_false(CTX.running);
+    assert_true(led_pwm_blink(1000, 500));
+}
+
+//------------------------------------------------------------------------------
+static void test_stop_failure_reported(void **state) {
+    (void)state;
+    assert_true(led_pwm_breathe(1000));
+
+    // A sequencer that does not stop fails the stop and any new mode
+    CTX.wedged = true;
+    assert_false(led_pwm_off());
+    assert_int_equal(LED_PWM_OFF, led_pwm_mode());
+    assert_false(led_pwm_steady(LED_PWM_LEVELS));
+    assert_false(led_pwm_blink(1000, 500));
+    assert_int_equal(LED_PWM_OFF, led_pwm_mode());
+
+    CTX.wedged = false;
+    assert_true(led_pwm_off());
+    assert_true(led_pwm_blink(1000, 500));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_init_validation),
+        cmocka_unit_test_setup(test_blink_timing, setup),
+        cmocka_unit_test_setup(test_breathe_table, setup),
+        cmocka_unit_test_setup(test_pattern_steps, setup),
+        cmocka_unit_test_setup(test_steady_off_and_no_sequencer, setup),
+        cmocka_unit_test_setup(test_stop_failure_reported, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,274 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define scheduler unit tests
+//
+//------------------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 199309L
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <time.h>
+
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+
+#include "sched_api.h"
+#include "sched_stub.h"
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+
+static sched_stub_ctx_t CTX;
+
+// Dispatch log shared by the recording tasks
+typedef struct {
+    uint32_t prio[16];
+    uint32_t events[16];
+    size_t   count;
+} run_log_t;
+
+static run_log_t LOG;
+
+// Task context: own priority, plus an optional post issued while running
+typedef struct {
+    uint32_t prio;
+    uint32_t post_prio;
+    uint32_t post_events;
+    uint32_t work_cycles;
+} task_ctx_t;
+
+static void recording_task(void *pctx, uint32_t events) {
+    task_ctx_t *pt = (task_ctx_t*)pctx;
+    if (LOG.count < 16u) {
+        LOG.prio[LOG.count] = pt->prio;
+        LOG.events[LOG.count] = events;
+        LOG.count++;
+    }
+    // Simulated work on the virtual cycle counter
+    CTX.cycles += pt->work_cycles;
+    if (pt->post_events) {
+        sched_post(pt->post_prio, pt->post_events);
+        pt->post_events = 0u;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Reusable Test Setup
+static int setup(void **state) {
+    (void)state;
+    sched_hw_vtable_t VTable;
+    CTX = (sched_stub_ctx_t){0};
+    LOG = (run_log_t){0};
+    sched_stub_create(&VTable, &CTX);
+    return sched_init(&VTable) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+// Test Cases
+//------------------------------------------------------------------------------
+static void test_init_and_create_validation(void **state) {
+    (void)state;
+    sched_hw_vtable_t VTable;
+    sched_stub_create(&VTable, &CTX);
+    task_ctx_t t = {0};
+
+    assert_false(sched_init(NULL));
+    sched_hw_vtable_t invalid = VTable;
+    invalid.hw_idle = NULL;
+    assert_false(sched_init(&invalid));
+    assert_true(sched_init(&VTable));
+
+    assert_false(sched_task_create(SCHED_MAX_TASKS, recording_task, &t));
+    assert_false(sched_task_create(0, NULL, &t));
+    assert_true(sched_task_create(0, recording_task, &t));
+    assert_false(sched_task_create(0, recording_task, &t));
+    assert_true(sched_task_create(SCHED_MAX_TASKS - 1u, recording_task, &t));
+
+    // Nothing posted, nothing to run
+    assert_false(sched_dispatch());
+}
+
+//------------------------------------------------------------------------------
+static void test_highest_priority_first(void **state) {
+    (void)state;
+    task_ctx_t t0 = { .prio = 0 };
+    task_ctx_t t3 = { .prio = 3 };
+    task_ctx_t t31 = { .prio = 31 };
+    assert_true(sched_task_create(0, recording_task, &t0));
+    assert_true(sched_task_create(3, recording_task, &t3));
+    assert_true(sched_task_create(31, recording_task, &t31));
+
+    sched_post(3, 0x1u);
+    sched_post(0, 0x2u);
+    sched_post(31, 0x4u);
+    while (sched_dispatch()) {
+    }
+
+    assert_int_equal(3, LOG.count);
+    assert_int_equal(31, LOG.prio[0]);
+    assert_int_equal(3, LOG.prio[1]);
+    assert_int_equal(0, LOG.prio[2]);
+    assert_int_equal(0x4u, LOG.events[0]);
+    assert_false(CTX.irq_masked);
+}
+
+//------------------------------------------------------------------------------
+static void test_events_coalesce_and_ignore_invalid(void **state) {
+    (void)state;
+    task_ctx_t t5 = { .prio = 5 };
+    assert_true(sched_task_create(5, recording_task, &t5));
+
+    sched_post(5, 0x1u);
+    sched_post(5, 0x8u);
+    sched_post(5, 0x1u);
+    // No task, no events, out of range: all ignored
+    sched_post(6, 0x1u);
+    sched_post(5, 0u);
+    sched_post(SCHED_MAX_TASKS, 0x1u);
+
+    assert_true(sched_dispatch());
+    assert_false(sched_dispatch());
+    assert_int_equal(1, LOG.count);
+    assert_int_equal(0x9u, LOG.events[0]);
+}
+
+//------------------------------------------------------------------------------
+static void test_post_from_task(void **state) {
+    (void)state;
+    task_ctx_t lo = { .prio = 1, .post_prio = 7, .post_events = 0x2u };
+    task_ctx_t hi = { .prio = 7 };
+    task_ctx_t mid = { .prio = 4 };
+    assert_true(sched_task_create(1, recording_task, &lo));
+    assert_true(sched_task_create(7, recording_task, &hi));
+    assert_true(sched_task_create(4, recording_task, &mid));
+
+    // Low task readies the high one: it runs before the pending middle task
+    sched_post(1, 0x1u);
+    assert_true(sched_dispatch());
+    sched_post(4, 0x1u);
+    assert_true(sched_dispatch());
+    assert_true(sched_dispatch());
+    assert_false(sched_dispatch());
+
+    assert_int_equal(3, LOG.count);
+    assert_int_equal(1, LOG.prio[0]);
+    assert_int_equal(7, LOG.prio[1]);
+    assert_int_equal(4, LOG.prio[2]);
+}
+
+//------------------------------------------------------------------------------
+// Interrupt arriving during the sleep posts to the task
+static void post_on_idle(void *pctx) {
+    // Sleep must be entered with interrupts masked
+    assert_true(CTX.irq_masked);
+    CTX.cycles += 500u;
+    sched_post(*(uint32_t*)pctx, 0x1u);
+}
+
+static void test_idle_only_when_nothing_ready(void **state) {
+    (void)state;
+    uint32_t prio = 2;
+    task_ctx_t t2 = { .prio = 2 };
+    assert_true(sched_task_create(2, recording_task, &t2));
+    CTX.on_idle = post_on_idle;
+    CTX.on_idle_ctx = &prio;
+
+    sched_post(2, 0x1u);
+    sched_idle();
+    assert_int_equal(0, CTX.idle_calls);
+
+    assert_true(sched_dispatch());
+    sched_idle();
+    assert_int_equal(1, CTX.idle_calls);
+    assert_false(CTX.irq_masked);
+    assert_int_equal(500u, sched_idle_cycles());
+
+    // Woken by the interrupt's post
+    assert_true(sched_dispatch());
+    assert_int_equal(2, LOG.count);
+}
+
+//------------------------------------------------------------------------------
+static void test_run_time_accounting(void **state) {
+    (void)state;
+    task_ctx_t t9 = { .prio = 9 };
+    sched_task_stats_t stats;
+    CTX.cycles_step = 1u;
+    assert_true(sched_task_create(9, recording_task, &t9));
+    assert_false(sched_task_stats(8, &stats));
+
+    t9.work_cycles = 100u;
+    sched_post(9, 0x1u);
+    assert_true(sched_dispatch());
+    t9.work_cycles = 300u;
+    sched_post(9, 0x1u);
+    assert_true(sched_dispatch());
+
+    assert_true(sched_task_stats(9, &stats));
+    assert_int_equal(2, stats.runs);
+    // Each run: its work plus one counter step between the two reads
+    assert_int_equal(402u, stats.cycles);
+    assert_int_equal(301u, stats.cycles_max);
+
+    sched_stats_clear();
+    assert_true(sched_task_stats(9, &stats));
+    assert_int_equal(0, stats.runs);
+    assert_int_equal(0, stats.cycles);
+}
+
+//------------------------------------------------------------------------------
+static void noop_task(void *pctx, uint32_t events) {
+    (void)pctx;
+    (void)events;
+}
+
+// Host measurement of post + dispatch cost, reported rather than asserted
+static void test_dispatch_overhead(void **state) {
+    (void)state;
+    enum { N = 1000000 };
+    sched_task_stats_t stats;
+    CTX.use_host_clock = true;
+    assert_true(sched_task_create(0, noop_task, NULL));
+    assert_true(sched_task_create(17, noop_task, NULL));
+
+    struct timespec t0;
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < N; ++i) {
+        sched_post(17, 0x1u);
+        sched_post(0, 0x1u);
+        (void)sched_dispatch();
+        (void)sched_dispatch();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    assert_true(sched_task_stats(17, &stats));
+    assert_int_equal(N, stats.runs);
+    double total_ns = (double)(t1.tv_sec - t0.tv_sec) * 1e9 +
+        (double)(t1.tv_nsec - t0.tv_nsec);
+    print_message("sched: %.1f ns per post+dispatch (incl. accounting)\n",
+        total_ns / (2.0 * N));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_init_and_create_validation),
+        cmocka_unit_test_setup(test_highest_priority_first, setup),
+        cmocka_unit_test_setup(test_events_coalesce_and_ignore_invalid, setup),
+        cmocka_unit_test_setup(test_post_from_task, setup),
+        cmocka_unit_test_setup(test_idle_only_when_nothing_ready, setup),
+        cmocka_unit_test_setup(test_run_time_accounting, setup),
+        cmocka_unit_test_setup(test_dispatch_overhead, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
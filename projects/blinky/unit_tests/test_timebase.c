@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define timebase unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+
+#include "timebase_api.h"
+#include "timebase_stub.h"
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static timebase_stub_ctx_t CTX;
+
+//------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------
+
+// Reusable Test Setup: 64 MHz virtual core, 1 kHz tick
+static int setup(void **state) {
+    (void)state;
+    timebase_hw_vtable_t VTable;
+    CTX = (timebase_stub_ctx_t){ .cycle_hz = 64000000u };
+    timebase_stub_create(&VTable, &CTX);
+    return timebase_init(&VTable, 1000u) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+// Test Cases
+//------------------------------------------------------------------------------
+static void test_init_validation(void **state) {
+    (void)state;
+    timebase_hw_vtable_t VTable;
+    timebase_stub_create(&VTable, &CTX);
+
+    assert_false(timebase_init(NULL, 1000u));
+    assert_false(timebase_init(&VTable, 0u));
+    timebase_hw_vtable_t invalid = VTable;
+    invalid.hw_cycles = NULL;
+    assert_false(timebase_init(&invalid, 1000u));
+
+    assert_true(timebase_init(&VTable, 1000u));
+    assert_int_equal(1000u, CTX.tick_hz);
+    assert_int_equal(1000u, timebase_tick_hz());
+}
+
+//------------------------------------------------------------------------------
+static void test_ticks_monotonic(void **state) {
+    (void)state;
+    assert_int_equal(0, timebase_ticks());
+    timebase_stub_advance_ticks(1);
+    assert_int_equal(1, timebase_ticks());
+    timebase_stub_advance_ticks(2500);
+    assert_int_equal(2501, timebase_ticks());
+}
+
+//------------------------------------------------------------------------------
+static void test_ms_to_ticks_rounds_up(void **state) {
+    (void)state;
+    assert_int_equal(250, timebase_ms_to_ticks(250));
+    assert_int_equal(0, timebase_ms_to_ticks(0));
+
+    // At 100 Hz a 15 ms delay must not come back as one 10 ms tick
+    timebase_hw_vtable_t VTable;
+    timebase_stub_create(&VTable, &CTX);
+    assert_true(timebase_init(&VTable, 100u));
+    assert_int_equal(2, timebase_ms_to_ticks(15));
+}
+
+//------------------------------------------------------------------------------
+static void test_now_cycles(void **state) {
+    (void)state;
+    uint32_t t0 = timebase_now();
+    timebase_stub_advance_ticks(3);
+    uint32_t t1 = timebase_now();
+    // 3 ms of a 64 MHz clock
+    assert_int_equal(192000u, t1 - t0);
+    assert_int_equal(3000000u, timebase_cycles_to_ns(t1 - t0));
+    assert_int_equal(1000u, timebase_cycles_to_ns(64u));
+
+    // Interval arithmetic survives counter wrap
+    CTX.cycles = 0xFFFFFFC0u;
+    t0 = timebase_now();
+    CTX.cycles += 128u;
+    assert_int_equal(2000u, timebase_cycles_to_ns(timebase_now() - t0));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_init_validation),
+        cmocka_unit_test_setup(test_ticks_monotonic, setup),
+        cmocka_unit_test_setup(test_ms_to_ticks_rounds_up, setup),
+        cmocka_unit_test_setup(test_now_cycles, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
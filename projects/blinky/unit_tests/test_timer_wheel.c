@@ -0,0 +1,230 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define timer wheel unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+
+#include "timer_wheel.h"
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+
+// Expiry record for one timer
+typedef struct {
+    const timer_wheel_t *ptw;
+    uint32_t            fired;
+    uint32_t            last_tick;
+} expiry_t;
+
+static void on_expiry(tw_timer_t *pt, void *pctx) {
+    (void)pt;
+    expiry_t *pe = (expiry_t*)pctx;
+    pe->fired++;
+    pe->last_tick = pe->ptw->now;
+}
+
+//------------------------------------------------------------------------------
+// Advance one tick at a time, as the tick ISR would drive it
+static void run_to(timer_wheel_t *ptw, uint32_t tick) {
+    while (ptw->now != tick) {
+        (void)timer_wheel_advance(ptw, ptw->now + 1u);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_one_shot_exact(void **state) {
+    (void)state;
+    static timer_wheel_t tw;
+    tw_timer_t t = {0};
+    expiry_t e = { .ptw = &tw };
+
+    timer_wheel_init(&tw, 1000u);
+    timer_wheel_start(&tw, &t, 10u, 0u, on_expiry, &e);
+    assert_true(timer_wheel_pending(&t));
+
+    run_to(&tw, 1009u);
+    assert_int_equal(0, e.fired);
+    run_to(&tw, 1010u);
+    assert_int_equal(1, e.fired);
+    assert_int_equal(1010u, e.last_tick);
+    assert_false(timer_wheel_pending(&t));
+
+    run_to(&tw, 1200u);
+    assert_int_equal(1, e.fired);
+}
+
+//------------------------------------------------------------------------------
+static void test_periodic_no_drift(void **state) {
+    (void)state;
+    static timer_wheel_t tw;
+    tw_timer_t t = {0};
+    expiry_t e = { .ptw = &tw };
+
+    timer_wheel_init(&tw, 0u);
+    timer_wheel_start(&tw, &t, 250u, 250u, on_expiry, &e);
+
+    // Coarse advances (late main loop) still fire once per period, on time
+    (void)timer_wheel_advance(&tw, 999u);
+    assert_int_equal(3, e.fired);
+    assert_int_equal(750u, e.last_tick);
+    (void)timer_wheel_advance(&tw, 1000u);
+    assert_int_equal(4, e.fired);
+    assert_int_equal(1000u, e.last_tick);
+}
+
+//------------------------------------------------------------------------------
+static void test_periodic_zero_delay(void **state) {
+    (void)state;
+    static timer_wheel_t tw;
+    tw_timer_t t = {0};
+    expiry_t e = { .ptw = &tw };
+
+    timer_wheel_init(&tw, 500u);
+    timer_wheel_start(&tw, &t, 0u, 10u, on_expiry, &e);
+
+    // First expiry on the next tick, then a full period after it
+    run_to(&tw, 501u);
+    assert_int_equal(1, e.fired);
+    assert_int_equal(501u, e.last_tick);
+    run_to(&tw, 510u);
+    assert_int_equal(1, e.fired);
+    run_to(&tw, 511u);
+    assert_int_equal(2, e.fired);
+    assert_int_equal(511u, e.last_tick);
+}
+
+//------------------------------------------------------------------------------
+static void test_cancel_and_restart(void **state) {
+    (void)state;
+    static timer_wheel_t tw;
+    tw_timer_t t = {0};
+    expiry_t e = { .ptw = &tw };
+
+    timer_wheel_init(&tw, 0u);
+    timer_wheel_start(&tw, &t, 5u, 0u, on_expiry, &e);
+    timer_wheel_cancel(&tw, &t);
+    assert_false(timer_wheel_pending(&t));
+    // Cancel of a stopped timer is harmless
+    timer_wheel_cancel(&tw, &t);
+    run_to(&tw, 100u);
+    assert_int_equal(0, e.fired);
+    assert_int_equal(0, tw.pending);
+
+    // Restart while pending moves the expiry
+    timer_wheel_start(&tw, &t, 5u, 0u, on_expiry, &e);
+    timer_wheel_start(&tw, &t, 50u, 0u, on_expiry, &e);
+    assert_int_equal(1, tw.pending);
+    run_to(&tw, 150u);
+    assert_int_equal(1, e.fired);
+    assert_int_equal(150u, e.last_tick);
+
+    // Zero delay fires on the next advance, not a wheel turn later
+    timer_wheel_start(&tw, &t, 0u, 0u, on_expiry, &e);
+    (void)timer_wheel_advance(&tw, 151u);
+    assert_int_equal(2, e.fired);
+}
+
+//------------------------------------------------------------------------------
+static void test_far_timers_cascade_exact(void **state) {
+    (void)state;
+    static timer_wheel_t tw;
+    // One per level boundary, plus one beyond the wheel's reach
+    static const uint32_t delays[] = {
+        63u, 64u, 65u, 4095u, 4096u, 4097u, 262143u, 262144u, 300000u,
+        (1u << 24) - 1u, (1u << 24), (1u << 24) + 12345u,
+    };
+    enum { N = sizeof(delays) / sizeof(delays[0]) };
+    static tw_timer_t t[N];
+    static expiry_t e[N];
+    const uint32_t start = 0xFFFFF000u;  // wraps the 32-bit tick on the way
+
+    memset(t, 0, sizeof(t));
+    timer_wheel_init(&tw, start);
+    for (size_t i = 0; i < N; ++i) {
+        e[i] = (expiry_t){ .ptw = &tw };
+        timer_wheel_start(&tw, &t[i], delays[i], 0u, on_expiry, &e[i]);
+    }
+    run_to(&tw, start + (1u << 24) + 20000u);
+    for (size_t i = 0; i < N; ++i) {
+        assert_int_equal(1, e[i].fired);
+        assert_int_equal(start + delays[i], e[i].last_tick);
+    }
+    assert_int_equal(0, tw.pending);
+}
+
+//------------------------------------------------------------------------------
+static void test_thousands_of_timers(void **state) {
+    (void)state;
+    enum { N = 5000 };
+    static timer_wheel_t tw;
+    static tw_timer_t t[N];
+    static expiry_t e[N];
+    uint32_t seed = 12345u;
+
+    memset(t, 0, sizeof(t));
+    timer_wheel_init(&tw, 0u);
+    for (size_t i = 0; i < N; ++i) {
+        // Deterministic pseudo-random delays up to ~2^17 ticks
+        seed = seed * 1103515245u + 12345u;
+        e[i] = (expiry_t){ .ptw = &tw };
+        timer_wheel_start(&tw, &t[i], (seed >> 8) & 0x1FFFFu, 0u, on_expiry, &e[i]);
+    }
+    assert_int_equal(N, tw.pending);
+    run_to(&tw, 0x20000u);
+    for (size_t i = 0; i < N; ++i) {
+        assert_int_equal(1, e[i].fired);
+        assert_int_equal(t[i].expires, e[i].last_tick);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void test_next_delay(void **state) {
+    (void)state;
+    static timer_wheel_t tw;
+    tw_timer_t near = {0};
+    tw_timer_t far = {0};
+    expiry_t e = { .ptw = &tw };
+
+    timer_wheel_init(&tw, 10u);
+    assert_int_equal(1000u, timer_wheel_next_delay(&tw, 1000u));
+
+    timer_wheel_start(&tw, &far, 5000u, 0u, on_expiry, &e);
+    // Upper level only: wake at the next cascade, never after the expiry
+    assert_int_equal(54u, timer_wheel_next_delay(&tw, 1000u));
+
+    timer_wheel_start(&tw, &near, 7u, 0u, on_expiry, &e);
+    assert_int_equal(7u, timer_wheel_next_delay(&tw, 1000u));
+    assert_int_equal(3u, timer_wheel_next_delay(&tw, 3u));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_one_shot_exact),
+        cmocka_unit_test(test_periodic_no_drift),
+        cmocka_unit_test(test_periodic_zero_delay),
+        cmocka_unit_test(test_cancel_and_restart),
+        cmocka_unit_test(test_far_timers_cascade_exact),
+        cmocka_unit_test(test_thousands_of_timers),
+        cmocka_unit_test(test_next_delay),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "boot_api.h"
+#include "boot_hw.h"
+#include "flash_hw.h"
+#include "uart_api.h"
+#include "uart_core.h"
+#include "uart_hw.h"
+#include "timebase_api.h"
+#include "timebase_hw.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#ifndef BOOT_BAUD
+#define BOOT_BAUD      115200u
+#endif
+
+// How long a valid application waits for a host before it is started
+#ifndef BOOT_WAIT_MS
+#define BOOT_WAIT_MS   500u
+#endif
+
+// Room for a whole DATA frame while the main loop is busy programming
+#define BOOT_RX_SIZE   2048
+#define BOOT_TX_SIZE   64
+
+// Time for the last reply to leave the shift register
+#define BOOT_DRAIN_MS  2u
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(uart_boot, BOOT_RX_SIZE, BOOT_TX_SIZE);
+static boot_t boot;
+
+static const boot_layout_t layout = {
+    .app_base = BOOT_APP_BASE,
+    .app_max = BOOT_APP_MAX,
+    .record_addr = BOOT_RECORD_ADDR,
+};
+
+//------------------------------------------------------------------------------
+// Interrupt Service Routine
+//------------------------------------------------------------------------------
+// Keep receiving while the main loop waits on the flash
+void UART_HW_IRQHandler(void) {
+    (void)uart_poll_rx(uart_boot.pu);
+}
+
+//------------------------------------------------------------------------------
+static void delay_ms(uint32_t ms) {
+    uint64_t end = timebase_ticks() + timebase_ms_to_ticks(ms);
+    while (timebase_ticks() < end) {
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    timebase_hw_vtable_t tb_hw;
+    timebase_hw_install(&tb_hw);
+    (void)timebase_init(&tb_hw, 1000u);
+
+    uart_hw_vtable_t uart_hw;
+    uart_hw_install(&uart_hw);
+    (void)uart_init_instance(&uart_boot, &uart_hw, BOOT_BAUD);
+    uart_hw_enable_rx_irq();
+
+    flash_hw_vtable_t flash_hw;
+    flash_hw_install(&flash_hw);
+    (void)boot_init(&boot, uart_boot.pu, &flash_hw, &layout, BOOT_BUFFERS);
+
+    // Stay for an update if there is no valid application, or a host says
+    // hello within the wait
+    bool valid = boot_app_valid(&flash_hw, &layout);
+    uint64_t deadline = timebase_ticks() + timebase_ms_to_ticks(BOOT_WAIT_MS);
+    for (;;) {
+        if (boot_poll(&boot)) {
+            break;
+        }
+        uart_service_tx(uart_boot.pu);
+        if (valid && !boot_contacted(&boot) && timebase_ticks() >= deadline) {
+            break;
+        }
+    }
+
+    delay_ms(BOOT_DRAIN_MS);
+    boot_hw_jump(BOOT_APP_BASE);
+}
@@ -0,0 +1,447 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define bootloader tests: the host side of the protocol talks to the core
+// through the modeled USART3, and the core programs the modeled flash through
+// the STM32H5 backend, all on one virtual clock
+//
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "boot_api.h"
+#include "crc_api.h"
+#include "flash_hw.h"
+#include "uart_core.h"
+#include "uart_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define US            1000u
+#define MS            1000000u
+#define BAUD_SLOW     115200u
+#define BAUD_FAST     921600u
+// Longest any command may take: erasing 2 MB, or a block at the slow rate
+#define REPLY_TIMEOUT (600u * MS)
+#define IMAGE_MAX     (64u * 1024u)
+#define DATA_MAX      (BOOT_DATA_HDR_BYTES + BOOT_BLOCK_BYTES)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    frame_decoder_t dec;
+    uint8_t         dec_buf[FRAME_DECODE_BUF(BOOT_REPLY_BYTES)];
+    uint8_t         reply[BOOT_REPLY_BYTES];
+    bool            got;
+    // Bytes either way, for the line time
+    size_t          sent;
+    size_t          received;
+} host_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_uart, 2048, 64);
+static boot_t s_boot;
+static flash_hw_vtable_t s_flash;
+static host_t s_host;
+static uint64_t s_step_ns;
+static uint8_t s_image[IMAGE_MAX];
+static const boot_layout_t s_layout = {
+    BOOT_APP_BASE, BOOT_APP_MAX, BOOT_RECORD_ADDR
+};
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static inline void put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+//------------------------------------------------------------------------------
+static inline uint32_t get32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+        ((uint32_t)p[3] << 24);
+}
+
+//------------------------------------------------------------------------------
+static void on_reply(void *pctx, const uint8_t *ppayload, size_t len) {
+    host_t *ph = (host_t*)pctx;
+    assert_int_equal(BOOT_REPLY_BYTES, len);
+    memcpy(ph->reply, ppayload, len);
+    ph->got = true;
+}
+
+//------------------------------------------------------------------------------
+// A freshly reset target: erased flash, bootloader on USART3 at baud
+static void start(uint32_t baud, uint32_t buffers) {
+    uart_hw_vtable_t hw;
+    periph_sim_reset();
+    uart_hw_install(&hw);
+    assert_true(uart_init_instance(&s_uart, &hw, baud));
+    flash_hw_install(&s_flash);
+    assert_true(boot_init(&s_boot, s_uart.pu, &s_flash, &s_layout, buffers));
+
+    memset(&s_host, 0, sizeof(s_host));
+    frame_decoder_init(&s_host.dec, s_host.dec_buf, sizeof(s_host.dec_buf),
+        on_reply, &s_host);
+    // Several main loop passes per character
+    s_step_ns = periph_sim_usart_char_ns() / 5u;
+}
+
+//------------------------------------------------------------------------------
+// One pass of the bootloader's main loop (with the Rx interrupt's work), then
+// the host picks up what the line delivered
+static bool target_step(void) {
+    uint8_t buf[64];
+    size_t n;
+    (void)uart_poll_rx(s_uart.pu);
+    bool run = boot_poll(&s_boot);
+    uart_service_tx(s_uart.pu);
+    periph_sim_advance(s_step_ns);
+    while ((n = periph_sim_usart_tx_take(buf, sizeof(buf))) > 0u) {
+        s_host.received += n;
+        (void)frame_decoder_feed(&s_host.dec, buf, n);
+    }
+    return run;
+}
+
+//------------------------------------------------------------------------------
+static void host_send(const uint8_t *ppayload, size_t len) {
+    uint8_t frame[FRAME_ENCODED_MAX(DATA_MAX)];
+    size_t n = frame_encode(ppayload, len, frame, sizeof(frame));
+    assert_true(n > 0u);
+    periph_sim_usart_rx(frame, n, 0u);
+    s_host.sent += n;
+}
+
+//------------------------------------------------------------------------------
+// Send a command, run the target until its reply and return the status
+static uint8_t command(const uint8_t *ppayload, size_t len, uint32_t *pvalue) {
+    s_host.got = false;
+    host_send(ppayload, len);
+    uint64_t end = periph_sim_now() + REPLY_TIMEOUT;
+    while (!s_host.got && periph_sim_now() < end) {
+        (void)target_step();
+    }
+    assert_true(s_host.got);
+    assert_int_equal(ppayload[0] | BOOT_REPLY, s_host.reply[0]);
+    if (pvalue) {
+        *pvalue = get32(&s_host.reply[2]);
+    }
+    return s_host.reply[1];
+}
+
+//------------------------------------------------------------------------------
+static uint8_t cmd_simple(uint8_t cmd, uint32_t *pvalue) {
+    return command(&cmd, 1u, pvalue);
+}
+
+//------------------------------------------------------------------------------
+static uint8_t cmd_begin(uint32_t size, uint32_t crc) {
+    uint8_t p[9] = { BOOT_CMD_BEGIN };
+    put32(&p[1], size);
+    put32(&p[5], crc);
+    return command(p, sizeof(p), NULL);
+}
+
+//------------------------------------------------------------------------------
+static uint8_t cmd_data(uint32_t offset, size_t len, uint32_t *pnext) {
+    uint8_t p[DATA_MAX] = { BOOT_CMD_DATA };
+    put32(&p[1], offset);
+    memcpy(&p[BOOT_DATA_HDR_BYTES], &s_image[offset], len);
+    return command(p, BOOT_DATA_HDR_BYTES + len, pnext);
+}
+
+//------------------------------------------------------------------------------
+// Fill the image with a pattern and return its CRC-32
+static uint32_t make_image(uint32_t size, uint32_t seed) {
+    uint32_t x = seed;
+    for (uint32_t i = 0; i < size; ++i) {
+        x = x * 1103515245u + 12345u;
+        s_image[i] = (uint8_t)(x >> 16);
+    }
+    return crc32(s_image, size);
+}
+
+//------------------------------------------------------------------------------
+// All of the image in order; returns the time from the first DATA to the
+// last reply
+static uint64_t send_blocks(uint32_t size) {
+    uint64_t t0 = periph_sim_now();
+    for (uint32_t off = 0; off < size; off += BOOT_BLOCK_BYTES) {
+        uint32_t n = (size - off < BOOT_BLOCK_BYTES) ? size - off : BOOT_BLOCK_BYTES;
+        uint32_t next = 0;
+        assert_int_equal(BOOT_OK, cmd_data(off, n, &next));
+        assert_int_equal(off + n, next);
+    }
+    return periph_sim_now() - t0;
+}
+
+//------------------------------------------------------------------------------
+static void update(uint32_t size, uint32_t seed) {
+    uint32_t crc = make_image(size, seed);
+    uint32_t value = 0;
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_HELLO, &value));
+    assert_int_equal(BOOT_BLOCK_BYTES, value);
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    (void)send_blocks(size);
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, &value));
+    assert_int_equal(crc, value);
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_update_and_run(void **state) {
+    (void)state;
+    start(BAUD_SLOW, BOOT_BUFFERS);
+    assert_false(boot_app_valid(&s_flash, &s_layout));
+    assert_false(boot_contacted(&s_boot));
+
+    uint32_t size = 20004u;
+    update(size, 1u);
+    assert_true(boot_contacted(&s_boot));
+    assert_memory_equal(s_image, periph_sim_flash(BOOT_APP_BASE), size);
+    // The tail of the last quad-word is left erased
+    assert_int_equal(0xFFu, periph_sim_flash(BOOT_APP_BASE)[size]);
+    assert_true(boot_app_valid(&s_flash, &s_layout));
+    assert_int_equal(20u, s_boot.stats.blocks);
+    assert_int_equal(0u, s_boot.stats.dups);
+    assert_int_equal((size + FLASH_QWORD_BYTES - 1u) / FLASH_QWORD_BYTES,
+        s_boot.stats.qwords);
+    // Record sector plus three image sectors
+    assert_int_equal(4u, s_boot.stats.erases);
+    assert_int_equal(0u, s_boot.stats.flash_errors);
+
+    // Flash is locked again once done
+    assert_true(REG32(FLASH_REGS_BASE + FLASH_NSCR_OFFSET) & FLASH_CR_LOCK);
+
+    // RUN: the reply goes out in full before the application is started
+    uint32_t base = 0;
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_RUN, &base));
+    assert_int_equal(BOOT_APP_BASE, base);
+    bool run = false;
+    for (int i = 0; i < 100 && !run; ++i) {
+        run = target_step();
+    }
+    assert_true(run);
+}
+
+//------------------------------------------------------------------------------
+static void test_run_existing_app(void **state) {
+    (void)state;
+    start(BAUD_SLOW, BOOT_BUFFERS);
+    // Nothing to run yet
+    assert_int_equal(BOOT_ERR_STATE, cmd_simple(BOOT_CMD_RUN, NULL));
+
+    update(3000u, 2u);
+    // As after a reset: a new session finds the application valid
+    assert_true(boot_init(&s_boot, s_uart.pu, &s_flash, &s_layout, BOOT_BUFFERS));
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_RUN, NULL));
+}
+
+//------------------------------------------------------------------------------
+// With two buffers a block is programmed while the next one is on the line;
+// with one, the reply waits for the programming
+static void test_pipelining_hides_programming(void **state) {
+    (void)state;
+    uint32_t size = IMAGE_MAX;
+    uint32_t crc = make_image(size, 3u);
+    periph_sim_stats_t st0;
+    periph_sim_stats_t st1;
+
+    start(BAUD_FAST, 1u);
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    periph_sim_stats(&st0);
+    uint64_t t_single = send_blocks(size);
+    periph_sim_stats(&st1);
+    uint64_t prog_ns = st1.flash_busy_ns - st0.flash_busy_ns;
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, NULL));
+    assert_int_equal(size / BOOT_BLOCK_BYTES, s_boot.stats.held);
+
+    start(BAUD_FAST, 2u);
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    size_t line0 = s_host.sent + s_host.received;
+    uint64_t t_double = send_blocks(size);
+    uint64_t line_ns = (uint64_t)(s_host.sent + s_host.received - line0) *
+        periph_sim_usart_char_ns();
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, NULL));
+    assert_int_equal(0u, s_boot.stats.held);
+    assert_true(boot_app_valid(&s_flash, &s_layout));
+
+    print_message("      single %llu us, double %llu us, line %llu us, "
+        "programming %llu us\n", (unsigned long long)(t_single / US),
+        (unsigned long long)(t_double / US), (unsigned long long)(line_ns / US),
+        (unsigned long long)(prog_ns / US));
+    // Programming is hidden behind the line
+    assert_true(t_single - t_double >= prog_ns * 9u / 10u);
+    assert_true(t_double <= line_ns + line_ns / 50u);
+}
+
+//------------------------------------------------------------------------------
+static void test_bad_crc_rejected(void **state) {
+    (void)state;
+    start(BAUD_FAST, BOOT_BUFFERS);
+    uint32_t size = 5000u;
+    uint32_t crc = make_image(size, 4u);
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc ^ 1u));
+    (void)send_blocks(size);
+    assert_int_equal(BOOT_ERR_CRC, cmd_simple(BOOT_CMD_END, NULL));
+    assert_false(boot_app_valid(&s_flash, &s_layout));
+    assert_int_equal(BOOT_ERR_STATE, cmd_simple(BOOT_CMD_RUN, NULL));
+    // Starting over works
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    (void)send_blocks(size);
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, NULL));
+    assert_true(boot_app_valid(&s_flash, &s_layout));
+}
+
+//------------------------------------------------------------------------------
+static void test_interrupted_update_invalidates_app(void **state) {
+    (void)state;
+    start(BAUD_FAST, BOOT_BUFFERS);
+    update(8000u, 5u);
+    assert_true(boot_app_valid(&s_flash, &s_layout));
+
+    // A new image, cut off after two blocks
+    uint32_t crc = make_image(8000u, 6u);
+    assert_int_equal(BOOT_OK, cmd_begin(8000u, crc));
+    assert_false(boot_app_valid(&s_flash, &s_layout));
+    assert_int_equal(BOOT_OK, cmd_data(0u, BOOT_BLOCK_BYTES, NULL));
+    assert_int_equal(BOOT_OK, cmd_data(BOOT_BLOCK_BYTES, BOOT_BLOCK_BYTES, NULL));
+    assert_false(boot_app_valid(&s_flash, &s_layout));
+    assert_int_equal(BOOT_ERR_SIZE, cmd_simple(BOOT_CMD_END, NULL));
+}
+
+//------------------------------------------------------------------------------
+static void test_resent_and_out_of_order_blocks(void **state) {
+    (void)state;
+    start(BAUD_FAST, BOOT_BUFFERS);
+    uint32_t size = 4u * BOOT_BLOCK_BYTES;
+    uint32_t crc = make_image(size, 7u);
+    uint32_t next = 0;
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    assert_int_equal(BOOT_OK, cmd_data(0u, BOOT_BLOCK_BYTES, &next));
+
+    // Reply lost, block resent: acknowledged, not programmed again
+    assert_int_equal(BOOT_OK, cmd_data(0u, BOOT_BLOCK_BYTES, &next));
+    assert_int_equal(BOOT_BLOCK_BYTES, next);
+    assert_int_equal(1u, s_boot.stats.dups);
+    assert_int_equal(1u, s_boot.stats.blocks);
+
+    // A gap: the reply names the offset expected
+    assert_int_equal(BOOT_ERR_SEQ, cmd_data(3u * BOOT_BLOCK_BYTES, BOOT_BLOCK_BYTES,
+        &next));
+    assert_int_equal(BOOT_BLOCK_BYTES, next);
+
+    for (uint32_t off = BOOT_BLOCK_BYTES; off < size; off += BOOT_BLOCK_BYTES) {
+        assert_int_equal(BOOT_OK, cmd_data(off, BOOT_BLOCK_BYTES, NULL));
+    }
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, NULL));
+    // END again (reply lost): same answer
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, NULL));
+    assert_int_equal(0u, s_boot.stats.flash_errors);
+    assert_true(boot_app_valid(&s_flash, &s_layout));
+}
+
+//------------------------------------------------------------------------------
+static void test_rejects_bad_commands(void **state) {
+    (void)state;
+    start(BAUD_FAST, BOOT_BUFFERS);
+    uint32_t value = 0;
+    make_image(2u * BOOT_BLOCK_BYTES, 8u);
+
+    assert_int_equal(BOOT_ERR_STATE, cmd_data(0u, BOOT_BLOCK_BYTES, NULL));
+    assert_int_equal(BOOT_ERR_STATE, cmd_simple(BOOT_CMD_END, NULL));
+    assert_int_equal(BOOT_ERR_CMD, cmd_simple(0x33u, NULL));
+    uint8_t short_begin[3] = { BOOT_CMD_BEGIN, 1u, 2u };
+    assert_int_equal(BOOT_ERR_CMD, command(short_begin, sizeof(short_begin), NULL));
+
+    // Image size: zero, or more than fits
+    assert_int_equal(BOOT_ERR_SIZE, cmd_begin(0u, 0u));
+    uint8_t big[9] = { BOOT_CMD_BEGIN };
+    put32(&big[1], BOOT_APP_MAX + 1u);
+    assert_int_equal(BOOT_ERR_SIZE, command(big, sizeof(big), &value));
+    assert_int_equal(BOOT_APP_MAX, value);
+
+    // Blocks: only the last may end off a quad-word, none past the image
+    assert_int_equal(BOOT_OK, cmd_begin(2u * BOOT_BLOCK_BYTES, 0u));
+    assert_int_equal(BOOT_ERR_SIZE, cmd_data(0u, 100u, NULL));
+    assert_int_equal(BOOT_OK, cmd_data(0u, BOOT_BLOCK_BYTES, NULL));
+    assert_int_equal(BOOT_ERR_SIZE, cmd_simple(BOOT_CMD_END, NULL));
+    assert_int_equal(BOOT_OK, cmd_data(BOOT_BLOCK_BYTES, BOOT_BLOCK_BYTES - 16u, NULL));
+    assert_int_equal(BOOT_ERR_SIZE, cmd_data(2u * BOOT_BLOCK_BYTES - 16u, 32u, NULL));
+}
+
+//------------------------------------------------------------------------------
+static void test_flash_error_reported(void **state) {
+    (void)state;
+    start(BAUD_FAST, BOOT_BUFFERS);
+    uint32_t size = 8u * BOOT_BLOCK_BYTES;
+    uint32_t crc = make_image(size, 9u);
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    // A quad-word that did not erase
+    periph_sim_flash(BOOT_APP_BASE + 3u * BOOT_BLOCK_BYTES + 32u)[0] = 0u;
+
+    uint8_t status = BOOT_OK;
+    uint32_t off = 0;
+    for (; off < size && status == BOOT_OK; off += BOOT_BLOCK_BYTES) {
+        status = cmd_data(off, BOOT_BLOCK_BYTES, NULL);
+    }
+    assert_int_equal(BOOT_ERR_FLASH, status);
+    assert_int_equal(1u, s_boot.stats.flash_errors);
+    // Reported until the next BEGIN
+    assert_int_equal(BOOT_ERR_FLASH, cmd_simple(BOOT_CMD_END, NULL));
+    assert_false(boot_app_valid(&s_flash, &s_layout));
+    assert_int_equal(BOOT_OK, cmd_begin(size, crc));
+    (void)send_blocks(size);
+    assert_int_equal(BOOT_OK, cmd_simple(BOOT_CMD_END, NULL));
+    assert_true(boot_app_valid(&s_flash, &s_layout));
+}
+
+//------------------------------------------------------------------------------
+static void test_init_rejects_bad_arguments(void **state) {
+    (void)state;
+    start(BAUD_FAST, BOOT_BUFFERS);
+    boot_layout_t layout = s_layout;
+    assert_false(boot_init(&s_boot, s_uart.pu, &s_flash, &layout, 0u));
+    assert_false(boot_init(&s_boot, s_uart.pu, &s_flash, &layout, BOOT_BUFFERS + 1u));
+    layout.app_base += FLASH_QWORD_BYTES;
+    assert_false(boot_init(&s_boot, s_uart.pu, &s_flash, &layout, BOOT_BUFFERS));
+    assert_false(boot_init(&s_boot, NULL, &s_flash, &s_layout, BOOT_BUFFERS));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_update_and_run),
+        cmocka_unit_test(test_run_existing_app),
+        cmocka_unit_test(test_pipelining_hides_programming),
+        cmocka_unit_test(test_bad_crc_rejected),
+        cmocka_unit_test(test_interrupted_update_invalidates_app),
+        cmocka_unit_test(test_resent_and_out_of_order_blocks),
+        cmocka_unit_test(test_rejects_bad_commands),
+        cmocka_unit_test(test_flash_error_reported),
+        cmocka_unit_test(test_init_rejects_bad_arguments),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,210 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define STM32H5 flash backend tests on the register-level peripheral model
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "flash_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define US           1000u
+#define MS           1000000u
+#define FLASH(off)   REG32(FLASH_REGS_BASE + (off))
+// Sector 5 of bank 2
+#define BANK2_ADDR   (FLASH_MEM_BASE + FLASH_BANK_BYTES + 5u * FLASH_SECTOR_BYTES)
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static flash_hw_vtable_t s_flash;
+static const uint32_t s_qw[FLASH_QWORD_WORDS] = {
+    0x03020100u, 0x07060504u, 0x0B0A0908u, 0x0F0E0D0Cu
+};
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    periph_sim_reset();
+    flash_hw_install(&s_flash);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static int wait_done(void) {
+    int status;
+    while ((status = s_flash.hw_status()) == FLASH_BUSY) {
+        periph_sim_advance(10u * US);
+    }
+    return status;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_locked_until_unlocked(void **state) {
+    (void)state;
+    // Locked out of reset: nothing starts
+    assert_false(s_flash.hw_erase_start(FLASH_MEM_BASE));
+    assert_false(s_flash.hw_program_start(FLASH_MEM_BASE, s_qw));
+
+    // Keys out of order do not unlock
+    FLASH(FLASH_NSKEYR_OFFSET) = FLASH_KEY2;
+    FLASH(FLASH_NSKEYR_OFFSET) = FLASH_KEY2;
+    assert_true(FLASH(FLASH_NSCR_OFFSET) & FLASH_CR_LOCK);
+
+    assert_true(s_flash.hw_unlock());
+    assert_false(FLASH(FLASH_NSCR_OFFSET) & FLASH_CR_LOCK);
+    // Already unlocked: no second key sequence needed
+    assert_true(s_flash.hw_unlock());
+
+    s_flash.hw_lock();
+    assert_true(FLASH(FLASH_NSCR_OFFSET) & FLASH_CR_LOCK);
+    assert_false(s_flash.hw_program_start(FLASH_MEM_BASE, s_qw));
+}
+
+//------------------------------------------------------------------------------
+static void test_erase_sector(void **state) {
+    (void)state;
+    memset(periph_sim_flash(BANK2_ADDR - FLASH_SECTOR_BYTES), 0,
+        3u * FLASH_SECTOR_BYTES);
+    assert_true(s_flash.hw_unlock());
+    assert_true(s_flash.hw_erase_start(BANK2_ADDR + 100u));
+
+    // Bank and sector selected; busy for the erase time
+    uint32_t cr = FLASH(FLASH_NSCR_OFFSET);
+    assert_true(cr & FLASH_CR_BKSEL);
+    assert_int_equal(5u, (cr & FLASH_CR_SNB_MASK) >> FLASH_CR_SNB_SHIFT);
+    assert_int_equal(FLASH_BUSY, s_flash.hw_status());
+    assert_false(s_flash.hw_erase_start(BANK2_ADDR));
+    periph_sim_advance(1u * MS);
+    assert_int_equal(FLASH_BUSY, s_flash.hw_status());
+    periph_sim_advance(1u * MS);
+    assert_int_equal(FLASH_OK, s_flash.hw_status());
+    // EOP was cleared
+    assert_false(FLASH(FLASH_NSSR_OFFSET) & FLASH_SR_EOP);
+
+    // That sector only
+    const uint8_t *p = periph_sim_flash(BANK2_ADDR - FLASH_SECTOR_BYTES);
+    for (uint32_t i = 0; i < 3u * FLASH_SECTOR_BYTES; ++i) {
+        bool inside = i >= FLASH_SECTOR_BYTES && i < 2u * FLASH_SECTOR_BYTES;
+        assert_int_equal(inside ? 0xFFu : 0x00u, p[i]);
+    }
+
+    periph_sim_stats_t st;
+    periph_sim_stats(&st);
+    assert_int_equal(1u, st.flash_erases);
+}
+
+//------------------------------------------------------------------------------
+static void test_program_quadword(void **state) {
+    (void)state;
+    uint32_t addr = FLASH_MEM_BASE + 0x40u;
+    assert_true(s_flash.hw_unlock());
+    assert_true(s_flash.hw_program_start(addr, s_qw));
+    assert_int_equal(FLASH_BUSY, s_flash.hw_status());
+    // Busy: nothing else starts
+    assert_false(s_flash.hw_program_start(addr + FLASH_QWORD_BYTES, s_qw));
+
+    // A read waits for the operation, then sees the data
+    uint64_t t0 = periph_sim_now();
+    uint8_t got[FLASH_QWORD_BYTES];
+    s_flash.hw_read(addr, got, sizeof(got));
+    assert_memory_equal(s_qw, got, sizeof(got));
+    assert_true(periph_sim_now() - t0 >= 40u * US);
+    periph_sim_stats_t st;
+    periph_sim_stats(&st);
+    assert_true(st.flash_stall_ns > 0u);
+    assert_int_equal(1u, st.flash_programs);
+    assert_int_equal(FLASH_OK, s_flash.hw_status());
+
+    // Unaligned reads assemble the bytes
+    s_flash.hw_read(addr + 3u, got, 7u);
+    assert_memory_equal((const uint8_t*)s_qw + 3u, got, 7u);
+}
+
+//------------------------------------------------------------------------------
+static void test_program_twice_fails(void **state) {
+    (void)state;
+    uint32_t addr = FLASH_MEM_BASE + 0x80u;
+    assert_true(s_flash.hw_unlock());
+    assert_true(s_flash.hw_program_start(addr, s_qw));
+    assert_int_equal(FLASH_OK, wait_done());
+
+    // Not erased: rejected, reported once, contents kept
+    static const uint32_t zeros[FLASH_QWORD_WORDS];
+    assert_true(s_flash.hw_program_start(addr, zeros));
+    assert_int_equal(FLASH_ERROR, wait_done());
+    assert_int_equal(FLASH_OK, s_flash.hw_status());
+    assert_memory_equal(s_qw, periph_sim_flash(addr), FLASH_QWORD_BYTES);
+
+    // Erasing makes it programmable again
+    assert_true(s_flash.hw_erase_start(addr));
+    assert_int_equal(FLASH_OK, wait_done());
+    assert_true(s_flash.hw_program_start(addr, zeros));
+    assert_int_equal(FLASH_OK, wait_done());
+    assert_memory_equal(zeros, periph_sim_flash(addr), FLASH_QWORD_BYTES);
+}
+
+//------------------------------------------------------------------------------
+static void test_invalid_addresses(void **state) {
+    (void)state;
+    assert_true(s_flash.hw_unlock());
+    assert_false(s_flash.hw_program_start(FLASH_MEM_BASE + 8u, s_qw));
+    assert_false(s_flash.hw_program_start(FLASH_MEM_BASE - FLASH_QWORD_BYTES, s_qw));
+    assert_false(s_flash.hw_program_start(FLASH_MEM_BASE + FLASH_MEM_BYTES, s_qw));
+    assert_false(s_flash.hw_erase_start(FLASH_MEM_BASE + FLASH_MEM_BYTES));
+    // The last quad-word is fine
+    assert_true(s_flash.hw_program_start(
+        FLASH_MEM_BASE + FLASH_MEM_BYTES - FLASH_QWORD_BYTES, s_qw));
+    assert_int_equal(FLASH_OK, wait_done());
+}
+
+//------------------------------------------------------------------------------
+static void test_unfinished_quadword(void **state) {
+    (void)state;
+    assert_true(s_flash.hw_unlock());
+    // Half a quad-word, then another one: the first is discarded
+    FLASH(FLASH_NSCR_OFFSET) = FLASH_CR_PG;
+    FLASH_STORE32(FLASH_MEM_BASE, 0u);
+    FLASH_STORE32(FLASH_MEM_BASE + 4u, 0u);
+    assert_true(FLASH(FLASH_NSSR_OFFSET) & FLASH_SR_WBNE);
+    assert_int_equal(FLASH_BUSY, s_flash.hw_status());
+    for (uint32_t i = 0; i < FLASH_QWORD_WORDS; ++i) {
+        FLASH_STORE32(FLASH_MEM_BASE + FLASH_QWORD_BYTES + 4u * i, s_qw[i]);
+    }
+    assert_int_equal(FLASH_ERROR, wait_done());
+    assert_int_equal(0xFFu, periph_sim_flash(FLASH_MEM_BASE)[0]);
+    assert_memory_equal(s_qw, periph_sim_flash(FLASH_MEM_BASE + FLASH_QWORD_BYTES),
+        FLASH_QWORD_BYTES);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_locked_until_unlocked, setup),
+        cmocka_unit_test_setup(test_erase_sector, setup),
+        cmocka_unit_test_setup(test_program_quadword, setup),
+        cmocka_unit_test_setup(test_program_twice_fails, setup),
+        cmocka_unit_test_setup(test_invalid_addresses, setup),
+        cmocka_unit_test_setup(test_unfinished_quadword, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// SPI loopback demo: with MOSI jumpered to MISO, frames of a held header and
+// a payload circulate through the queue for good, each re-submitted from
+// its own completion callback. LD1 stays lit while every byte comes back as
+// sent.
+//
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+#include "spi_api.h"
+#include "spi_core.h"
+#include "spi_hw.h"
+#include "dma_api.h"
+#include "dma_hw.h"
+#include "gpio_hw.h"
+#include "platform_config.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define SPI_CLOCK_HZ   8000000u
+#define FRAMES         4u
+#define HEADER_BYTES   4u
+#define PAYLOAD_BYTES  256u
+
+// LD1 (green), lit while the loopback holds
+#define DEMO_LED_PIN   GPIO_PIN(GPIO_PORT_B, 0u)
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// A header keeps chip select asserted into its payload, so the two are
+// chained and run back to back
+typedef struct {
+    spi_xfer_t header;
+    spi_xfer_t payload;
+    uint8_t hdr_tx[HEADER_BYTES];
+    uint8_t hdr_rx[HEADER_BYTES];
+    uint8_t tx[PAYLOAD_BYTES];
+    uint8_t rx[PAYLOAD_BYTES];
+    uint32_t seq;
+} frame_t;
+
+//------------------------------------------------------------------------------
+// SPI Instance
+//------------------------------------------------------------------------------
+
+// Two transfers per frame in flight at most
+SPI_DEFINE_INSTANCE(spi_bus, 2u * FRAMES);
+
+static frame_t frames[FRAMES];
+static volatile uint32_t mismatches;
+
+//------------------------------------------------------------------------------
+// Helper to fill a frame with its next sequence number and pattern
+static void frame_fill(frame_t *pf) {
+    pf->seq += FRAMES;
+    memcpy(pf->hdr_tx, &pf->seq, HEADER_BYTES);
+    for (size_t i = 0; i < PAYLOAD_BYTES; i++) {
+        pf->tx[i] = (uint8_t)(pf->seq + i);
+    }
+}
+
+//------------------------------------------------------------------------------
+static bool frame_submit(frame_t *pf) {
+    return spi_submit(spi_bus.ps, &pf->header) &&
+        spi_submit(spi_bus.ps, &pf->payload);
+}
+
+//------------------------------------------------------------------------------
+// Context: Rx DMA channel ISR, via spi_isr()
+static void on_payload(void *pctx, spi_xfer_t *px) {
+    frame_t *pf = pctx;
+    if (px->status != SPI_XFER_DONE ||
+            memcmp(pf->hdr_rx, pf->hdr_tx, HEADER_BYTES) != 0 ||
+            memcmp(pf->rx, pf->tx, PAYLOAD_BYTES) != 0) {
+        mismatches++;
+        gpio_hw_write(DEMO_LED_PIN, 0u);
+    }
+    frame_fill(pf);
+    // Its header was retired first, so both descriptors are free again
+    (void)frame_submit(pf);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    static const gpio_config_t led_cfg = {
+        .mode  = GPIO_MODE_OUTPUT,
+        .otype = GPIO_OTYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_LOW,
+        .pull  = GPIO_PULL_NONE,
+        .af    = 0u,
+    };
+
+    // The SPI backend takes its channels from the allocator
+    dma_hw_vtable_t dma_hw;
+    dma_hw_install(&dma_hw);
+    spi_hw_vtable_t spi_hw;
+    spi_hw_install(&spi_hw);
+    if (!dma_init(&dma_hw) ||
+            !spi_init_instance(&spi_bus, &spi_hw, SPI_CLOCK_HZ, SPI_MODE_0)) {
+        while (1) {
+        }
+    }
+    (void)gpio_hw_configure(DEMO_LED_PIN, &led_cfg);
+    gpio_hw_write(DEMO_LED_PIN, 1u);
+
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        frame_t *pf = &frames[i];
+        pf->seq = i - FRAMES;
+        frame_fill(pf);
+        pf->header = (spi_xfer_t){
+            .ptx = pf->hdr_tx, .prx = pf->hdr_rx, .len = HEADER_BYTES,
+            .flags = SPI_XFER_CS_HOLD,
+        };
+        pf->payload = (spi_xfer_t){
+            .ptx = pf->tx, .prx = pf->rx, .len = PAYLOAD_BYTES,
+            .done = on_payload, .pctx = pf,
+        };
+    }
+
+    // From here on the frames keep themselves going
+    spi_hw_enable_irq(spi_bus.ps);
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        (void)frame_submit(&frames[i]);
+    }
+    while (1) {
+        __asm volatile ("wfi");
+    }
+}
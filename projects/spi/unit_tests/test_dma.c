@@ -0,0 +1,461 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define DMA allocator tests on the STM32H5 backend and the register-level
+// peripheral model
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "dma_api.h"
+#include "dma_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define MAX_EVENTS  32u
+// Peripheral registers with no model behind them hold what is written
+#define TIM3_CCR3   (TIM3_BASE + TIM_CCR_OFFSET(3u))
+#define SPI1_RXDR   (SPI1_BASE + SPI_RXDR_OFFSET)
+#define NVIC_BIT(ch) (1u << ((GPDMA1_CH0_IRQN + (ch)) % 32u))
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t ch;
+    uint32_t block;
+    uint32_t events;
+} event_t;
+
+typedef struct {
+    event_t ev[MAX_EVENTS];
+    size_t count;
+    // Reload and restart from the callback on this block (UINT32_MAX: never)
+    uint32_t restart_on;
+    const dma_block_t *prestart;
+    size_t restart_n;
+} recorder_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+static dma_hw_vtable_t s_hw;
+static recorder_t s_rec;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static void on_event(void *pctx, uint32_t ch, uint32_t block, uint32_t events) {
+    recorder_t *pr = pctx;
+    if (pr->count < MAX_EVENTS) {
+        pr->ev[pr->count++] = (event_t){ ch, block, events };
+    }
+    if (block == pr->restart_on) {
+        pr->restart_on = UINT32_MAX;
+        dma_stop(ch);
+        assert_true(dma_load(ch, pr->prestart, pr->restart_n, false));
+        assert_true(dma_start(ch));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Run the channel's interrupt while the model holds it pending
+static void service(uint32_t ch) {
+    while (periph_sim_dma_irq(ch)) {
+        dma_isr(ch);
+    }
+}
+
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    periph_sim_reset();
+    memset(&s_rec, 0, sizeof(s_rec));
+    s_rec.restart_on = UINT32_MAX;
+    dma_hw_install(&s_hw);
+    return dma_init(&s_hw) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+static dma_config_t m2m_config(void) {
+    return (dma_config_t){
+        .request = DMA_REQ_NONE, .dir = DMA_DIR_MEM_TO_MEM,
+        .width = DMA_WIDTH_32, .on_event = on_event, .pctx = &s_rec,
+    };
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_init_rejects_partial_vtable(void **state) {
+    (void)state;
+    dma_hw_vtable_t partial = s_hw;
+    partial.hw_position = NULL;
+    assert_false(dma_init(&partial));
+    assert_false(dma_init(NULL));
+    // The backend installed before stays in place
+    uint32_t ch;
+    dma_config_t cfg = m2m_config();
+    assert_true(dma_alloc(&cfg, &ch));
+}
+
+//------------------------------------------------------------------------------
+static void test_alloc_until_exhausted(void **state) {
+    (void)state;
+    dma_config_t cfg = m2m_config();
+    uint32_t ch;
+    assert_int_equal(DMA_MAX_CHANNELS, dma_channels_free());
+    for (uint32_t i = 0; i < DMA_MAX_CHANNELS; i++) {
+        assert_true(dma_alloc(&cfg, &ch));
+        assert_int_equal(i, ch);
+        // A callback enables the channel's interrupt line
+        assert_true(REG32(NVIC_ISER_ADDR + 4u * ((GPDMA1_CH0_IRQN + ch) / 32u)) &
+            NVIC_BIT(ch));
+    }
+    assert_int_equal(0u, dma_channels_free());
+    assert_false(dma_alloc(&cfg, &ch));
+
+    // A freed channel is the next one handed out
+    dma_free(3u);
+    assert_int_equal(1u, dma_channels_free());
+    assert_true(dma_alloc(&cfg, &ch));
+    assert_int_equal(3u, ch);
+}
+
+//------------------------------------------------------------------------------
+static void test_invalid_config_and_blocks(void **state) {
+    (void)state;
+    static uint32_t src[4];
+    static uint32_t dst[4];
+    uint32_t ch;
+
+    dma_config_t cfg = m2m_config();
+    cfg.request = GPDMA1_REQ_TIM6_UP;
+    assert_false(dma_alloc(&cfg, &ch));
+    cfg = (dma_config_t){ .request = GPDMA1_REQ_TIM6_UP, .dir = DMA_DIR_MEM_TO_PERIPH };
+    assert_false(dma_alloc(&cfg, &ch));
+    cfg.pperiph = (volatile void *)(uintptr_t)TIM3_CCR3;
+    cfg.width = (dma_width_t)3;
+    assert_false(dma_alloc(&cfg, &ch));
+    assert_int_equal(DMA_MAX_CHANNELS, dma_channels_free());
+
+    cfg = m2m_config();
+    assert_true(dma_alloc(&cfg, &ch));
+    dma_block_t b = { .psrc = src, .pdst = dst, .len = sizeof(src) };
+    dma_block_t odd = { .psrc = src, .pdst = dst, .len = 6u };
+    dma_block_t nodst = { .psrc = src, .len = sizeof(src) };
+    dma_block_t empty = { .psrc = src, .pdst = dst, .len = 0u };
+    dma_block_t many[DMA_CHAIN_MAX + 1u];
+    for (size_t i = 0; i < DMA_CHAIN_MAX + 1u; i++) {
+        many[i] = b;
+    }
+    assert_false(dma_load(ch, &odd, 1u, false));
+    assert_false(dma_load(ch, &nodst, 1u, false));
+    assert_false(dma_load(ch, &empty, 1u, false));
+    assert_false(dma_load(ch, many, 0u, false));
+    assert_false(dma_load(ch, many, DMA_CHAIN_MAX + 1u, false));
+    // Nothing loaded yet
+    assert_false(dma_start(ch));
+    assert_false(dma_load(ch + 1u, &b, 1u, false));
+    assert_true(dma_load(ch, many, DMA_CHAIN_MAX, false));
+}
+
+//------------------------------------------------------------------------------
+static void test_mem_to_mem_chain(void **state) {
+    (void)state;
+    static uint32_t src[3][8];
+    static uint32_t dst[3][8];
+    for (uint32_t i = 0; i < 24u; i++) {
+        src[i / 8u][i % 8u] = 0xA5000000u + i;
+    }
+    dma_config_t cfg = m2m_config();
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t blocks[3] = {
+        { .psrc = src[0], .pdst = dst[0], .len = sizeof(src[0]), .flags = DMA_BLOCK_NOTIFY },
+        { .psrc = src[1], .pdst = dst[1], .len = sizeof(src[1]) },
+        { .psrc = src[2], .pdst = dst[2], .len = sizeof(src[2]) },
+    };
+    assert_true(dma_load(ch, blocks, 3u, false));
+    assert_true(dma_start(ch));
+    assert_false(dma_start(ch));
+    assert_false(dma_load(ch, blocks, 3u, false));
+
+    service(ch);
+    assert_memory_equal(src, dst, sizeof(src));
+    // The notifying block, then the last one with the end of the chain
+    assert_int_equal(2u, s_rec.count);
+    assert_int_equal(0u, s_rec.ev[0].block);
+    assert_int_equal(DMA_EV_BLOCK, s_rec.ev[0].events);
+    assert_int_equal(2u, s_rec.ev[1].block);
+    assert_int_equal(DMA_EV_BLOCK | DMA_EV_END, s_rec.ev[1].events);
+
+    uint32_t block;
+    uint32_t remaining;
+    assert_false(dma_position(ch, &block, &remaining));
+    periph_sim_stats_t stats;
+    periph_sim_stats(&stats);
+    assert_int_equal(24u, stats.dma_beats);
+    assert_int_equal(3u, stats.dma_links);
+
+    // The chain stays loaded for the next start
+    memset(dst, 0, sizeof(dst));
+    assert_true(dma_start(ch));
+    service(ch);
+    assert_memory_equal(src, dst, sizeof(src));
+    assert_int_equal(4u, s_rec.count);
+}
+
+//------------------------------------------------------------------------------
+static void test_fixed_source_fills(void **state) {
+    (void)state;
+    static const uint8_t pattern = 0x5Au;
+    static uint8_t dst[64];
+    dma_config_t cfg = m2m_config();
+    cfg.width = DMA_WIDTH_8;
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t fill = {
+        .psrc = &pattern, .pdst = dst, .len = sizeof(dst), .flags = DMA_BLOCK_FIXED,
+    };
+    assert_true(dma_load(ch, &fill, 1u, false));
+    assert_true(dma_start(ch));
+    service(ch);
+    for (size_t i = 0; i < sizeof(dst); i++) {
+        assert_int_equal(0x5Au, dst[i]);
+    }
+    assert_int_equal(1u, s_rec.count);
+    assert_int_equal(DMA_EV_BLOCK | DMA_EV_END, s_rec.ev[0].events);
+}
+
+//------------------------------------------------------------------------------
+static void test_ring_paced_by_requests(void **state) {
+    (void)state;
+    static const uint16_t table[2][4] = { { 10, 20, 30, 40 }, { 50, 60, 70, 80 } };
+    dma_config_t cfg = {
+        .request = GPDMA1_REQ_TIM6_UP, .dir = DMA_DIR_MEM_TO_PERIPH,
+        .width = DMA_WIDTH_16, .pperiph = (volatile void *)(uintptr_t)TIM3_CCR3,
+        .on_event = on_event, .pctx = &s_rec,
+    };
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t blocks[2] = {
+        { .psrc = table[0], .len = sizeof(table[0]), .flags = DMA_BLOCK_NOTIFY },
+        { .psrc = table[1], .len = sizeof(table[1]), .flags = DMA_BLOCK_NOTIFY },
+    };
+    assert_true(dma_load(ch, blocks, 2u, true));
+    assert_true(dma_start(ch));
+
+    // Nothing moves without a request
+    uint32_t block;
+    uint32_t remaining;
+    assert_true(dma_position(ch, &block, &remaining));
+    assert_int_equal(0u, block);
+    assert_int_equal(sizeof(table[0]), remaining);
+
+    assert_int_equal(3u, periph_sim_dma_request(GPDMA1_REQ_TIM6_UP, 3u));
+    assert_int_equal(30u, REG32(TIM3_CCR3));
+    assert_true(dma_position(ch, &block, &remaining));
+    assert_int_equal(0u, block);
+    assert_int_equal(2u, remaining);
+    assert_false(periph_sim_dma_irq(ch));
+
+    // Three laps, serviced once a block
+    for (uint32_t i = 0; i < 6u; i++) {
+        uint32_t beats = i ? 4u : 1u;
+        assert_int_equal(beats, periph_sim_dma_request(GPDMA1_REQ_TIM6_UP, beats));
+        assert_int_equal(table[i % 2u][3], REG32(TIM3_CCR3));
+        service(ch);
+        assert_int_equal(i + 1u, s_rec.count);
+        assert_int_equal(i % 2u, s_rec.ev[i].block);
+        assert_int_equal(DMA_EV_BLOCK, s_rec.ev[i].events);
+    }
+
+    // A different request line moves nothing; a stopped ring neither
+    assert_int_equal(0u, periph_sim_dma_request(GPDMA1_REQ_SPI1_RX, 4u));
+    dma_stop(ch);
+    assert_false(dma_position(ch, &block, &remaining));
+    assert_int_equal(0u, periph_sim_dma_request(GPDMA1_REQ_TIM6_UP, 4u));
+    assert_int_equal(6u, s_rec.count);
+}
+
+//------------------------------------------------------------------------------
+static void test_single_block_rx_ring(void **state) {
+    (void)state;
+    static uint8_t rx[4];
+    dma_config_t cfg = {
+        .request = GPDMA1_REQ_SPI1_RX, .dir = DMA_DIR_PERIPH_TO_MEM,
+        .width = DMA_WIDTH_8, .pperiph = (volatile void *)(uintptr_t)SPI1_RXDR,
+        .on_event = on_event, .pctx = &s_rec,
+    };
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t ring = { .pdst = rx, .len = sizeof(rx), .flags = DMA_BLOCK_NOTIFY };
+    assert_true(dma_load(ch, &ring, 1u, true));
+    assert_true(dma_start(ch));
+
+    // Every lap reports the block
+    for (uint32_t lap = 0; lap < 3u; lap++) {
+        for (uint32_t i = 0; i < sizeof(rx); i++) {
+            REG32(SPI1_RXDR) = 0x10u * lap + i;
+            assert_int_equal(1u, periph_sim_dma_request(GPDMA1_REQ_SPI1_RX, 1u));
+        }
+        assert_int_equal(0x10u * lap + 3u, rx[3]);
+        service(ch);
+        assert_int_equal(lap + 1u, s_rec.count);
+        assert_int_equal(0u, s_rec.ev[lap].block);
+    }
+    uint32_t block;
+    uint32_t remaining;
+    REG32(SPI1_RXDR) = 0xEEu;
+    assert_int_equal(1u, periph_sim_dma_request(GPDMA1_REQ_SPI1_RX, 1u));
+    assert_true(dma_position(ch, &block, &remaining));
+    assert_int_equal(0u, block);
+    assert_int_equal(sizeof(rx) - 1u, remaining);
+    assert_int_equal(0xEEu, rx[0]);
+}
+
+//------------------------------------------------------------------------------
+static void test_transfer_error_stops(void **state) {
+    (void)state;
+    static const uint16_t table[4] = { 1, 2, 3, 4 };
+    dma_config_t cfg = {
+        .request = GPDMA1_REQ_TIM6_UP, .dir = DMA_DIR_MEM_TO_PERIPH,
+        .width = DMA_WIDTH_16, .pperiph = (volatile void *)(uintptr_t)TIM3_CCR3,
+        .on_event = on_event, .pctx = &s_rec,
+    };
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t b = { .psrc = table, .len = sizeof(table) };
+    assert_true(dma_load(ch, &b, 1u, true));
+    assert_true(dma_start(ch));
+
+    assert_int_equal(1u, periph_sim_dma_request(GPDMA1_REQ_TIM6_UP, 1u));
+    periph_sim_dma_fault(ch);
+    assert_int_equal(0u, periph_sim_dma_request(GPDMA1_REQ_TIM6_UP, 1u));
+    service(ch);
+    assert_int_equal(1u, s_rec.count);
+    assert_int_equal(0u, s_rec.ev[0].block);
+    assert_int_equal(DMA_EV_ERROR, s_rec.ev[0].events);
+    uint32_t block;
+    uint32_t remaining;
+    assert_false(dma_position(ch, &block, &remaining));
+
+    // Starts again from the first block
+    assert_true(dma_start(ch));
+    assert_int_equal(2u, periph_sim_dma_request(GPDMA1_REQ_TIM6_UP, 2u));
+    assert_int_equal(2u, REG32(TIM3_CCR3));
+}
+
+//------------------------------------------------------------------------------
+static void test_wedged_channel_stop_fails(void **state) {
+    (void)state;
+    static const uint16_t table[4] = { 1, 2, 3, 4 };
+    dma_config_t cfg = {
+        .request = GPDMA1_REQ_TIM6_UP, .dir = DMA_DIR_MEM_TO_PERIPH,
+        .width = DMA_WIDTH_16, .pperiph = (volatile void *)(uintptr_t)TIM3_CCR3,
+    };
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t b = { .psrc = table, .len = sizeof(table) };
+    assert_true(dma_load(ch, &b, 1u, true));
+    assert_true(dma_start(ch));
+
+    // The suspend never completes: the stop gives up and reports it
+    periph_sim_dma_wedge(ch, true);
+    assert_false(dma_stop(ch));
+    uint32_t block;
+    uint32_t remaining;
+    assert_true(dma_position(ch, &block, &remaining));
+    assert_false(dma_load(ch, &b, 1u, true));
+
+    periph_sim_dma_wedge(ch, false);
+    assert_true(dma_stop(ch));
+    assert_false(dma_position(ch, &block, &remaining));
+}
+
+//------------------------------------------------------------------------------
+static void test_restart_from_callback(void **state) {
+    (void)state;
+    static uint32_t src[2][4] = { { 1, 2, 3, 4 }, { 5, 6, 7, 8 } };
+    static uint32_t dst[2][4];
+    static uint32_t again[4];
+    dma_config_t cfg = m2m_config();
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    const dma_block_t first[2] = {
+        { .psrc = src[0], .pdst = dst[0], .len = sizeof(src[0]), .flags = DMA_BLOCK_NOTIFY },
+        { .psrc = src[1], .pdst = dst[1], .len = sizeof(src[1]), .flags = DMA_BLOCK_NOTIFY },
+    };
+    const dma_block_t second = { .psrc = src[1], .pdst = again, .len = sizeof(again) };
+    s_rec.restart_on = 0u;
+    s_rec.prestart = &second;
+    s_rec.restart_n = 1u;
+
+    assert_true(dma_load(ch, first, 2u, false));
+    assert_true(dma_start(ch));
+    service(ch);
+    // The first chain's later blocks go unreported once it is replaced
+    assert_int_equal(2u, s_rec.count);
+    assert_int_equal(0u, s_rec.ev[0].block);
+    assert_int_equal(DMA_EV_BLOCK, s_rec.ev[0].events);
+    assert_int_equal(0u, s_rec.ev[1].block);
+    assert_int_equal(DMA_EV_BLOCK | DMA_EV_END, s_rec.ev[1].events);
+    assert_memory_equal(src[1], again, sizeof(again));
+}
+
+//------------------------------------------------------------------------------
+static void test_raw_channel(void **state) {
+    (void)state;
+    static uint32_t src[2];
+    dma_config_t cfg = { .raw = true, .on_event = on_event, .pctx = &s_rec };
+    uint32_t ch;
+    assert_true(dma_alloc(&cfg, &ch));
+    // The owner programs it: the allocator only routes its interrupt
+    const dma_block_t b = { .psrc = src, .pdst = src, .len = sizeof(src) };
+    assert_false(dma_load(ch, &b, 1u, false));
+    dma_isr(ch);
+    assert_int_equal(1u, s_rec.count);
+    assert_int_equal(ch, s_rec.ev[0].ch);
+    assert_int_equal(0u, s_rec.ev[0].events);
+
+    dma_irq_mask(ch, true);
+    assert_true(REG32(NVIC_ICER_ADDR + 4u * ((GPDMA1_CH0_IRQN + ch) / 32u)) &
+        NVIC_BIT(ch));
+    // Freed channels are not routed
+    dma_free(ch);
+    dma_isr(ch);
+    assert_int_equal(1u, s_rec.count);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_init_rejects_partial_vtable, setup),
+        cmocka_unit_test_setup(test_alloc_until_exhausted, setup),
+        cmocka_unit_test_setup(test_invalid_config_and_blocks, setup),
+        cmocka_unit_test_setup(test_mem_to_mem_chain, setup),
+        cmocka_unit_test_setup(test_fixed_source_fills, setup),
+        cmocka_unit_test_setup(test_ring_paced_by_requests, setup),
+        cmocka_unit_test_setup(test_single_block_rx_ring, setup),
+        cmocka_unit_test_setup(test_transfer_error_stops, setup),
+        cmocka_unit_test_setup(test_wedged_channel_stop_fails, setup),
+        cmocka_unit_test_setup(test_restart_from_callback, setup),
+        cmocka_unit_test_setup(test_raw_channel, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
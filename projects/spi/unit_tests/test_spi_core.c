@@ -0,0 +1,401 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define portable SPI Core unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "spi_core.h"
+#include "spi_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+SPI_DEFINE_INSTANCE(test_spi, 8);
+SPI_DEFINE_INSTANCE(test_spi2, 2);
+
+static spi_hw_vtable_t VTable;
+static spi_stub_ctx_t CTX;
+static uint8_t mosi[256];
+
+// Completion log
+static spi_xfer_t *done_log[16];
+static size_t done_count;
+
+//------------------------------------------------------------------------------
+static void on_done(void *pctx, spi_xfer_t *px) {
+    (void)pctx;
+    if (done_count < 16u) {
+        done_log[done_count] = px;
+    }
+    done_count++;
+}
+
+//------------------------------------------------------------------------------
+// Helper to bring up the static instance with a stub that links up to
+// link_max transfers
+static spi_t *setup(size_t link_max) {
+    memset(&CTX, 0, sizeof(CTX));
+    memset(mosi, 0, sizeof(mosi));
+    done_count = 0;
+    CTX.pmosi_buf = mosi;
+    CTX.mosi_capacity = sizeof(mosi);
+    CTX.loopback = true;
+    CTX.link_max = link_max;
+    spi_hw_stub_create(&VTable, &CTX);
+    assert_true(spi_init_instance(&test_spi, &VTable, 1000000u, SPI_MODE_0));
+    return test_spi.ps;
+}
+
+//------------------------------------------------------------------------------
+static spi_xfer_t xfer(const void *ptx, void *prx, size_t len, uint32_t flags) {
+    return (spi_xfer_t){
+        .ptx = ptx, .prx = prx, .len = len, .flags = flags, .done = on_done,
+    };
+}
+
+//------------------------------------------------------------------------------
+// Test Functions
+//------------------------------------------------------------------------------
+static void test_init_validation(void **state) {
+    (void)state;  // silence unused warning
+    spi_xfer_t *queue[4];
+
+    spi_hw_stub_create(&VTable, &CTX);
+    assert_false(spi_init(NULL, &VTable, 1000u, SPI_MODE_0, queue, 4));
+    assert_false(spi_init(test_spi.ps, NULL, 1000u, SPI_MODE_0, queue, 4));
+    assert_false(spi_init(test_spi.ps, &VTable, 0u, SPI_MODE_0, queue, 4));
+    assert_false(spi_init(test_spi.ps, &VTable, 1000u, (spi_mode_t)4, queue, 4));
+    assert_false(spi_init(test_spi.ps, &VTable, 1000u, SPI_MODE_0, NULL, 4));
+    // Depth a power of two
+    assert_false(spi_init(test_spi.ps, &VTable, 1000u, SPI_MODE_0, queue, 0));
+    assert_false(spi_init(test_spi.ps, &VTable, 1000u, SPI_MODE_0, queue, 3));
+
+    // Required entries
+    spi_hw_vtable_t partial = VTable;
+    partial.hw_poll_done = NULL;
+    assert_false(spi_init(test_spi.ps, &partial, 1000u, SPI_MODE_0, queue, 4));
+
+    // Settings reach the backend, and its verdict is returned
+    assert_true(spi_init(test_spi.ps, &VTable, 2000000u, SPI_MODE_3, queue, 4));
+    assert_int_equal(2000000u, CTX.clock_hz);
+    assert_int_equal(SPI_MODE_3, CTX.mode);
+    CTX.init_fail = true;
+    assert_false(spi_init(test_spi.ps, &VTable, 1000u, SPI_MODE_0, queue, 4));
+}
+
+//------------------------------------------------------------------------------
+static void test_define_instance(void **state) {
+    (void)state;  // silence unused warning
+    assert_int_equal(spi_context_size() + 8 * sizeof(spi_xfer_t*),
+        test_spi.footprint_bytes);
+    assert_int_equal(SPI_INSTANCE_FOOTPRINT(8), test_spi.footprint_bytes);
+    assert_int_equal(8, test_spi.depth);
+}
+
+//------------------------------------------------------------------------------
+static void test_single_transfer(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(0);
+    uint8_t rx[4] = {0};
+    spi_xfer_t x = xfer("\x9F\x01\x02\x03", rx, 4, 0);
+
+    assert_true(spi_submit(ps, &x));
+    assert_int_equal(SPI_XFER_ACTIVE, x.status);
+    assert_int_equal(1, spi_pending(ps));
+    assert_true(CTX.cs_asserted);
+
+    // Resubmitting while in flight is refused
+    assert_false(spi_submit(ps, &x));
+
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(SPI_XFER_DONE, x.status);
+    assert_int_equal(0, spi_pending(ps));
+    assert_memory_equal("\x9F\x01\x02\x03", rx, 4);
+    assert_memory_equal("\x9F\x01\x02\x03", mosi, 4);
+    assert_false(CTX.cs_asserted);
+    assert_int_equal(1, done_count);
+    assert_ptr_equal(&x, done_log[0]);
+
+    // Nothing more to finish
+    assert_int_equal(0, spi_isr(ps));
+    assert_int_equal(1, done_count);
+}
+
+//------------------------------------------------------------------------------
+static void test_hold_chains_transfers(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(8);
+    uint8_t rx[8] = {0};
+    spi_xfer_t cmd = xfer("\x03\x00\x10\x00", NULL, 4, SPI_XFER_CS_HOLD);
+    spi_xfer_t data = xfer(NULL, rx, 8, 0);
+    spi_stats_t stats;
+
+    // A command and its read phase: one bus start, one chip select cycle
+    CTX.loopback = false;
+    CTX.pmiso_src = (const uint8_t*)"xxxxABCDEFGH";
+    CTX.miso_len = 12;
+    assert_true(spi_submit(ps, &cmd));
+    assert_true(spi_submit(ps, &data));
+    assert_int_equal(1, CTX.starts);
+    assert_int_equal(1, CTX.links);
+    assert_int_equal(SPI_XFER_ACTIVE, data.status);
+
+    assert_int_equal(2, spi_isr(ps));
+    assert_ptr_equal(&cmd, done_log[0]);
+    assert_ptr_equal(&data, done_log[1]);
+    assert_memory_equal("ABCDEFGH", rx, 8);
+    // Fill bytes clocked out for the read
+    assert_memory_equal("\x03\x00\x10\x00\xFF\xFF\xFF\xFF", mosi, 8);
+    assert_int_equal(1, CTX.cs_cycles);
+    assert_false(CTX.cs_asserted);
+
+    spi_get_stats(ps, &stats);
+    assert_int_equal(2, stats.submitted);
+    assert_int_equal(2, stats.completed);
+    assert_int_equal(1, stats.started);
+    assert_int_equal(1, stats.linked);
+    assert_int_equal(2, stats.max_queued);
+}
+
+//------------------------------------------------------------------------------
+static void test_no_hold_starts_each(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(8);
+    spi_xfer_t a = xfer("a", NULL, 1, 0);
+    spi_xfer_t b = xfer("b", NULL, 1, 0);
+    spi_xfer_t c = xfer("c", NULL, 1, 0);
+
+    // Chip select goes up between them, so nothing is chained
+    assert_true(spi_submit(ps, &a));
+    assert_true(spi_submit(ps, &b));
+    assert_true(spi_submit(ps, &c));
+    assert_int_equal(SPI_XFER_QUEUED, b.status);
+    assert_int_equal(1, CTX.starts);
+    assert_int_equal(0, CTX.links);
+
+    // Each completion starts the next
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(SPI_XFER_ACTIVE, b.status);
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(3, CTX.starts);
+    assert_int_equal(3, CTX.cs_cycles);
+    assert_memory_equal("abc", mosi, 3);
+    assert_int_equal(0, spi_pending(ps));
+}
+
+//------------------------------------------------------------------------------
+static void test_late_link_starts(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(8);
+    spi_xfer_t a = xfer("a", NULL, 1, SPI_XFER_CS_HOLD);
+    spi_xfer_t b = xfer("b", NULL, 1, 0);
+    spi_stats_t stats;
+
+    // The bus stops before the link lands: started from the interrupt
+    // instead, chip select still held
+    CTX.late = true;
+    assert_true(spi_submit(ps, &a));
+    assert_true(spi_submit(ps, &b));
+    assert_int_equal(SPI_XFER_QUEUED, b.status);
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(SPI_XFER_ACTIVE, b.status);
+    assert_true(CTX.cs_asserted);
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(1, CTX.cs_cycles);
+
+    spi_get_stats(ps, &stats);
+    assert_int_equal(2, stats.started);
+    assert_int_equal(0, stats.linked);
+}
+
+//------------------------------------------------------------------------------
+static void test_link_room(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(2);
+    spi_xfer_t x[4];
+    for (size_t i = 0; i < 4; i++) {
+        x[i] = xfer("0123" + i, NULL, 1, SPI_XFER_CS_HOLD);
+        assert_true(spi_submit(ps, &x[i]));
+    }
+    // Two with the backend, the rest go over as it finishes
+    assert_int_equal(1, CTX.starts);
+    assert_int_equal(1, CTX.links);
+    assert_int_equal(SPI_XFER_QUEUED, x[2].status);
+
+    CTX.done_max = 1;
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(2, CTX.links);
+    assert_int_equal(SPI_XFER_ACTIVE, x[2].status);
+    CTX.done_max = 0;
+    assert_int_equal(2, spi_isr(ps));
+    assert_int_equal(1, spi_isr(ps));
+    assert_memory_equal("0123", mosi, 4);
+    // Held throughout
+    assert_int_equal(1, CTX.cs_cycles);
+}
+
+//------------------------------------------------------------------------------
+static void test_queue_full_and_invalid(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(0);
+    spi_xfer_t x[9];
+    for (size_t i = 0; i < 9; i++) {
+        x[i] = xfer(NULL, NULL, 1, 0);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        assert_true(spi_submit(ps, &x[i]));
+    }
+    assert_false(spi_submit(ps, &x[8]));
+    assert_int_equal(SPI_XFER_IDLE, x[8].status);
+    assert_int_equal(8, spi_pending(ps));
+
+    // Invalid descriptors
+    spi_xfer_t empty = xfer(NULL, NULL, 0, 0);
+    spi_xfer_t huge = xfer(NULL, NULL, SPI_XFER_MAX_BYTES + 1u, 0);
+    assert_false(spi_submit(ps, NULL));
+    assert_false(spi_submit(ps, &empty));
+    assert_false(spi_submit(ps, &huge));
+
+    // Room again as they finish
+    assert_int_equal(1, spi_isr(ps));
+    assert_true(spi_submit(ps, &x[8]));
+}
+
+//------------------------------------------------------------------------------
+// Resubmits itself n times from its own callback
+static void on_done_again(void *pctx, spi_xfer_t *px) {
+    size_t *pleft = pctx;
+    done_count++;
+    if (*pleft) {
+        (*pleft)--;
+        assert_true(spi_submit(test_spi.ps, px));
+    }
+}
+
+//------------------------------------------------------------------------------
+static void test_resubmit_from_callback(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(8);
+    size_t left = 3;
+    spi_xfer_t x = xfer("z", NULL, 1, 0);
+    x.done = on_done_again;
+    x.pctx = &left;
+
+    assert_true(spi_submit(ps, &x));
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(1, spi_isr(ps));
+    }
+    assert_int_equal(4, done_count);
+    assert_int_equal(4, CTX.starts);
+    assert_int_equal(SPI_XFER_DONE, x.status);
+    assert_memory_equal("zzzz", mosi, 4);
+    assert_int_equal(0, spi_pending(ps));
+}
+
+//------------------------------------------------------------------------------
+static void test_error_fails_inflight(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(8);
+    spi_xfer_t a = xfer("a", NULL, 1, SPI_XFER_CS_HOLD);
+    spi_xfer_t b = xfer("b", NULL, 1, 0);
+    spi_xfer_t c = xfer("c", NULL, 1, 0);
+    spi_stats_t stats;
+
+    assert_true(spi_submit(ps, &a));
+    assert_true(spi_submit(ps, &b));
+    assert_true(spi_submit(ps, &c));
+    CTX.error = true;
+
+    // Both with the backend fail; the queued one starts on a clean bus
+    assert_int_equal(2, spi_isr(ps));
+    assert_int_equal(SPI_XFER_ERROR, a.status);
+    assert_int_equal(SPI_XFER_ERROR, b.status);
+    assert_int_equal(SPI_XFER_ACTIVE, c.status);
+    assert_int_equal(2, done_count);
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal(SPI_XFER_DONE, c.status);
+
+    spi_get_stats(ps, &stats);
+    assert_int_equal(2, stats.failed);
+    assert_int_equal(1, stats.completed);
+
+    // A failed transfer may be submitted again
+    assert_true(spi_submit(ps, &a));
+}
+
+//------------------------------------------------------------------------------
+static void test_irq_mask_balanced(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(8);
+    spi_xfer_t x[9];
+    for (size_t i = 0; i < 9; i++) {
+        x[i] = xfer(NULL, NULL, 1, 0);
+        (void)spi_submit(ps, &x[i]);
+    }
+    // Unmasked after every submit, the refused one too
+    assert_int_equal(9, CTX.mask_calls);
+    assert_int_equal(9, CTX.unmask_calls);
+    assert_false(CTX.masked);
+}
+
+//------------------------------------------------------------------------------
+static void test_two_buses(void **state) {
+    (void)state;  // silence unused warning
+    spi_t *ps = setup(0);
+    spi_hw_vtable_t vt2;
+    spi_stub_ctx_t ctx2 = {0};
+    uint8_t mosi2[4];
+    spi_xfer_t a = xfer("a", NULL, 1, 0);
+    spi_xfer_t b = xfer("b", NULL, 1, 0);
+
+    ctx2.pmosi_buf = mosi2;
+    ctx2.mosi_capacity = sizeof(mosi2);
+    assert_false(spi_hw_stub_create_instance(&vt2, &ctx2, SPI_HW_STUB_MAX_INSTANCES));
+    assert_true(spi_hw_stub_create_instance(&vt2, &ctx2, 1));
+    assert_null(vt2.hw_link);
+    assert_true(spi_init_instance(&test_spi2, &vt2, 500000u, SPI_MODE_2));
+
+    // Each bus runs on its own backend
+    assert_true(spi_submit(ps, &a));
+    assert_true(spi_submit(test_spi2.ps, &b));
+    assert_int_equal(1, spi_isr(test_spi2.ps));
+    assert_int_equal(0, CTX.mosi_len);
+    assert_int_equal(1, ctx2.mosi_len);
+    assert_int_equal('b', mosi2[0]);
+    assert_int_equal(1, spi_isr(ps));
+    assert_int_equal('a', mosi[0]);
+    assert_int_equal(SPI_MODE_2, ctx2.mode);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_init_validation),
+        cmocka_unit_test(test_define_instance),
+        cmocka_unit_test(test_single_transfer),
+        cmocka_unit_test(test_hold_chains_transfers),
+        cmocka_unit_test(test_no_hold_starts_each),
+        cmocka_unit_test(test_late_link_starts),
+        cmocka_unit_test(test_link_room),
+        cmocka_unit_test(test_queue_full_and_invalid),
+        cmocka_unit_test(test_resubmit_from_callback),
+        cmocka_unit_test(test_error_fails_inflight),
+        cmocka_unit_test(test_irq_mask_balanced),
+        cmocka_unit_test(test_two_buses),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define STM32H5 SPI backend tests on the register-level peripheral model:
+// the real spi_hw.c and DMA allocator under the portable core
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "spi_core.h"
+#include "spi_hw.h"
+#include "dma_api.h"
+#include "dma_hw.h"
+#include "gpio_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Allocated in this order by the first hw_init()
+#define TX_CH  0u
+#define RX_CH  1u
+
+// The SPI has no model behind it: its registers hold what is written
+#define SPI(off)  REG32(SPI_HW_SPI + (off))
+#define CS_LEVEL() \
+    ((REG32(GPIOA_BASE + (uintptr_t)GPIO_PIN_PORT(SPI_HW_CS_PIN) * \
+        GPIO_PORT_STRIDE + GPIO_ODR_OFFSET) >> GPIO_PIN_NUM(SPI_HW_CS_PIN)) & 1u)
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+
+SPI_DEFINE_INSTANCE(test_spi, 4);
+
+static dma_hw_vtable_t s_dma_hw;
+static spi_hw_vtable_t s_hw;
+static size_t s_done;
+
+//------------------------------------------------------------------------------
+static void on_done(void *pctx, spi_xfer_t *px) {
+    (void)pctx;
+    (void)px;
+    s_done++;
+}
+
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    periph_sim_reset();
+    s_done = 0;
+    dma_hw_install(&s_dma_hw);
+    spi_hw_install(&s_hw);
+    if (!dma_init(&s_dma_hw) ||
+            !spi_init_instance(&test_spi, &s_hw, 1000000u, SPI_MODE_0)) {
+        return -1;
+    }
+    spi_hw_enable_irq(test_spi.ps);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Run a channel's interrupt while the model holds it pending
+static void service(uint32_t ch) {
+    while (periph_sim_dma_irq(ch)) {
+        dma_isr(ch);
+    }
+}
+
+//------------------------------------------------------------------------------
+static spi_xfer_t xfer(const void *ptx, void *prx, size_t len, uint32_t flags) {
+    return (spi_xfer_t){
+        .ptx = ptx, .prx = prx, .len = len, .flags = flags, .done = on_done,
+    };
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+// Helper to fail the Tx channel mid-transfer and run its interrupt
+static void tx_fault(void) {
+    assert_int_equal(2u, periph_sim_dma_request(SPI_HW_DMA_TX_REQ, 2u));
+    periph_sim_dma_fault(TX_CH);
+    assert_int_equal(0u, periph_sim_dma_request(SPI_HW_DMA_TX_REQ, 1u));
+    // The clock stops with it, so the Rx channel never finishes: only the
+    // Tx channel's interrupt reports the error
+    assert_false(periph_sim_dma_irq(RX_CH));
+    assert_true(periph_sim_dma_irq(TX_CH));
+    service(TX_CH);
+    assert_false(periph_sim_dma_irq(TX_CH));
+}
+
+//------------------------------------------------------------------------------
+static void test_tx_error_fails_inflight(void **state) {
+    (void)state;
+    static const uint8_t cmd[4] = { 0x03, 0x00, 0x10, 0x00 };
+    static uint8_t data[8];
+    spi_t *ps = test_spi.ps;
+    spi_xfer_t a = xfer(cmd, NULL, sizeof(cmd), SPI_XFER_CS_HOLD);
+    spi_xfer_t b = xfer(NULL, data, sizeof(data), 0u);
+    spi_stats_t stats;
+
+    assert_true(spi_submit(ps, &a));
+    assert_true(spi_submit(ps, &b));
+    assert_int_equal(SPI_XFER_ACTIVE, a.status);
+    assert_int_equal(0u, CS_LEVEL());
+
+    // The transfer with the backend fails; the queued one starts on a
+    // clean bus
+    tx_fault();
+    assert_int_equal(SPI_XFER_ERROR, a.status);
+    assert_int_equal(SPI_XFER_ACTIVE, b.status);
+    assert_int_equal(1u, s_done);
+    assert_int_equal(0u, CS_LEVEL());
+
+    tx_fault();
+    assert_int_equal(SPI_XFER_ERROR, b.status);
+    assert_int_equal(2u, s_done);
+    assert_int_equal(1u, CS_LEVEL());
+    assert_int_equal(0u, spi_pending(ps));
+    spi_get_stats(ps, &stats);
+    assert_int_equal(2u, stats.failed);
+}
+
+//------------------------------------------------------------------------------
+static void test_spi_error_fails_inflight(void **state) {
+    (void)state;
+    static const uint8_t cmd[2] = { 0x9F, 0x00 };
+    spi_t *ps = test_spi.ps;
+    spi_xfer_t a = xfer(cmd, NULL, sizeof(cmd), 0u);
+
+    // Errors raise the SPI's own interrupt
+    assert_int_equal(SPI_IER_ERRORS, SPI(SPI_IER_OFFSET) & SPI_IER_ERRORS);
+    assert_true(spi_submit(ps, &a));
+    SPI(SPI_SR_OFFSET) = SPI_SR_MODF;
+    SPI_HW_IRQHandler();
+
+    assert_int_equal(SPI_XFER_ERROR, a.status);
+    assert_int_equal(1u, s_done);
+    assert_int_equal(1u, CS_LEVEL());
+    assert_int_equal(0u, spi_pending(ps));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_tx_error_fails_inflight, setup),
+        cmocka_unit_test_setup(test_spi_error_fails_inflight, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -9,6 +9,12 @@
 #include "uart_core.h"
 #include "platform_config.h"
 #include "uart_hw.h"
+#include "sched_api.h"
+#include "sched_hw.h"
+#include "trace_api.h"
+#ifdef UART_SHELL
+#include "shell_api.h"
+#endif
 
 //------------------------------------------------------------------------------
 // Constants
@@ -22,14 +28,89 @@
 #define UART_TX_SIZE  128
 #endif
 
+// Batched Rx delivery: wake the echo on a quarter FIFO, or after two
+// character times of line silence
+#define UART_RX_BATCH_BYTES    (UART_RX_SIZE / 4)
+#define UART_RX_TIMEOUT_CHARS  2u
+
+#ifndef SHELL_LINE_SIZE
+#define SHELL_LINE_SIZE  80
+#endif
+
+// Task priorities (higher runs first)
+#define TASK_ECHO  1u
+
+// Task events
+#define EV_RX_READY    (1u << 0)
+#define EV_TX_PENDING  (1u << 1)
+
 //------------------------------------------------------------------------------
-// Opaque Context
+// UART Instance
 //------------------------------------------------------------------------------
 
-// Since context is opaque, size is dependent on backend implementation,
-// determined dynamically
-extern size_t uart_context_size(void);
-static uint8_t uart_context_store[512];
+// Context and FIFOs in .bss, sized exactly at compile time
+UART_DEFINE_INSTANCE(uart_vcp, UART_RX_SIZE, UART_TX_SIZE);
+
+#ifdef UART_SHELL
+// Serial console in place of the echo (commands in src/console.cmds)
+extern const shell_table_t g_console_cmds;
+static shell_t console;
+static char console_line[SHELL_LINE_SIZE];
+#endif
+
+//------------------------------------------------------------------------------
+// Rx Batch Notification
+//------------------------------------------------------------------------------
+
+static bool batching;
+
+// Context: UART ISR, via uart_poll_rx()
+static void on_rx_batch(void *pctx, size_t available) {
+    (void)pctx;
+    (void)available;
+    sched_post(TASK_ECHO, EV_RX_READY);
+}
+
+//------------------------------------------------------------------------------
+// Interrupt Service Routine
+//------------------------------------------------------------------------------
+// Drain Rx data, errors and timeout; wake the echo task when there is work
+void UART_HW_IRQHandler(void) {
+    size_t n = uart_poll_rx(uart_vcp.pu);
+    if (!batching && n) {
+        sched_post(TASK_ECHO, EV_RX_READY);
+    }
+    // Room in the Tx data register for the bytes still queued
+    if (uart_hw_tx_irq_fired()) {
+        sched_post(TASK_ECHO, EV_TX_PENDING);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Tasks
+//------------------------------------------------------------------------------
+// Echo the Rx batch (or run console input) and push to hardware
+static void echo_task(void *pctx, uint32_t events) {
+    (void)events;
+    uart_t *pU = (uart_t*)pctx;
+
+#ifdef UART_SHELL
+    bool more = shell_poll(&console);
+#else
+    bool more = false;
+    uart_echo_pump(pU);
+#endif
+    uart_service_tx(pU);
+
+    if (uart_tx_queued(pU)) {
+        // The hardware is full: sleep until the Tx interrupt says otherwise
+        uart_hw_arm_tx_irq();
+    } else if (more) {
+        // Unfinished command with Tx space to spare: come back, yielding to
+        // any higher priority task
+        sched_post(TASK_ECHO, EV_TX_PENDING);
+    }
+}
 
 //------------------------------------------------------------------------------
 int main(void) {
@@ -37,30 +118,30 @@ int main(void) {
     // Uncomment if minimal system clock init not covered by startup code
     // SystemInit();
 
-    uart_t *pU = (uart_t*)uart_context_store;
+    uart_t *pU = uart_vcp.pu;
 
-    uint8_t rx_fifo[UART_RX_SIZE];
-    uint8_t tx_fifo[UART_TX_SIZE];
+    // Trace pins, when built with UART_TRACE
+    TRACE_INIT();
 
     uart_hw_vtable_t hw;
     uart_hw_install(&hw);
 
-    (void)uart_init(
-        pU, &hw, 115200, rx_fifo, sizeof(rx_fifo), tx_fifo, sizeof(tx_fifo));
-
-    while (1) {
-        //-------------------
-        // Polling option
-        if (hw.hw_rx_available()) {
-            uint8_t byte = hw.hw_rx_read();
-            // If USART interrupt enabled at some point, ISR will call this
-            // directly, in which case this entire polling option can be removed
-            uart_isr_rx_byte(pU, byte);
-        }
-        // End polling option
-        //-------------------
-        // Echo the byte and push to hardware
-        uart_echo_pump(pU);
-        uart_service_tx(pU);
-    }
+    sched_hw_vtable_t sched_hw;
+    sched_hw_install(&sched_hw);
+    (void)sched_init(&sched_hw);
+    (void)sched_task_create(TASK_ECHO, echo_task, pU);
+
+    (void)uart_init_instance(&uart_vcp, &hw, 115200);
+#ifdef UART_SHELL
+    (void)shell_init(&console, pU, &g_console_cmds, console_line,
+        sizeof(console_line), "> ");
+#endif
+
+    // Fall back to echoing on every Rx interrupt if batching is unavailable
+    batching = uart_set_rx_batching(
+        pU, UART_RX_BATCH_BYTES, UART_RX_TIMEOUT_CHARS, on_rx_batch, NULL);
+    uart_hw_enable_rx_irq();
+
+    // Sleeps in WFI until the UART interrupt posts work
+    sched_run();
 }
@@ -0,0 +1,47 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Serial console command handlers, listed in console.cmds
+//
+//------------------------------------------------------------------------------
+
+#include "shell_api.h"
+
+//------------------------------------------------------------------------------
+// Command Handlers
+//------------------------------------------------------------------------------
+int cmd_echo(shell_t *psh, int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        (void)shell_printf(psh, (i > 1) ? " %s" : "%s", argv[i]);
+    }
+    (void)shell_write(psh, "\r\n", 2u);
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+int cmd_stats(shell_t *psh, int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    const uart_t *pu = shell_uart(psh);
+    (void)shell_printf(psh,
+        "overflow %u\r\noverrun %u framing %u noise %u parity %u\r\n",
+        uart_rx_overflow_count(pu),
+        uart_rx_error_count(pu, UART_RX_ERR_OVERRUN),
+        uart_rx_error_count(pu, UART_RX_ERR_FRAMING),
+        uart_rx_error_count(pu, UART_RX_ERR_NOISE),
+        uart_rx_error_count(pu, UART_RX_ERR_PARITY));
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+int cmd_clear(shell_t *psh, int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    uart_t *pu = shell_uart(psh);
+    uart_rx_overflow_clear(pu);
+    uart_rx_error_clear(pu);
+    return SHELL_OK;
+}
@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define log statements built with LOG_LEVEL at LOG_LEVEL_WARN, for the
+// logging tests
+//
+//------------------------------------------------------------------------------
+
+#include "log_api.h"
+
+//------------------------------------------------------------------------------
+// Log once at every level; only the warning and the error are built in
+void log_level_warn_all(uint32_t n) {
+    LOG_DEBUG("compiled out %u", n);
+    LOG_INFO("compiled out %u", n);
+    LOG_WARN("kept %u", n);
+    LOG_ERROR("kept");
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define CRC unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "crc_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+// Standard check input for CRC catalogues
+static const uint8_t CHECK[] = "123456789";
+#define CHECK_LEN  9u
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_check_values(void **state) {
+    (void)state;
+    assert_int_equal(0x29B1u, crc16_ccitt(CHECK, CHECK_LEN));
+    assert_int_equal(0xCBF43926u, crc32(CHECK, CHECK_LEN));
+    // Empty input leaves the initial value
+    assert_int_equal(CRC16_CCITT_INIT, crc16_ccitt(CHECK, 0));
+    assert_int_equal(0u, crc32(CHECK, 0));
+}
+
+//------------------------------------------------------------------------------
+static void test_incremental_matches_one_shot(void **state) {
+    (void)state;
+    for (size_t split = 0; split <= CHECK_LEN; ++split) {
+        uint16_t c16 = crc16_ccitt_update(CRC16_CCITT_INIT, CHECK, split);
+        c16 = crc16_ccitt_update(c16, &CHECK[split], CHECK_LEN - split);
+        assert_int_equal(0x29B1u, c16);
+
+        uint32_t c32 = crc32_update(CRC32_INIT, CHECK, split);
+        c32 = crc32_update(c32, &CHECK[split], CHECK_LEN - split);
+        assert_int_equal(0xCBF43926u, crc32_final(c32));
+    }
+}
+
+//------------------------------------------------------------------------------
+static void test_crc16_residue(void **state) {
+    (void)state;
+    // Appending the CRC MSB first gives a zero remainder, as framing relies on
+    uint8_t buf[CHECK_LEN + 2u];
+    memcpy(buf, CHECK, CHECK_LEN);
+    uint16_t crc = crc16_ccitt(CHECK, CHECK_LEN);
+    buf[CHECK_LEN] = (uint8_t)(crc >> 8);
+    buf[CHECK_LEN + 1u] = (uint8_t)crc;
+    assert_int_equal(0u, crc16_ccitt(buf, sizeof(buf)));
+    buf[3] ^= 0x10u;
+    assert_int_not_equal(0u, crc16_ccitt(buf, sizeof(buf)));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_check_values),
+        cmocka_unit_test(test_incremental_matches_one_shot),
+        cmocka_unit_test(test_crc16_residue),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define heap-free formatter unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "fmt_api.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_uart, 16, 16);
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+
+// Standard conversions must match the C library exactly
+#define CHECK_LIKE_PRINTF(...)                                                 \
+    do {                                                                       \
+        char want_[128];                                                       \
+        char got_[128];                                                        \
+        int m_ = snprintf(want_, sizeof(want_), __VA_ARGS__);                  \
+        size_t n_ = fmt_buf(got_, sizeof(got_), __VA_ARGS__);                  \
+        assert_string_equal(want_, got_);                                      \
+        assert_int_equal((size_t)m_, n_);                                      \
+    } while (0)
+
+#define CHECK(want, ...)                                                       \
+    do {                                                                       \
+        char got_[128];                                                        \
+        size_t n_ = fmt_buf(got_, sizeof(got_), __VA_ARGS__);                  \
+        assert_string_equal(want, got_);                                       \
+        assert_int_equal(strlen(want), n_);                                    \
+    } while (0)
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_integers_match_printf(void **state) {
+    (void)state;
+    CHECK_LIKE_PRINTF("plain text");
+    CHECK_LIKE_PRINTF("%d %i %u", 0, -1, 42u);
+    CHECK_LIKE_PRINTF("%d %d", INT_MIN, INT_MAX);
+    CHECK_LIKE_PRINTF("%u %x %X", UINT_MAX, 0xDEADBEEFu, 0xDEADBEEFu);
+    CHECK_LIKE_PRINTF("[%5d] [%-5d] [%05d] [%+d] [% d]", 42, 42, -42, 42, 42);
+    // Sign flags do nothing on %u (spelled out: the C library check warns)
+    CHECK("[36] [36] [    7] [7    ]", "[%+u] [% u] [%+5u] [% -5u]", 36u, 36u, 7u, 7u);
+    CHECK_LIKE_PRINTF("[%.4d] [%8.4x] [%-8.3u] [%.0d]", 7, 0xABu, 5u, 0);
+    CHECK_LIKE_PRINTF("[%08X] [%*d] [%-*d] [%.*u]", 0x1Fu, 6, 3, 6, 3, 4, 9u);
+    CHECK_LIKE_PRINTF("%hhd %hhu %hd %hu", 300, 300, 70000, 70000);
+    CHECK_LIKE_PRINTF("%ld %lu %lx", -123456789L, 4000000000UL, 0xCAFEUL);
+    CHECK_LIKE_PRINTF("%lld %llu %llX", LLONG_MIN, ULLONG_MAX, 0x123456789ABCDEFULL);
+    CHECK_LIKE_PRINTF("%zu %zx", (size_t)12345, (size_t)0xFFFF);
+    CHECK_LIKE_PRINTF("%p", (void*)0x1234);
+}
+
+//------------------------------------------------------------------------------
+static void test_chars_and_strings_match_printf(void **state) {
+    (void)state;
+    CHECK_LIKE_PRINTF("%c%c%c", 'a', 'b', 'c');
+    CHECK_LIKE_PRINTF("[%3c] [%-3c]", 'x', 'y');
+    CHECK_LIKE_PRINTF("[%s] [%8s] [%-8s] [%.2s] [%6.3s]", "abc", "abc", "abc",
+        "abc", "abcdef");
+    CHECK_LIKE_PRINTF("100%% of %s", "it");
+    CHECK_LIKE_PRINTF("[%s]", "");
+}
+
+//------------------------------------------------------------------------------
+static void test_fixed_point(void **state) {
+    (void)state;
+    // Scaled decimal
+    CHECK("23.50", "%.2k", 2350);
+    CHECK("-0.005", "%k", -5);
+    CHECK("12", "%.0k", 12);
+    CHECK("[  -1.25] [+1.25  ] [001.25]", "[%7.2k] [%-+7.2k] [%06.2k]",
+        -125, 125, 125);
+    CHECK("-2147483.648", "%k", INT32_MIN);
+    CHECK("9223372036854775.807", "%llk", LLONG_MAX);
+    // Q16.16
+    CHECK("1.500", "%q", 0x00018000);
+    CHECK("-1.50", "%.2q", -0x00018000);
+    CHECK("0.0000153", "%.7q", 1);
+    CHECK("32767.99998", "%.5q", INT32_MAX);
+    CHECK("-32768.000", "%q", INT32_MIN);
+    // Rounding carries into the integer part
+    CHECK("2.00", "%.2q", 0x0001FFFF);
+    CHECK("3", "%.0q", 0x00028000);
+}
+
+//------------------------------------------------------------------------------
+static void test_truncation_and_edge_cases(void **state) {
+    (void)state;
+    char buf[8];
+    assert_int_equal(7u, fmt_buf(buf, sizeof(buf), "%d-%d-%d", 123, 456, 789));
+    assert_string_equal("123-456", buf);
+    assert_int_equal(0u, fmt_buf(buf, 1u, "abc"));
+    assert_string_equal("", buf);
+    assert_int_equal(0u, fmt_buf(buf, 0u, "abc"));
+    assert_int_equal(0u, fmt_buf(NULL, 8u, "abc"));
+    CHECK("(null)", "%s", (const char*)NULL);
+    // Unsupported conversions are shown, not interpreted
+    CHECK("%f", "%f");
+    CHECK("x", "x%");
+}
+
+//------------------------------------------------------------------------------
+static void test_uart_in_place_wraps(void **state) {
+    (void)state;
+    uart_hw_vtable_t hw;
+    uart_stub_ctx_t ctx = { 0 };
+    uint8_t out[64];
+    ctx.ptx_buf = out;
+    ctx.tx_capacity = sizeof(out);
+    uart_hw_stub_create(&hw, &ctx);
+    assert_true(uart_init_instance(&s_uart, &hw, 115200));
+
+    // Move the Tx FIFO head near the end of storage, then drain it
+    assert_int_equal(11u,
+        uart_write(s_uart.pu, (const uint8_t*)"0123456789\n", 11u));
+    ctx.tx_bytes = 64;
+    uart_service_tx(s_uart.pu);
+    ctx.tx_len = 0;
+    ctx.tx_bytes = 0;
+
+    // Output crosses the end of storage: two reservations, no staging copy
+    assert_int_equal(12u, fmt_uart(s_uart.pu, "v=%.3k mV\r\n", 3300));
+    assert_int_equal(12u, uart_tx_queued(s_uart.pu));
+    // A full FIFO takes what fits
+    assert_int_equal(4u, fmt_uart(s_uart.pu, "%s", "overflow"));
+    assert_int_equal(0u, fmt_uart(s_uart.pu, "%d", 1));
+
+    ctx.tx_bytes = 64;
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(16u, ctx.tx_len);
+    assert_memory_equal("v=3.300 mV\r\nover", out, 16u);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_integers_match_printf),
+        cmocka_unit_test(test_chars_and_strings_match_printf),
+        cmocka_unit_test(test_fixed_point),
+        cmocka_unit_test(test_truncation_and_edge_cases),
+        cmocka_unit_test(test_uart_in_place_wraps),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
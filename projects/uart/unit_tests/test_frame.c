@@ -0,0 +1,165 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define COBS framing unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "frame_api.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define MAX_PAYLOAD  600u
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+typedef struct {
+    size_t  calls;
+    size_t  len;
+    uint8_t data[MAX_PAYLOAD];
+} rx_log_t;
+
+static void on_frame(void *pctx, const uint8_t *ppayload, size_t len) {
+    rx_log_t *plog = (rx_log_t*)pctx;
+    plog->calls++;
+    plog->len = len;
+    memcpy(plog->data, ppayload, len);
+}
+
+//------------------------------------------------------------------------------
+// Payload with zeros, and runs long enough to fill maximal COBS blocks
+static void fill_payload(uint8_t *p, size_t len, unsigned seed) {
+    for (size_t i = 0; i < len; ++i) {
+        p[i] = ((i + seed) % 97u == 0u) ? 0u : (uint8_t)(i * 31u + seed);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_round_trip_all_lengths(void **state) {
+    (void)state;
+    static uint8_t payload[MAX_PAYLOAD];
+    static uint8_t enc[FRAME_ENCODED_MAX(MAX_PAYLOAD)];
+    static uint8_t buf[FRAME_DECODE_BUF(MAX_PAYLOAD)];
+    static rx_log_t log;
+    frame_decoder_t dec;
+    frame_decoder_init(&dec, buf, sizeof(buf), on_frame, &log);
+
+    for (size_t len = 0; len <= MAX_PAYLOAD; ++len) {
+        for (unsigned seed = 0; seed < 2u; ++seed) {
+            // seed 1 has no zeros at all, so every block is maximal
+            if (seed) {
+                memset(payload, 0xA5, len);
+            } else {
+                fill_payload(payload, len, (unsigned)len);
+            }
+            size_t n = frame_encode(payload, len, enc, sizeof(enc));
+            assert_true(n > 0u && n <= FRAME_ENCODED_MAX(len));
+            assert_null(memchr(enc, FRAME_DELIM, n - 1u));
+            assert_int_equal(FRAME_DELIM, enc[n - 1u]);
+
+            log.calls = 0;
+            assert_int_equal(1, frame_decoder_feed(&dec, enc, n));
+            assert_int_equal(1, log.calls);
+            assert_int_equal(len, log.len);
+            assert_memory_equal(payload, log.data, len);
+        }
+    }
+    assert_int_equal(0, dec.crc_errors);
+    assert_int_equal(0, dec.malformed);
+}
+
+//------------------------------------------------------------------------------
+static void test_split_feed_and_back_to_back(void **state) {
+    (void)state;
+    uint8_t stream[64];
+    uint8_t buf[FRAME_DECODE_BUF(16)];
+    rx_log_t log = {0};
+    frame_decoder_t dec;
+    frame_decoder_init(&dec, buf, sizeof(buf), on_frame, &log);
+
+    // Idle delimiters, two frames, one byte at a time
+    size_t n = 0;
+    stream[n++] = FRAME_DELIM;
+    n += frame_encode((const uint8_t*)"ab\0c", 4, &stream[n], sizeof(stream) - n);
+    stream[n++] = FRAME_DELIM;
+    n += frame_encode((const uint8_t*)"xyz", 3, &stream[n], sizeof(stream) - n);
+    for (size_t i = 0; i < n; ++i) {
+        (void)frame_decoder_feed(&dec, &stream[i], 1);
+    }
+    assert_int_equal(2, log.calls);
+    assert_int_equal(3, log.len);
+    assert_memory_equal("xyz", log.data, 3);
+    assert_int_equal(0, dec.malformed);
+}
+
+//------------------------------------------------------------------------------
+static void test_corruption_and_resync(void **state) {
+    (void)state;
+    uint8_t enc[FRAME_ENCODED_MAX(16)];
+    uint8_t buf[FRAME_DECODE_BUF(16)];
+    rx_log_t log = {0};
+    frame_decoder_t dec;
+    frame_decoder_init(&dec, buf, sizeof(buf), on_frame, &log);
+
+    size_t n = frame_encode((const uint8_t*)"hello", 5, enc, sizeof(enc));
+    // Flipped payload bit: CRC rejects the frame
+    enc[2] ^= 0x01u;
+    assert_int_equal(0, frame_decoder_feed(&dec, enc, n));
+    assert_int_equal(1, dec.crc_errors);
+
+    // Truncated frame (delimiter mid-block) is malformed, next frame decodes
+    enc[2] ^= 0x01u;
+    assert_int_equal(0, frame_decoder_feed(&dec, enc, 3));
+    assert_int_equal(0, frame_decoder_feed(&dec, (const uint8_t*)"", 1));
+    assert_int_equal(1, dec.malformed);
+    assert_int_equal(1, frame_decoder_feed(&dec, enc, n));
+    assert_int_equal(1, log.calls);
+    assert_memory_equal("hello", log.data, 5);
+
+    // Too long for the buffer: dropped, decoder recovers at the delimiter
+    uint8_t big[FRAME_ENCODED_MAX(32)];
+    uint8_t payload[32];
+    memset(payload, 'z', sizeof(payload));
+    size_t nb = frame_encode(payload, sizeof(payload), big, sizeof(big));
+    assert_int_equal(0, frame_decoder_feed(&dec, big, nb));
+    assert_int_equal(2, dec.malformed);
+    assert_int_equal(1, frame_decoder_feed(&dec, enc, n));
+    assert_int_equal(2, dec.frames);
+}
+
+//------------------------------------------------------------------------------
+static void test_encode_validation(void **state) {
+    (void)state;
+    uint8_t enc[FRAME_ENCODED_MAX(4)];
+    assert_int_equal(0, frame_encode((const uint8_t*)"abcd", 4, enc, sizeof(enc) - 1u));
+    assert_int_equal(0, frame_encode(NULL, 4, enc, sizeof(enc)));
+    // Empty payload still carries a CRC
+    assert_int_equal(FRAME_CRC_BYTES + 2u, frame_encode(NULL, 0, enc, sizeof(enc)));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_round_trip_all_lengths),
+        cmocka_unit_test(test_split_feed_and_back_to_back),
+        cmocka_unit_test(test_corruption_and_resync),
+        cmocka_unit_test(test_encode_validation),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
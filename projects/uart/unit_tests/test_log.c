@@ -0,0 +1,310 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define deferred binary logging unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "frame_api.h"
+#include "log_api.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define MAX_RECORDS  16u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+// One record as the host decoder sees it
+typedef struct {
+    uint16_t id;
+    uint32_t ts;
+    size_t   nargs;
+    uint32_t args[LOG_ARGS_MAX];
+} rx_record_t;
+
+typedef struct {
+    size_t      count;
+    rx_record_t rec[MAX_RECORDS];
+} rx_log_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_uart, 64, 64);
+static uart_hw_vtable_t s_hw;
+static uart_stub_ctx_t  s_ctx;
+static uint8_t          s_tx_out[1024];
+static log_slot_t       s_slots[4];
+static uint32_t         s_now;
+// Hook run inside log_write(), as an ISR would preempt it
+static void             (*s_now_hook)(void);
+
+// End of the dictionary section; provided by the linker
+extern const char __stop_log_fmt[];
+
+// From log_level_warn.c, built with LOG_LEVEL at LOG_LEVEL_WARN
+void log_level_warn_all(uint32_t n);
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static uint32_t fake_now(void) {
+    if (s_now_hook) {
+        void (*hook)(void) = s_now_hook;
+        s_now_hook = NULL;
+        hook();
+    }
+    return s_now;
+}
+
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    memset(&s_ctx, 0, sizeof(s_ctx));
+    s_ctx.ptx_buf = s_tx_out;
+    s_ctx.tx_capacity = sizeof(s_tx_out);
+    s_ctx.tx_bytes = (int)sizeof(s_tx_out);
+    uart_hw_stub_create(&s_hw, &s_ctx);
+    assert_true(uart_init_instance(&s_uart, &s_hw, 115200));
+    assert_true(log_init(s_slots, 4u, fake_now));
+    s_now = 1000u;
+    s_now_hook = NULL;
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t get_varint(const uint8_t *p, size_t len, size_t *ppos) {
+    uint32_t v = 0;
+    for (unsigned shift = 0; *ppos < len; shift += 7u) {
+        uint8_t b = p[(*ppos)++];
+        v |= (uint32_t)(b & 0x7Fu) << shift;
+        if (!(b & 0x80u)) {
+            break;
+        }
+    }
+    return v;
+}
+
+//------------------------------------------------------------------------------
+static void on_frame(void *pctx, const uint8_t *ppayload, size_t len) {
+    rx_log_t *plog = (rx_log_t*)pctx;
+    assert_true(len >= 3u && plog->count < MAX_RECORDS);
+    rx_record_t *pr = &plog->rec[plog->count++];
+    size_t pos = 2u;
+    pr->id = (uint16_t)(ppayload[0] | (ppayload[1] << 8));
+    pr->ts = get_varint(ppayload, len, &pos);
+    pr->nargs = 0;
+    while (pos < len && pr->nargs < LOG_ARGS_MAX) {
+        pr->args[pr->nargs++] = get_varint(ppayload, len, &pos);
+    }
+}
+
+//------------------------------------------------------------------------------
+static size_t decode_tx(rx_log_t *plog) {
+    static uint8_t buf[FRAME_DECODE_BUF(LOG_PAYLOAD_MAX)];
+    frame_decoder_t dec;
+    memset(plog, 0, sizeof(*plog));
+    frame_decoder_init(&dec, buf, sizeof(buf), on_frame, plog);
+    (void)frame_decoder_feed(&dec, s_tx_out, s_ctx.tx_len);
+    assert_int_equal(0u, dec.crc_errors + dec.malformed);
+    return plog->count;
+}
+
+//------------------------------------------------------------------------------
+// Dictionary entry of a record: "L\x1f<file>\x1f<line>\x1f<format>"
+static const char *entry(uint16_t id) {
+    return &__start_log_fmt[id];
+}
+
+//------------------------------------------------------------------------------
+static const char *entry_format(uint16_t id) {
+    const char *p = entry(id);
+    for (int sep = 0; sep < 3; ++sep) {
+        p = strchr(p, '\x1f');
+        assert_non_null(p);
+        p++;
+    }
+    return p;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_records_round_trip(void **state) {
+    (void)state;
+    rx_log_t rx;
+    LOG_INFO("x=%d y=%u", -5, 7u);
+    s_now = 200000u;
+    LOG_WARN("boot");
+    LOG_DEBUG("gain %f", 1.5f);
+    assert_int_equal(3u, log_pending());
+    // Nothing is formatted or sent until the drain runs
+    assert_int_equal(0u, s_ctx.tx_len);
+
+    assert_int_equal(3u, log_drain(s_uart.pu, 10u));
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(3u, decode_tx(&rx));
+    assert_int_equal(0u, log_pending());
+
+    assert_string_equal("x=%d y=%u", entry_format(rx.rec[0].id));
+    assert_int_equal('I', entry(rx.rec[0].id)[0]);
+    // File basename only, not the build path
+    assert_memory_equal("I\x1ftest_log.c\x1f", entry(rx.rec[0].id), 12u);
+    assert_int_equal(1000u, rx.rec[0].ts);
+    assert_int_equal(2u, rx.rec[0].nargs);
+    assert_int_equal((uint32_t)-5, rx.rec[0].args[0]);
+    assert_int_equal(7u, rx.rec[0].args[1]);
+
+    assert_string_equal("boot", entry_format(rx.rec[1].id));
+    assert_int_equal('W', entry(rx.rec[1].id)[0]);
+    assert_int_equal(200000u, rx.rec[1].ts);
+    assert_int_equal(0u, rx.rec[1].nargs);
+
+    float f = 1.5f;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    assert_string_equal("gain %f", entry_format(rx.rec[2].id));
+    assert_int_equal(bits, rx.rec[2].args[0]);
+}
+
+//------------------------------------------------------------------------------
+static void test_record_is_compact(void **state) {
+    (void)state;
+    s_now = 100u;
+    LOG_INFO("rx %u bytes on channel %u", 12u, 3u);
+    assert_int_equal(1u, log_drain(s_uart.pu, 1u));
+    uart_service_tx(s_uart.pu);
+    // ID 2 + timestamp 1 + arguments 2, plus CRC 2, COBS 1 and delimiter 1
+    assert_int_equal(9u, s_ctx.tx_len);
+}
+
+//------------------------------------------------------------------------------
+static void test_full_ring_drops_and_reports(void **state) {
+    (void)state;
+    rx_log_t rx;
+    for (uint32_t i = 0; i < 6u; ++i) {
+        LOG_INFO("n=%u", i);
+    }
+    assert_int_equal(2u, log_dropped());
+    assert_int_equal(4u, log_pending());
+
+    assert_int_equal(5u, log_drain(s_uart.pu, 10u));
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(5u, decode_tx(&rx));
+    assert_int_equal(LOG_ID_DROPPED, rx.rec[0].id);
+    assert_int_equal(2u, rx.rec[0].args[0]);
+    for (uint32_t i = 0; i < 4u; ++i) {
+        assert_int_equal(i, rx.rec[1u + i].args[0]);
+    }
+
+    // Space again after the drain, and nothing more to report
+    LOG_INFO("n=%u", 6u);
+    assert_int_equal(1u, log_drain(s_uart.pu, 10u));
+    assert_int_equal(2u, log_dropped());
+}
+
+//------------------------------------------------------------------------------
+static void test_drain_sends_whole_frames_only(void **state) {
+    (void)state;
+    rx_log_t rx;
+    // Hardware stalled: only what fits in the 64-byte Tx FIFO goes out
+    s_ctx.tx_bytes = 0;
+    for (uint32_t i = 0; i < 4u; ++i) {
+        LOG_ERROR("fault %u at %x %x %x", i, 0xDEADBEEFu, 0xFFFFFFFFu, 0x12345678u);
+    }
+    size_t first = log_drain(s_uart.pu, 10u);
+    assert_true(first > 0u && first < 4u);
+    assert_int_equal(4u - first, log_pending());
+    assert_true(uart_tx_space(s_uart.pu) < FRAME_ENCODED_MAX(LOG_PAYLOAD_MAX));
+
+    s_ctx.tx_bytes = (int)sizeof(s_tx_out);
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(4u - first, log_drain(s_uart.pu, 10u));
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(4u, decode_tx(&rx));
+    for (uint32_t i = 0; i < 4u; ++i) {
+        assert_int_equal(i, rx.rec[i].args[0]);
+        assert_int_equal(0xDEADBEEFu, rx.rec[i].args[1]);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void isr_logs(void) {
+    LOG_INFO("from isr");
+    // The drain must not pass the preempted record, though the later one
+    // is complete
+    assert_int_equal(0u, log_drain(s_uart.pu, 10u));
+}
+
+static void test_preempted_writer_holds_drain(void **state) {
+    (void)state;
+    rx_log_t rx;
+    s_now_hook = isr_logs;
+    LOG_INFO("from main");
+    assert_int_equal(2u, log_drain(s_uart.pu, 10u));
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(2u, decode_tx(&rx));
+    // Slots go out in reservation order
+    assert_string_equal("from main", entry_format(rx.rec[0].id));
+    assert_string_equal("from isr", entry_format(rx.rec[1].id));
+}
+
+//------------------------------------------------------------------------------
+static void test_below_level_compiles_out(void **state) {
+    (void)state;
+    static const char k_out[] = "compiled out";
+    rx_log_t rx;
+    log_level_warn_all(9u);
+    assert_int_equal(2u, log_drain(s_uart.pu, 10u));
+    uart_service_tx(s_uart.pu);
+    assert_int_equal(2u, decode_tx(&rx));
+    assert_string_equal("kept %u", entry_format(rx.rec[0].id));
+    assert_int_equal(9u, rx.rec[0].args[0]);
+    assert_string_equal("kept", entry_format(rx.rec[1].id));
+
+    // No dictionary entry, so no message ID, for the statements below it
+    for (const char *p = __start_log_fmt;
+            p + sizeof(k_out) - 1u <= __stop_log_fmt; ++p) {
+        assert_false(memcmp(p, k_out, sizeof(k_out) - 1u) == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void test_init_rejects_bad_sizes(void **state) {
+    (void)state;
+    assert_false(log_init(s_slots, 3u, NULL));
+    assert_false(log_init(s_slots, 1u, NULL));
+    assert_false(log_init(NULL, 4u, NULL));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_records_round_trip, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_record_is_compact, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_full_ring_drops_and_reports, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_drain_sends_whole_frames_only, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_preempted_writer_holds_drain, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_below_level_compiles_out, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_init_rejects_bad_sizes, setup, NULL),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,301 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define streaming LZ compression tests
+//
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "lz_api.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define STREAM_MAX  (96u * 1024u)
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_tx, 64, 256);
+UART_DEFINE_INSTANCE(s_rx, 256, 64);
+static lz_encoder_t s_enc;
+static lz_decoder_t s_dec;
+static uint8_t s_raw[STREAM_MAX];
+static uint8_t s_packed[LZ_BOUND(STREAM_MAX)];
+static uint8_t s_back[STREAM_MAX];
+static uint32_t s_rand;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    lz_encoder_init(&s_enc);
+    lz_decoder_init(&s_dec);
+    s_rand = 1u;
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t rnd(void) {
+    s_rand = s_rand * 1103515245u + 12345u;
+    return s_rand >> 8;
+}
+
+//------------------------------------------------------------------------------
+// Telemetry lines like the firmware's; returns the bytes written
+static size_t telemetry(uint8_t *p, size_t cap, uint32_t lines) {
+    size_t n = 0;
+    for (uint32_t i = 0; i < lines && n + 64u < cap; ++i) {
+        n += (size_t)snprintf((char*)&p[n], cap - n,
+            "t=%u v=3.%03u mV i=-%u.%02u mA T=25.%u\r\n",
+            i * 10u, 300u + (i & 0x7Fu), (i % 50u), i % 100u, i % 10u);
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+// Compress in calls of the given sizes (line by line if 0)
+static size_t pack(const uint8_t *p, size_t len, size_t call) {
+    size_t out = 0;
+    size_t i = 0;
+    while (i < len) {
+        size_t n = call;
+        if (!n) {
+            const uint8_t *eol = memchr(&p[i], '\n', len - i);
+            n = eol ? (size_t)(eol - &p[i]) + 1u : len - i;
+        }
+        n = (n < len - i) ? n : len - i;
+        size_t got = 0;
+        assert_int_equal(n, lz_encode(&s_enc, &p[i], n, &s_packed[out],
+            sizeof(s_packed) - out, &got));
+        assert_true(got <= LZ_BOUND(n));
+        out += got;
+        i += n;
+    }
+    return out;
+}
+
+//------------------------------------------------------------------------------
+// Decompress in random splits of input and output
+static size_t unpack(size_t len) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < len || out < sizeof(s_back)) {
+        size_t n = 1u + rnd() % 97u;
+        n = (n < len - in) ? n : len - in;
+        size_t cap = 1u + rnd() % 41u;
+        cap = (cap < sizeof(s_back) - out) ? cap : sizeof(s_back) - out;
+        size_t used = 0;
+        size_t got = lz_decode(&s_dec, &s_packed[in], n, &used, &s_back[out], cap);
+        in += used;
+        out += got;
+        if (in == len && got == 0u) {
+            break;
+        }
+    }
+    return out;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_token_format(void **state) {
+    (void)state;
+    size_t n = 0;
+    // Three literals, then a six byte match overlapping itself at distance 3
+    assert_int_equal(9u, lz_encode(&s_enc, (const uint8_t*)"abcabcabc", 9u,
+        s_packed, sizeof(s_packed), &n));
+    static const uint8_t expect[] = { 0x02, 'a', 'b', 'c', 0x8C, 0x02 };
+    assert_int_equal(sizeof(expect), n);
+    assert_memory_equal(expect, s_packed, n);
+
+    // Later calls reach back: the same bytes again are one match
+    assert_int_equal(9u, lz_encode(&s_enc, (const uint8_t*)"abcabcabc", 9u,
+        s_packed, sizeof(s_packed), &n));
+    static const uint8_t again[] = { 0x98, 0x02 };
+    assert_int_equal(sizeof(again), n);
+    assert_memory_equal(again, s_packed, n);
+}
+
+//------------------------------------------------------------------------------
+static void test_telemetry_round_trip(void **state) {
+    (void)state;
+    size_t len = telemetry(s_raw, sizeof(s_raw), 2000u);
+    size_t packed = pack(s_raw, len, 0u);
+    assert_int_equal(len, unpack(packed));
+    assert_memory_equal(s_raw, s_back, len);
+    // Four fields change per 35 B line; about 2:1 even a line at a time
+    assert_true(lz_ratio_q16(&s_enc.stats) > ((18u << 16) / 10u));
+    assert_int_equal(len, s_enc.stats.in);
+    assert_int_equal(packed, s_enc.stats.out);
+    assert_int_equal(packed, s_dec.stats.in);
+    assert_int_equal(len, s_dec.stats.out);
+}
+
+//------------------------------------------------------------------------------
+static void test_incompressible_within_bound(void **state) {
+    (void)state;
+    for (size_t i = 0; i < 20000u; ++i) {
+        s_raw[i] = (uint8_t)rnd();
+    }
+    size_t packed = pack(s_raw, 20000u, 1000u);
+    assert_true(packed <= 20u * LZ_BOUND(1000u));
+    assert_int_equal(20000u, unpack(packed));
+    assert_memory_equal(s_raw, s_back, 20000u);
+    assert_true(lz_ratio_q16(&s_enc.stats) < (1u << 16));
+}
+
+//------------------------------------------------------------------------------
+static void test_runs_and_call_sizes(void **state) {
+    (void)state;
+    // Runs (distance 1 matches), short repeats, and text, in odd call sizes
+    size_t len = 0;
+    memset(s_raw, 'a', 1000u);
+    len += 1000u;
+    for (uint32_t i = 0; i < 3000u; ++i) {
+        s_raw[len++] = (uint8_t)("xyz"[i % 3u] + (i / 700u));
+    }
+    len += telemetry(&s_raw[len], sizeof(s_raw) - len, 300u);
+    size_t packed = pack(s_raw, len, 7u);
+    assert_int_equal(len, unpack(packed));
+    assert_memory_equal(s_raw, s_back, len);
+
+    // One byte per call still round-trips, at a cost
+    setup(NULL);
+    packed = pack(s_raw, 200u, 1u);
+    assert_int_equal(400u, packed);
+    assert_int_equal(200u, unpack(packed));
+    assert_memory_equal(s_raw, s_back, 200u);
+}
+
+//------------------------------------------------------------------------------
+static void test_window_limit(void **state) {
+    (void)state;
+    uint8_t tag[16];
+    uint8_t filler[LZ_WINDOW];
+    size_t n = 0;
+    for (size_t i = 0; i < sizeof(tag); ++i) {
+        tag[i] = (uint8_t)rnd();
+    }
+    // Zeros: no hash slot of the tag is taken over in between
+    memset(filler, 0, sizeof(filler));
+
+    // Exactly LZ_WINDOW back: matched
+    (void)lz_encode(&s_enc, tag, sizeof(tag), s_packed, sizeof(s_packed), &n);
+    (void)lz_encode(&s_enc, filler, LZ_WINDOW - sizeof(tag), s_packed,
+        sizeof(s_packed), &n);
+    (void)lz_encode(&s_enc, tag, sizeof(tag), s_packed, sizeof(s_packed), &n);
+    assert_int_equal(2u, n);
+    assert_int_equal(0x80u | ((16u - 3u) << 2) | 0x03u, s_packed[0]);
+    assert_int_equal(0xFFu, s_packed[1]);
+
+    // One byte further: out of reach
+    setup(NULL);
+    (void)lz_encode(&s_enc, tag, sizeof(tag), s_packed, sizeof(s_packed), &n);
+    (void)lz_encode(&s_enc, filler, LZ_WINDOW - sizeof(tag) + 1u, s_packed,
+        sizeof(s_packed), &n);
+    (void)lz_encode(&s_enc, tag, sizeof(tag), s_packed, sizeof(s_packed), &n);
+    assert_int_equal(1u + sizeof(tag), n);
+}
+
+//------------------------------------------------------------------------------
+static void test_uart_spans(void **state) {
+    (void)state;
+    uart_hw_vtable_t hw;
+    uart_stub_ctx_t tx_ctx = { 0 };
+    uart_stub_ctx_t rx_ctx = { 0 };
+    static uint8_t wire[8192];
+    tx_ctx.ptx_buf = wire;
+    tx_ctx.tx_capacity = sizeof(wire);
+    // Block reads: Rx polling stops at a full FIFO instead of dropping bytes
+    rx_ctx.block_io = true;
+    assert_true(uart_hw_stub_create_instance(&hw, &tx_ctx, 0u));
+    assert_true(uart_init_instance(&s_tx, &hw, 115200));
+    assert_true(uart_hw_stub_create_instance(&hw, &rx_ctx, 1u));
+    assert_true(uart_init_instance(&s_rx, &hw, 115200));
+
+    // Tx: messages through a 256 B FIFO whose free space wraps, a part at a
+    // time when it fills up
+    size_t len = telemetry(s_raw, sizeof(s_raw), 200u);
+    size_t sent = 0;
+    bool partial = false;
+    while (sent < len) {
+        const uint8_t *eol = memchr(&s_raw[sent], '\n', len - sent);
+        size_t n = (size_t)(eol - &s_raw[sent]) + 1u;
+        size_t k = lz_write(&s_enc, s_tx.pu, &s_raw[sent], n);
+        partial |= (k > 0u && k < n);
+        sent += k;
+        // The line drains a little at a time
+        tx_ctx.tx_bytes = 5;
+        uart_service_tx(s_tx.pu);
+    }
+    tx_ctx.tx_bytes = (int)sizeof(wire);
+    uart_service_tx(s_tx.pu);
+    assert_true(partial);
+    assert_int_equal(0u, uart_tx_queued(s_tx.pu));
+    assert_int_equal(s_enc.stats.out, tx_ctx.tx_len);
+
+    // Rx: the wire bytes through a 256 B FIFO, read out in small pieces so
+    // matches are split across calls
+    rx_ctx.prx_src = wire;
+    rx_ctx.rx_len = tx_ctx.tx_len;
+    size_t got = 0;
+    while (got < len) {
+        (void)uart_poll_rx(s_rx.pu);
+        size_t k = lz_read(&s_dec, s_rx.pu, &s_back[got], 1u + rnd() % 40u);
+        got += k;
+        if (k == 0u && rx_ctx.rx_idx == rx_ctx.rx_len &&
+                uart_rx_available(s_rx.pu) == 0u) {
+            break;
+        }
+    }
+    assert_int_equal(len, got);
+    assert_memory_equal(s_raw, s_back, len);
+}
+
+//------------------------------------------------------------------------------
+static void test_ratio(void **state) {
+    (void)state;
+    lz_stats_t st = { 0 };
+    assert_int_equal(1u << 16, lz_ratio_q16(&st));
+    st = (lz_stats_t){ .in = 300u, .out = 100u };
+    assert_int_equal(3u << 16, lz_ratio_q16(&st));
+    st = (lz_stats_t){ .in = 100u, .out = 101u };
+    assert_true(lz_ratio_q16(&st) < (1u << 16));
+
+    // Nothing accepted without room for the worst case
+    size_t n = 0;
+    assert_int_equal(0u, lz_encode(&s_enc, (const uint8_t*)"abc", 3u, s_packed, 0u, &n));
+    assert_int_equal(1u, lz_encode(&s_enc, (const uint8_t*)"abc", 3u, s_packed, 2u, &n));
+    assert_int_equal(2u, n);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_token_format, setup),
+        cmocka_unit_test_setup(test_telemetry_round_trip, setup),
+        cmocka_unit_test_setup(test_incompressible_within_bound, setup),
+        cmocka_unit_test_setup(test_runs_and_call_sizes, setup),
+        cmocka_unit_test_setup(test_window_limit, setup),
+        cmocka_unit_test_setup(test_uart_spans, setup),
+        cmocka_unit_test_setup(test_ratio, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -78,12 +78,53 @@ static void test_wraparound(void **state) {
     assert_false(ringbuf_pop(&r, &byte));
 }
 
+//------------------------------------------------------------------------------
+static void test_spans_wraparound(void **state) {
+    (void)state;  // silence unused warning
+    uint8_t storage[4];
+    ringbuf_t r;
+    uint8_t *pw = NULL;
+    const uint8_t *pr = NULL;
+    uint8_t byte = 0;
+
+    ringbuf_init(&r, storage, sizeof(storage));
+
+    // Whole storage is one writable span when empty
+    assert_int_equal(4, ringbuf_reserve_span(&r, &pw));
+    memcpy(pw, "ABC", 3);
+    ringbuf_commit(&r, 3);
+    assert_int_equal(3, ringbuf_available(&r));
+
+    // Read two in place
+    assert_int_equal(3, ringbuf_peek_span(&r, &pr));
+    assert_memory_equal("AB", pr, 2);
+    ringbuf_consume(&r, 2);
+
+    // Free space wraps: one byte up to the end, then one at the start
+    assert_int_equal(1, ringbuf_reserve_span(&r, &pw));
+    *pw = 'D';
+    ringbuf_commit(&r, 1);
+    assert_int_equal(2, ringbuf_reserve_span(&r, &pw));
+    assert_ptr_equal(storage, pw);
+    *pw = 'E';
+    ringbuf_commit(&r, 1);
+
+    // Data wraps too: span stops at the end of storage
+    assert_int_equal(2, ringbuf_peek_span(&r, &pr));
+    assert_memory_equal("CD", pr, 2);
+    ringbuf_consume(&r, 2);
+    assert_true(ringbuf_pop(&r, &byte));
+    assert_int_equal('E', byte);
+    assert_int_equal(0, ringbuf_peek_span(&r, &pr));
+}
+
 //------------------------------------------------------------------------------
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_push_pop),
         cmocka_unit_test(test_overflow),
         cmocka_unit_test(test_wraparound),
+        cmocka_unit_test(test_spans_wraparound),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
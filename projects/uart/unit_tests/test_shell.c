@@ -0,0 +1,362 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define command shell unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "shell_api.h"
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define LINE_BYTES     32u
+#define CAPTURE_BYTES  16384u
+#define MANY_CMDS      300u  // plus help
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+// Generated from test_shell.cmds and a synthetic list of MANY_CMDS commands
+extern const shell_table_t g_test_cmds;
+extern const shell_table_t g_many_cmds;
+
+UART_DEFINE_INSTANCE(s_uart, 64, 64);
+static uart_stub_ctx_t s_ctx;
+static uint8_t s_out[CAPTURE_BYTES + 1u];
+static char s_line[LINE_BYTES];
+static shell_t s_sh;
+
+//------------------------------------------------------------------------------
+// Command Handlers
+//------------------------------------------------------------------------------
+int cmd_echo(shell_t *psh, int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        (void)shell_printf(psh, "%s<%s>", (i > 1) ? " " : "", argv[i]);
+    }
+    (void)shell_write(psh, "\r\n", 2u);
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+int cmd_add(shell_t *psh, int argc, char **argv) {
+    if (argc != 3) {
+        return SHELL_ERR_USAGE;
+    }
+    (void)shell_printf(psh, "%ld\r\n", strtol(argv[1], NULL, 0) +
+        strtol(argv[2], NULL, 0));
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+int cmd_fail(shell_t *psh, int argc, char **argv) {
+    (void)psh;
+    (void)argc;
+    (void)argv;
+    return -5;
+}
+
+//------------------------------------------------------------------------------
+// More lines than the Tx FIFO holds, a few per call
+int cmd_count(shell_t *psh, int argc, char **argv) {
+    if (argc != 2) {
+        return SHELL_ERR_USAGE;
+    }
+    uint32_t n = (uint32_t)strtoul(argv[1], NULL, 0);
+    uint32_t *pi = shell_state(psh);
+    while (*pi < n) {
+        if (shell_tx_space(psh) < 12u) {
+            return SHELL_MORE;
+        }
+        (void)shell_printf(psh, "%u\r\n", *pi);
+        (*pi)++;
+    }
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+int cmd_many(shell_t *psh, int argc, char **argv) {
+    (void)argc;
+    (void)shell_printf(psh, "ran %s\r\n", argv[0]);
+    return SHELL_OK;
+}
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+static void start(const shell_table_t *ptable) {
+    uart_hw_vtable_t hw;
+    memset(s_out, 0, sizeof(s_out));
+    s_ctx = (uart_stub_ctx_t){ .ptx_buf = s_out, .tx_capacity = CAPTURE_BYTES };
+    uart_hw_stub_create(&hw, &s_ctx);
+    assert_true(uart_init_instance(&s_uart, &hw, 115200));
+    assert_true(shell_init(&s_sh, s_uart.pu, ptable, s_line, sizeof(s_line),
+        "> "));
+}
+
+//------------------------------------------------------------------------------
+// Send whatever is queued to the capture buffer
+static void drain(void) {
+    s_ctx.tx_bytes = INT_MAX;
+    uart_service_tx(s_uart.pu);
+    s_ctx.tx_bytes = 0;
+}
+
+//------------------------------------------------------------------------------
+// Type input, then poll and drain until the shell is idle; returns the
+// number of polls taken
+static uint32_t type(const char *ps) {
+    uart_isr_rx_block(s_uart.pu, (const uint8_t*)ps, strlen(ps));
+    uint32_t polls = 0;
+    bool more;
+    do {
+        more = shell_poll(&s_sh);
+        drain();
+        polls++;
+        assert_true(polls < 10000u);
+    } while (more || uart_rx_available(s_uart.pu));
+    return polls;
+}
+
+//------------------------------------------------------------------------------
+// Output captured since the last call, as a string
+static const char *output(void) {
+    static size_t s_taken;
+    static char s_text[CAPTURE_BYTES + 1u];
+    if (s_ctx.tx_len < s_taken) {
+        s_taken = 0;
+    }
+    size_t n = s_ctx.tx_len - s_taken;
+    memcpy(s_text, &s_out[s_taken], n);
+    s_text[n] = '\0';
+    s_taken = s_ctx.tx_len;
+    return s_text;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_tokenize_in_place(void **state) {
+    (void)state;
+    char line[] = "  set \"a b\"  x\\ y \"\" q\\\"t\t end ";
+    char *argv[SHELL_ARGS_MAX];
+    int argc = shell_tokenize(line, argv, SHELL_ARGS_MAX);
+    assert_int_equal(6, argc);
+    assert_string_equal("set", argv[0]);
+    assert_string_equal("a b", argv[1]);
+    assert_string_equal("x y", argv[2]);
+    assert_string_equal("", argv[3]);
+    assert_string_equal("q\"t", argv[4]);
+    assert_string_equal("end", argv[5]);
+    // No copies: every argument lives in the line itself
+    for (int i = 0; i < argc; ++i) {
+        assert_true(argv[i] >= line && argv[i] < line + sizeof(line));
+    }
+
+    char blank[] = " \t ";
+    assert_int_equal(0, shell_tokenize(blank, argv, SHELL_ARGS_MAX));
+    char open[] = "say \"unterminated";
+    assert_int_equal(-1, shell_tokenize(open, argv, SHELL_ARGS_MAX));
+    char lots[] = "a b c d";
+    assert_int_equal(-1, shell_tokenize(lots, argv, 3));
+}
+
+//------------------------------------------------------------------------------
+static void test_find_every_command(void **state) {
+    (void)state;
+    static const char *const names[] = { "help", "echo", "add", "fail", "count" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        const shell_cmd_t *pc = shell_find(&g_test_cmds, names[i],
+            strlen(names[i]));
+        assert_non_null(pc);
+        assert_string_equal(names[i], pc->name);
+    }
+    // Each of the many commands maps to its own entry
+    char name[16];
+    assert_int_equal(MANY_CMDS + 1u, g_many_cmds.count);
+    for (uint32_t i = 0; i < MANY_CMDS; ++i) {
+        int n = snprintf(name, sizeof(name), "cmd%u", i);
+        const shell_cmd_t *pc = shell_find(&g_many_cmds, name, (size_t)n);
+        assert_non_null(pc);
+        assert_string_equal(name, pc->name);
+    }
+    // Names not in the table, including prefixes and extensions of names
+    static const char *const misses[] = {
+        "", "hel", "helpx", "Help", "cmd", "cmd300", "cmd0 ", "cmd1000"
+    };
+    for (size_t i = 0; i < sizeof(misses) / sizeof(misses[0]); ++i) {
+        assert_null(shell_find(&g_test_cmds, misses[i], strlen(misses[i])));
+        assert_null(shell_find(&g_many_cmds, misses[i], strlen(misses[i])));
+    }
+    // Length-bounded: the name need not be terminated
+    assert_non_null(shell_find(&g_test_cmds, "echo hi", 4u));
+}
+
+//------------------------------------------------------------------------------
+static void test_dispatch_and_errors(void **state) {
+    (void)state;
+    start(&g_test_cmds);
+    drain();
+    assert_string_equal("> ", output());
+
+    (void)type("echo a \"b c\" d\\ e\r\n");
+    assert_string_equal("echo a \"b c\" d\\ e\r\n<a> <b c> <d e>\r\n> ",
+        output());
+    (void)type("add 2 40\r");
+    assert_string_equal("add 2 40\r\n42\r\n> ", output());
+    (void)type("add 1\n");
+    assert_string_equal("add 1\r\nusage: add <a> <b>: print a + b\r\n> ",
+        output());
+    (void)type("fail\r\n");
+    assert_string_equal("fail\r\nfail: error -5\r\n> ", output());
+    (void)type("nope 1 2\r\n");
+    assert_string_equal("nope 1 2\r\nnope: command not found\r\n> ", output());
+    (void)type("  \r\n");
+    assert_string_equal("  \r\n> ", output());
+    (void)type("echo \"open\r\n");
+    assert_string_equal(
+        "echo \"open\r\nerror: unbalanced quote or too many arguments\r\n> ",
+        output());
+}
+
+//------------------------------------------------------------------------------
+static void test_line_editing(void **state) {
+    (void)state;
+    start(&g_test_cmds);
+    drain();
+    (void)output();
+
+    // Backspace and delete
+    (void)type("ecx\bho hi!\x7f\r\n");
+    assert_string_equal("ecx\b \bho hi!\b \b\r\n<hi>\r\n> ", output());
+    // Ctrl-U erases the line, Ctrl-C cancels it
+    (void)type("junk\x15" "echo ok\r\n");
+    assert_string_equal("junk\r\x1b[K> echo ok\r\n<ok>\r\n> ", output());
+    (void)type("junk\x03");
+    assert_string_equal("junk^C\r\n> ", output());
+    // Arrow keys and other escape sequences are ignored
+    (void)type("\x1b[A\x1b[1;5Cecho x\r\n");
+    assert_string_equal("echo x\r\n<x>\r\n> ", output());
+
+    // Characters beyond the line buffer are refused with a bell
+    char longline[LINE_BYTES + 8u];
+    memset(longline, 'z', sizeof(longline) - 1u);
+    longline[sizeof(longline) - 1u] = '\0';
+    (void)type(longline);
+    const char *pout = output();
+    assert_int_equal(sizeof(longline) - 1u, strlen(pout));
+    assert_int_equal(LINE_BYTES - 1u, strspn(pout, "z"));
+    assert_int_equal('\a', pout[LINE_BYTES - 1u]);
+    (void)type("\x15");
+    (void)output();
+}
+
+//------------------------------------------------------------------------------
+static void test_streaming_output(void **state) {
+    (void)state;
+    start(&g_test_cmds);
+    drain();
+    (void)output();
+
+    // 200 lines through a 64-byte Tx FIFO, resumed as it drains; input
+    // typed meanwhile waits its turn
+    uint32_t polls = type("count 200\recho after\r");
+    assert_true(polls > 10u);
+    const char *pout = output();
+    char want[16];
+    const char *p = strstr(pout, "\r\n") + 2;
+    for (uint32_t i = 0; i < 200u; ++i) {
+        int n = snprintf(want, sizeof(want), "%u\r\n", i);
+        assert_memory_equal(want, p, (size_t)n);
+        p += n;
+    }
+    assert_string_equal("> echo after\r\n<after>\r\n> ", p);
+
+    // Ctrl-C stops a command that is still producing output
+    uart_isr_rx_block(s_uart.pu, (const uint8_t*)"count 100000\r", 13u);
+    assert_true(shell_poll(&s_sh));
+    for (int i = 0; i < 5; ++i) {
+        drain();
+        assert_true(shell_poll(&s_sh));
+    }
+    uart_isr_rx_block(s_uart.pu, (const uint8_t*)"\x03", 1u);
+    drain();
+    assert_false(shell_poll(&s_sh));
+    drain();
+    pout = output();
+    assert_non_null(strstr(pout, "^C\r\n> "));
+}
+
+//------------------------------------------------------------------------------
+static void test_many_commands(void **state) {
+    (void)state;
+    start(&g_many_cmds);
+    drain();
+    (void)output();
+
+    (void)type("cmd0\r\ncmd299\r\ncmd150\r\n");
+    assert_string_equal(
+        "cmd0\r\nran cmd0\r\n> cmd299\r\nran cmd299\r\n> cmd150\r\nran cmd150\r\n> ",
+        output());
+
+    // help lists every command, streamed through the 64-byte Tx FIFO
+    assert_true(type("help\r\n") > 10u);
+    const char *pout = output();
+    char want[40];
+    for (uint32_t i = 0; i < MANY_CMDS; ++i) {
+        (void)snprintf(want, sizeof(want), "\ncmd%-9u  Command %u\r\n", i, i);
+        assert_non_null(strstr(pout, want));
+    }
+    assert_non_null(strstr(pout, "\nhelp          List commands\r\n"));
+}
+
+//------------------------------------------------------------------------------
+static void test_help_streams_table(void **state) {
+    (void)state;
+    start(&g_test_cmds);
+    drain();
+    (void)output();
+    (void)type("help\r\n");
+    const char *pout = output();
+    assert_non_null(strstr(pout, "help          List commands\r\n"));
+    assert_non_null(strstr(pout, "count         <n>: print 0 to n-1, one line each\r\n"));
+    assert_non_null(strstr(pout, "add           <a> <b>: print a + b\r\n"));
+    size_t lines = 0;
+    for (const char *p = pout; (p = strstr(p, "\r\n")) != NULL; p += 2) {
+        lines++;
+    }
+    // Echoed command line, five commands, no prompt line ending
+    assert_int_equal(6u, lines);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_tokenize_in_place),
+        cmocka_unit_test(test_find_every_command),
+        cmocka_unit_test(test_dispatch_and_errors),
+        cmocka_unit_test(test_line_editing),
+        cmocka_unit_test(test_streaming_output),
+        cmocka_unit_test(test_many_commands),
+        cmocka_unit_test(test_help_streams_table),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
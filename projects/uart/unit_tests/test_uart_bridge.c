@@ -0,0 +1,161 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define UART bridge unit tests
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "uart_core.h"
+#include "uart_bridge.h"
+#include "uart_hw_stub.h"
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+
+static uint32_t fake_now;
+
+static uint32_t fake_clock(void) {
+    return fake_now;
+}
+
+//------------------------------------------------------------------------------
+#define PORT_RX_SIZE  16u
+#define PORT_TX_SIZE  8u
+
+UART_DEFINE_INSTANCE(uart_a, PORT_RX_SIZE, PORT_TX_SIZE);
+UART_DEFINE_INSTANCE(uart_b, PORT_RX_SIZE, PORT_TX_SIZE);
+
+// One end of the bridge: a UART instance on its own stub backend
+typedef struct {
+    uart_t           *pu;
+    uart_hw_vtable_t vtable;
+    uart_stub_ctx_t  ctx;
+    uint8_t          tx_out[256];
+} port_t;
+
+static void port_init(port_t *pp, const uart_instance_t *pi, size_t index) {
+    memset(&pp->ctx, 0, sizeof(pp->ctx));
+    pp->pu = pi->pu;
+    pp->ctx.ptx_buf = pp->tx_out;
+    pp->ctx.tx_capacity = sizeof(pp->tx_out);
+    assert_true(uart_hw_stub_create_instance(&pp->vtable, &pp->ctx, index));
+    assert_true(uart_init_instance(pi, &pp->vtable, 115200));
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_bridge_full_duplex(void **state) {
+    (void)state;  // silence unused warning
+    static port_t A;
+    static port_t B;
+    uart_bridge_t bridge;
+    uint8_t a_src[100];
+    uint8_t b_src[100];
+
+    for (size_t i = 0; i < sizeof(a_src); i++) {
+        a_src[i] = (uint8_t)i;
+        b_src[i] = (uint8_t)(0xFF - i);
+    }
+
+    port_init(&A, &uart_a, 0);
+    port_init(&B, &uart_b, 1);
+    uart_bridge_init(&bridge, A.pu, B.pu, NULL);
+
+    // Interleave bursts on both ports with pumps and line drain: bursts are
+    // larger than the Tx FIFOs, the average rate is below the line rate, and
+    // the FIFOs are smaller than the traffic so every path wraps
+    size_t fed = 0;
+    for (size_t pass = 0; fed < sizeof(a_src) || uart_tx_queued(A.pu) ||
+            uart_tx_queued(B.pu) || uart_rx_available(A.pu) ||
+            uart_rx_available(B.pu); pass++) {
+        for (size_t k = 0; (pass % 3) == 0 && k < 12 && fed < sizeof(a_src);
+                k++, fed++) {
+            uart_isr_rx_byte(A.pu, a_src[fed]);
+            uart_isr_rx_byte(B.pu, b_src[fed]);
+        }
+        // Line time elapses after the pump
+        uart_bridge_pump(&bridge);
+        A.ctx.tx_bytes = 5;
+        B.ctx.tx_bytes = 5;
+        uart_service_tx(A.pu);
+        uart_service_tx(B.pu);
+    }
+
+    // Each direction delivered everything, in order, with nothing dropped
+    assert_int_equal(sizeof(a_src), B.ctx.tx_len);
+    assert_memory_equal(a_src, B.tx_out, sizeof(a_src));
+    assert_int_equal(sizeof(b_src), A.ctx.tx_len);
+    assert_memory_equal(b_src, A.tx_out, sizeof(b_src));
+    assert_int_equal(0, uart_rx_overflow_count(A.pu));
+    assert_int_equal(0, uart_rx_overflow_count(B.pu));
+
+    const uart_bridge_stats_t *pab = uart_bridge_stats(&bridge, UART_BRIDGE_A_TO_B);
+    const uart_bridge_stats_t *pba = uart_bridge_stats(&bridge, UART_BRIDGE_B_TO_A);
+    assert_int_equal(sizeof(a_src), pab->bytes_forwarded);
+    assert_int_equal(sizeof(b_src), pba->bytes_forwarded);
+    assert_true(pab->spans_moved > 0);
+    assert_true(pab->backpressure_events > 0);
+}
+
+//------------------------------------------------------------------------------
+static void test_bridge_backpressure_keeps_data(void **state) {
+    (void)state;  // silence unused warning
+    static port_t A;
+    static port_t B;
+    uart_bridge_t bridge;
+    const uint8_t msg[] = "0123456789AB";
+
+    port_init(&A, &uart_a, 0);
+    port_init(&B, &uart_b, 1);
+    uart_bridge_init(&bridge, A.pu, B.pu, fake_clock);
+    fake_now = 100;
+
+    for (size_t i = 0; i < sizeof(msg) - 1; i++) {
+        uart_isr_rx_byte(A.pu, msg[i]);
+    }
+
+    // Destination line stalled: its Tx FIFO fills, the rest waits in source
+    B.ctx.tx_bytes = 0;
+    assert_int_equal(PORT_TX_SIZE, uart_bridge_pump(&bridge));
+    assert_int_equal(sizeof(msg) - 1 - PORT_TX_SIZE, uart_rx_available(A.pu));
+    assert_int_equal(1, uart_bridge_stats(&bridge, UART_BRIDGE_A_TO_B)->backpressure_events);
+    assert_int_equal(sizeof(msg) - 1,
+        uart_bridge_stats(&bridge, UART_BRIDGE_A_TO_B)->max_backlog_bytes);
+
+    // Line resumes later: remainder forwarded, latency measured end to end
+    fake_now = 130;
+    B.ctx.tx_bytes = 64;
+    uart_service_tx(B.pu);
+    uart_bridge_pump(&bridge);
+    uart_service_tx(B.pu);
+
+    assert_int_equal(sizeof(msg) - 1, B.ctx.tx_len);
+    assert_memory_equal(msg, B.tx_out, sizeof(msg) - 1);
+    assert_int_equal(30, uart_bridge_stats(&bridge, UART_BRIDGE_A_TO_B)->latency_last);
+    assert_int_equal(30, uart_bridge_stats(&bridge, UART_BRIDGE_A_TO_B)->latency_max);
+
+    uart_bridge_stats_clear(&bridge);
+    assert_int_equal(0, uart_bridge_stats(&bridge, UART_BRIDGE_A_TO_B)->bytes_forwarded);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_bridge_full_duplex),
+        cmocka_unit_test(test_bridge_backpressure_keeps_data),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -47,6 +47,18 @@ static uint8_t test_hw_read(void) {
     return 0u;
 }
 
+//------------------------------------------------------------------------------
+typedef struct {
+    size_t calls;
+    size_t last_available;
+} notify_log_t;
+
+static void test_rx_notify(void *pctx, size_t available) {
+    notify_log_t *plog = (notify_log_t*)pctx;
+    plog->calls++;
+    plog->last_available = available;
+}
+
 //------------------------------------------------------------------------------
 // Test Definitions
 //------------------------------------------------------------------------------
@@ -370,6 +382,447 @@ static void test_echo_chunk_config(void **state) {
     assert_memory_equal(rx_src, tx_out, 100);
 }
 
+//------------------------------------------------------------------------------
+static void test_rx_error_counts(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_fifo[8];
+    uint8_t tx_fifo[8];
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+
+    // Each kind is counted separately
+    uart_isr_rx_error(pUART, UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN));
+    uart_isr_rx_error(pUART, UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN) |
+                             UART_RX_ERR_MASK(UART_RX_ERR_FRAMING));
+    uart_isr_rx_error(pUART, UART_RX_ERR_MASK(UART_RX_ERR_PARITY));
+    assert_int_equal(2, uart_rx_error_count(pUART, UART_RX_ERR_OVERRUN));
+    assert_int_equal(1, uart_rx_error_count(pUART, UART_RX_ERR_FRAMING));
+    assert_int_equal(0, uart_rx_error_count(pUART, UART_RX_ERR_NOISE));
+    assert_int_equal(1, uart_rx_error_count(pUART, UART_RX_ERR_PARITY));
+    assert_int_equal(0, uart_rx_error_count(pUART, UART_RX_ERR_KINDS));
+
+    // Marking disabled by default
+    assert_int_equal(0, uart_rx_error_take(pUART));
+
+    uart_rx_error_clear(pUART);
+    assert_int_equal(0, uart_rx_error_count(pUART, UART_RX_ERR_OVERRUN));
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_error_marking(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_fifo[8];
+    uint8_t tx_fifo[8];
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+
+    uart_set_rx_error_marking(pUART, true);
+    uart_isr_rx_error(pUART, UART_RX_ERR_MASK(UART_RX_ERR_NOISE));
+    uart_isr_rx_error(pUART, UART_RX_ERR_MASK(UART_RX_ERR_FRAMING));
+
+    // Latched until taken, then cleared
+    assert_int_equal(
+        UART_RX_ERR_MASK(UART_RX_ERR_NOISE) | UART_RX_ERR_MASK(UART_RX_ERR_FRAMING),
+        uart_rx_error_take(pUART));
+    assert_int_equal(0, uart_rx_error_take(pUART));
+}
+
+//------------------------------------------------------------------------------
+static void test_poll_rx_reports_errors(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_src[] = "abc";
+    uint8_t rx_fifo[8];
+    uint8_t tx_fifo[8];
+    uint8_t out[8];
+
+    CTX.prx_src = rx_src;
+    CTX.rx_len = sizeof(rx_src) - 1;
+    CTX.rx_errors = UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN);
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+    uart_set_rx_error_marking(pUART, true);
+
+    // An overrun does not stall reception: all bytes still arrive
+    assert_int_equal(3, uart_poll_rx(pUART));
+    assert_int_equal(3, uart_read(pUART, out, sizeof(out)));
+    assert_memory_equal(rx_src, out, 3);
+    assert_int_equal(1, uart_rx_error_count(pUART, UART_RX_ERR_OVERRUN));
+    assert_int_equal(
+        UART_RX_ERR_MASK(UART_RX_ERR_OVERRUN), uart_rx_error_take(pUART));
+    // Injected error was cleared by the backend read
+    assert_int_equal(0, CTX.rx_errors);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_batching_threshold_and_timeout(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_fifo[32];
+    uint8_t tx_fifo[8];
+    notify_log_t log = {0};
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+    assert_true(uart_set_rx_batching(pUART, 8, 3, test_rx_notify, &log));
+    assert_int_equal(3, CTX.rx_timeout_chars);
+
+    // No wakeup per byte below threshold
+    for (int i = 0; i < 7; i++) {
+        uart_isr_rx_byte(pUART, (uint8_t)i);
+    }
+    assert_int_equal(0, log.calls);
+
+    // One wakeup on reaching threshold
+    uart_isr_rx_byte(pUART, 7);
+    assert_int_equal(1, log.calls);
+    assert_int_equal(8, log.last_available);
+
+    // Tail of the message is flushed by line silence
+    uart_isr_rx_byte(pUART, 8);
+    uart_isr_rx_byte(pUART, 9);
+    uart_isr_rx_timeout(pUART);
+    assert_int_equal(2, log.calls);
+    assert_int_equal(10, log.last_available);
+
+    // Silence with nothing new received does not wake the consumer
+    uart_isr_rx_timeout(pUART);
+    assert_int_equal(2, log.calls);
+
+    // Disabling turns the backend timeout back off
+    assert_true(uart_set_rx_batching(pUART, 0, 0, NULL, NULL));
+    assert_int_equal(0, CTX.rx_timeout_chars);
+    uart_isr_rx_byte(pUART, 10);
+    uart_isr_rx_timeout(pUART);
+    assert_int_equal(2, log.calls);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_batching_poll_timeout(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_src[] = "ping";
+    uint8_t rx_fifo[16];
+    uint8_t tx_fifo[8];
+    notify_log_t log = {0};
+
+    CTX.prx_src = rx_src;
+    CTX.rx_len = sizeof(rx_src) - 1;
+    CTX.rx_timeout = true;
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+    assert_true(uart_set_rx_batching(pUART, 0, 2, test_rx_notify, &log));
+
+    // Whole request delivered with a single wakeup
+    assert_int_equal(4, uart_poll_rx(pUART));
+    assert_int_equal(1, log.calls);
+    assert_int_equal(4, log.last_available);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_batching_requires_backend_timeout(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uint8_t rx_fifo[8];
+    uint8_t tx_fifo[8];
+    notify_log_t log = {0};
+
+    uart_hw_vtable_t VTable = {
+        .hw_init = test_hw_init,
+        .hw_tx_ready = test_hw_ready,
+        .hw_tx_write = test_hw_write,
+        .hw_rx_available = test_hw_available,
+        .hw_rx_read = test_hw_read,
+    };
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+
+    assert_false(uart_set_rx_batching(pUART, 4, 2, test_rx_notify, &log));
+    // Threshold-only batching needs nothing from the backend
+    assert_true(uart_set_rx_batching(pUART, 4, 0, test_rx_notify, &log));
+    // Nor does disabling batching, whatever timeout comes with it
+    assert_true(uart_set_rx_batching(pUART, 4, 2, NULL, NULL));
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_timestamps_per_batch(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_fifo[16];
+    uint8_t tx_fifo[8];
+    uint8_t out[16];
+    uint32_t ts = 0;
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+    assert_false(uart_rx_arrival(pUART, &ts));
+
+    // First batch arrives at t=100, later bytes of the batch keep that time
+    CTX.now = 100;
+    uart_isr_rx_byte(pUART, 'a');
+    CTX.now = 101;
+    uart_isr_rx_byte(pUART, 'b');
+    // Line silence closes the batch
+    uart_isr_rx_timeout(pUART);
+
+    // Second batch via the DMA/idle path at t=200
+    CTX.now = 200;
+    uart_isr_rx_block(pUART, (const uint8_t*)"cde", 3);
+
+    // Main loop notices late: arrival time still reflects the ISR
+    CTX.now = 500;
+    assert_true(uart_rx_arrival(pUART, &ts));
+    assert_int_equal(100, ts);
+    assert_int_equal(1, uart_read_ts(pUART, out, 1, &ts));
+    assert_int_equal('a', out[0]);
+    assert_int_equal(100, ts);
+    assert_int_equal(2, uart_read_ts(pUART, out, 2, &ts));
+    assert_memory_equal("bc", out, 2);
+    assert_int_equal(100, ts);
+    assert_int_equal(2, uart_read_ts(pUART, out, sizeof(out), &ts));
+    assert_memory_equal("de", out, 2);
+    assert_int_equal(200, ts);
+    assert_false(uart_rx_arrival(pUART, &ts));
+
+    // Data landing in an empty FIFO starts a new batch
+    CTX.now = 300;
+    uart_isr_rx_byte(pUART, 'f');
+    assert_int_equal(1, uart_read_ts(pUART, out, sizeof(out), &ts));
+    assert_int_equal(300, ts);
+
+    // Nothing read: no stale time from the batch just consumed
+    ts = 1;
+    assert_int_equal(0, uart_read_ts(pUART, out, sizeof(out), &ts));
+    assert_int_equal(0, ts);
+    CTX.now = 400;
+    uart_isr_rx_byte(pUART, 'g');
+    assert_int_equal(1, uart_read_ts(pUART, out, sizeof(out), &ts));
+    assert_int_equal(400, ts);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_timestamps_queue_full(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t rx_fifo[64];
+    uint8_t tx_fifo[8];
+    uint8_t byte = 0;
+    uint32_t ts = 0;
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+
+    // One more batch than there are timestamp slots
+    for (uint32_t b = 0; b <= UART_RX_TS_DEPTH; b++) {
+        CTX.now = 10 * (b + 1);
+        uart_isr_rx_byte(pUART, (uint8_t)b);
+        uart_isr_rx_timeout(pUART);
+    }
+
+    // Batches that fit keep their own time; the extra one merges into the last
+    for (uint32_t b = 0; b < UART_RX_TS_DEPTH; b++) {
+        assert_int_equal(1, uart_read_ts(pUART, &byte, 1, &ts));
+        assert_int_equal(b, byte);
+        assert_int_equal(10 * (b + 1), ts);
+    }
+    assert_int_equal(1, uart_read_ts(pUART, &byte, 1, &ts));
+    assert_int_equal(UART_RX_TS_DEPTH, byte);
+    assert_int_equal(10 * UART_RX_TS_DEPTH, ts);
+}
+
+//------------------------------------------------------------------------------
+UART_DEFINE_INSTANCE(test_static_uart, 16, 8);
+
+static void test_define_instance(void **state) {
+    (void)state;  // silence unused warning
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = {0};
+    uint8_t tx_out[8];
+    uint8_t out[4];
+
+    // Exact compile-time footprint, context correctly aligned
+    assert_int_equal(uart_context_size() + 16 + 8, test_static_uart.footprint_bytes);
+    assert_int_equal(UART_INSTANCE_FOOTPRINT(16, 8), test_static_uart.footprint_bytes);
+    assert_int_equal(0, (uintptr_t)test_static_uart.pu % _Alignof(struct uart_t));
+    assert_int_equal(16, test_static_uart.rx_size);
+    assert_int_equal(8, test_static_uart.tx_size);
+
+    CTX.ptx_buf = tx_out;
+    CTX.tx_capacity = sizeof(tx_out);
+    CTX.tx_bytes = 8;
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_true(uart_init_instance(&test_static_uart, &VTable, 115200));
+
+    // Instance is usable through the normal API
+    uart_isr_rx_byte(test_static_uart.pu, 'x');
+    uart_echo_pump(test_static_uart.pu);
+    assert_int_equal(1, CTX.tx_len);
+    assert_int_equal('x', tx_out[0]);
+    assert_int_equal(0, uart_read(test_static_uart.pu, out, sizeof(out)));
+}
+
+//------------------------------------------------------------------------------
+static void test_block_io(void **state) {
+    (void)state;  // silence unused warning
+    size_t usize = uart_context_size();
+    uint8_t ustore[usize];
+    uart_t *pUART = (uart_t*)ustore;
+    uart_hw_vtable_t VTable;
+    uart_stub_ctx_t CTX = { .block_io = true };
+    uint8_t rx_fifo[8];
+    uint8_t tx_fifo[8];
+    uint8_t tx_out[16] = {0};
+    uint8_t out[16];
+    uint32_t ts = 0;
+    const uint8_t rx_src[] = "0123456789AB";
+
+    uart_hw_stub_create(&VTable, &CTX);
+    assert_non_null(VTable.hw_rx_read_block);
+    assert_true(
+        uart_init(
+            pUART,
+            &VTable,
+            115200,
+            rx_fifo,
+            sizeof(rx_fifo),
+            tx_fifo,
+            sizeof(tx_fifo)));
+    CTX.prx_src = rx_src;
+    CTX.rx_len = 12;
+    CTX.ptx_buf = tx_out;
+    CTX.tx_capacity = sizeof(tx_out);
+
+    // Move the FIFO indices so the free space wraps: two segments, one batch
+    CTX.rx_len = 3;
+    CTX.now = 50;
+    assert_int_equal(3, uart_poll_rx(pUART));
+    assert_int_equal(3, uart_read(pUART, out, sizeof(out)));
+    CTX.rx_len = 12;
+    CTX.rx_block_calls = 0;
+    CTX.now = 100;
+    assert_int_equal(8, uart_poll_rx(pUART));
+    assert_int_equal(2, CTX.rx_block_calls);
+    // What did not fit stays in the backend rather than overflowing
+    assert_int_equal(0, uart_rx_overflow_count(pUART));
+    assert_int_equal(8, uart_read_ts(pUART, out, sizeof(out), &ts));
+    assert_memory_equal("3456789A", out, 8);
+    assert_int_equal(100, ts);
+    assert_int_equal(1, uart_poll_rx(pUART));
+    assert_int_equal(1, uart_read(pUART, out, sizeof(out)));
+    assert_int_equal('B', out[0]);
+
+    // Tx goes out a segment at a time until the backend pushes back
+    CTX.tx_bytes = 5;
+    assert_int_equal(8, uart_write(pUART, (const uint8_t*)"abcdefgh", 8));
+    assert_int_equal(5, CTX.tx_len);
+    assert_int_equal(3, uart_tx_queued(pUART));
+    CTX.tx_bytes = 100;
+    CTX.tx_block_calls = 0;
+    uart_service_tx(pUART);
+    assert_int_equal(0, uart_tx_queued(pUART));
+    assert_memory_equal("abcdefgh", tx_out, 8);
+    assert_int_equal(1, CTX.tx_block_calls);
+}
+
 //------------------------------------------------------------------------------
 int main(void) {
     const struct CMUnitTest tests[] = {
@@ -379,6 +832,16 @@ int main(void) {
         cmocka_unit_test(test_tx_limiting),
         cmocka_unit_test(test_overflow_count),
         cmocka_unit_test(test_echo_chunk_config),
+        cmocka_unit_test(test_rx_error_counts),
+        cmocka_unit_test(test_rx_error_marking),
+        cmocka_unit_test(test_poll_rx_reports_errors),
+        cmocka_unit_test(test_rx_batching_threshold_and_timeout),
+        cmocka_unit_test(test_rx_batching_poll_timeout),
+        cmocka_unit_test(test_rx_batching_requires_backend_timeout),
+        cmocka_unit_test(test_rx_timestamps_per_batch),
+        cmocka_unit_test(test_rx_timestamps_queue_full),
+        cmocka_unit_test(test_define_instance),
+        cmocka_unit_test(test_block_io),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -0,0 +1,280 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define STM32H5 UART backend tests on the register-level peripheral model
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "gpio_api.h"
+#include "uart_core.h"
+#include "uart_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define BAUD        115200u
+#define US          1000u
+#define USART(off)  REG32(USART3_BASE + (off))
+#define GPIO(port, off) \
+    REG32(GPIOA_BASE + (uintptr_t)(port) * GPIO_PORT_STRIDE + (off))
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_uart, 256, 256);
+static size_t s_notify_calls;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    uart_hw_vtable_t hw;
+    periph_sim_reset();
+    uart_hw_install(&hw);
+    assert_true(uart_init_instance(&s_uart, &hw, BAUD));
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Run poll/echo/service every period_ns until duration_ns has passed
+static void run_loop(uint64_t period_ns, uint64_t duration_ns, bool echo) {
+    uint64_t end = periph_sim_now() + duration_ns;
+    while (periph_sim_now() < end) {
+        (void)uart_poll_rx(s_uart.pu);
+        if (echo) {
+            uart_echo_pump(s_uart.pu);
+        }
+        uart_service_tx(s_uart.pu);
+        periph_sim_advance(period_ns);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void on_batch(void *pctx, size_t available) {
+    (void)pctx;
+    (void)available;
+    s_notify_calls++;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_init_registers(void **state) {
+    (void)state;
+    // 64 MHz / 115200, rounded
+    assert_int_equal(556u, USART(USART_BRR_OFFSET));
+    assert_int_equal(115107u, periph_sim_usart_baud());
+    assert_int_equal(86875u, periph_sim_usart_char_ns());
+    assert_int_equal(USART_CR1_TE | USART_CR1_RE | USART_CR1_UE,
+        USART(USART_CR1_OFFSET));
+    assert_true(REG32(RCC_APB1LENR_ADDR) & RCC_EN_USART3);
+    assert_true(REG32(RCC_AHB2ENR_ADDR) & RCC_EN_GPIOD);
+    // No side effects beyond the UART: the cycle counter is left alone
+    assert_false(REG32(DCB_DEMCR_ADDR) & DCB_DEMCR_TRCENA);
+    // PD8/PD9 on AF7, high speed, pull-up
+    assert_int_equal(0xAu << 16, GPIO(GPIO_PORT_D, GPIO_MODER_OFFSET) & (0xFu << 16));
+    assert_int_equal(0x77u, GPIO(GPIO_PORT_D, GPIO_AFRH_OFFSET) & 0xFFu);
+    assert_int_equal(0x5u << 16, GPIO(GPIO_PORT_D, GPIO_PUPDR_OFFSET) & (0xFu << 16));
+
+    periph_sim_stats_t st;
+    periph_sim_stats(&st);
+    assert_int_equal(0u, st.unclocked);
+}
+
+//------------------------------------------------------------------------------
+static void test_tx_flag_timing(void **state) {
+    (void)state;
+    uint8_t out[8];
+    uint32_t char_ns = periph_sim_usart_char_ns();
+    assert_int_equal(5u, uart_write(s_uart.pu, (const uint8_t*)"hello", 5u));
+
+    // Shift register and TDR take two bytes, then TXE drops
+    assert_int_equal(3u, uart_tx_queued(s_uart.pu));
+    assert_false(USART(USART_ISR_OFFSET) & USART_ISR_TXE_TXFNF);
+    assert_false(USART(USART_ISR_OFFSET) & USART_ISR_TC);
+    assert_int_equal(0u, periph_sim_usart_tx_take(out, sizeof(out)));
+
+    periph_sim_advance(char_ns);
+    assert_int_equal(1u, periph_sim_usart_tx_take(out, sizeof(out)));
+    assert_int_equal('h', out[0]);
+
+    run_loop(10u * US, 1000u * US, false);
+    assert_int_equal(4u, periph_sim_usart_tx_take(out, sizeof(out)));
+    assert_memory_equal("ello", out, 4u);
+    assert_true(USART(USART_ISR_OFFSET) & USART_ISR_TC);
+
+    periph_sim_stats_t st;
+    periph_sim_stats(&st);
+    assert_int_equal(0u, st.tdr_overwrites);
+}
+
+//------------------------------------------------------------------------------
+static void test_tx_irq_one_shot(void **state) {
+    (void)state;
+    assert_int_equal(5u, uart_write(s_uart.pu, (const uint8_t*)"hello", 5u));
+    uart_hw_arm_tx_irq();
+    assert_true(USART(USART_CR1_OFFSET) & USART_CR1_TXEIE);
+
+    // No room until the shift register takes the byte waiting in TDR
+    assert_false(uart_hw_tx_irq_fired());
+    periph_sim_advance(periph_sim_usart_char_ns());
+    assert_true(uart_hw_tx_irq_fired());
+
+    // Disarmed: TXE still set, but no further interrupt until re-armed
+    assert_false(USART(USART_CR1_OFFSET) & USART_CR1_TXEIE);
+    assert_true(USART(USART_ISR_OFFSET) & USART_ISR_TXE_TXFNF);
+    assert_false(uart_hw_tx_irq_fired());
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_overrun_and_recovery(void **state) {
+    (void)state;
+    uint8_t out[8];
+    // Three back-to-back bytes with nobody reading: RDR holds 'a', 'b' sets
+    // ORE, and the receiver drops 'c' until ORE is cleared
+    periph_sim_usart_rx((const uint8_t*)"abc", 3u, 0u);
+    periph_sim_advance(4u * periph_sim_usart_char_ns());
+    (void)uart_poll_rx(s_uart.pu);
+    assert_int_equal(1u, uart_read(s_uart.pu, out, sizeof(out)));
+    assert_int_equal('a', out[0]);
+    assert_int_equal(1u, uart_rx_error_count(s_uart.pu, UART_RX_ERR_OVERRUN));
+
+    // Backend cleared ORE: polling faster than a character loses nothing
+    periph_sim_usart_rx((const uint8_t*)"xyz", 3u, 0u);
+    run_loop(20u * US, 400u * US, false);
+    assert_int_equal(3u, uart_read(s_uart.pu, out, sizeof(out)));
+    assert_memory_equal("xyz", out, 3u);
+
+    periph_sim_stats_t st;
+    periph_sim_stats(&st);
+    assert_int_equal(2u, st.rx_lost);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_fifo_mode(void **state) {
+    (void)state;
+    uint8_t out[8];
+    // FIFOEN may only change while the USART is disabled
+    uint32_t cr1 = USART(USART_CR1_OFFSET);
+    USART(USART_CR1_OFFSET) = cr1 & ~USART_CR1_UE;
+    USART(USART_CR1_OFFSET) = cr1 | USART_CR1_FIFOEN;
+
+    periph_sim_usart_rx((const uint8_t*)"abcdefgh", 8u, 0u);
+    periph_sim_advance(9u * periph_sim_usart_char_ns());
+    (void)uart_poll_rx(s_uart.pu);
+    assert_int_equal(8u, uart_read(s_uart.pu, out, sizeof(out)));
+    assert_memory_equal("abcdefgh", out, 8u);
+    assert_int_equal(0u, uart_rx_error_count(s_uart.pu, UART_RX_ERR_OVERRUN));
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_timeout_and_errors(void **state) {
+    (void)state;
+    s_notify_calls = 0;
+    // Cycle counter on, as the timebase or scheduler startup would leave it
+    REG32(DCB_DEMCR_ADDR) |= DCB_DEMCR_TRCENA;
+    REG32(DWT_CTRL_ADDR) |= DWT_CTRL_CYCCNTENA;
+    assert_true(uart_set_rx_batching(s_uart.pu, 0u, 3u, on_batch, NULL));
+    assert_true(REG32(USART3_BASE + USART_CR2_OFFSET) & USART_CR2_RTOEN);
+    assert_int_equal(30u, USART(USART_RTOR_OFFSET) & USART_RTOR_RTO_MASK);
+
+    periph_sim_usart_rx((const uint8_t*)"ab", 2u, USART_ISR_FE);
+    run_loop(20u * US, 1000u * US, false);
+    assert_int_equal(1u, s_notify_calls);
+    assert_int_equal(1u, uart_rx_error_count(s_uart.pu, UART_RX_ERR_FRAMING));
+    assert_int_equal(0u, USART(USART_ISR_OFFSET) & USART_ISR_RX_ERRORS);
+
+    // Arrival timestamps come from the DWT cycle counter
+    uint32_t ts = 0;
+    assert_true(uart_rx_arrival(s_uart.pu, &ts));
+    assert_true(ts > 0u);
+}
+
+//------------------------------------------------------------------------------
+static void test_clock_gating_and_gpio(void **state) {
+    (void)state;
+    gpio_pin_t pin = GPIO_PIN(GPIO_PORT_B, 0u);
+    gpio_config_t cfg = { .mode = GPIO_MODE_OUTPUT };
+    periph_sim_stats_t st;
+    periph_sim_reset();
+    gpio_init();
+
+    // Registers read zero and ignore writes until their clock is on
+    USART(USART_BRR_OFFSET) = 556u;
+    assert_int_equal(0u, USART(USART_BRR_OFFSET));
+    gpio.write(pin, 1u);
+    assert_int_equal(0u, GPIO(GPIO_PORT_B, GPIO_ODR_OFFSET));
+    periph_sim_stats(&st);
+    assert_int_equal(4u, st.unclocked);
+
+    // Configuring the pin enables its port clock
+    assert_true(gpio.configure(pin, &cfg));
+    gpio.write(pin, 1u);
+    assert_int_equal(1u, GPIO(GPIO_PORT_B, GPIO_ODR_OFFSET));
+    gpio.toggle(pin);
+    assert_int_equal(0u, GPIO(GPIO_PORT_B, GPIO_IDR_OFFSET));
+    gpio.write_mask(GPIO_PORT_B, 0x3u, 0x2u);
+    assert_int_equal(0x2u, GPIO(GPIO_PORT_B, GPIO_ODR_OFFSET));
+    gpio.set_mask(GPIO_PORT_B, 0x5u);
+    assert_int_equal(0x7u, GPIO(GPIO_PORT_B, GPIO_ODR_OFFSET));
+    gpio.clear_mask(GPIO_PORT_B, 0x6u);
+    assert_int_equal(0x1u, GPIO(GPIO_PORT_B, GPIO_ODR_OFFSET));
+    periph_sim_stats(&st);
+    assert_int_equal(4u, st.unclocked);
+}
+
+//------------------------------------------------------------------------------
+static void test_echo_access_budget(void **state) {
+    (void)state;
+    static uint8_t data[64];
+    uint8_t out[64];
+    periph_sim_stats_t st0;
+    periph_sim_stats_t st1;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 3u + 1u);
+    }
+    periph_sim_stats(&st0);
+    periph_sim_usart_rx(data, sizeof(data), 0u);
+    // Poll at half a character time, as a busy main loop would
+    run_loop(periph_sim_usart_char_ns() / 2u,
+        (sizeof(data) + 4u) * periph_sim_usart_char_ns(), true);
+    assert_int_equal(sizeof(data), periph_sim_usart_tx_take(out, sizeof(out)));
+    assert_memory_equal(data, out, sizeof(data));
+    periph_sim_stats(&st1);
+    assert_int_equal(0u, st1.rx_lost);
+    assert_int_equal(0u, st1.tdr_overwrites);
+    // Register traffic of the whole echo path, per byte
+    uint64_t per_byte = (st1.accesses - st0.accesses) / sizeof(data);
+    print_message("echo: %llu register accesses per byte\n",
+        (unsigned long long)per_byte);
+    assert_true(per_byte <= 16u);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_init_registers, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_tx_flag_timing, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_tx_irq_one_shot, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_rx_overrun_and_recovery, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_rx_fifo_mode, setup, NULL),
+        cmocka_unit_test_setup_teardown(test_rx_timeout_and_errors, setup, NULL),
+        cmocka_unit_test(test_clock_gating_and_gpio),
+        cmocka_unit_test_setup_teardown(test_echo_access_budget, setup, NULL),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,247 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define Linux UART backend tests, run against a pty pair
+//
+//------------------------------------------------------------------------------
+
+// posix_openpt() and friends
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "uart_core.h"
+#include "uart_hw.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define FIFO_BYTES   4096u
+#define BULK_BYTES   3000u
+#define WAIT_MS      1000
+
+//------------------------------------------------------------------------------
+// Test Fixture
+//------------------------------------------------------------------------------
+typedef struct {
+    int master;
+    char slave[64];
+    uart_hw_vtable_t hw;
+    uint8_t ustore[sizeof(struct uart_t)];
+    uart_t *pu;
+    uint8_t rx_fifo[FIFO_BYTES];
+    uint8_t tx_fifo[FIFO_BYTES];
+} pty_fixture_t;
+
+static pty_fixture_t FX;
+
+//------------------------------------------------------------------------------
+static int setup(void **state) {
+    (void)state;
+    memset(&FX, 0, sizeof(FX));
+    FX.master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (FX.master < 0 || grantpt(FX.master) != 0 || unlockpt(FX.master) != 0 ||
+            ptsname_r(FX.master, FX.slave, sizeof(FX.slave)) != 0) {
+        return -1;
+    }
+    uart_hw_install(&FX.hw);
+    uart_hw_set_device(FX.slave);
+    FX.pu = (uart_t*)FX.ustore;
+    return uart_init(FX.pu, &FX.hw, 115200, FX.rx_fifo, sizeof(FX.rx_fifo),
+        FX.tx_fifo, sizeof(FX.tx_fifo)) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+static int teardown(void **state) {
+    (void)state;
+    uart_hw_close();
+    (void)close(FX.master);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Read exactly len bytes from the pty master, waiting as needed
+static size_t master_read(uint8_t *pout, size_t len) {
+    size_t got = 0;
+    while (got < len) {
+        struct pollfd pfd = { .fd = FX.master, .events = POLLIN };
+        if (poll(&pfd, 1, WAIT_MS) != 1) {
+            break;
+        }
+        ssize_t n = read(FX.master, &pout[got], len - got);
+        if (n <= 0) {
+            break;
+        }
+        got += (size_t)n;
+    }
+    return got;
+}
+
+//------------------------------------------------------------------------------
+static void fill_pattern(uint8_t *p, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        p[i] = (uint8_t)(i * 7u + 3u);
+    }
+}
+
+//------------------------------------------------------------------------------
+typedef struct {
+    size_t calls;
+    size_t last_available;
+} notify_log_t;
+
+static void on_rx_notify(void *pctx, size_t available) {
+    notify_log_t *plog = (notify_log_t*)pctx;
+    plog->calls++;
+    plog->last_available = available;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_init_validation(void **state) {
+    (void)state;
+    // Rates without a termios constant, and missing devices, are refused
+    assert_false(uart_hw_reinit(12345));
+    uart_hw_set_device("/nonexistent/tty");
+    assert_false(uart_hw_reinit(115200));
+    assert_int_equal(-1, uart_hw_fd());
+    assert_int_equal(-1, uart_hw_wait(0));
+
+    uart_hw_set_device(FX.slave);
+    assert_true(uart_hw_reinit(921600));
+    assert_true(uart_hw_fd() >= 0);
+    assert_true(uart_hw_epoll_fd() >= 0);
+    // Idle line: nothing to report
+    assert_int_equal(0, uart_hw_wait(0));
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_bulk(void **state) {
+    (void)state;
+    uint8_t src[BULK_BYTES];
+    uint8_t out[BULK_BYTES];
+    fill_pattern(src, sizeof(src));
+    assert_int_equal(sizeof(src), write(FX.master, src, sizeof(src)));
+
+    // Whole kernel reads land straight in the Rx FIFO
+    size_t got = 0;
+    for (int i = 0; i < 100 && got < sizeof(src); ++i) {
+        int ev = uart_hw_wait(WAIT_MS);
+        assert_true(ev >= 0);
+        if (ev & UART_HW_EV_RX) {
+            got += uart_poll_rx(FX.pu);
+        }
+    }
+    assert_int_equal(sizeof(src), got);
+    assert_int_equal(0, uart_rx_overflow_count(FX.pu));
+    assert_int_equal(sizeof(src), uart_read(FX.pu, out, sizeof(out)));
+    assert_memory_equal(src, out, sizeof(src));
+}
+
+//------------------------------------------------------------------------------
+static void test_tx_bulk(void **state) {
+    (void)state;
+    uint8_t src[BULK_BYTES];
+    uint8_t out[BULK_BYTES];
+    fill_pattern(src, sizeof(src));
+
+    assert_int_equal(sizeof(src), uart_write(FX.pu, src, sizeof(src)));
+    assert_int_equal(0, uart_tx_queued(FX.pu));
+    assert_int_equal(sizeof(src), master_read(out, sizeof(out)));
+    assert_memory_equal(src, out, sizeof(src));
+}
+
+//------------------------------------------------------------------------------
+static void test_tx_backpressure(void **state) {
+    (void)state;
+    uint8_t chunk[1024];
+    fill_pattern(chunk, sizeof(chunk));
+
+    // Nobody reads the master, so the pty eventually stops taking data
+    size_t sent = 0;
+    for (int i = 0; i < 4096 && uart_tx_queued(FX.pu) == 0u; ++i) {
+        sent += uart_write(FX.pu, chunk, sizeof(chunk));
+    }
+    size_t queued = uart_tx_queued(FX.pu);
+    assert_true(queued > 0u);
+    assert_false(uart_hw_wait(0) & UART_HW_EV_TX);
+
+    // Drain the far end: writable again, the core catches up
+    uint8_t sink[4096];
+    size_t drained = 0;
+    for (int i = 0; i < 10000 && drained < sent; ++i) {
+        drained += master_read(sink, sizeof(sink) < sent - drained ?
+            sizeof(sink) : sent - drained);
+        int ev = uart_hw_wait(0);
+        assert_true(ev >= 0);
+        if (ev & UART_HW_EV_TX) {
+            uart_service_tx(FX.pu);
+        }
+    }
+    assert_int_equal(sent, drained);
+    assert_int_equal(0, uart_tx_queued(FX.pu));
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_timeout(void **state) {
+    (void)state;
+    notify_log_t log = {0};
+    // ~0.9 ms of silence at 115200 baud
+    assert_true(uart_set_rx_batching(FX.pu, 0, 10, on_rx_notify, &log));
+    assert_int_equal(5, write(FX.master, "hello", 5));
+
+    for (int i = 0; i < 100 && log.calls == 0u; ++i) {
+        assert_true(uart_hw_wait(WAIT_MS) >= 0);
+        (void)uart_poll_rx(FX.pu);
+    }
+    assert_int_equal(1, log.calls);
+    assert_int_equal(5, log.last_available);
+
+    // No further data, no further notifications
+    assert_int_equal(0, uart_hw_wait(5));
+    (void)uart_poll_rx(FX.pu);
+    assert_int_equal(1, log.calls);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_timestamps(void **state) {
+    (void)state;
+    uint8_t out[8];
+    uint32_t ts = 0;
+    uint32_t before = FX.hw.hw_timestamp();
+    assert_int_equal(3, write(FX.master, "abc", 3));
+    assert_true(uart_hw_wait(WAIT_MS) & UART_HW_EV_RX);
+    assert_int_equal(3, uart_poll_rx(FX.pu));
+    assert_int_equal(3, uart_read_ts(FX.pu, out, sizeof(out), &ts));
+    assert_memory_equal("abc", out, 3);
+    assert_true((int32_t)(ts - before) >= 0);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_init_validation, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_rx_bulk, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_tx_bulk, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_tx_backpressure, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_rx_timeout, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_rx_timestamps, setup, teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
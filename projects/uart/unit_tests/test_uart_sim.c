@@ -0,0 +1,248 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define UART core tests on the virtual-time simulator backend
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "uart_core.h"
+#include "uart_sim.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define BAUD        115200u
+// 10 bits at 115200 baud, rounded
+#define CHAR_NS     86806u
+#define US          1000u
+#define LAT_SAMPLES 4096u
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_uart, 256, 256);
+static uart_sim_t s_sim;
+static uint32_t s_rx_lat[LAT_SAMPLES];
+static uint32_t s_echo_lat[LAT_SAMPLES];
+static uart_sim_lat_t s_rx_l;
+static uart_sim_lat_t s_echo_l;
+static size_t s_notify_calls;
+static size_t s_notify_bytes;
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+static void setup_sim(uint32_t rx_depth, uint32_t tx_depth, uint32_t access_ns,
+        uint8_t *pcapture, size_t capture_cap) {
+    uart_hw_vtable_t hw;
+    uart_sim_config_t cfg = {
+        .rx_fifo_depth = rx_depth,
+        .tx_fifo_depth = tx_depth,
+        .access_ns = access_ns,
+        .ptx_capture = pcapture,
+        .tx_capture_cap = capture_cap,
+    };
+    assert_true(uart_sim_create(&hw, &s_sim, &cfg));
+    assert_true(uart_init_instance(&s_uart, &hw, BAUD));
+    s_rx_l = (uart_sim_lat_t){ s_rx_lat, LAT_SAMPLES, 0 };
+    s_echo_l = (uart_sim_lat_t){ s_echo_lat, LAT_SAMPLES, 0 };
+    uart_sim_set_latency(&s_sim, &s_rx_l, &s_echo_l);
+}
+
+//------------------------------------------------------------------------------
+// Main loop bodies
+static void step_tx(void *pctx) {
+    (void)pctx;
+    uart_service_tx(s_uart.pu);
+}
+
+static void step_poll(void *pctx) {
+    (void)pctx;
+    (void)uart_poll_rx(s_uart.pu);
+}
+
+static void step_sink(void *pctx) {
+    (void)pctx;
+    uint8_t discard[64];
+    uart_poll_rx(s_uart.pu);
+    while (uart_read(s_uart.pu, discard, sizeof(discard))) {
+    }
+}
+
+static void step_echo(void *pctx) {
+    (void)pctx;
+    uart_poll_rx(s_uart.pu);
+    uart_echo_pump(s_uart.pu);
+    uart_service_tx(s_uart.pu);
+}
+
+//------------------------------------------------------------------------------
+static void on_batch(void *pctx, size_t available) {
+    (void)pctx;
+    s_notify_calls++;
+    s_notify_bytes = available;
+}
+
+//------------------------------------------------------------------------------
+// Stream 1000 bytes at line rate into a sink loop; returns hardware overruns
+static uint64_t sink_overruns(uint32_t rx_depth, uint64_t period_ns) {
+    uart_sim_stream_t stream;
+    uart_sim_report_t rep;
+    setup_sim(rx_depth, 1u, 0u, NULL, 0u);
+    uart_sim_stream_init(&stream, &s_sim, 1000u, 0u, 0u);
+    uart_sim_set_rx_source(&s_sim, uart_sim_stream_gen, &stream);
+    // One period past the last arrival, so nothing is left in hardware
+    uart_sim_run(&s_sim, period_ns, 1000u * CHAR_NS + period_ns, step_sink, NULL);
+    uart_sim_report(&s_sim, &rep);
+    assert_int_equal(1000u, rep.rx_arrived);
+    assert_int_equal(1000u, rep.rx_read + rep.rx_overruns);
+    // The core sees each lost byte as an overrun line error
+    assert_int_equal(rep.rx_overruns > 0u,
+        uart_rx_error_count(s_uart.pu, UART_RX_ERR_OVERRUN) > 0u);
+    return rep.rx_overruns;
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_tx_character_time(void **state) {
+    (void)state;
+    uint8_t data[200];
+    uint8_t capture[200];
+    uart_sim_report_t rep;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 7u);
+    }
+    setup_sim(1u, 1u, 0u, capture, sizeof(capture));
+    assert_int_equal(sizeof(data), uart_write(s_uart.pu, data, sizeof(data)));
+
+    // Half way, only half the bytes can have left
+    uart_sim_run(&s_sim, 10u * US, 100u * CHAR_NS, step_tx, NULL);
+    uart_sim_report(&s_sim, &rep);
+    assert_in_range(rep.tx_sent, 98u, 100u);
+
+    uart_sim_run(&s_sim, 10u * US, 100u * CHAR_NS, step_tx, NULL);
+    uart_sim_report(&s_sim, &rep);
+    assert_int_equal(sizeof(data), rep.tx_sent);
+    assert_memory_equal(data, capture, sizeof(data));
+    // 11520 B/s at 115200 8N1, less the polling gaps
+    assert_in_range((uint64_t)rep.tx_bytes_per_s, 11000u, 11520u);
+    assert_true(rep.tx_line_busy > 0.95);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_overrun_by_cadence(void **state) {
+    (void)state;
+    // Single data register: the loop must beat one character time
+    assert_true(sink_overruns(1u, 200u * US) > 0u);
+    assert_int_equal(0u, sink_overruns(1u, 50u * US));
+    // An 8-deep FIFO covers a loop of several character times
+    assert_int_equal(0u, sink_overruns(8u, 500u * US));
+    assert_true(sink_overruns(8u, 800u * US) > 0u);
+}
+
+//------------------------------------------------------------------------------
+static void test_rx_latency_percentiles(void **state) {
+    (void)state;
+    uart_sim_stream_t stream;
+    uart_sim_report_t rep;
+    setup_sim(8u, 1u, 0u, NULL, 0u);
+    // Bursts of 16 bytes every 5 ms
+    uart_sim_stream_init(&stream, &s_sim, 160u, 16u, 5000u * US);
+    uart_sim_set_rx_source(&s_sim, uart_sim_stream_gen, &stream);
+    uart_sim_run(&s_sim, 300u * US, 50000u * US, step_sink, NULL);
+    uart_sim_report(&s_sim, &rep);
+    assert_int_equal(160u, rep.rx_read);
+    assert_int_equal(0u, rep.rx_overruns);
+    assert_int_equal(160u, s_rx_l.count);
+    assert_true(rep.rx_lat_p50 <= rep.rx_lat_p99);
+    assert_true(rep.rx_lat_p99 <= rep.rx_lat_max);
+    // Never waits longer than one loop period
+    assert_true(rep.rx_lat_max <= 300u * US);
+    assert_true(rep.rx_lat_max > 0u);
+}
+
+//------------------------------------------------------------------------------
+static void test_trace_and_rx_timeout(void **state) {
+    (void)state;
+    static const uart_sim_event_t trace[] = {
+        { 100u * US, 'a' }, { 187u * US, 'b' }, { 274u * US, 'c' },
+        { 2000u * US, 'd' }, { 2087u * US, 'e' },
+    };
+    uart_sim_trace_t src;
+    uint8_t out[8];
+    setup_sim(8u, 1u, 0u, NULL, 0u);
+    assert_true(uart_set_rx_batching(s_uart.pu, 0u, 4u, on_batch, NULL));
+    s_notify_calls = 0;
+    uart_sim_trace_init(&src, trace, sizeof(trace) / sizeof(trace[0]));
+    uart_sim_set_rx_source(&s_sim, uart_sim_trace_gen, &src);
+
+    // Poll every 50 us: one delivery per burst, after 4 silent characters
+    uart_sim_run(&s_sim, 50u * US, 1000u * US, step_poll, NULL);
+    assert_int_equal(1u, s_notify_calls);
+    assert_int_equal(3u, s_notify_bytes);
+    // Timestamp is virtual microseconds at the start of the batch
+    uint32_t ts = 0;
+    assert_true(uart_rx_arrival(s_uart.pu, &ts));
+    assert_in_range(ts, 100u, 150u);
+    assert_int_equal(3u, uart_read(s_uart.pu, out, sizeof(out)));
+    assert_memory_equal("abc", out, 3u);
+
+    uart_sim_run(&s_sim, 50u * US, 2000u * US, step_poll, NULL);
+    assert_int_equal(2u, s_notify_calls);
+    assert_int_equal(2u, uart_read(s_uart.pu, out, sizeof(out)));
+    assert_memory_equal("de", out, 2u);
+}
+
+//------------------------------------------------------------------------------
+static void test_echo_throughput_and_budget(void **state) {
+    (void)state;
+    uart_sim_stream_t stream;
+    uart_sim_report_t rep;
+
+    // Cheap loop keeps up with a line-rate stream
+    setup_sim(8u, 8u, 0u, NULL, 0u);
+    uart_sim_stream_init(&stream, &s_sim, 2000u, 0u, 0u);
+    uart_sim_set_rx_source(&s_sim, uart_sim_stream_gen, &stream);
+    uart_sim_run(&s_sim, 100u * US, 2100u * CHAR_NS, step_echo, NULL);
+    uart_sim_report(&s_sim, &rep);
+    assert_int_equal(0u, rep.rx_overruns);
+    assert_int_equal(2000u, rep.tx_sent);
+    assert_true(rep.tx_bytes_per_s > 10900.0);
+    // Echo lags by at most a loop period plus a Tx FIFO of characters
+    assert_true(rep.echo_lat_max <= 100u * US + 10u * CHAR_NS);
+    assert_true(rep.echo_lat_p50 <= rep.echo_lat_p99);
+
+    // 20 us per register access: the per-byte pump no longer keeps up
+    setup_sim(8u, 8u, 20u * US, NULL, 0u);
+    uart_sim_stream_init(&stream, &s_sim, 2000u, 0u, 0u);
+    uart_sim_set_rx_source(&s_sim, uart_sim_stream_gen, &stream);
+    uart_sim_run(&s_sim, 100u * US, 2100u * CHAR_NS, step_echo, NULL);
+    uart_sim_report(&s_sim, &rep);
+    assert_true(rep.rx_overruns > 0u);
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_tx_character_time),
+        cmocka_unit_test(test_rx_overrun_by_cadence),
+        cmocka_unit_test(test_rx_latency_percentiles),
+        cmocka_unit_test(test_trace_and_rx_timeout),
+        cmocka_unit_test(test_echo_throughput_and_budget),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
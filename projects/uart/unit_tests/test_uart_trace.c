@@ -0,0 +1,127 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define UART trace point unit tests: the core is built with TRACE_ENABLE
+// and the recording trace stub
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "uart_core.h"
+#include "uart_hw_stub.h"
+#include "trace_api.h"
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+
+// Virtual clock: one unit per trace edge, so every edge has its own time
+static uint64_t fake_now;
+
+static uint64_t fake_clock(void) {
+    return ++fake_now;
+}
+
+UART_DEFINE_INSTANCE(uart_t0, 8u, 8u);
+
+static uart_hw_vtable_t VTable;
+static uart_stub_ctx_t CTX;
+static uint8_t tx_out[64];
+
+static int setup(void **state) {
+    (void)state;
+    memset(&CTX, 0, sizeof(CTX));
+    CTX.ptx_buf = tx_out;
+    CTX.tx_capacity = sizeof(tx_out);
+    CTX.tx_bytes = 64;
+    uart_hw_stub_create(&VTable, &CTX);
+    if (!uart_init_instance(&uart_t0, &VTable, 115200)) {
+        return -1;
+    }
+    TRACE_INIT();
+    fake_now = 0;
+    trace_stub_reset(fake_clock);
+    return 0;
+}
+
+// Check that edge i is (id, enter)
+static void expect_edge(size_t i, uint32_t id, bool enter) {
+    const trace_stub_event_t *pe = trace_stub_event(i);
+    assert_non_null(pe);
+    assert_int_equal(id, pe->id);
+    assert_int_equal(enter, pe->enter);
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_rx_byte_paired_on_every_path(void **state) {
+    (void)state;
+    uart_t *pu = uart_t0.pu;
+
+    // Eight bytes fill the FIFO, the ninth takes the overflow path
+    for (uint8_t i = 0; i < 9u; ++i) {
+        uart_isr_rx_byte(pu, i);
+    }
+    assert_int_equal(1, uart_rx_overflow_count(pu));
+    assert_int_equal(18, trace_stub_count());
+    for (size_t i = 0; i < 18u; i += 2u) {
+        expect_edge(i, TRACE_UART_RX_BYTE, true);
+        expect_edge(i + 1u, TRACE_UART_RX_BYTE, false);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void test_echo_pump_nests_service_tx(void **state) {
+    (void)state;
+    uart_t *pu = uart_t0.pu;
+    uart_isr_rx_byte(pu, 'a');
+    uart_isr_rx_byte(pu, 'b');
+    trace_stub_reset(fake_clock);
+
+    uart_echo_pump(pu);
+
+    // Pump brackets the Tx flush triggered by its write
+    assert_int_equal(4, trace_stub_count());
+    expect_edge(0, TRACE_UART_ECHO_PUMP, true);
+    expect_edge(1, TRACE_UART_SERVICE_TX, true);
+    expect_edge(2, TRACE_UART_SERVICE_TX, false);
+    expect_edge(3, TRACE_UART_ECHO_PUMP, false);
+    assert_memory_equal("ab", tx_out, 2);
+
+    // Durations come from the timestamps of each pair
+    uint64_t pump_ns = trace_stub_event(3)->ts - trace_stub_event(0)->ts;
+    uint64_t tx_ns = trace_stub_event(2)->ts - trace_stub_event(1)->ts;
+    assert_true(pump_ns > tx_ns);
+}
+
+//------------------------------------------------------------------------------
+static void test_record_full_drops(void **state) {
+    (void)state;
+    uart_t *pu = uart_t0.pu;
+    for (uint32_t i = 0; i < TRACE_STUB_DEPTH; ++i) {
+        uart_service_tx(pu);
+    }
+    assert_int_equal(TRACE_STUB_DEPTH, trace_stub_count());
+    assert_int_equal(TRACE_STUB_DEPTH, trace_stub_dropped());
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_rx_byte_paired_on_every_path, setup),
+        cmocka_unit_test_setup(test_echo_pump_nests_service_tx, setup),
+        cmocka_unit_test_setup(test_record_full_drops, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,329 @@
+// Copyright (c) 2025 Michael Dello
+//
+// This software is provided under the MIT License.
+// See LICENSE file for details.
+//------------------------------------------------------------------------------
+//
+// Define sliding-window transfer unit tests on a simulated lossy line
+//
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
+//--------------------
+// Unit Test Framework
+//--------------------
+#include <cmocka.h>
+//--------------------
+#include "xfer_api.h"
+#include "uart_core.h"
+#include "lossy_link.h"
+
+//------------------------------------------------------------------------------
+// Constants
+//------------------------------------------------------------------------------
+
+#define BLOB_MAX   (600u * 1024u)
+#define STEP_NS    100000u
+#define STEPS_MAX  2000000u
+
+//------------------------------------------------------------------------------
+// Types
+//------------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t  *pdst;
+    size_t   len;
+    bool     ended;
+    uint32_t ended_us;
+} sink_t;
+
+typedef struct {
+    uint32_t baud;
+    uint32_t window;
+    // Peer's window, 0 for the same
+    uint32_t window_b;
+    uint32_t seg;
+    size_t   bytes;
+    uint32_t delay_us;
+    uint32_t corrupt_ppm;
+    uint32_t drop_ppm;
+    // Transfer both ways at once
+    bool     both;
+} run_cfg_t;
+
+typedef struct {
+    // Payload delivered over what the line could carry in the same time
+    double       efficiency;
+    xfer_stats_t a;
+    xfer_stats_t b;
+} run_result_t;
+
+//------------------------------------------------------------------------------
+// Variables
+//------------------------------------------------------------------------------
+
+UART_DEFINE_INSTANCE(s_ua, 1024, 512);
+UART_DEFINE_INSTANCE(s_ub, 1024, 512);
+static lossy_link_t s_link;
+static xfer_slot_t s_tx_a[XFER_WINDOW_MAX];
+static xfer_slot_t s_rx_a[XFER_WINDOW_MAX];
+static xfer_slot_t s_tx_b[XFER_WINDOW_MAX];
+static xfer_slot_t s_rx_b[XFER_WINDOW_MAX];
+static xfer_t s_a;
+static xfer_t s_b;
+static uint8_t s_src_a[BLOB_MAX];
+static uint8_t s_src_b[BLOB_MAX];
+static uint8_t s_dst_a[BLOB_MAX];
+static uint8_t s_dst_b[BLOB_MAX];
+
+//------------------------------------------------------------------------------
+// Test Helpers
+//------------------------------------------------------------------------------
+static void on_rx(void *pctx, const uint8_t *pdata, size_t len) {
+    sink_t *ps = (sink_t*)pctx;
+    assert_false(ps->ended);
+    if (len == 0u) {
+        assert_null(pdata);
+        ps->ended = true;
+        ps->ended_us = lossy_link_now_us();
+        return;
+    }
+    assert_true(ps->len + len <= BLOB_MAX);
+    memcpy(&ps->pdst[ps->len], pdata, len);
+    ps->len += len;
+}
+
+//------------------------------------------------------------------------------
+static void fill(uint8_t *p, size_t n, uint32_t seed) {
+    uint32_t x = seed;
+    for (size_t i = 0; i < n; ++i) {
+        x = x * 1664525u + 1013904223u;
+        p[i] = (uint8_t)(x >> 24);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Queue as much of src as the window takes, then the end mark
+static void feed(xfer_t *px, const uint8_t *psrc, size_t bytes, uint32_t seg,
+        size_t *poff, bool *pend) {
+    while (*poff < bytes && xfer_send_space(px)) {
+        size_t n = bytes - *poff;
+        *poff += xfer_send(px, &psrc[*poff], (n < seg) ? n : seg);
+    }
+    if (*poff == bytes && !*pend) {
+        *pend = xfer_send_end(px);
+    }
+}
+
+//------------------------------------------------------------------------------
+static void run(const run_cfg_t *pc, run_result_t *pr) {
+    uart_hw_vtable_t hw_a;
+    uart_hw_vtable_t hw_b;
+    lossy_link_config_t lc = {
+        .baud = pc->baud,
+        .bits_per_char = 10u,
+        .step_ns = STEP_NS,
+        .delay_steps = pc->delay_us * 1000u / STEP_NS,
+        .corrupt_ppm = pc->corrupt_ppm,
+        .drop_ppm = pc->drop_ppm,
+        .seed = 0x1234567u,
+    };
+    assert_true(lossy_link_create(&s_link, &lc, &hw_a, &hw_b));
+    assert_true(uart_init_instance(&s_ua, &hw_a, pc->baud));
+    assert_true(uart_init_instance(&s_ub, &hw_b, pc->baud));
+    lossy_link_connect(&s_link, s_ua.pu, s_ub.pu);
+
+    // Time out after the Tx FIFO drains and a full frame makes a round trip,
+    // with margin
+    double char_us = 1e6 / lossy_link_char_rate(&s_link);
+    uint32_t rto = (uint32_t)(2.0 * (512.0 + 2.0 * 256.0) * char_us) +
+        4u * pc->delay_us + 1000u;
+    xfer_config_t ca = { .window = pc->window, .rto = rto,
+        .now = lossy_link_now_us };
+    xfer_config_t cb = ca;
+    if (pc->window_b) {
+        cb.window = pc->window_b;
+    }
+    sink_t sink_a = { .pdst = s_dst_a };
+    sink_t sink_b = { .pdst = s_dst_b };
+    assert_true(xfer_init(&s_a, s_ua.pu, s_tx_a, s_rx_a, &ca, on_rx, &sink_a));
+    assert_true(xfer_init(&s_b, s_ub.pu, s_tx_b, s_rx_b, &cb, on_rx, &sink_b));
+
+    fill(s_src_a, pc->bytes, 1u);
+    fill(s_src_b, pc->bytes, 2u);
+    size_t off_a = 0;
+    size_t off_b = 0;
+    bool end_a = false;
+    bool end_b = false;
+    uint32_t steps = 0;
+    while (!sink_b.ended || !xfer_idle(&s_a) ||
+            (pc->both && (!sink_a.ended || !xfer_idle(&s_b)))) {
+        feed(&s_a, s_src_a, pc->bytes, pc->seg, &off_a, &end_a);
+        if (pc->both) {
+            feed(&s_b, s_src_b, pc->bytes, pc->seg, &off_b, &end_b);
+        }
+        xfer_poll(&s_a);
+        xfer_poll(&s_b);
+        lossy_link_step(&s_link);
+        assert_true(++steps < STEPS_MAX);
+    }
+
+    // Everything arrived, once, in order
+    assert_int_equal(pc->bytes, sink_b.len);
+    assert_memory_equal(s_src_a, s_dst_b, pc->bytes);
+    uint32_t ended_us = sink_b.ended_us;
+    if (pc->both) {
+        assert_int_equal(pc->bytes, sink_a.len);
+        assert_memory_equal(s_src_b, s_dst_a, pc->bytes);
+        ended_us = (sink_a.ended_us > ended_us) ? sink_a.ended_us : ended_us;
+    }
+    pr->efficiency = (double)pc->bytes /
+        ((double)ended_us * 1e-6 * lossy_link_char_rate(&s_link));
+    pr->a = s_a.stats;
+    pr->b = s_b.stats;
+    print_message("  %u baud, window %u, %u ppm corrupt, %u ppm drop: "
+        "%.1f%% of line rate, %u sent, %u resent (%u on timeout)\n",
+        pc->baud, pc->window, pc->corrupt_ppm, pc->drop_ppm,
+        100.0 * pr->efficiency, pr->a.segs_sent,
+        pr->a.resent_lost + pr->a.resent_rto, pr->a.resent_rto);
+}
+
+//------------------------------------------------------------------------------
+// Test Definitions
+//------------------------------------------------------------------------------
+static void test_clean_link_near_line_rate(void **state) {
+    (void)state;
+    run_cfg_t c = { .baud = 921600, .window = 16, .seg = XFER_SEG_MAX,
+        .bytes = 256u * 1024u };
+    run_result_t r;
+    run(&c, &r);
+    // Framing costs 8 bytes in 248; ACKs use the other direction
+    assert_true(r.efficiency > 0.93);
+    assert_int_equal(0, r.a.resent_lost + r.a.resent_rto);
+    assert_int_equal(0, r.b.dups);
+}
+
+//------------------------------------------------------------------------------
+static void test_corruption_resends_only_losses(void **state) {
+    (void)state;
+    // About 1.5% of frames damaged each way, ACKs included
+    run_cfg_t c = { .baud = 921600, .window = 16, .seg = XFER_SEG_MAX,
+        .bytes = 512u * 1024u, .corrupt_ppm = 50, .drop_ppm = 10 };
+    run_result_t r;
+    run(&c, &r);
+    assert_true(r.efficiency > 0.88);
+    uint32_t segs = (uint32_t)(c.bytes / XFER_SEG_MAX) + 2u;
+    uint32_t resent = r.a.resent_lost + r.a.resent_rto;
+    assert_true(resent > 0u);
+    assert_true(resent < segs / 20u);
+    assert_true(r.a.resent_lost > r.a.resent_rto);
+}
+
+//------------------------------------------------------------------------------
+static void test_heavy_loss_completes(void **state) {
+    (void)state;
+    // Most long frames are damaged
+    run_cfg_t c = { .baud = 115200, .window = 8, .seg = XFER_SEG_MAX,
+        .bytes = 32u * 1024u, .corrupt_ppm = 2000, .drop_ppm = 500 };
+    run_result_t r;
+    run(&c, &r);
+    assert_true(r.a.resent_lost > 0u);
+    assert_true(r.a.resent_rto > 0u);
+}
+
+//------------------------------------------------------------------------------
+static void test_window_beats_stop_and_wait(void **state) {
+    (void)state;
+    // A 2 ms adapter latency each way
+    run_cfg_t c = { .baud = 921600, .window = 1, .seg = XFER_SEG_MAX,
+        .bytes = 64u * 1024u, .delay_us = 2000 };
+    run_result_t stop_and_wait;
+    run(&c, &stop_and_wait);
+    c.window = 32;
+    run_result_t windowed;
+    run(&c, &windowed);
+    assert_true(stop_and_wait.efficiency < 0.5);
+    assert_true(windowed.efficiency > 0.9);
+}
+
+//------------------------------------------------------------------------------
+static void test_both_directions(void **state) {
+    (void)state;
+    run_cfg_t c = { .baud = 460800, .window = 12, .seg = XFER_SEG_MAX,
+        .bytes = 128u * 1024u, .corrupt_ppm = 50, .both = true };
+    run_result_t r;
+    run(&c, &r);
+    assert_true(r.efficiency > 0.85);
+}
+
+//------------------------------------------------------------------------------
+static void test_sequence_wrap(void **state) {
+    (void)state;
+    // 75000 small segments: the 16-bit sequence number wraps
+    run_cfg_t c = { .baud = 921600, .window = 32, .seg = 8,
+        .bytes = 600u * 1024u, .corrupt_ppm = 20 };
+    run_result_t r;
+    run(&c, &r);
+    assert_true(r.b.segs_rcvd > 70000u);
+}
+
+//------------------------------------------------------------------------------
+static void test_smaller_peer_window(void **state) {
+    (void)state;
+    // The receiver advertises 4; the sender's 16 is clamped to it
+    run_cfg_t c = { .baud = 921600, .window = 16, .window_b = 4,
+        .seg = XFER_SEG_MAX, .bytes = 64u * 1024u, .corrupt_ppm = 50 };
+    run_result_t r;
+    run(&c, &r);
+    assert_int_equal(4u, s_a.peer_window);
+}
+
+//------------------------------------------------------------------------------
+static void test_api_edges(void **state) {
+    (void)state;
+    uart_hw_vtable_t hw_a;
+    uart_hw_vtable_t hw_b;
+    lossy_link_config_t lc = { .baud = 115200, .bits_per_char = 10,
+        .step_ns = STEP_NS };
+    assert_true(lossy_link_create(&s_link, &lc, &hw_a, &hw_b));
+    assert_true(uart_init_instance(&s_ua, &hw_a, 115200));
+
+    xfer_config_t cfg = { .window = 0, .rto = 1000, .now = lossy_link_now_us };
+    assert_false(xfer_init(&s_a, s_ua.pu, s_tx_a, s_rx_a, &cfg, NULL, NULL));
+    cfg.window = XFER_WINDOW_MAX + 1u;
+    assert_false(xfer_init(&s_a, s_ua.pu, s_tx_a, s_rx_a, &cfg, NULL, NULL));
+    cfg.window = 2;
+    cfg.rto = 0;
+    assert_false(xfer_init(&s_a, s_ua.pu, s_tx_a, s_rx_a, &cfg, NULL, NULL));
+    cfg.rto = 1000;
+    assert_true(xfer_init(&s_a, s_ua.pu, s_tx_a, s_rx_a, &cfg, NULL, NULL));
+
+    // Segments are capped; the window limits what is queued
+    static uint8_t big[XFER_SEG_MAX * 2u];
+    assert_true(xfer_idle(&s_a));
+    assert_int_equal(2u, xfer_send_space(&s_a));
+    assert_int_equal(XFER_SEG_MAX, xfer_send(&s_a, big, sizeof(big)));
+    assert_int_equal(0u, xfer_send(&s_a, big, 0u));
+    assert_true(xfer_send_end(&s_a));
+    assert_int_equal(0u, xfer_send_space(&s_a));
+    assert_int_equal(0u, xfer_send(&s_a, big, 1u));
+    assert_false(xfer_send_end(&s_a));
+    assert_false(xfer_idle(&s_a));
+}
+
+//------------------------------------------------------------------------------
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_clean_link_near_line_rate),
+        cmocka_unit_test(test_corruption_resends_only_losses),
+        cmocka_unit_test(test_heavy_loss_completes),
+        cmocka_unit_test(test_window_beats_stop_and_wait),
+        cmocka_unit_test(test_both_directions),
+        cmocka_unit_test(test_sequence_wrap),
+        cmocka_unit_test(test_smaller_peer_window),
+        cmocka_unit_test(test_api_edges),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+# ------------------------------------------------------------------------------
+#
+# Host side of the UART bootloader (common/include/boot_api.h): load an
+# application image (raw binary, linked with stm32h563xx_app.ld) and start it
+# (needs pyserial).
+#
+#   boot_host.py --baud 921600 /dev/ttyACM0 uart_echo.bin
+#   boot_host.py /dev/ttyACM0 --run
+#
+# Reset the target just before, or while, this runs: the bootloader waits
+# BOOT_WAIT_MS for a first command before starting the application it has.
+#
+# ------------------------------------------------------------------------------
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+from xfer_host import cobs_decode, crc16_ccitt, frame_encode
+
+CMD_HELLO = 0x01
+CMD_BEGIN = 0x02
+CMD_DATA = 0x03
+CMD_END = 0x04
+CMD_RUN = 0x05
+REPLY = 0x80
+
+STATUS = ("OK", "unknown command", "wrong state", "bad size",
+          "out of sequence", "CRC mismatch", "flash error")
+
+SECTOR_BYTES = 8192
+# Per sector, with margin over the data sheet's typical erase time
+ERASE_S = 0.05
+
+
+class BootError(Exception):
+    pass
+
+
+# ------------------------------------------------------------------------------
+# Protocol
+# ------------------------------------------------------------------------------
+class Loader:
+    """One command at a time; a command is resent if no reply comes."""
+
+    def __init__(self, port, baud, retries=5):
+        self.port = port
+        self.char_s = 10.0 / baud
+        self.retries = retries
+        self.buf = bytearray()
+        self.resent = 0
+
+    def _reply(self, deadline):
+        while time.monotonic() < deadline:
+            data = self.port.read(64)
+            if not data:
+                continue
+            self.buf += data
+            while True:
+                end = self.buf.find(b"\0")
+                if end < 0:
+                    break
+                raw = cobs_decode(bytes(self.buf[:end]))
+                del self.buf[:end + 1]
+                if raw and len(raw) == 8 and crc16_ccitt(raw) == 0:
+                    return raw[:6]
+        return None
+
+    def command(self, payload, wait_s=0.0):
+        frame = frame_encode(payload)
+        # Both frames on the line, the target's work, and adapter latency
+        timeout = (len(frame) + 10) * self.char_s + wait_s + 0.1
+        for attempt in range(self.retries + 1):
+            if attempt:
+                self.resent += 1
+            self.port.write(frame)
+            while True:
+                r = self._reply(time.monotonic() + timeout)
+                if r is None:
+                    break
+                # A late reply to an earlier attempt answers this one too
+                if r[0] == payload[0] | REPLY:
+                    status, value = struct.unpack_from("<BI", r, 1)
+                    return status, value
+        raise BootError(f"no reply to command {payload[0]}")
+
+    def check(self, what, status, value):
+        if status:
+            name = STATUS[status] if status < len(STATUS) else str(status)
+            raise BootError(f"{what}: {name} (0x{value:08X})")
+        return value
+
+    def hello(self):
+        # Retry for a while: the target may still be coming out of reset
+        for _ in range(50):
+            try:
+                return self.check("HELLO", *self.command(bytes([CMD_HELLO])))
+            except BootError:
+                continue
+        raise BootError("no bootloader")
+
+    def load(self, image, progress):
+        block = self.hello()
+        crc = zlib.crc32(image) & 0xFFFFFFFF
+        sectors = (len(image) + SECTOR_BYTES - 1) // SECTOR_BYTES + 1
+        self.check("BEGIN", *self.command(
+            struct.pack("<BII", CMD_BEGIN, len(image), crc), sectors * ERASE_S))
+        off = 0
+        while off < len(image):
+            data = image[off:off + block]
+            status, nxt = self.command(struct.pack("<BI", CMD_DATA, off) + data)
+            if status == 4:
+                # A resent block overtook a lost one: go back
+                off = nxt
+                continue
+            off = self.check(f"DATA at {off}", status, nxt)
+            progress(off)
+        # Read-back of the image, one chunk per main loop pass
+        got = self.check("END", *self.command(bytes([CMD_END]),
+                                              len(image) * 1e-6 + 0.5))
+        if got != crc:
+            raise BootError(f"END: CRC 0x{got:08X}, expected 0x{crc:08X}")
+        return crc
+
+    def run(self):
+        return self.check("RUN", *self.command(bytes([CMD_RUN])))
+
+
+# ------------------------------------------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description="Load and start an application "
+                                             "through the UART bootloader")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--run", action="store_true",
+                    help="start the application once loaded")
+    ap.add_argument("port", help="serial port, e.g., /dev/ttyACM0")
+    ap.add_argument("image", nargs="?", help="raw binary to load")
+    opt = ap.parse_args()
+    if not opt.image and not opt.run:
+        ap.error("nothing to do: give an image and/or --run")
+
+    import serial  # pyserial
+    port = serial.Serial(opt.port, opt.baud, timeout=0.002)
+    loader = Loader(port, opt.baud)
+
+    def progress(n):
+        print(f"\r{n} bytes", end="", file=sys.stderr)
+
+    try:
+        if opt.image:
+            with open(opt.image, "rb") as f:
+                image = f.read()
+            start = time.monotonic()
+            crc = loader.load(image, progress)
+            elapsed = time.monotonic() - start
+            print(f"\r{len(image)} bytes in {elapsed:.2f} s, CRC-32 "
+                  f"0x{crc:08X}, {loader.resent} resent", file=sys.stderr)
+        if opt.run:
+            loader.hello()
+            base = loader.run()
+            print(f"started at 0x{base:08X}", file=sys.stderr)
+    except BootError as e:
+        print(f"\n{e}", file=sys.stderr)
+        return 1
+    except KeyboardInterrupt:
+        print("\ninterrupted", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+# ------------------------------------------------------------------------------
+#
+# Decode deferred binary log records (common/include/log_api.h) into text.
+#
+# The dictionary comes from the "log_fmt" section of the firmware ELF, or
+# from a JSON file written earlier with --emit-dict. Records are read from a
+# capture file, stdin ("-"), or a serial port (needs pyserial).
+#
+#   log_decode.py --elf uart_echo.elf capture.bin
+#   log_decode.py --elf uart_echo.elf --emit-dict uart_echo.logdict.json
+#   log_decode.py --dict uart_echo.logdict.json --tick-hz 1000 /dev/ttyACM0
+#
+# ------------------------------------------------------------------------------
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+LOG_SECTION = "log_fmt"
+LOG_ID_DROPPED = 0xFFFF
+SEP = "\x1f"
+
+# printf conversion, with the C length modifiers Python does not take
+CONV = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\d*)(?P<prec>(?:\.\d+)?)"
+    r"(?:hh|h|ll|l|j|z|t|L)?(?P<conv>[diouxXcfFeEgG%])")
+
+
+# ------------------------------------------------------------------------------
+# Dictionary
+# ------------------------------------------------------------------------------
+def elf_section(path, name):
+    """Return the contents of section `name` of an ELF32/64 file."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        raise ValueError(f"{path}: not an ELF file")
+    is64 = data[4] == 2
+    end = "<" if data[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", data, 0x3A)
+        shdr = end + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", data, 0x2E)
+        shdr = end + "IIIIIIIIII"
+
+    def header(i):
+        return struct.unpack_from(shdr, data, shoff + i * shentsize)
+
+    strtab = header(shstrndx)
+    str_off = strtab[4]
+    for i in range(shnum):
+        h = header(i)
+        sec_name = data[str_off + h[0]:data.index(b"\0", str_off + h[0])]
+        if sec_name.decode() == name:
+            return data[h[4]:h[4] + h[5]]
+    raise ValueError(f"{path}: no {name} section (no LOG_x() statements?)")
+
+
+def parse_dict(blob):
+    """Map each entry's offset (its message ID) to its text."""
+    entries = {}
+    pos = 0
+    while pos < len(blob):
+        if blob[pos] == 0:
+            # Alignment padding between entries
+            pos += 1
+            continue
+        end = blob.index(b"\0", pos)
+        entries[pos] = blob[pos:end].decode("utf-8", "replace")
+        pos = end + 1
+    return entries
+
+
+# ------------------------------------------------------------------------------
+# Wire Format
+# ------------------------------------------------------------------------------
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(enc):
+    out = bytearray()
+    pos = 0
+    while pos < len(enc):
+        code = enc[pos]
+        if code == 0 or pos + code > len(enc):
+            return None
+        out += enc[pos + 1:pos + code]
+        pos += code
+        if code != 0xFF and pos < len(enc):
+            out.append(0)
+    return bytes(out)
+
+
+def varints(data, pos):
+    values = []
+    while pos < len(data):
+        v = 0
+        shift = 0
+        while True:
+            b = data[pos]
+            pos += 1
+            v |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80 or pos >= len(data):
+                break
+        values.append(v & 0xFFFFFFFF)
+    return values
+
+
+def records(stream, stats):
+    """Yield (id, ts, args) per valid frame; bad frames are counted."""
+    buf = bytearray()
+    for chunk in stream:
+        buf += chunk
+        while True:
+            end = buf.find(b"\0")
+            if end < 0:
+                break
+            enc = bytes(buf[:end])
+            del buf[:end + 1]
+            if not enc:
+                continue
+            frame = cobs_decode(enc)
+            if frame is None or len(frame) < 5:
+                stats["malformed"] += 1
+                continue
+            if crc16_ccitt(frame) != 0:
+                stats["crc_errors"] += 1
+                continue
+            payload = frame[:-2]
+            vals = varints(payload, 2)
+            yield payload[0] | (payload[1] << 8), vals[0], vals[1:]
+
+
+# ------------------------------------------------------------------------------
+# Formatting
+# ------------------------------------------------------------------------------
+def format_args(fmt, args):
+    it = iter(args)
+
+    def repl(m):
+        conv = m.group("conv")
+        if conv == "%":
+            return "%"
+        v = next(it, None)
+        if v is None:
+            return "<?>"
+        spec = "%" + m.group("flags") + m.group("width") + m.group("prec")
+        if conv in "di":
+            v = v - (1 << 32) if v & 0x80000000 else v
+            conv = "d"
+        elif conv in "fFeEgG":
+            v, = struct.unpack("<f", struct.pack("<I", v))
+        return (spec + conv) % v
+
+    return CONV.sub(repl, fmt)
+
+
+def render(entries, rid, ts, args, tick_hz):
+    stamp = f"{ts / tick_hz:12.6f}" if tick_hz else f"{ts:>10}"
+    if rid == LOG_ID_DROPPED:
+        n = args[0] if args else 0
+        return f"{stamp} ! *** {n} log record(s) dropped ***"
+    entry = entries.get(rid)
+    if entry is None:
+        return f"{stamp} ? <unknown id {rid}> {args}"
+    level, path, line, fmt = entry.split(SEP, 3)
+    name = path.replace("\\", "/").rsplit("/", 1)[-1]
+    return f"{stamp} {level} {name}:{line}: {format_args(fmt, args)}"
+
+
+# ------------------------------------------------------------------------------
+# Input
+# ------------------------------------------------------------------------------
+# Windows serial port names; anything else not under /dev/ is a file, even
+# one named e.g. commands.log
+COM_PORT = re.compile(r"COM\d+", re.IGNORECASE)
+
+
+def is_serial_port(src):
+    return src.startswith("/dev/") or COM_PORT.fullmatch(src) is not None
+
+
+# ------------------------------------------------------------------------------
+def open_input(src, baud):
+    """Return an iterator of byte chunks from a file, stdin or serial port."""
+    if src == "-":
+        f = sys.stdin.buffer
+        return iter(lambda: f.read1(4096), b"")
+    if is_serial_port(src):
+        import serial  # pyserial, only needed for live capture
+        port = serial.Serial(src, baud, timeout=0.1)
+        return iter(lambda: port.read(4096) or b"", None)
+    f = open(src, "rb")
+    return iter(lambda: f.read(4096), b"")
+
+
+# ------------------------------------------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description=__doc__ or "Decode binary logs")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--elf", help="firmware ELF holding the log_fmt section")
+    src.add_argument("--dict", help="dictionary JSON from --emit-dict")
+    ap.add_argument("--emit-dict", metavar="PATH",
+                    help="write the dictionary as JSON and exit")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--tick-hz", type=float, default=0.0,
+                    help="print timestamps in seconds at this tick rate")
+    ap.add_argument("input", nargs="?", default="-",
+                    help="capture file, serial port, or - for stdin")
+    opt = ap.parse_args()
+
+    if opt.elf:
+        entries = parse_dict(elf_section(opt.elf, LOG_SECTION))
+    else:
+        with open(opt.dict) as f:
+            entries = {int(k): v for k, v in json.load(f).items()}
+    if opt.emit_dict:
+        with open(opt.emit_dict, "w") as f:
+            json.dump({str(k): v for k, v in sorted(entries.items())}, f,
+                      indent=1)
+        return 0
+
+    stats = {"crc_errors": 0, "malformed": 0}
+    try:
+        for rid, ts, args in records(open_input(opt.input, opt.baud), stats):
+            print(render(entries, rid, ts, args, opt.tick_hz), flush=True)
+    except KeyboardInterrupt:
+        pass
+    if stats["crc_errors"] or stats["malformed"]:
+        print(f"frames dropped: {stats['crc_errors']} CRC, "
+              f"{stats['malformed']} malformed", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
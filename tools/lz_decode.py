@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+# ------------------------------------------------------------------------------
+#
+# Decompress a UART stream written with lz_write() (common/include/lz_api.h).
+#
+# The stream is read from a capture file, stdin ("-"), or a serial port
+# (needs pyserial), and written to stdout as it decodes. Start the capture
+# before the target starts the stream: it cannot be joined part way.
+#
+#   lz_decode.py capture.bin > telemetry.txt
+#   lz_decode.py --baud 115200 /dev/ttyACM0
+#
+# ------------------------------------------------------------------------------
+
+import argparse
+import sys
+
+from log_decode import open_input
+
+WINDOW = 1024
+MATCH_MIN = 3
+TOKEN_MATCH = 0x80
+
+
+# ------------------------------------------------------------------------------
+# Decoder
+# ------------------------------------------------------------------------------
+class Decoder:
+    """Same state machine as lz_decode(): any split of the stream works."""
+
+    def __init__(self):
+        self.hist = bytearray()
+        self.lit_left = 0
+        self.token = None
+        self.bytes_in = 0
+        self.bytes_out = 0
+
+    def feed(self, data):
+        out = bytearray()
+        i = 0
+        while i < len(data):
+            if self.lit_left:
+                k = min(self.lit_left, len(data) - i)
+                out += data[i:i + k]
+                self.hist += data[i:i + k]
+                self.lit_left -= k
+                i += k
+            else:
+                b = data[i]
+                i += 1
+                if self.token is not None:
+                    n = ((self.token >> 2) & 0x1F) + MATCH_MIN
+                    d = (((self.token & 0x03) << 8) | b) + 1
+                    self.token = None
+                    if d > len(self.hist):
+                        raise ValueError(f"match distance {d} before the "
+                                         "start of the stream")
+                    # Byte by byte: a match may overlap what it produces
+                    for _ in range(n):
+                        self.hist.append(self.hist[-d])
+                    out += self.hist[-n:]
+                elif b & TOKEN_MATCH:
+                    self.token = b
+                else:
+                    self.lit_left = b + 1
+            if len(self.hist) > 4 * WINDOW:
+                del self.hist[:-WINDOW]
+        self.bytes_in += len(data)
+        self.bytes_out += len(out)
+        return bytes(out)
+
+
+# ------------------------------------------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description="Decompress an lz_write() "
+                                             "UART stream")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--stats", action="store_true",
+                    help="print the compression ratio at the end")
+    ap.add_argument("input", nargs="?", default="-",
+                    help="capture file, serial port, or - for stdin")
+    opt = ap.parse_args()
+
+    dec = Decoder()
+    out = sys.stdout.buffer
+    try:
+        for chunk in open_input(opt.input, opt.baud):
+            if chunk:
+                out.write(dec.feed(chunk))
+                out.flush()
+    except KeyboardInterrupt:
+        pass
+    except ValueError as e:
+        print(f"\ncorrupt stream: {e}", file=sys.stderr)
+        return 1
+    if opt.stats and dec.bytes_in:
+        print(f"{dec.bytes_in} -> {dec.bytes_out} bytes, ratio "
+              f"{dec.bytes_out / dec.bytes_in:.2f}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
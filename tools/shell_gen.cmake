@@ -0,0 +1,31 @@
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+#-------------------------------------------------------------------------------
+#
+# shell_table_generate(<out.c> <in.cmds> <symbol>)
+#
+# Generate a shell command table source with tools/shell_gen.py, rebuilt when
+# the command list changes. Sets SHELL_GEN_FOUND in the caller's scope; when
+# it is false (no Python 3), nothing is generated.
+#
+#-------------------------------------------------------------------------------
+
+find_package(Python3 COMPONENTS Interpreter QUIET)
+set(SHELL_GEN_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/shell_gen.py")
+
+function(shell_table_generate out in symbol)
+    set(SHELL_GEN_FOUND ${Python3_Interpreter_FOUND} PARENT_SCOPE)
+    if(NOT Python3_Interpreter_FOUND)
+        return()
+    endif()
+    add_custom_command(
+        OUTPUT ${out}
+        COMMAND Python3::Interpreter ${SHELL_GEN_SCRIPT} ${in} ${out}
+            --symbol ${symbol}
+        DEPENDS ${in} ${SHELL_GEN_SCRIPT}
+        COMMENT "Generating shell table ${symbol}"
+        VERBATIM
+    )
+endfunction()
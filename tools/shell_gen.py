@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+# ------------------------------------------------------------------------------
+#
+# Generate a shell command table (common/include/shell_api.h) with a minimal
+# perfect hash over the command names, so dispatch costs two hashes and one
+# string compare however many commands there are.
+#
+# Input is one command per line: name, handler function, help text. Blank
+# lines and lines starting with '#' are ignored.
+#
+#   # name   handler         help
+#   help     shell_cmd_help  List commands
+#   stats    cmd_stats       Show UART counters
+#
+#   shell_gen.py console.cmds console_cmds.c --symbol g_console_cmds
+#
+# ------------------------------------------------------------------------------
+
+import argparse
+import re
+import sys
+
+NAME = re.compile(r"^[!-~]+$")
+IDENT = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+DISP_MAX = 0x7FFF
+
+
+# ------------------------------------------------------------------------------
+# Hash (must match phash() in common/services/shell/shell.c)
+# ------------------------------------------------------------------------------
+def phash(seed, key):
+    """FNV-1a over the name bytes, with the seed folded into the basis and a
+    final mix (the low bits of plain FNV-1a only see the low input bits)."""
+    h = 0x811C9DC5 ^ seed
+    for b in key:
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+    return h ^ (h >> 13)
+
+
+def build(keys):
+    """Hash and displace: return (disp, slots) with slots[i] the key there.
+
+    Keys hash into len(keys) buckets with seed 0. The largest buckets are
+    placed first, each by searching for one seed that sends all of its keys
+    to free slots; disp holds that seed. Buckets of one key take any free
+    slot directly, stored as -(slot + 1).
+    """
+    n = len(keys)
+    buckets = [[] for _ in range(n)]
+    for k in keys:
+        buckets[phash(0, k) % n].append(k)
+    disp = [0] * n
+    slots = [None] * n
+    order = sorted(range(n), key=lambda b: len(buckets[b]), reverse=True)
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) <= 1:
+            break
+        for d in range(1, DISP_MAX + 1):
+            want = [phash(d, k) % n for k in bucket]
+            if len(set(want)) == len(want) and \
+                    all(slots[s] is None for s in want):
+                break
+        else:
+            raise ValueError(f"no seed found for bucket {bucket!r}")
+        disp[b] = d
+        for s, k in zip(want, bucket):
+            slots[s] = k
+    free = [s for s in range(n) if slots[s] is None]
+    for b in order:
+        if len(buckets[b]) != 1:
+            continue
+        s = free.pop()
+        disp[b] = -(s + 1)
+        slots[s] = buckets[b][0]
+    return disp, slots
+
+
+# ------------------------------------------------------------------------------
+# Input and Output
+# ------------------------------------------------------------------------------
+def parse(path):
+    cmds = {}
+    with open(path) as f:
+        for num, raw in enumerate(f, 1):
+            line = raw.strip()
+            if not line or line.startswith("#"):
+                continue
+            parts = line.split(None, 2)
+            if len(parts) < 2:
+                raise ValueError(f"{path}:{num}: expected: name handler [help]")
+            name, handler = parts[0], parts[1]
+            text = parts[2] if len(parts) > 2 else ""
+            if not NAME.match(name) or not IDENT.match(handler):
+                raise ValueError(f"{path}:{num}: bad name or handler")
+            if name in cmds:
+                raise ValueError(f"{path}:{num}: duplicate command '{name}'")
+            cmds[name] = (handler, text)
+    if not cmds:
+        raise ValueError(f"{path}: no commands")
+    if len(cmds) > DISP_MAX:
+        raise ValueError(f"{path}: more than {DISP_MAX} commands")
+    return cmds
+
+
+def c_string(s):
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def emit(out, src, symbol, cmds):
+    keys = [name.encode() for name in cmds]
+    disp, slots = build(keys)
+    lines = [
+        f"// Generated by tools/shell_gen.py from {src}; do not edit",
+        "",
+        '#include "shell_api.h"',
+        "",
+    ]
+    for handler in sorted({h for h, _ in cmds.values()}):
+        lines.append(f"int {handler}(shell_t *psh, int argc, char **argv);")
+    lines += ["", f"static const shell_cmd_t s_cmds[{len(slots)}] = {{"]
+    for key in slots:
+        name = key.decode()
+        handler, text = cmds[name]
+        lines.append(f"    {{ {c_string(name)}, {handler}, {c_string(text)} }},")
+    lines += ["};", "", f"static const int16_t s_disp[{len(disp)}] = {{"]
+    for i in range(0, len(disp), 12):
+        lines.append("    " + ", ".join(str(d) for d in disp[i:i + 12]) + ",")
+    lines += [
+        "};",
+        "",
+        f"const shell_table_t {symbol} = {{",
+        "    .pcmds = s_cmds,",
+        "    .pdisp = s_disp,",
+        f"    .count = {len(slots)}u,",
+        "};",
+        "",
+    ]
+    with open(out, "w") as f:
+        f.write("\n".join(lines))
+
+
+# ------------------------------------------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description="Generate a shell command table")
+    ap.add_argument("input", help="command list")
+    ap.add_argument("output", help="C source to write")
+    ap.add_argument("--symbol", default="g_shell_cmds",
+                    help="name of the shell_table_t to define")
+    opt = ap.parse_args()
+    try:
+        emit(opt.output, opt.input.replace("\\", "/").rsplit("/", 1)[-1],
+             opt.symbol, parse(opt.input))
+    except (OSError, ValueError) as e:
+        print(f"shell_gen: {e}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
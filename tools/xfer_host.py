@@ -0,0 +1,348 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Michael Dello
+#
+# This software is provided under the MIT License.
+# See LICENSE file for details.
+# ------------------------------------------------------------------------------
+#
+# Host peer for the sliding-window transfer (common/include/xfer_api.h): send
+# a file to, or receive one from, a target over a serial port (needs
+# pyserial).
+#
+#   xfer_host.py --baud 921600 /dev/ttyACM0 send image.bin
+#   xfer_host.py --baud 921600 --window 32 /dev/ttyACM0 recv capture.bin
+#
+# The Peer class follows xfer.c rule for rule, on any port object with
+# read(n) (non-blocking or short timeout) and write(data).
+#
+# ------------------------------------------------------------------------------
+
+import argparse
+import struct
+import sys
+import time
+
+SEG_MAX = 240
+WINDOW_MAX = 32
+TYPE_DATA = 0x01
+TYPE_ACK = 0x02
+
+TX_QUEUED, TX_SENT, TX_LOST, TX_ACKED = range(4)
+
+
+# ------------------------------------------------------------------------------
+# Wire Format
+# ------------------------------------------------------------------------------
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for b in data:
+        if b == 0:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(b)
+        code += 1
+        if code == 0xFF:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(enc):
+    out = bytearray()
+    pos = 0
+    while pos < len(enc):
+        code = enc[pos]
+        if code == 0 or pos + code > len(enc):
+            return None
+        out += enc[pos + 1:pos + code]
+        pos += code
+        if code != 0xFF and pos < len(enc):
+            out.append(0)
+    return bytes(out)
+
+
+def frame_encode(payload):
+    return cobs_encode(payload + struct.pack(">H", crc16_ccitt(payload))) \
+        + b"\0"
+
+
+# ------------------------------------------------------------------------------
+# Protocol
+# ------------------------------------------------------------------------------
+class Slot:
+    __slots__ = ("seq", "data", "state", "sent_at", "stamp")
+
+    def __init__(self, seq, data):
+        self.seq = seq
+        self.data = data
+        self.state = TX_QUEUED
+        self.sent_at = 0.0
+        self.stamp = 0
+
+
+class Peer:
+    """One endpoint; on_rx(data) gets segments in order, b"" at the end."""
+
+    def __init__(self, port, window=16, rto=0.2, on_rx=None):
+        if not 1 <= window <= WINDOW_MAX:
+            raise ValueError(f"window must be 1 to {WINDOW_MAX}")
+        self.port = port
+        self.window = window
+        self.rto = rto
+        self.on_rx = on_rx
+        # Sender, counting sequence numbers without wrapping
+        self.tx = {}
+        self.base = 0
+        self.next = 0
+        self.peer_window = window
+        self.stamp = 0
+        self.acked_stamp = 0
+        # Receiver
+        self.rx = {}
+        self.expected = 0
+        self.ack_due = False
+        self.buf = bytearray()
+        self.stats = dict(segs_sent=0, resent_lost=0, resent_rto=0,
+                          segs_rcvd=0, dups=0, acks_sent=0, acks_rcvd=0,
+                          bad_frames=0)
+
+    # Sending
+    def send_space(self):
+        return max(0, min(self.window, self.peer_window) -
+                   (self.next - self.base))
+
+    def send(self, data):
+        """Queue one segment; returns the bytes taken, 0 if the window is
+        full."""
+        if not data or not self.send_space():
+            return 0
+        data = bytes(data[:SEG_MAX])
+        self.tx[self.next] = Slot(self.next, data)
+        self.next += 1
+        return len(data)
+
+    def send_end(self):
+        if not self.send_space():
+            return False
+        self.tx[self.next] = Slot(self.next, b"")
+        self.next += 1
+        return True
+
+    def idle(self):
+        return self.base == self.next
+
+    def _send_data(self, s):
+        payload = struct.pack("<BH", TYPE_DATA, s.seq & 0xFFFF) + s.data
+        self.port.write(frame_encode(payload))
+        self.stamp += 1
+        s.state = TX_SENT
+        s.sent_at = time.monotonic()
+        s.stamp = self.stamp
+        self.stats["segs_sent"] += 1
+
+    def _send_ack(self):
+        bitmap = 0
+        for i in range(self.window - 1):
+            if self.expected + 1 + i in self.rx:
+                bitmap |= 1 << i
+        self.port.write(frame_encode(struct.pack(
+            "<BHIB", TYPE_ACK, self.expected & 0xFFFF, bitmap, self.window)))
+        self.stats["acks_sent"] += 1
+
+    # Receiving
+    def _deliver(self, data):
+        self.expected += 1
+        self.stats["segs_rcvd"] += 1
+        if self.on_rx:
+            self.on_rx(data)
+
+    def _on_data(self, payload):
+        seq, = struct.unpack_from("<H", payload, 1)
+        d = (seq - self.expected) & 0xFFFF
+        self.ack_due = True
+        if d >= self.window or self.expected + d in self.rx:
+            self.stats["dups"] += 1
+            return
+        if d:
+            self.rx[self.expected + d] = payload[3:]
+            return
+        self._deliver(payload[3:])
+        while self.expected in self.rx:
+            self._deliver(self.rx.pop(self.expected))
+
+    def _ack(self, seq):
+        s = self.tx.get(seq)
+        if s and s.state in (TX_SENT, TX_LOST):
+            s.state = TX_ACKED
+            self.acked_stamp = max(self.acked_stamp, s.stamp)
+
+    def _on_ack(self, payload):
+        _, cum, bitmap, window = struct.unpack("<BHIB", payload)
+        d = (cum - self.base) & 0xFFFF
+        in_flight = self.next - self.base
+        if d > in_flight:
+            return
+        self.stats["acks_rcvd"] += 1
+        self.peer_window = min(max(window, 1), WINDOW_MAX)
+        cum = self.base + d
+        for seq in range(self.base, cum):
+            self._ack(seq)
+        for i in range(32):
+            if bitmap >> i & 1 and cum + 1 + i - self.base < in_flight:
+                self._ack(cum + 1 + i)
+        while self.base != self.next and self.tx[self.base].state == TX_ACKED:
+            del self.tx[self.base]
+            self.base += 1
+        # Sent before a segment that got through, yet unacknowledged: lost
+        for s in self.tx.values():
+            if s.state == TX_SENT and s.stamp < self.acked_stamp:
+                s.state = TX_LOST
+
+    def _on_frame(self, enc):
+        raw = cobs_decode(enc)
+        if raw is None or len(raw) < 3 or crc16_ccitt(raw) != 0:
+            self.stats["bad_frames"] += 1
+            return
+        payload = raw[:-2]
+        if payload[0] == TYPE_DATA:
+            self._on_data(payload)
+        elif payload[0] == TYPE_ACK and len(payload) == 8:
+            self._on_ack(payload)
+
+    def poll(self):
+        data = self.port.read(4096)
+        if data:
+            self.buf += data
+            while True:
+                end = self.buf.find(b"\0")
+                if end < 0:
+                    break
+                if end:
+                    self._on_frame(bytes(self.buf[:end]))
+                del self.buf[:end + 1]
+
+        if self.ack_due:
+            self._send_ack()
+            self.ack_due = False
+
+        if self.base != self.next:
+            s = self.tx[self.base]
+            if s.state == TX_SENT and time.monotonic() - s.sent_at >= self.rto:
+                self._send_data(s)
+                self.stats["resent_rto"] += 1
+
+        for seq in range(self.base, self.next):
+            s = self.tx[seq]
+            if s.state == TX_LOST:
+                self.stats["resent_lost"] += 1
+                self._send_data(s)
+            elif s.state == TX_QUEUED:
+                self._send_data(s)
+
+
+# ------------------------------------------------------------------------------
+# Transfers
+# ------------------------------------------------------------------------------
+def send_file(peer, f, progress):
+    end_queued = False
+    data = f.read(SEG_MAX)
+    total = 0
+    while not (end_queued and peer.idle()):
+        while data and peer.send_space():
+            total += peer.send(data)
+            data = f.read(SEG_MAX)
+        if not data and not end_queued:
+            end_queued = peer.send_end()
+        peer.poll()
+        progress(total)
+    return total
+
+
+def recv_file(peer, f, progress):
+    state = {"total": 0, "done": False}
+
+    def on_rx(data):
+        if not data:
+            state["done"] = True
+            return
+        f.write(data)
+        state["total"] += len(data)
+
+    peer.on_rx = on_rx
+    while not state["done"]:
+        peer.poll()
+        progress(state["total"])
+    # Linger so the final ACK is sent and a resend of the end mark answered
+    linger = time.monotonic() + 2 * peer.rto
+    while time.monotonic() < linger:
+        peer.poll()
+    return state["total"]
+
+
+# ------------------------------------------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description="Sliding-window file transfer")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--window", type=int, default=16)
+    ap.add_argument("--rto", type=float, default=0.0,
+                    help="retransmission timeout in seconds "
+                         "(default: from baud and window)")
+    ap.add_argument("port", help="serial port, e.g., /dev/ttyACM0")
+    ap.add_argument("mode", choices=("send", "recv"))
+    ap.add_argument("file")
+    opt = ap.parse_args()
+
+    import serial  # pyserial
+    port = serial.Serial(opt.port, opt.baud, timeout=0.002)
+    # Time to send a full window, twice, plus USB adapter latency
+    char_s = 10.0 / opt.baud
+    rto = opt.rto or 2 * opt.window * (SEG_MAX + 8) * char_s + 0.05
+    peer = Peer(port, opt.window, rto)
+
+    start = time.monotonic()
+
+    def progress(n):
+        print(f"\r{n} bytes", end="", file=sys.stderr)
+
+    try:
+        if opt.mode == "send":
+            with open(opt.file, "rb") as f:
+                total = send_file(peer, f, progress)
+        else:
+            with open(opt.file, "wb") as f:
+                total = recv_file(peer, f, progress)
+    except KeyboardInterrupt:
+        print("\ninterrupted", file=sys.stderr)
+        return 1
+    elapsed = time.monotonic() - start
+    rate = total / elapsed if elapsed else 0.0
+    print(f"\r{total} bytes in {elapsed:.2f} s, {rate:.0f} B/s "
+          f"({100.0 * rate * 10 / opt.baud:.1f}% of line rate)",
+          file=sys.stderr)
+    s = peer.stats
+    print(f"sent {s['segs_sent']}, resent {s['resent_lost']} lost "
+          f"+ {s['resent_rto']} on timeout, {s['dups']} duplicates, "
+          f"{s['bad_frames']} bad frames", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())